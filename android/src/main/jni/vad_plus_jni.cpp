@@ -5,62 +5,158 @@
 #include <pthread.h>
 #include <android/log.h>
 
+#include "vad_convert.h"
+#include "vad_events.h"
+#include "vad_gate.h"
+#include "vad_platform.h"
+#include "vad_plus.h"
+#include "vad_resample.h"
+#include "vad_ring.h"
+#include "vad_stats.h"
+#include "vad_trace.h"
+#include "vad_status.h"
+
 #define TAG "VadPlusJNI"
 #define LOGD(...) __android_log_print(ANDROID_LOG_DEBUG, TAG, __VA_ARGS__)
 #define LOGE(...) __android_log_print(ANDROID_LOG_ERROR, TAG, __VA_ARGS__)
 
 // ============================================================================
-// VAD Event Structure (matching iOS/Dart expectations)
+// Global State
 // ============================================================================
 
-struct VADEventC
+static JavaVM *g_jvm = nullptr;
+static jclass g_handleManagerClass = nullptr;
+static jclass g_handleInternalClass = nullptr;
+static jclass g_configInternalClass = nullptr;
+
+// Method and field IDs stay valid while the classes above are referenced, so
+// they are looked up once in JNI_OnLoad instead of on every FFI call
+struct JniIds
 {
-    int32_t type;
-
-    // Frame data
-    float frame_probability;
-    int32_t frame_is_speech;
-    const float *frame_data;
-    int32_t frame_length;
-
-    // Speech end data
-    const int16_t *speech_end_audio_data;
-    int32_t speech_end_audio_length;
-    int32_t speech_end_duration_ms;
-
-    // Error data
-    const char *error_message;
-    int32_t error_code;
+    // VadPlusHandleManager (static)
+    jmethodID createHandle;
+    jmethodID getHandle;
+    jmethodID removeHandle;
+    jmethodID getApplicationContext;
+
+    // VADConfigInternal
+    jmethodID configConstructor;
+
+    // VADHandleInternal
+    jmethodID initialize;
+    jmethodID initializeFromMemory;
+    jmethodID setCallback;
+    jmethodID invalidateCallback;
+    jmethodID setEventMask;
+    jmethodID setFrameEventInterval;
+    jmethodID startListening;
+    jmethodID stopListening;
+    jmethodID drainInput;
+    jmethodID resetStates;
+    jmethodID forceEndSpeech;
+    jmethodID isSpeaking;
+    jmethodID prewarm;
+    jmethodID getWarmupInfo;
+    jmethodID startTrace;
+    jmethodID stopTrace;
+    jmethodID dumpTrace;
+    jmethodID getLastError;
+    jfieldID inputRing;
+    jfieldID inputResampler;
+    jfieldID statusBlock;
+    jfieldID statsRecorder;
+    jfieldID eventPool;
 };
 
-struct VADConfig
+static JniIds g_ids = {};
+static bool g_idsResolved = false;
+
+// The opaque VADHandle behind the FFI: the Kotlin handle pinned by a global
+// ref, so exports call into it without any lookup
+struct VADHandle
 {
-    float positive_speech_threshold;
-    float negative_speech_threshold;
-    int32_t pre_speech_pad_frames;
-    int32_t redemption_frames;
-    int32_t min_speech_frames;
-    int32_t sample_rate;
-    int32_t frame_samples;
-    int32_t end_speech_pad_frames;
-    int32_t is_debug;
+    jlong id; // Key in VadPlusHandleManager
+    jobject object;
+    VADStatusBlock *status; // Owned by the Kotlin handle, fixed for its lifetime
+    VADStatsRecorder *stats; // Same
+    char last_error[1024];
 };
 
-// Callback type
-typedef void (*VADEventCallback)(const void *event, void *user_data);
-
 // ============================================================================
-// Global State
+// JNI OnLoad
 // ============================================================================
 
-static JavaVM *g_jvm = nullptr;
-static jclass g_handleManagerClass = nullptr;
-static jclass g_handleInternalClass = nullptr;
-static jclass g_configInternalClass = nullptr;
+// Lookups below stop at the first failure: no JNI call may run with an exception pending
+static jmethodID staticMethodId(JNIEnv *env, jclass clazz, const char *name, const char *signature)
+{
+    return env->ExceptionCheck() ? nullptr : env->GetStaticMethodID(clazz, name, signature);
+}
 
-// ============================================================================
-// JNI OnLoad
-// ============================================================================
+static jmethodID methodId(JNIEnv *env, jclass clazz, const char *name, const char *signature)
+{
+    return env->ExceptionCheck() ? nullptr : env->GetMethodID(clazz, name, signature);
+}
+
+static jfieldID fieldId(JNIEnv *env, jclass clazz, const char *name, const char *signature)
+{
+    return env->ExceptionCheck() ? nullptr : env->GetFieldID(clazz, name, signature);
+}
+
+static bool resolveIds(JNIEnv *env)
+{
+    if (g_handleManagerClass == nullptr || g_handleInternalClass == nullptr || g_configInternalClass == nullptr)
+        return false;
+
+    JniIds ids = {};
+    ids.createHandle = staticMethodId(env, g_handleManagerClass, "createHandle", "()J");
+    ids.getHandle = staticMethodId(env, g_handleManagerClass, "getHandle",
+                                   "(J)Ldev/miracle/vad_plus/VADHandleInternal;");
+    ids.removeHandle = staticMethodId(env, g_handleManagerClass, "removeHandle", "(J)V");
+    ids.getApplicationContext = staticMethodId(env, g_handleManagerClass, "getApplicationContext",
+                                               "()Landroid/content/Context;");
+
+    // VADConfigInternal's primary constructor: one type per field, in declaration
+    // order, as newConfigObject() passes them. Change all three together.
+    ids.configConstructor = methodId(env, g_configInternalClass, "<init>", "(FFIIIIIIZIIZIZIIFF)V");
+
+    ids.initialize = methodId(env, g_handleInternalClass, "initialize",
+                              "(Ldev/miracle/vad_plus/VADConfigInternal;Ljava/lang/String;Landroid/content/Context;)I");
+    ids.initializeFromMemory = methodId(env, g_handleInternalClass, "initializeFromMemory",
+                                        "(Ldev/miracle/vad_plus/VADConfigInternal;Ljava/nio/ByteBuffer;)I");
+    ids.setCallback = methodId(env, g_handleInternalClass, "setCallback", "(JJ)V");
+    ids.invalidateCallback = methodId(env, g_handleInternalClass, "invalidateCallback", "()V");
+    ids.setEventMask = methodId(env, g_handleInternalClass, "setEventMask", "(I)V");
+    ids.setFrameEventInterval = methodId(env, g_handleInternalClass, "setFrameEventInterval", "(I)V");
+    ids.startListening = methodId(env, g_handleInternalClass, "startListening", "()I");
+    ids.stopListening = methodId(env, g_handleInternalClass, "stopListening", "()V");
+    ids.drainInput = methodId(env, g_handleInternalClass, "drainInput", "()V");
+    ids.resetStates = methodId(env, g_handleInternalClass, "resetStates", "()V");
+    ids.forceEndSpeech = methodId(env, g_handleInternalClass, "forceEndSpeech", "()V");
+    ids.isSpeaking = methodId(env, g_handleInternalClass, "isSpeaking", "()Z");
+    ids.prewarm = methodId(env, g_handleInternalClass, "prewarm", "(I)I");
+    ids.getWarmupInfo = methodId(env, g_handleInternalClass, "getWarmupInfo", "()[F");
+    ids.startTrace = methodId(env, g_handleInternalClass, "startTrace", "(I)I");
+    ids.stopTrace = methodId(env, g_handleInternalClass, "stopTrace", "()V");
+    ids.dumpTrace = methodId(env, g_handleInternalClass, "dumpTrace", "(Ljava/lang/String;)I");
+    ids.getLastError = methodId(env, g_handleInternalClass, "getLastError", "()Ljava/lang/String;");
+    ids.inputRing = fieldId(env, g_handleInternalClass, "inputRing", "J");
+    ids.inputResampler = fieldId(env, g_handleInternalClass, "inputResampler", "J");
+    ids.statusBlock = fieldId(env, g_handleInternalClass, "statusBlock", "J");
+    ids.statsRecorder = fieldId(env, g_handleInternalClass, "statsRecorder", "J");
+    ids.eventPool = fieldId(env, g_handleInternalClass, "eventPool", "J");
+
+    // Any failed lookup leaves a NoSuchMethodError/NoSuchFieldError pending
+    if (env->ExceptionCheck())
+    {
+        env->ExceptionDescribe();
+        env->ExceptionClear();
+        LOGE("Failed to resolve VAD Plus method IDs in JNI_OnLoad");
+        return false;
+    }
+
+    g_ids = ids;
+    return true;
+}
 
 extern "C" JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved)
 {
@@ -129,10 +225,13 @@ extern "C" JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved)
         }
     }
 
-    LOGD("JNI_OnLoad completed (HandleManager: %s, HandleInternal: %s, ConfigInternal: %s)",
+    g_idsResolved = resolveIds(env);
+
+    LOGD("JNI_OnLoad completed (HandleManager: %s, HandleInternal: %s, ConfigInternal: %s, IDs: %s)",
          g_handleManagerClass != nullptr ? "OK" : "FAILED",
          g_handleInternalClass != nullptr ? "OK" : "FAILED",
-         g_configInternalClass != nullptr ? "OK" : "FAILED");
+         g_configInternalClass != nullptr ? "OK" : "FAILED",
+         g_idsResolved ? "OK" : "FAILED");
 
     return JNI_VERSION_1_6;
 }
@@ -158,6 +257,7 @@ extern "C" JNIEXPORT void JNICALL JNI_OnUnload(JavaVM *vm, void *reserved)
             g_configInternalClass = nullptr;
         }
     }
+    g_idsResolved = false;
     g_jvm = nullptr;
 }
 
@@ -193,382 +293,897 @@ static JNIEnv *getEnv()
 
 static jobject getHandle(JNIEnv *env, jlong handleId)
 {
-    // Always clear any pending exception first
-    clearException(env);
-
-    // If class wasn't cached in JNI_OnLoad, we cannot use FindClass here
-    // because Dart FFI calls come from the boot class loader which cannot
-    // find application classes. The class MUST be cached during JNI_OnLoad.
-    if (g_handleManagerClass == nullptr)
-    {
-        LOGE("VadPlusHandleManager class not cached - JNI_OnLoad may have failed");
-        return nullptr;
-    }
-
-    jmethodID getHandleMethod = env->GetStaticMethodID(
-        g_handleManagerClass,
-        "getHandle",
-        "(J)Ldev/miracle/vad_plus/VADHandleInternal;");
-
+    jobject result = env->CallStaticObjectMethod(g_handleManagerClass, g_ids.getHandle, handleId);
     if (env->ExceptionCheck())
     {
-        LOGE("Exception while getting getHandle method");
+        LOGE("Exception while calling getHandle");
         clearException(env);
         return nullptr;
     }
+    return result;
+}
+
+// Resolve an FFI handle and an env for the calling thread; every export starts here
+static VADHandle *beginCall(VADHandle *handle, JNIEnv **env)
+{
+    if (handle == nullptr || !g_idsResolved)
+        return nullptr;
 
-    if (getHandleMethod == nullptr)
+    *env = getEnv();
+    if (*env == nullptr)
         return nullptr;
 
-    jobject result = env->CallStaticObjectMethod(g_handleManagerClass, getHandleMethod, handleId);
+    // A previous call on this thread may have left an exception pending
+    clearException(*env);
+    return handle;
+}
 
-    if (env->ExceptionCheck())
+// Build the Kotlin VADConfigInternal for a C config
+static jobject newConfigObject(JNIEnv *env, const VADConfig *config)
+{
+    return env->NewObject(g_configInternalClass, g_ids.configConstructor,
+                          config->positive_speech_threshold,
+                          config->negative_speech_threshold,
+                          config->pre_speech_pad_frames,
+                          config->redemption_frames,
+                          config->min_speech_frames,
+                          config->sample_rate,
+                          config->frame_samples,
+                          config->end_speech_pad_frames,
+                          config->is_debug != 0,
+                          config->speech_chunk_samples,
+                          config->max_speech_frames,
+                          config->speech_end_by_reference != 0,
+                          config->input_sample_rate,
+                          config->prefer_int8_model != 0,
+                          config->prewarm_frames,
+                          config->silence_gate_frames,
+                          config->silence_gate_dbfs,
+                          config->silence_gate_noise_margin_db);
+}
+
+// Log and clear an exception thrown by a Kotlin call
+// @return true if the call threw
+static bool logCallException(JNIEnv *env, const char *call)
+{
+    if (!env->ExceptionCheck())
+        return false;
+
+    // Log the exception details before clearing
+    jthrowable exception = env->ExceptionOccurred();
+    env->ExceptionDescribe(); // This prints to logcat
+    env->ExceptionClear();
+
+    if (exception != nullptr)
     {
-        LOGE("Exception while calling getHandle");
-        clearException(env);
-        return nullptr;
+        jclass throwableClass = env->FindClass("java/lang/Throwable");
+        jmethodID getMessageMethod = env->GetMethodID(throwableClass, "getMessage", "()Ljava/lang/String;");
+        if (getMessageMethod != nullptr)
+        {
+            jstring message = (jstring)env->CallObjectMethod(exception, getMessageMethod);
+            if (message != nullptr)
+            {
+                const char *messageChars = env->GetStringUTFChars(message, nullptr);
+                LOGE("Exception during %s call: %s", call, messageChars);
+                env->ReleaseStringUTFChars(message, messageChars);
+                env->DeleteLocalRef(message);
+            }
+        }
+        env->DeleteLocalRef(throwableClass);
+        env->DeleteLocalRef(exception);
     }
-
-    return result;
+    return true;
 }
 
 // ============================================================================
-// Native Event Sending (Called from Kotlin)
+// Input Ring (Called from Kotlin)
 // ============================================================================
+//
+// The capture thread writes samples and the inference thread reads whole
+// frames; the ring is lock-free so neither side blocks the other.
+// Critical array access avoids copying; nothing inside calls back into the JVM.
 
-extern "C" JNIEXPORT void JNICALL
-Java_dev_miracle_vad_1plus_VADHandleInternal_nativeSendEvent(
+extern "C" JNIEXPORT jlong JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeRingCreate(
     JNIEnv *env,
     jclass clazz,
-    jlong callbackPtr,
-    jlong userDataPtr,
-    jint type)
+    jint capacity,
+    jint maxWindow)
 {
-    if (callbackPtr == 0)
-        return;
-
-    VADEventCallback callback = reinterpret_cast<VADEventCallback>(callbackPtr);
-    void *userData = reinterpret_cast<void *>(userDataPtr);
-
-    // Allocate event on heap
-    VADEventC *event = new VADEventC();
-    memset(event, 0, sizeof(VADEventC));
-    event->type = type;
-
-    callback(event, userData);
-
-    // Schedule cleanup (in a real implementation, Dart should handle this)
-    // For now, we'll let Dart manage the memory through the callback contract
+    return reinterpret_cast<jlong>(vad_ring_create(capacity, maxWindow));
 }
 
 extern "C" JNIEXPORT void JNICALL
-Java_dev_miracle_vad_1plus_VADHandleInternal_nativeSendFrameEvent(
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeRingDestroy(
     JNIEnv *env,
     jclass clazz,
-    jlong callbackPtr,
-    jlong userDataPtr,
-    jfloat probability,
-    jboolean isSpeech,
-    jfloatArray frameData,
-    jint frameLength)
+    jlong ring)
 {
-    if (callbackPtr == 0)
-        return;
+    vad_ring_destroy(reinterpret_cast<VADRing *>(ring));
+}
 
-    VADEventCallback callback = reinterpret_cast<VADEventCallback>(callbackPtr);
-    void *userData = reinterpret_cast<void *>(userDataPtr);
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeRingReset(
+    JNIEnv *env,
+    jclass clazz,
+    jlong ring)
+{
+    vad_ring_reset(reinterpret_cast<VADRing *>(ring));
+}
 
-    // Copy frame data
-    float *frameCopy = nullptr;
-    if (frameData != nullptr && frameLength > 0)
-    {
-        jfloat *frameElements = env->GetFloatArrayElements(frameData, nullptr);
-        frameCopy = new float[frameLength];
-        memcpy(frameCopy, frameElements, frameLength * sizeof(float));
-        env->ReleaseFloatArrayElements(frameData, frameElements, JNI_ABORT);
-    }
+extern "C" JNIEXPORT jint JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeRingWrite(
+    JNIEnv *env,
+    jclass clazz,
+    jlong ring,
+    jfloatArray source,
+    jint offset,
+    jint count)
+{
+    if (ring == 0 || source == nullptr || offset < 0 || count <= 0)
+        return 0;
 
-    VADEventC *event = new VADEventC();
-    memset(event, 0, sizeof(VADEventC));
-    event->type = 3; // FRAME_PROCESSED
-    event->frame_probability = probability;
-    event->frame_is_speech = isSpeech ? 1 : 0;
-    event->frame_data = frameCopy;
-    event->frame_length = frameLength;
+    void *src = env->GetPrimitiveArrayCritical(source, nullptr);
+    if (src == nullptr)
+        return 0;
+    jint written = vad_ring_write(reinterpret_cast<VADRing *>(ring), static_cast<const float *>(src) + offset, count);
+    env->ReleasePrimitiveArrayCritical(source, src, JNI_ABORT);
+    return written;
+}
 
-    callback(event, userData);
+extern "C" JNIEXPORT jint JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeRingWritePcm16(
+    JNIEnv *env,
+    jclass clazz,
+    jlong ring,
+    jshortArray source,
+    jint count)
+{
+    if (ring == 0 || source == nullptr || count <= 0)
+        return 0;
 
-    // Note: frameCopy should be freed by Dart after processing
-    // For safety, schedule deletion after a delay
-    // In production, this should be managed more carefully
+    void *src = env->GetPrimitiveArrayCritical(source, nullptr);
+    if (src == nullptr)
+        return 0;
+    jint written = vad_ring_write_pcm16(reinterpret_cast<VADRing *>(ring), static_cast<const int16_t *>(src), count);
+    env->ReleasePrimitiveArrayCritical(source, src, JNI_ABORT);
+    return written;
 }
 
-extern "C" JNIEXPORT void JNICALL
-Java_dev_miracle_vad_1plus_VADHandleInternal_nativeSendSpeechEndEvent(
+// The ring's storage as a direct buffer, so Kotlin reads frames in place
+extern "C" JNIEXPORT jobject JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeRingBuffer(
     JNIEnv *env,
     jclass clazz,
-    jlong callbackPtr,
-    jlong userDataPtr,
-    jshortArray audioData,
-    jint audioLength,
-    jint durationMs)
+    jlong ring)
 {
-    if (callbackPtr == 0)
-        return;
-
-    VADEventCallback callback = reinterpret_cast<VADEventCallback>(callbackPtr);
-    void *userData = reinterpret_cast<void *>(userDataPtr);
-
-    // Copy audio data
-    jshort *audioElements = env->GetShortArrayElements(audioData, nullptr);
-    int16_t *audioCopy = new int16_t[audioLength];
-    memcpy(audioCopy, audioElements, audioLength * sizeof(int16_t));
-    env->ReleaseShortArrayElements(audioData, audioElements, JNI_ABORT);
-
-    VADEventC *event = new VADEventC();
-    memset(event, 0, sizeof(VADEventC));
-    event->type = 2; // SPEECH_END
-    event->speech_end_audio_data = audioCopy;
-    event->speech_end_audio_length = audioLength;
-    event->speech_end_duration_ms = durationMs;
+    VADRing *input = reinterpret_cast<VADRing *>(ring);
+    if (input == nullptr)
+        return nullptr;
 
-    callback(event, userData);
+    void *data = const_cast<float *>(vad_ring_data(input));
+    return env->NewDirectByteBuffer(data, static_cast<jlong>(vad_ring_data_length(input)) * sizeof(float));
+}
 
-    // Note: audioCopy should be freed by Dart after processing
-    // For safety, schedule deletion after a delay
-    // In production, this should be managed more carefully
+// Float index of the next count unread samples in the direct buffer, or -1
+extern "C" JNIEXPORT jint JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeRingPeek(
+    JNIEnv *env,
+    jclass clazz,
+    jlong ring,
+    jint count)
+{
+    VADRing *input = reinterpret_cast<VADRing *>(ring);
+    const float *window = vad_ring_peek(input, count);
+    if (window == nullptr)
+        return -1;
+    return static_cast<jint>(window - vad_ring_data(input));
 }
 
 extern "C" JNIEXPORT void JNICALL
-Java_dev_miracle_vad_1plus_VADHandleInternal_nativeSendErrorEvent(
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeRingConsume(
     JNIEnv *env,
     jclass clazz,
-    jlong callbackPtr,
-    jlong userDataPtr,
-    jstring message,
-    jint code)
+    jlong ring,
+    jint count)
 {
-    if (callbackPtr == 0)
-        return;
-
-    VADEventCallback callback = reinterpret_cast<VADEventCallback>(callbackPtr);
-    void *userData = reinterpret_cast<void *>(userDataPtr);
-
-    // Copy message
-    const char *msgChars = env->GetStringUTFChars(message, nullptr);
-    char *msgCopy = strdup(msgChars);
-    env->ReleaseStringUTFChars(message, msgChars);
-
-    VADEventC *event = new VADEventC();
-    memset(event, 0, sizeof(VADEventC));
-    event->type = 6; // ERROR
-    event->error_message = msgCopy;
-    event->error_code = code;
-
-    callback(event, userData);
+    vad_ring_consume(reinterpret_cast<VADRing *>(ring), count);
 }
 
 // ============================================================================
-// FFI Exports (Called from Dart via FFI)
+// Input Resampler (Called from Kotlin)
 // ============================================================================
+//
+// Owned by the Kotlin handle; vad_process_audio reads it from the
+// inputResampler field and runs it on the caller's thread.
 
-extern "C"
+extern "C" JNIEXPORT jlong JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeResamplerCreate(
+    JNIEnv *env,
+    jclass clazz,
+    jint inputRate,
+    jint outputRate)
 {
+    return reinterpret_cast<jlong>(vad_resampler_create(inputRate, outputRate));
+}
 
-    __attribute__((visibility("default"))) void vad_config_default(VADConfig *config_out)
-    {
-        if (config_out == nullptr)
-            return;
-        config_out->positive_speech_threshold = 0.5f;
-        config_out->negative_speech_threshold = 0.35f;
-        config_out->pre_speech_pad_frames = 3;
-        config_out->redemption_frames = 24;
-        config_out->min_speech_frames = 9;
-        config_out->sample_rate = 16000;
-        config_out->frame_samples = 512;
-        config_out->end_speech_pad_frames = 3;
-        config_out->is_debug = 0;
-    }
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeResamplerDestroy(
+    JNIEnv *env,
+    jclass clazz,
+    jlong resampler)
+{
+    vad_resampler_destroy(reinterpret_cast<VADResampler *>(resampler));
+}
 
-    __attribute__((visibility("default"))) void *vad_create()
-    {
-        JNIEnv *env = getEnv();
-        if (env == nullptr)
-        {
-            LOGE("Failed to get JNIEnv");
-            return nullptr;
-        }
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeResamplerReset(
+    JNIEnv *env,
+    jclass clazz,
+    jlong resampler)
+{
+    vad_resampler_reset(reinterpret_cast<VADResampler *>(resampler));
+}
 
-        // Clear any pending exception
-        clearException(env);
+// Caller audio layout (vad_process_audio_ex): channels adjacent samples are
+// averaged per frame, frames start stride samples apart
+struct InputLayout
+{
+    VADSampleFormat format;
+    int32_t channels;
+    int32_t stride;
+};
 
-        // Class must be cached during JNI_OnLoad - we cannot use FindClass here
-        // because Dart FFI calls use the boot class loader
-        if (g_handleManagerClass == nullptr)
-        {
-            LOGE("VadPlusHandleManager class not cached - native library may not have been loaded via System.loadLibrary");
-            return nullptr;
-        }
+static const InputLayout kMonoFloat = {VAD_SAMPLE_FORMAT_F32, 1, 1};
 
-        jmethodID createMethod = env->GetStaticMethodID(g_handleManagerClass, "createHandle", "()J");
+static const void *frameAt(const void *data, const InputLayout &layout, int32_t frame)
+{
+    size_t bytes = layout.format == VAD_SAMPLE_FORMAT_S16 ? sizeof(int16_t) : sizeof(float);
+    return static_cast<const char *>(data) + static_cast<size_t>(frame) * layout.stride * bytes;
+}
+
+// Convert frames into the input ring as mono float, draining whenever it
+// fills so arbitrarily large inputs fit
+static int32_t writeInput(JNIEnv *env, VADHandle *native, VADRing *ring, const void *data, const InputLayout &layout,
+                          int32_t frames)
+{
+    int32_t offset = 0;
+    while (offset < frames)
+    {
+        const void *source = frameAt(data, layout, offset);
+        int32_t written = layout.format == VAD_SAMPLE_FORMAT_S16
+                              ? vad_ring_write_s16_frames(ring, static_cast<const int16_t *>(source), layout.channels,
+                                                          layout.stride, frames - offset)
+                              : vad_ring_write_f32_frames(ring, static_cast<const float *>(source), layout.channels,
+                                                          layout.stride, frames - offset);
+        offset += written;
+        env->CallVoidMethod(native->object, g_ids.drainInput);
         if (env->ExceptionCheck())
         {
-            LOGE("Exception while getting createHandle method");
             clearException(env);
-            return nullptr;
+            return -1;
         }
-        if (createMethod == nullptr)
+        if (written == 0)
         {
-            LOGE("Failed to find createHandle method");
-            return nullptr;
+            // The previous drain freed nothing, so the rest cannot fit
+            return -1;
         }
+    }
+    return 0;
+}
 
-        jlong handleId = env->CallStaticLongMethod(g_handleManagerClass, createMethod);
-        if (env->ExceptionCheck())
-        {
-            LOGE("Exception while calling createHandle");
-            clearException(env);
-            return nullptr;
-        }
+// ============================================================================
+// Native Event Sending (Called from Kotlin)
+// ============================================================================
+//
+// Events and their payloads come from the handle's pool (src/vad_events.c)
+// and stay valid until Dart calls vad_event_release(). If the callback was
+// not invoked the event goes straight back. The time spent in the callback
+// goes to the handle's stats recorder.
 
-        LOGD("Created handle with ID: %lld", (long long)handleId);
+// Inline event payload: one frame at the largest supported frame size
+static const size_t kEventInlineBytes = 512 * sizeof(float);
 
-        return reinterpret_cast<void *>(handleId);
-    }
+static void deliverEvent(jlong stats, jlong callbackPtr, jlong userDataPtr, VADEvent *event)
+{
+    if (event == nullptr)
+        return;
 
-    __attribute__((visibility("default"))) void vad_destroy(void *handle)
+    VADEventCallback callback = reinterpret_cast<VADEventCallback>(callbackPtr);
+    if (callback == nullptr)
     {
-        if (handle == nullptr)
-            return;
-
-        JNIEnv *env = getEnv();
-        if (env == nullptr)
-            return;
+        vad_event_pool_release(event);
+        return;
+    }
+    uint64_t start = vad_now_ns();
+    callback(event, reinterpret_cast<void *>(userDataPtr));
+    vad_stats_record_callback(reinterpret_cast<VADStatsRecorder *>(stats), vad_now_ns() - start);
+}
 
-        clearException(env);
+extern "C" JNIEXPORT jlong JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeEventPoolCreate(
+    JNIEnv *env,
+    jclass clazz)
+{
+    return reinterpret_cast<jlong>(vad_event_pool_create(VAD_EVENT_POOL_SLOTS, kEventInlineBytes));
+}
 
-        if (g_handleManagerClass == nullptr)
-            return;
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeEventPoolClose(
+    JNIEnv *env,
+    jclass clazz,
+    jlong pool)
+{
+    vad_event_pool_close(reinterpret_cast<VADEventPool *>(pool));
+}
 
-        jmethodID removeMethod = env->GetStaticMethodID(g_handleManagerClass, "removeHandle", "(J)V");
-        if (removeMethod == nullptr || env->ExceptionCheck())
-        {
-            clearException(env);
-            return;
-        }
+// ============================================================================
+// Status Block
+// ============================================================================
 
-        jlong handleId = reinterpret_cast<jlong>(handle);
-        env->CallStaticVoidMethod(g_handleManagerClass, removeMethod, handleId);
-        if (env->ExceptionCheck())
-        {
-            clearException(env);
-            return;
-        }
-        LOGD("Destroyed handle with ID: %lld", (long long)handleId);
-    }
+extern "C" JNIEXPORT jlong JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeStatusCreate(
+    JNIEnv *env,
+    jclass clazz)
+{
+    return reinterpret_cast<jlong>(vad_status_create());
+}
 
-    __attribute__((visibility("default")))
-    int32_t
-    vad_init(void *handle, const VADConfig *config, const char *model_path)
-    {
-        if (handle == nullptr || config == nullptr)
-            return -1;
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeStatusDestroy(
+    JNIEnv *env,
+    jclass clazz,
+    jlong status)
+{
+    vad_status_destroy(reinterpret_cast<VADStatusBlock *>(status));
+}
 
-        JNIEnv *env = getEnv();
-        if (env == nullptr)
-            return -1;
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeStatusReset(
+    JNIEnv *env,
+    jclass clazz,
+    jlong status)
+{
+    vad_status_reset(reinterpret_cast<VADStatusBlock *>(status));
+}
 
-        // Clear any pending exception
-        clearException(env);
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeStatusPublishFrame(
+    JNIEnv *env,
+    jclass clazz,
+    jlong status,
+    jfloat probability,
+    jboolean isSpeaking)
+{
+    vad_status_publish_frame(reinterpret_cast<VADStatusBlock *>(status), probability, isSpeaking ? 1 : 0);
+}
 
-        jlong handleId = reinterpret_cast<jlong>(handle);
-        jobject handleObj = getHandle(env, handleId);
-        if (handleObj == nullptr)
-        {
-            LOGE("Failed to get handle object for ID: %lld", (long long)handleId);
-            return -1;
-        }
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeStatusSetSpeaking(
+    JNIEnv *env,
+    jclass clazz,
+    jlong status,
+    jboolean isSpeaking)
+{
+    vad_status_set_speaking(reinterpret_cast<VADStatusBlock *>(status), isSpeaking ? 1 : 0);
+}
+
+// ============================================================================
+// Stats Recorder
+// ============================================================================
+
+extern "C" JNIEXPORT jlong JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeStatsCreate(
+    JNIEnv *env,
+    jclass clazz)
+{
+    return reinterpret_cast<jlong>(vad_stats_create());
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeStatsDestroy(
+    JNIEnv *env,
+    jclass clazz,
+    jlong stats)
+{
+    vad_stats_destroy(reinterpret_cast<VADStatsRecorder *>(stats));
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeStatsReset(
+    JNIEnv *env,
+    jclass clazz,
+    jlong stats)
+{
+    vad_stats_reset(reinterpret_cast<VADStatsRecorder *>(stats));
+}
+
+// Called by the ring's consumer after each frame, so the ring fill read here
+// is the queue the next frame comes from
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeStatsRecordFrame(
+    JNIEnv *env,
+    jclass clazz,
+    jlong stats,
+    jlong ring,
+    jlong inferenceNs,
+    jlong frameNs,
+    jlong budgetNs,
+    jlong speechBytes,
+    jlong speechCapacityBytes)
+{
+    VADStatsRecorder *recorder = reinterpret_cast<VADStatsRecorder *>(stats);
+    vad_stats_record_frame(recorder, static_cast<uint64_t>(inferenceNs), static_cast<uint64_t>(frameNs),
+                           static_cast<uint64_t>(budgetNs));
+    vad_stats_set_queued(recorder, vad_ring_available(reinterpret_cast<VADRing *>(ring)));
+    vad_stats_set_speech(recorder, speechBytes, speechCapacityBytes);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeStatsAddDropped(
+    JNIEnv *env,
+    jclass clazz,
+    jlong stats,
+    jint samples)
+{
+    vad_stats_add_dropped(reinterpret_cast<VADStatsRecorder *>(stats), samples);
+}
+
+// nativeStatsRecordFrame for a frame the silence gate kept from the model
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeStatsRecordGated(
+    JNIEnv *env,
+    jclass clazz,
+    jlong stats,
+    jlong ring,
+    jlong speechBytes,
+    jlong speechCapacityBytes)
+{
+    VADStatsRecorder *recorder = reinterpret_cast<VADStatsRecorder *>(stats);
+    vad_stats_add_gated(recorder);
+    vad_stats_set_queued(recorder, vad_ring_available(reinterpret_cast<VADRing *>(ring)));
+    vad_stats_set_speech(recorder, speechBytes, speechCapacityBytes);
+}
 
-        // Get VADHandleInternal class
-        jclass handleClass = env->GetObjectClass(handleObj);
-        if (handleClass == nullptr || env->ExceptionCheck())
+// ============================================================================
+// Silence Gate
+// ============================================================================
+
+extern "C" JNIEXPORT jlong JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeGateCreate(
+    JNIEnv *env,
+    jclass clazz)
+{
+    return reinterpret_cast<jlong>(vad_gate_create());
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeGateDestroy(
+    JNIEnv *env,
+    jclass clazz,
+    jlong gate)
+{
+    vad_gate_destroy(reinterpret_cast<VADGate *>(gate));
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeGateConfigure(
+    JNIEnv *env,
+    jclass clazz,
+    jlong gate,
+    jint holdFrames,
+    jfloat thresholdDbfs,
+    jfloat noiseMarginDb)
+{
+    vad_gate_configure(reinterpret_cast<VADGate *>(gate), holdFrames, thresholdDbfs, noiseMarginDb);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeGateReset(
+    JNIEnv *env,
+    jclass clazz,
+    jlong gate)
+{
+    vad_gate_reset(reinterpret_cast<VADGate *>(gate));
+}
+
+// Critical array access, as for the input ring: the level is read in place
+extern "C" JNIEXPORT jint JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeGatePush(
+    JNIEnv *env,
+    jclass clazz,
+    jlong gate,
+    jfloatArray frame,
+    jint count)
+{
+    if (gate == 0 || frame == nullptr || count <= 0)
+        return VAD_GATE_INFER;
+
+    void *samples = env->GetPrimitiveArrayCritical(frame, nullptr);
+    if (samples == nullptr)
+        return VAD_GATE_INFER;
+    jint decision = vad_gate_push(reinterpret_cast<VADGate *>(gate), static_cast<const float *>(samples), count);
+    env->ReleasePrimitiveArrayCritical(frame, samples, JNI_ABORT);
+    return decision;
+}
+
+// ============================================================================
+// Timeline Trace
+// ============================================================================
+//
+// Kotlin timestamps come from System.nanoTime, the CLOCK_MONOTONIC clock
+// vad_trace.c reads, so an end of 0 (now) can be mixed with them.
+
+extern "C" JNIEXPORT jlong JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeTraceCreate(
+    JNIEnv *env,
+    jclass clazz)
+{
+    return reinterpret_cast<jlong>(vad_tracer_create());
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeTraceDestroy(
+    JNIEnv *env,
+    jclass clazz,
+    jlong trace)
+{
+    vad_tracer_destroy(reinterpret_cast<VADTracer *>(trace));
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeTraceStart(
+    JNIEnv *env,
+    jclass clazz,
+    jlong trace,
+    jint eventsPerThread)
+{
+    vad_tracer_start(reinterpret_cast<VADTracer *>(trace), eventsPerThread);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeTraceStop(
+    JNIEnv *env,
+    jclass clazz,
+    jlong trace)
+{
+    vad_tracer_stop(reinterpret_cast<VADTracer *>(trace));
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeTraceRecord(
+    JNIEnv *env,
+    jclass clazz,
+    jlong trace,
+    jint span,
+    jint arg,
+    jlong startNs,
+    jlong endNs)
+{
+    vad_tracer_record(reinterpret_cast<VADTracer *>(trace), span, arg, static_cast<uint64_t>(startNs),
+                      static_cast<uint64_t>(endNs));
+}
+
+extern "C" JNIEXPORT jstring JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeTraceDump(
+    JNIEnv *env,
+    jclass clazz,
+    jlong trace,
+    jstring path)
+{
+    if (trace == 0)
+        return env->NewStringUTF("Trace recorder not allocated");
+    const char *pathChars = env->GetStringUTFChars(path, nullptr);
+    if (pathChars == nullptr)
+        return env->NewStringUTF("Out of memory");
+
+    char error[512];
+    int32_t result = vad_tracer_write_json(reinterpret_cast<VADTracer *>(trace), pathChars, error, sizeof(error));
+    env->ReleaseStringUTFChars(path, pathChars);
+    return result == 0 ? nullptr : env->NewStringUTF(error);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeSendEvent(
+    JNIEnv *env,
+    jclass clazz,
+    jlong pool,
+    jlong stats,
+    jlong callbackPtr,
+    jlong userDataPtr,
+    jint type)
+{
+    if (callbackPtr == 0)
+        return;
+
+    VADEvent *event = vad_event_pool_acquire(reinterpret_cast<VADEventPool *>(pool), type, 0, nullptr);
+    deliverEvent(stats, callbackPtr, userDataPtr, event);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeSendSegmentEvent(
+    JNIEnv *env,
+    jclass clazz,
+    jlong pool,
+    jlong stats,
+    jlong callbackPtr,
+    jlong userDataPtr,
+    jint type,
+    jlong startSample,
+    jlong endSample)
+{
+    if (callbackPtr == 0)
+        return;
+
+    VADEvent *event = vad_event_pool_acquire(reinterpret_cast<VADEventPool *>(pool), type, 0, nullptr);
+    if (event == nullptr)
+        return;
+
+    event->segment_start_sample = startSample;
+    event->segment_end_sample = endSample;
+
+    deliverEvent(stats, callbackPtr, userDataPtr, event);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeSendFrameEvent(
+    JNIEnv *env,
+    jclass clazz,
+    jlong pool,
+    jlong stats,
+    jlong callbackPtr,
+    jlong userDataPtr,
+    jfloat probability,
+    jboolean isSpeech,
+    jfloatArray frameData,
+    jint frameLength)
+{
+    if (callbackPtr == 0)
+        return;
+    if (frameData == nullptr || frameLength < 0)
+        frameLength = 0;
+
+    float *frameCopy = nullptr;
+    VADEvent *event = vad_event_pool_acquire(reinterpret_cast<VADEventPool *>(pool), VAD_EVENT_FRAME_PROCESSED,
+                                             frameLength * sizeof(float), reinterpret_cast<void **>(&frameCopy));
+    if (event == nullptr)
+        return;
+
+    if (frameLength > 0)
+    {
+        env->GetFloatArrayRegion(frameData, 0, frameLength, frameCopy);
+        event->frame_data = frameCopy;
+    }
+    event->frame_probability = probability;
+    event->frame_is_speech = isSpeech ? 1 : 0;
+    event->frame_length = frameLength;
+
+    deliverEvent(stats, callbackPtr, userDataPtr, event);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeSendSpeechEndEvent(
+    JNIEnv *env,
+    jclass clazz,
+    jlong pool,
+    jlong stats,
+    jlong callbackPtr,
+    jlong userDataPtr,
+    jshortArray audioData,
+    jint audioLength,
+    jint durationMs,
+    jlong startSample,
+    jlong endSample)
+{
+    if (callbackPtr == 0)
+        return;
+    if (audioData == nullptr || audioLength < 0)
+        audioLength = 0;
+
+    int16_t *audioCopy = nullptr;
+    VADEvent *event = vad_event_pool_acquire(reinterpret_cast<VADEventPool *>(pool), VAD_EVENT_SPEECH_END,
+                                             audioLength * sizeof(int16_t), reinterpret_cast<void **>(&audioCopy));
+    if (event == nullptr)
+        return;
+
+    if (audioLength > 0)
+    {
+        env->GetShortArrayRegion(audioData, 0, audioLength, audioCopy);
+        event->speech_end_audio_data = audioCopy;
+    }
+    event->speech_end_audio_length = audioLength;
+    event->speech_end_duration_ms = durationMs;
+    event->segment_start_sample = startSample;
+    event->segment_end_sample = endSample;
+
+    deliverEvent(stats, callbackPtr, userDataPtr, event);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeSendSpeechChunkEvent(
+    JNIEnv *env,
+    jclass clazz,
+    jlong pool,
+    jlong stats,
+    jlong callbackPtr,
+    jlong userDataPtr,
+    jshortArray audioData,
+    jint offset,
+    jint audioLength,
+    jboolean isLast)
+{
+    if (callbackPtr == 0)
+        return;
+    if (audioData == nullptr || offset < 0 || audioLength < 0)
+        audioLength = 0;
+
+    int16_t *audioCopy = nullptr;
+    VADEvent *event = vad_event_pool_acquire(reinterpret_cast<VADEventPool *>(pool), VAD_EVENT_SPEECH_CHUNK,
+                                             audioLength * sizeof(int16_t), reinterpret_cast<void **>(&audioCopy));
+    if (event == nullptr)
+        return;
+
+    if (audioLength > 0)
+    {
+        env->GetShortArrayRegion(audioData, offset, audioLength, audioCopy);
+        event->speech_chunk_audio_data = audioCopy;
+    }
+    event->speech_chunk_audio_length = audioLength;
+    event->speech_chunk_offset = offset;
+    event->speech_chunk_is_last = isLast ? 1 : 0;
+
+    deliverEvent(stats, callbackPtr, userDataPtr, event);
+}
+
+extern "C" JNIEXPORT void JNICALL
+Java_dev_miracle_vad_1plus_VADHandleInternal_nativeSendErrorEvent(
+    JNIEnv *env,
+    jclass clazz,
+    jlong pool,
+    jlong stats,
+    jlong callbackPtr,
+    jlong userDataPtr,
+    jstring message,
+    jint code)
+{
+    if (callbackPtr == 0)
+        return;
+
+    // Copy the modified UTF-8 bytes straight into the pooled payload
+    jsize chars = message != nullptr ? env->GetStringLength(message) : 0;
+    jsize bytes = message != nullptr ? env->GetStringUTFLength(message) : 0;
+
+    char *messageCopy = nullptr;
+    VADEvent *event = vad_event_pool_acquire(reinterpret_cast<VADEventPool *>(pool), VAD_EVENT_ERROR,
+                                             static_cast<size_t>(bytes) + 1, reinterpret_cast<void **>(&messageCopy));
+    if (event == nullptr)
+        return;
+
+    if (chars > 0)
+        env->GetStringUTFRegion(message, 0, chars, messageCopy);
+    messageCopy[bytes] = '\0';
+    event->error_message = messageCopy;
+    event->error_code = code;
+
+    deliverEvent(stats, callbackPtr, userDataPtr, event);
+}
+
+// ============================================================================
+// FFI Exports (Called from Dart via FFI)
+// ============================================================================
+
+extern "C"
+{
+
+    FFI_PLUGIN_EXPORT void vad_config_default(VADConfig *config_out)
+    {
+        if (config_out == nullptr)
+            return;
+        config_out->positive_speech_threshold = 0.5f;
+        config_out->negative_speech_threshold = 0.35f;
+        config_out->pre_speech_pad_frames = 3;
+        config_out->redemption_frames = 24;
+        config_out->min_speech_frames = 9;
+        config_out->sample_rate = 16000;
+        config_out->frame_samples = 512;
+        config_out->end_speech_pad_frames = 3;
+        config_out->is_debug = 0;
+        config_out->speech_chunk_samples = 0;
+        config_out->max_speech_frames = 938;
+        config_out->speech_end_by_reference = 0;
+        config_out->input_sample_rate = 0;
+        config_out->prefer_int8_model = 0;
+        config_out->prewarm_frames = 0;
+        config_out->silence_gate_frames = 0;
+        config_out->silence_gate_dbfs = -55.0f;
+        config_out->silence_gate_noise_margin_db = 0.0f;
+    }
+
+    FFI_PLUGIN_EXPORT VADHandle *vad_create(void)
+    {
+        if (!g_idsResolved)
         {
-            clearException(env);
-            env->DeleteLocalRef(handleObj);
-            return -1;
+            LOGE("VAD Plus classes not resolved - native library may not have been loaded via System.loadLibrary");
+            return nullptr;
         }
 
-        // Use cached config class - FindClass won't work from Dart FFI context
-        if (g_configInternalClass == nullptr)
+        JNIEnv *env = getEnv();
+        if (env == nullptr)
         {
-            env->DeleteLocalRef(handleObj);
-            env->DeleteLocalRef(handleClass);
-            LOGE("VADConfigInternal class not cached - JNI_OnLoad may have failed");
-            return -1;
+            LOGE("Failed to get JNIEnv");
+            return nullptr;
         }
-        jclass configClass = g_configInternalClass;
 
-        // Signature: (FFIIIIIIZ)V = 2 floats + 6 ints + 1 boolean
-        // Matches VADConfigInternal(Float, Float, Int, Int, Int, Int, Int, Int, Boolean)
-        jmethodID configConstructor = env->GetMethodID(configClass, "<init>",
-                                                       "(FFIIIIIIZ)V");
-        if (configConstructor == nullptr || env->ExceptionCheck())
+        clearException(env);
+
+        jlong handleId = env->CallStaticLongMethod(g_handleManagerClass, g_ids.createHandle);
+        if (env->ExceptionCheck())
         {
+            LOGE("Exception while calling createHandle");
             clearException(env);
-            env->DeleteLocalRef(handleObj);
-            env->DeleteLocalRef(handleClass);
-            // Note: configClass is a global ref, don't delete it
-            return -1;
+            return nullptr;
         }
 
-        jobject configObj = env->NewObject(configClass, configConstructor,
-                                           config->positive_speech_threshold,
-                                           config->negative_speech_threshold,
-                                           config->pre_speech_pad_frames,
-                                           config->redemption_frames,
-                                           config->min_speech_frames,
-                                           config->sample_rate,
-                                           config->frame_samples,
-                                           config->end_speech_pad_frames,
-                                           config->is_debug != 0);
-
-        if (configObj == nullptr || env->ExceptionCheck())
+        jobject handleObj = getHandle(env, handleId);
+        if (handleObj == nullptr)
         {
+            LOGE("Failed to get handle object for ID: %lld", (long long)handleId);
+            env->CallStaticVoidMethod(g_handleManagerClass, g_ids.removeHandle, handleId);
             clearException(env);
-            env->DeleteLocalRef(handleObj);
-            env->DeleteLocalRef(handleClass);
-            LOGE("Failed to create VADConfigInternal object");
-            return -1;
+            return nullptr;
         }
 
-        // Get application context
-        if (g_handleManagerClass == nullptr)
-        {
-            env->DeleteLocalRef(handleObj);
-            env->DeleteLocalRef(handleClass);
-            env->DeleteLocalRef(configObj);
-            LOGE("HandleManager class not cached");
+        VADHandle *native = new VADHandle();
+        native->id = handleId;
+        native->object = env->NewGlobalRef(handleObj);
+        native->status = reinterpret_cast<VADStatusBlock *>(env->GetLongField(handleObj, g_ids.statusBlock));
+        native->stats = reinterpret_cast<VADStatsRecorder *>(env->GetLongField(handleObj, g_ids.statsRecorder));
+        native->last_error[0] = '\0';
+        env->DeleteLocalRef(handleObj);
+
+        LOGD("Created handle with ID: %lld", (long long)handleId);
+
+        return native;
+    }
+
+    FFI_PLUGIN_EXPORT void vad_destroy(VADHandle *handle)
+    {
+        JNIEnv *env;
+        VADHandle *native = beginCall(handle, &env);
+        if (native == nullptr)
+            return;
+
+        env->CallStaticVoidMethod(g_handleManagerClass, g_ids.removeHandle, native->id);
+        clearException(env);
+
+        LOGD("Destroyed handle with ID: %lld", (long long)native->id);
+
+        env->DeleteGlobalRef(native->object);
+        delete native;
+    }
+
+    FFI_PLUGIN_EXPORT
+    int32_t
+    vad_init(VADHandle *handle, const VADConfig *config, const char *model_path)
+    {
+        JNIEnv *env;
+        VADHandle *native = beginCall(handle, &env);
+        if (native == nullptr || config == nullptr)
             return -1;
-        }
 
-        jmethodID getContextMethod = env->GetStaticMethodID(g_handleManagerClass,
-                                                            "getApplicationContext", "()Landroid/content/Context;");
-        if (getContextMethod == nullptr || env->ExceptionCheck())
+        jobject configObj = newConfigObject(env, config);
+
+        if (configObj == nullptr || env->ExceptionCheck())
         {
             clearException(env);
-            env->DeleteLocalRef(handleObj);
-            env->DeleteLocalRef(handleClass);
-            env->DeleteLocalRef(configObj);
-            LOGE("Failed to find getApplicationContext method");
+            LOGE("Failed to create VADConfigInternal object");
             return -1;
         }
 
-        jobject context = env->CallStaticObjectMethod(g_handleManagerClass, getContextMethod);
+        jobject context = env->CallStaticObjectMethod(g_handleManagerClass, g_ids.getApplicationContext);
         if (env->ExceptionCheck())
         {
             clearException(env);
-            env->DeleteLocalRef(handleObj);
-            env->DeleteLocalRef(handleClass);
             env->DeleteLocalRef(configObj);
             LOGE("Exception calling getApplicationContext");
             return -1;
@@ -576,514 +1191,436 @@ extern "C"
         if (context == nullptr)
         {
             LOGE("Application context is null");
-            env->DeleteLocalRef(handleObj);
-            env->DeleteLocalRef(handleClass);
             env->DeleteLocalRef(configObj);
             return -1;
         }
 
-        // Call initialize method
-        jmethodID initMethod = env->GetMethodID(handleClass, "initialize",
-                                                "(Ldev/miracle/vad_plus/VADConfigInternal;Ljava/lang/String;Landroid/content/Context;)I");
-        if (initMethod == nullptr || env->ExceptionCheck())
-        {
-            clearException(env);
-            env->DeleteLocalRef(handleObj);
-            env->DeleteLocalRef(handleClass);
-            env->DeleteLocalRef(configObj);
-            env->DeleteLocalRef(context);
-            LOGE("Failed to find initialize method");
-            return -1;
-        }
-
         jstring modelPathStr = (model_path != nullptr && strlen(model_path) > 0)
                                    ? env->NewStringUTF(model_path)
                                    : nullptr;
 
-        jint result = env->CallIntMethod(handleObj, initMethod, configObj, modelPathStr, context);
+        jint result = env->CallIntMethod(native->object, g_ids.initialize, configObj, modelPathStr, context);
 
-        if (env->ExceptionCheck())
-        {
-            // Log the exception details before clearing
-            jthrowable exception = env->ExceptionOccurred();
-            env->ExceptionDescribe(); // This prints to logcat
-            env->ExceptionClear();
-
-            if (exception != nullptr)
-            {
-                jclass throwableClass = env->FindClass("java/lang/Throwable");
-                jmethodID getMessageMethod = env->GetMethodID(throwableClass, "getMessage", "()Ljava/lang/String;");
-                if (getMessageMethod != nullptr)
-                {
-                    jstring message = (jstring)env->CallObjectMethod(exception, getMessageMethod);
-                    if (message != nullptr)
-                    {
-                        const char *messageChars = env->GetStringUTFChars(message, nullptr);
-                        LOGE("Exception during initialize call: %s", messageChars);
-                        env->ReleaseStringUTFChars(message, messageChars);
-                        env->DeleteLocalRef(message);
-                    }
-                }
-                env->DeleteLocalRef(throwableClass);
-                env->DeleteLocalRef(exception);
-            }
+        if (logCallException(env, "initialize"))
             result = -1;
-        }
 
-        // Cleanup (note: configClass is a global ref, don't delete it)
         if (modelPathStr != nullptr)
         {
             env->DeleteLocalRef(modelPathStr);
         }
-        env->DeleteLocalRef(handleObj);
-        env->DeleteLocalRef(handleClass);
         env->DeleteLocalRef(configObj);
         env->DeleteLocalRef(context);
 
         return result;
     }
 
-    __attribute__((visibility("default"))) void vad_set_callback(void *handle, VADEventCallback callback, void *user_data)
+    FFI_PLUGIN_EXPORT
+    int32_t
+    vad_init_from_memory(VADHandle *handle, const VADConfig *config, const void *data, size_t length)
     {
-        if (handle == nullptr)
-            return;
-
-        JNIEnv *env = getEnv();
-        if (env == nullptr)
-            return;
-
-        clearException(env);
+        JNIEnv *env;
+        VADHandle *native = beginCall(handle, &env);
+        if (native == nullptr || config == nullptr || data == nullptr || length == 0)
+            return -1;
 
-        jlong handleId = reinterpret_cast<jlong>(handle);
-        jobject handleObj = getHandle(env, handleId);
-        if (handleObj == nullptr)
-            return;
+        jobject configObj = newConfigObject(env, config);
 
-        jclass handleClass = env->GetObjectClass(handleObj);
-        if (handleClass == nullptr || env->ExceptionCheck())
+        if (configObj == nullptr || env->ExceptionCheck())
         {
             clearException(env);
-            env->DeleteLocalRef(handleObj);
-            return;
+            LOGE("Failed to create VADConfigInternal object");
+            return -1;
         }
 
-        jmethodID setCallbackMethod = env->GetMethodID(handleClass, "setCallback", "(JJ)V");
-        if (setCallbackMethod != nullptr && !env->ExceptionCheck())
-        {
-            env->CallVoidMethod(handleObj, setCallbackMethod,
-                                reinterpret_cast<jlong>(callback),
-                                reinterpret_cast<jlong>(user_data));
-            clearException(env);
-        }
-        else
+        // Borrow the caller's buffer: ONNX Runtime reads a direct buffer in
+        // place while it builds the session, and nothing keeps it afterwards
+        jobject model = env->NewDirectByteBuffer(const_cast<void *>(data), static_cast<jlong>(length));
+        if (model == nullptr || env->ExceptionCheck())
         {
             clearException(env);
+            env->DeleteLocalRef(configObj);
+            LOGE("Failed to wrap model buffer");
+            return -2;
         }
 
-        env->DeleteLocalRef(handleObj);
-        env->DeleteLocalRef(handleClass);
+        jint result = env->CallIntMethod(native->object, g_ids.initializeFromMemory, configObj, model);
+        if (logCallException(env, "initializeFromMemory"))
+            result = -1;
+
+        env->DeleteLocalRef(model);
+        env->DeleteLocalRef(configObj);
+
+        return result;
     }
 
-    __attribute__((visibility("default"))) void vad_invalidate_callback(void *handle)
+    FFI_PLUGIN_EXPORT void vad_set_callback(VADHandle *handle, VADEventCallback callback, void *user_data)
     {
-        if (handle == nullptr)
+        JNIEnv *env;
+        VADHandle *native = beginCall(handle, &env);
+        if (native == nullptr)
             return;
 
-        JNIEnv *env = getEnv();
-        if (env == nullptr)
+        env->CallVoidMethod(native->object, g_ids.setCallback,
+                            reinterpret_cast<jlong>(callback),
+                            reinterpret_cast<jlong>(user_data));
+        clearException(env);
+    }
+
+    FFI_PLUGIN_EXPORT void vad_invalidate_callback(VADHandle *handle)
+    {
+        JNIEnv *env;
+        VADHandle *native = beginCall(handle, &env);
+        if (native == nullptr)
             return;
 
+        env->CallVoidMethod(native->object, g_ids.invalidateCallback);
         clearException(env);
+    }
 
-        jlong handleId = reinterpret_cast<jlong>(handle);
-        jobject handleObj = getHandle(env, handleId);
-        if (handleObj == nullptr)
+    FFI_PLUGIN_EXPORT void vad_set_event_mask(VADHandle *handle, uint32_t mask)
+    {
+        JNIEnv *env;
+        VADHandle *native = beginCall(handle, &env);
+        if (native == nullptr)
             return;
 
-        jclass handleClass = env->GetObjectClass(handleObj);
-        if (handleClass == nullptr || env->ExceptionCheck())
-        {
-            clearException(env);
-            env->DeleteLocalRef(handleObj);
+        env->CallVoidMethod(native->object, g_ids.setEventMask, static_cast<jint>(mask));
+        clearException(env);
+    }
+
+    FFI_PLUGIN_EXPORT void vad_set_frame_event_interval(VADHandle *handle, int32_t interval)
+    {
+        JNIEnv *env;
+        VADHandle *native = beginCall(handle, &env);
+        if (native == nullptr)
             return;
-        }
 
-        jmethodID invalidateMethod = env->GetMethodID(handleClass, "invalidateCallback", "()V");
-        if (invalidateMethod != nullptr && !env->ExceptionCheck())
-        {
-            env->CallVoidMethod(handleObj, invalidateMethod);
-            clearException(env);
-        }
-        else
+        env->CallVoidMethod(native->object, g_ids.setFrameEventInterval, static_cast<jint>(interval));
+        clearException(env);
+    }
+
+    FFI_PLUGIN_EXPORT
+    int32_t
+    vad_start(VADHandle *handle)
+    {
+        JNIEnv *env;
+        VADHandle *native = beginCall(handle, &env);
+        if (native == nullptr)
+            return -1;
+
+        jint result = env->CallIntMethod(native->object, g_ids.startListening);
+        if (env->ExceptionCheck())
         {
             clearException(env);
+            result = -1;
         }
 
-        env->DeleteLocalRef(handleObj);
-        env->DeleteLocalRef(handleClass);
+        return result;
     }
 
-    __attribute__((visibility("default")))
-    int32_t
-    vad_start(void *handle)
+    FFI_PLUGIN_EXPORT void vad_stop(VADHandle *handle)
     {
-        if (handle == nullptr)
-            return -1;
-
-        JNIEnv *env = getEnv();
-        if (env == nullptr)
-            return -1;
+        JNIEnv *env;
+        VADHandle *native = beginCall(handle, &env);
+        if (native == nullptr)
+            return;
 
+        env->CallVoidMethod(native->object, g_ids.stopListening);
         clearException(env);
+    }
 
-        jlong handleId = reinterpret_cast<jlong>(handle);
-        jobject handleObj = getHandle(env, handleId);
-        if (handleObj == nullptr)
+    // Samples are converted straight into the handle's native input ring
+    // (through the resampler when inputSampleRate is set); Kotlin only gets a
+    // call to drain complete frames, so no Java array is created
+    static int32_t processInput(VADHandle *handle, const void *data, const InputLayout &layout, int32_t frames)
+    {
+        JNIEnv *env;
+        VADHandle *native = beginCall(handle, &env);
+        if (native == nullptr)
             return -1;
 
-        jclass handleClass = env->GetObjectClass(handleObj);
-        if (handleClass == nullptr || env->ExceptionCheck())
-        {
-            clearException(env);
-            env->DeleteLocalRef(handleObj);
+        VADRing *ring = reinterpret_cast<VADRing *>(env->GetLongField(native->object, g_ids.inputRing));
+        if (ring == nullptr)
             return -1;
-        }
 
-        jmethodID startMethod = env->GetMethodID(handleClass, "startListening", "()I");
-        if (startMethod == nullptr || env->ExceptionCheck())
-        {
-            clearException(env);
-            env->DeleteLocalRef(handleObj);
-            env->DeleteLocalRef(handleClass);
-            return -1;
-        }
+        VADResampler *resampler =
+            reinterpret_cast<VADResampler *>(env->GetLongField(native->object, g_ids.inputResampler));
+        if (resampler == nullptr)
+            return writeInput(env, native, ring, data, layout, frames);
 
-        jint result = env->CallIntMethod(handleObj, startMethod);
-        if (env->ExceptionCheck())
+        // Input at inputSampleRate: convert and resample a block at a time on the stack
+        float converted[VAD_RESAMPLER_BLOCK];
+        float block[VAD_RESAMPLER_BLOCK];
+        for (int32_t offset = 0; offset < frames; offset += VAD_RESAMPLER_BLOCK)
         {
-            clearException(env);
-            result = -1;
+            int32_t count = frames - offset < VAD_RESAMPLER_BLOCK ? frames - offset : VAD_RESAMPLER_BLOCK;
+            const void *source = frameAt(data, layout, offset);
+            if (layout.format == VAD_SAMPLE_FORMAT_S16)
+                vad_convert_s16_frames_to_f32(static_cast<const int16_t *>(source), layout.channels, layout.stride,
+                                              converted, count);
+            else
+                vad_convert_f32_frames_to_f32(static_cast<const float *>(source), layout.channels, layout.stride,
+                                              converted, count);
+
+            const float *samples = converted;
+            for (;;)
+            {
+                int32_t used;
+                int32_t produced = vad_resampler_process(resampler, samples, count, &used, block,
+                                                         VAD_RESAMPLER_BLOCK);
+                samples += used;
+                count -= used;
+                if (writeInput(env, native, ring, block, kMonoFloat, produced) != 0)
+                    return -1;
+                if (produced < VAD_RESAMPLER_BLOCK)
+                    break;
+            }
         }
+        return 0;
+    }
 
-        env->DeleteLocalRef(handleObj);
-        env->DeleteLocalRef(handleClass);
+    FFI_PLUGIN_EXPORT
+    int32_t
+    vad_process_audio(VADHandle *handle, const float *samples, int32_t sample_count)
+    {
+        if (samples == nullptr || sample_count <= 0)
+            return -1;
+        return processInput(handle, samples, kMonoFloat, sample_count);
+    }
 
-        return result;
+    FFI_PLUGIN_EXPORT
+    int32_t
+    vad_process_audio_ex(VADHandle *handle, const void *data, int32_t frames, VADSampleFormat format,
+                         int32_t channels, int32_t stride)
+    {
+        if (data == nullptr || frames <= 0)
+            return -1;
+        if (format != VAD_SAMPLE_FORMAT_F32 && format != VAD_SAMPLE_FORMAT_S16)
+            return -1;
+        if (stride == 0)
+            stride = channels;
+        if (channels < 1 || stride < channels)
+            return -1;
+        return processInput(handle, data, InputLayout{format, channels, stride}, frames);
     }
 
-    __attribute__((visibility("default"))) void vad_stop(void *handle)
+    FFI_PLUGIN_EXPORT void vad_reset(VADHandle *handle)
     {
-        if (handle == nullptr)
+        JNIEnv *env;
+        VADHandle *native = beginCall(handle, &env);
+        if (native == nullptr)
             return;
 
-        JNIEnv *env = getEnv();
-        if (env == nullptr)
+        env->CallVoidMethod(native->object, g_ids.resetStates);
+        clearException(env);
+    }
+
+    FFI_PLUGIN_EXPORT void vad_force_end_speech(VADHandle *handle)
+    {
+        JNIEnv *env;
+        VADHandle *native = beginCall(handle, &env);
+        if (native == nullptr)
             return;
 
+        env->CallVoidMethod(native->object, g_ids.forceEndSpeech);
         clearException(env);
+    }
 
-        jlong handleId = reinterpret_cast<jlong>(handle);
-        jobject handleObj = getHandle(env, handleId);
-        if (handleObj == nullptr)
-            return;
+    FFI_PLUGIN_EXPORT
+    int32_t
+    vad_is_speaking(VADHandle *handle)
+    {
+        JNIEnv *env;
+        VADHandle *native = beginCall(handle, &env);
+        if (native == nullptr)
+            return 0;
 
-        jclass handleClass = env->GetObjectClass(handleObj);
-        if (handleClass == nullptr || env->ExceptionCheck())
+        jboolean result = env->CallBooleanMethod(native->object, g_ids.isSpeaking);
+        if (env->ExceptionCheck())
         {
             clearException(env);
-            env->DeleteLocalRef(handleObj);
-            return;
+            result = JNI_FALSE;
         }
 
-        jmethodID stopMethod = env->GetMethodID(handleClass, "stopListening", "()V");
-        if (stopMethod != nullptr && !env->ExceptionCheck())
-        {
-            env->CallVoidMethod(handleObj, stopMethod);
-            clearException(env);
-        }
-        else
-        {
-            clearException(env);
-        }
+        return result ? 1 : 0;
+    }
 
-        env->DeleteLocalRef(handleObj);
-        env->DeleteLocalRef(handleClass);
+    FFI_PLUGIN_EXPORT const VADStatusBlock *vad_get_status_block(VADHandle *handle)
+    {
+        if (handle == nullptr)
+            return nullptr;
+        return handle->status;
     }
 
-    __attribute__((visibility("default")))
+    FFI_PLUGIN_EXPORT
     int32_t
-    vad_process_audio(void *handle, const float *samples, int32_t sample_count)
+    vad_prewarm(VADHandle *handle, int32_t n_frames)
     {
-        if (handle == nullptr || samples == nullptr || sample_count <= 0)
+        JNIEnv *env;
+        VADHandle *native = beginCall(handle, &env);
+        if (native == nullptr)
             return -1;
 
-        JNIEnv *env = getEnv();
-        if (env == nullptr)
-            return -1;
+        jint result = env->CallIntMethod(native->object, g_ids.prewarm, static_cast<jint>(n_frames));
+        if (logCallException(env, "prewarm"))
+            result = -2;
 
-        clearException(env);
+        return result;
+    }
 
-        jlong handleId = reinterpret_cast<jlong>(handle);
-        jobject handleObj = getHandle(env, handleId);
-        if (handleObj == nullptr)
+    FFI_PLUGIN_EXPORT
+    int32_t
+    vad_get_warmup_info(VADHandle *handle, VADWarmupInfo *info_out)
+    {
+        if (info_out == nullptr)
             return -1;
 
-        jclass handleClass = env->GetObjectClass(handleObj);
-        if (handleClass == nullptr || env->ExceptionCheck())
-        {
-            clearException(env);
-            env->DeleteLocalRef(handleObj);
+        JNIEnv *env;
+        VADHandle *native = beginCall(handle, &env);
+        if (native == nullptr)
             return -1;
-        }
 
-        jmethodID processMethod = env->GetMethodID(handleClass, "processAudioData", "([F)V");
-        if (processMethod == nullptr || env->ExceptionCheck())
+        // [prewarm frames, cold us, warm us, first frame us]
+        jfloatArray values = (jfloatArray)env->CallObjectMethod(native->object, g_ids.getWarmupInfo);
+        if (env->ExceptionCheck() || values == nullptr)
         {
             clearException(env);
-            env->DeleteLocalRef(handleObj);
-            env->DeleteLocalRef(handleClass);
             return -1;
         }
 
-        jfloatArray floatArray = env->NewFloatArray(sample_count);
-        if (floatArray == nullptr || env->ExceptionCheck())
+        jfloat fields[4];
+        env->GetFloatArrayRegion(values, 0, 4, fields);
+        env->DeleteLocalRef(values);
+        if (env->ExceptionCheck())
         {
             clearException(env);
-            env->DeleteLocalRef(handleObj);
-            env->DeleteLocalRef(handleClass);
             return -1;
         }
 
-        env->SetFloatArrayRegion(floatArray, 0, sample_count, samples);
-
-        env->CallVoidMethod(handleObj, processMethod, floatArray);
-        clearException(env);
-
-        env->DeleteLocalRef(floatArray);
-        env->DeleteLocalRef(handleObj);
-        env->DeleteLocalRef(handleClass);
-
+        info_out->prewarm_frames = static_cast<int32_t>(fields[0]);
+        info_out->cold_frame_us = fields[1];
+        info_out->warm_frame_us = fields[2];
+        info_out->first_frame_us = fields[3];
         return 0;
     }
 
-    __attribute__((visibility("default"))) void vad_reset(void *handle)
+    FFI_PLUGIN_EXPORT
+    int32_t
+    vad_get_stats(VADHandle *handle, VADStats *stats_out)
     {
-        if (handle == nullptr)
-            return;
-
-        JNIEnv *env = getEnv();
-        if (env == nullptr)
-            return;
+        if (stats_out == nullptr)
+            return -1;
 
-        clearException(env);
+        JNIEnv *env;
+        VADHandle *native = beginCall(handle, &env);
+        if (native == nullptr)
+            return -1;
 
-        jlong handleId = reinterpret_cast<jlong>(handle);
-        jobject handleObj = getHandle(env, handleId);
-        if (handleObj == nullptr)
-            return;
+        VADEventPool *pool = reinterpret_cast<VADEventPool *>(env->GetLongField(native->object, g_ids.eventPool));
+        vad_stats_read(native->stats, pool, stats_out);
+        return 0;
+    }
 
-        jclass handleClass = env->GetObjectClass(handleObj);
-        if (handleClass == nullptr || env->ExceptionCheck())
-        {
-            clearException(env);
-            env->DeleteLocalRef(handleObj);
-            return;
-        }
+    FFI_PLUGIN_EXPORT
+    int32_t
+    vad_trace_start(VADHandle *handle, int32_t events_per_thread)
+    {
+        JNIEnv *env;
+        VADHandle *native = beginCall(handle, &env);
+        if (native == nullptr)
+            return -1;
 
-        jmethodID resetMethod = env->GetMethodID(handleClass, "resetStates", "()V");
-        if (resetMethod != nullptr && !env->ExceptionCheck())
-        {
-            env->CallVoidMethod(handleObj, resetMethod);
-            clearException(env);
-        }
-        else
-        {
-            clearException(env);
-        }
+        jint result = env->CallIntMethod(native->object, g_ids.startTrace, static_cast<jint>(events_per_thread));
+        if (logCallException(env, "startTrace"))
+            result = -2;
 
-        env->DeleteLocalRef(handleObj);
-        env->DeleteLocalRef(handleClass);
+        return result;
     }
 
-    __attribute__((visibility("default"))) void vad_force_end_speech(void *handle)
+    FFI_PLUGIN_EXPORT void vad_trace_stop(VADHandle *handle)
     {
-        if (handle == nullptr)
-            return;
-
-        JNIEnv *env = getEnv();
-        if (env == nullptr)
+        JNIEnv *env;
+        VADHandle *native = beginCall(handle, &env);
+        if (native == nullptr)
             return;
 
+        env->CallVoidMethod(native->object, g_ids.stopTrace);
         clearException(env);
-
-        jlong handleId = reinterpret_cast<jlong>(handle);
-        jobject handleObj = getHandle(env, handleId);
-        if (handleObj == nullptr)
-            return;
-
-        jclass handleClass = env->GetObjectClass(handleObj);
-        if (handleClass == nullptr || env->ExceptionCheck())
-        {
-            clearException(env);
-            env->DeleteLocalRef(handleObj);
-            return;
-        }
-
-        jmethodID forceEndMethod = env->GetMethodID(handleClass, "forceEndSpeech", "()V");
-        if (forceEndMethod != nullptr && !env->ExceptionCheck())
-        {
-            env->CallVoidMethod(handleObj, forceEndMethod);
-            clearException(env);
-        }
-        else
-        {
-            clearException(env);
-        }
-
-        env->DeleteLocalRef(handleObj);
-        env->DeleteLocalRef(handleClass);
     }
 
-    __attribute__((visibility("default")))
+    FFI_PLUGIN_EXPORT
     int32_t
-    vad_is_speaking(void *handle)
+    vad_trace_dump(VADHandle *handle, const char *path)
     {
-        if (handle == nullptr)
-            return 0;
-
-        JNIEnv *env = getEnv();
-        if (env == nullptr)
-            return 0;
-
-        clearException(env);
-
-        jlong handleId = reinterpret_cast<jlong>(handle);
-        jobject handleObj = getHandle(env, handleId);
-        if (handleObj == nullptr)
-            return 0;
-
-        jclass handleClass = env->GetObjectClass(handleObj);
-        if (handleClass == nullptr || env->ExceptionCheck())
-        {
-            clearException(env);
-            env->DeleteLocalRef(handleObj);
-            return 0;
-        }
+        if (path == nullptr)
+            return -1;
 
-        jmethodID isSpeakingMethod = env->GetMethodID(handleClass, "isSpeaking", "()Z");
-        if (isSpeakingMethod == nullptr || env->ExceptionCheck())
-        {
-            clearException(env);
-            env->DeleteLocalRef(handleObj);
-            env->DeleteLocalRef(handleClass);
-            return 0;
-        }
+        JNIEnv *env;
+        VADHandle *native = beginCall(handle, &env);
+        if (native == nullptr)
+            return -1;
 
-        jboolean result = env->CallBooleanMethod(handleObj, isSpeakingMethod);
-        if (env->ExceptionCheck())
+        jstring pathStr = env->NewStringUTF(path);
+        if (pathStr == nullptr)
         {
             clearException(env);
-            result = JNI_FALSE;
+            return -2;
         }
+        jint result = env->CallIntMethod(native->object, g_ids.dumpTrace, pathStr);
+        env->DeleteLocalRef(pathStr);
+        if (logCallException(env, "dumpTrace"))
+            result = -2;
 
-        env->DeleteLocalRef(handleObj);
-        env->DeleteLocalRef(handleClass);
-
-        return result ? 1 : 0;
+        return result;
     }
 
-    static char g_lastErrorBuffer[1024] = {0};
-
-    __attribute__((visibility("default")))
+    FFI_PLUGIN_EXPORT
     const char *
-    vad_get_last_error(void *handle)
+    vad_get_last_error(VADHandle *handle)
     {
         if (handle == nullptr)
             return "Invalid handle";
 
-        JNIEnv *env = getEnv();
-        if (env == nullptr)
+        JNIEnv *env;
+        VADHandle *native = beginCall(handle, &env);
+        if (native == nullptr)
             return "JNI error";
 
-        // Clear any pending exception first - this is critical!
-        clearException(env);
-
-        jlong handleId = reinterpret_cast<jlong>(handle);
-        jobject handleObj = getHandle(env, handleId);
-        if (handleObj == nullptr)
-            return "Handle not found";
-
-        jclass handleClass = env->GetObjectClass(handleObj);
-        if (handleClass == nullptr || env->ExceptionCheck())
-        {
-            clearException(env);
-            env->DeleteLocalRef(handleObj);
-            return "Failed to get handle class";
-        }
-
-        jmethodID getErrorMethod = env->GetMethodID(handleClass, "getLastError", "()Ljava/lang/String;");
-        if (getErrorMethod == nullptr || env->ExceptionCheck())
-        {
-            clearException(env);
-            env->DeleteLocalRef(handleObj);
-            env->DeleteLocalRef(handleClass);
-            return "Method not found";
-        }
-
-        jstring errorStr = (jstring)env->CallObjectMethod(handleObj, getErrorMethod);
+        jstring errorStr = (jstring)env->CallObjectMethod(native->object, g_ids.getLastError);
         if (env->ExceptionCheck())
         {
             clearException(env);
-            env->DeleteLocalRef(handleObj);
-            env->DeleteLocalRef(handleClass);
             return "Exception getting error";
         }
 
         if (errorStr == nullptr)
-        {
-            env->DeleteLocalRef(handleObj);
-            env->DeleteLocalRef(handleClass);
             return "";
-        }
 
         const char *errorChars = env->GetStringUTFChars(errorStr, nullptr);
         if (errorChars != nullptr)
         {
-            strncpy(g_lastErrorBuffer, errorChars, sizeof(g_lastErrorBuffer) - 1);
-            g_lastErrorBuffer[sizeof(g_lastErrorBuffer) - 1] = '\0';
+            strncpy(native->last_error, errorChars, sizeof(native->last_error) - 1);
+            native->last_error[sizeof(native->last_error) - 1] = '\0';
             env->ReleaseStringUTFChars(errorStr, errorChars);
         }
         else
         {
-            g_lastErrorBuffer[0] = '\0';
+            native->last_error[0] = '\0';
         }
 
         env->DeleteLocalRef(errorStr);
-        env->DeleteLocalRef(handleObj);
-        env->DeleteLocalRef(handleClass);
 
-        return g_lastErrorBuffer;
+        return native->last_error;
     }
 
-    __attribute__((visibility("default"))) void vad_float_to_pcm16(const float *float_samples, int16_t *pcm16_samples, int32_t sample_count)
+    FFI_PLUGIN_EXPORT void vad_float_to_pcm16(const float *float_samples, int16_t *pcm16_samples, int32_t sample_count)
     {
-        for (int32_t i = 0; i < sample_count; i++)
-        {
-            float clamped = float_samples[i];
-            if (clamped > 1.0f)
-                clamped = 1.0f;
-            if (clamped < -1.0f)
-                clamped = -1.0f;
-            pcm16_samples[i] = (int16_t)(clamped * 32767.0f);
-        }
+        vad_convert_f32_to_s16(float_samples, pcm16_samples, sample_count);
     }
 
-    __attribute__((visibility("default"))) void vad_pcm16_to_float(const int16_t *pcm16_samples, float *float_samples, int32_t sample_count)
+    FFI_PLUGIN_EXPORT void vad_pcm16_to_float(const int16_t *pcm16_samples, float *float_samples, int32_t sample_count)
     {
-        for (int32_t i = 0; i < sample_count; i++)
-        {
-            float_samples[i] = (float)pcm16_samples[i] / 32768.0f;
-        }
+        vad_convert_s16_to_f32(pcm16_samples, float_samples, sample_count);
     }
 
 } // extern "C"
@@ -12,11 +12,15 @@ import ai.onnxruntime.OrtEnvironment
 import ai.onnxruntime.OrtSession
 import java.io.File
 import java.io.FileOutputStream
+import java.nio.ByteBuffer
+import java.nio.ByteOrder
 import java.nio.FloatBuffer
 import java.nio.LongBuffer
+import java.security.MessageDigest
 import java.util.concurrent.ConcurrentHashMap
 import java.util.concurrent.atomic.AtomicBoolean
 import java.util.concurrent.atomic.AtomicReference
+import java.util.concurrent.locks.LockSupport
 import java.util.concurrent.locks.ReentrantLock
 import kotlin.concurrent.withLock
 
@@ -32,7 +36,16 @@ data class VADConfigInternal(
     var sampleRate: Int = 16000,
     var frameSamples: Int = 512,
     var endSpeechPadFrames: Int = 3,
-    var isDebug: Boolean = false
+    var isDebug: Boolean = false,
+    var speechChunkSamples: Int = 0,
+    var maxSpeechFrames: Int = 938,
+    var speechEndByReference: Boolean = false,
+    var inputSampleRate: Int = 0,
+    var preferInt8Model: Boolean = false,
+    var prewarmFrames: Int = 0,
+    var silenceGateFrames: Int = 0,
+    var silenceGateDbfs: Float = -55f,
+    var silenceGateNoiseMarginDb: Float = 0f
 ) {
     val contextSize: Int
         get() = if (sampleRate == 16000) 64 else 32
@@ -50,26 +63,225 @@ object VADEventType {
     const val MISFIRE = 5
     const val ERROR = 6
     const val STOPPED = 7
+    const val SPEECH_CHUNK = 8
+}
+
+/**
+ * Timeline trace stages matching VADTraceSpan in src/vad_trace.h
+ */
+internal object VADTraceSpan {
+    const val CAPTURE = 0
+    const val PROCESS_AUDIO = 1
+    const val FRAME = 2
+    const val INFERENCE = 3
+    const val VAD_LOGIC = 4
+    const val CALLBACK_LOCK = 5
+    const val CALLBACK = 6
+    const val PREWARM = 7
+}
+
+/**
+ * Silence gate decisions matching VAD_GATE_* in src/vad_gate.h
+ */
+internal object VADGateDecision {
+    const val INFER = 0
+    const val SKIP = 1
+    const val RESUME = 2
+}
+
+/**
+ * Process-wide ONNX Runtime sessions, one per model. A session is immutable
+ * once created and can run from several threads, so every handle using the
+ * same model shares it and keeps only its own state and context. Sessions are
+ * keyed by the model's content hash (remembered per path, file size and
+ * modification time) and closed with their last reference.
+ */
+internal object SharedModelSessions {
+    private class Entry(val key: String, val session: OrtSession) {
+        var refs = 0
+    }
+    
+    private class FileDigest(val length: Long, val modified: Long, val hash: String)
+    
+    private val entries = HashMap<String, Entry>()
+    private val digests = HashMap<String, FileDigest>()
+    
+    /**
+     * Get the session for a model file, creating it on first use
+     * @param disableQdq Keep DequantizeLinear weights out of QDQ fusion (int8 models)
+     */
+    @Synchronized
+    fun acquire(env: OrtEnvironment, path: String, disableQdq: Boolean): OrtSession =
+        acquire(contentHash(path), disableQdq) { options -> env.createSession(path, options) }
+    
+    /**
+     * Get the session for a serialized model, creating it on first use. A
+     * direct buffer is read in place and not kept once the session exists.
+     */
+    @Synchronized
+    fun acquire(env: OrtEnvironment, model: ByteBuffer): OrtSession {
+        val digest = MessageDigest.getInstance("SHA-256")
+        digest.update(model.duplicate())
+        // The buffer may hold either model; QDQ fusion off is a no-op for fp32
+        return acquire(hex(digest.digest()), disableQdq = true) { options -> env.createSession(model, options) }
+    }
+    
+    private fun acquire(hash: String, disableQdq: Boolean, create: (OrtSession.SessionOptions) -> OrtSession): OrtSession {
+        val key = hash + if (disableQdq) ":qdq-off" else ""
+        val entry = entries.getOrPut(key) {
+            val session = OrtSession.SessionOptions().use { options ->
+                options.setOptimizationLevel(OrtSession.SessionOptions.OptLevel.ALL_OPT)
+                // CPU execution provider only: NNAPI does not support every operator of the model
+                if (disableQdq) {
+                    options.addConfigEntry("session.disable_quant_qdq", "1")
+                }
+                create(options)
+            }
+            Entry(key, session)
+        }
+        entry.refs++
+        return entry.session
+    }
+    
+    /** Drop a reference taken by [acquire]; the session is closed with the last one */
+    @Synchronized
+    fun release(session: OrtSession) {
+        val entry = entries.values.firstOrNull { it.session === session } ?: return
+        entry.refs--
+        if (entry.refs == 0) {
+            entries.remove(entry.key)
+            entry.session.close()
+        }
+    }
+    
+    private fun contentHash(path: String): String {
+        val file = File(path)
+        val length = file.length()
+        val modified = file.lastModified()
+        digests[path]?.let {
+            if (it.length == length && it.modified == modified) {
+                return it.hash
+            }
+        }
+        
+        val digest = MessageDigest.getInstance("SHA-256")
+        file.inputStream().use { input ->
+            val buffer = ByteArray(64 * 1024)
+            while (true) {
+                val read = input.read(buffer)
+                if (read < 0) break
+                digest.update(buffer, 0, read)
+            }
+        }
+        val hash = hex(digest.digest())
+        digests[path] = FileDigest(length, modified, hash)
+        return hash
+    }
+    
+    private fun hex(bytes: ByteArray): String = bytes.joinToString("") { "%02x".format(it) }
+}
+
+/**
+ * One stream's inference with its I/O tensors bound once. The input tensor
+ * wraps a direct buffer holding the context followed by the frame, the
+ * recurrent state ping-pongs between two direct buffers (one bound as input,
+ * the other as pinned output) and the probability lands in a pinned output.
+ * A frame is copied straight into the input after the context, and the
+ * session runs on prebuilt name maps, so steady state creates no tensors,
+ * buffers or maps.
+ */
+internal class BoundInference(
+    env: OrtEnvironment,
+    private val session: OrtSession,
+    config: VADConfigInternal
+) : AutoCloseable {
+    private val contextSize = config.contextSize
+    private val frameSamples = config.frameSamples
+    
+    private val input = directFloats(contextSize + frameSamples)
+    private val states = arrayOf(directFloats(STATE_SIZE), directFloats(STATE_SIZE))
+    private val probability = directFloats(1)
+    
+    private val inputTensor = OnnxTensor.createTensor(env, input, longArrayOf(1, (contextSize + frameSamples).toLong()))
+    private val srTensor = OnnxTensor.createTensor(env, LongBuffer.wrap(longArrayOf(config.sampleRate.toLong())), longArrayOf(1))
+    private val stateTensors = Array(2) { OnnxTensor.createTensor(env, states[it], STATE_SHAPE) }
+    private val probabilityTensor = OnnxTensor.createTensor(env, probability, longArrayOf(1, 1))
+    
+    // Indexed by the state buffer currently holding the state
+    private val inputs = Array(2) { mapOf("input" to inputTensor, "sr" to srTensor, "state" to stateTensors[it]) }
+    private val outputs = Array(2) { mapOf("output" to probabilityTensor, "stateN" to stateTensors[1 - it]) }
+    private var current = 0
+    
+    /** Run one frame, advancing the state and context */
+    fun run(frame: FloatArray): Float {
+        input.position(contextSize)
+        input.put(frame, 0, frameSamples)
+        session.run(inputs[current], outputs[current]).close()
+        current = 1 - current
+        
+        // The frame's tail is the next frame's context
+        for (i in 0 until contextSize) {
+            input.put(i, input.get(frameSamples + i))
+        }
+        return probability.get(0)
+    }
+    
+    /**
+     * Take a frame the silence gate kept from the model: only its tail is
+     * needed, as the next frame's context
+     */
+    fun skip(frame: FloatArray) {
+        input.position(0)
+        input.put(frame, frameSamples - contextSize, contextSize)
+    }
+    
+    /** Clear the state but keep the context (inference resuming after skipped frames) */
+    fun clearState() {
+        for (i in 0 until STATE_SIZE) {
+            states[current].put(i, 0f)
+        }
+    }
+    
+    /** Clear the state and context */
+    fun reset() {
+        for (i in 0 until STATE_SIZE) {
+            states[current].put(i, 0f)
+        }
+        for (i in 0 until contextSize) {
+            input.put(i, 0f)
+        }
+    }
+    
+    override fun close() {
+        inputTensor.close()
+        srTensor.close()
+        stateTensors.forEach { it.close() }
+        probabilityTensor.close()
+    }
+    
+    companion object {
+        // v6: single state tensor (2, 1, 128) = 256 floats
+        private const val STATE_SIZE = 2 * 128
+        private val STATE_SHAPE = longArrayOf(2, 1, 128)
+        
+        private fun directFloats(count: Int): FloatBuffer =
+            ByteBuffer.allocateDirect(count * 4).order(ByteOrder.nativeOrder()).asFloatBuffer()
+    }
 }
 
 /**
  * VAD Handle Internal Implementation
  */
 class VADHandleInternal {
-    // ONNX Runtime
+    // ONNX Runtime (the session is shared, see SharedModelSessions)
     private var ortEnv: OrtEnvironment? = null
     private var ortSession: OrtSession? = null
     
     var config = VADConfigInternal()
         private set
     
-    // VAD state for v6 model (2 * 1 * 128 = 256 floats)
-    private var state: FloatArray = FloatArray(0)
-    private val hiddenSize = 128
-    private val numLayers = 2
-    
-    // Context buffer for v6
-    private var contextBuffer: FloatArray = FloatArray(0)
+    // Model state and context, with the I/O tensors bound to the session
+    private var inference: BoundInference? = null
     
     // Speech detection state
     @Volatile private var _isSpeaking = false
@@ -78,16 +290,46 @@ class VADHandleInternal {
     fun isSpeaking(): Boolean = _isSpeaking
     private var speechFrameCount = 0
     private var silenceFrameCount = 0
-    private var speechBuffer = mutableListOf<Float>()
-    private var preSpeechBuffer = mutableListOf<FloatArray>()
     private var hasEmittedRealStart = false
     
-    // Audio buffer for accumulating samples
-    private var audioBuffer = mutableListOf<Float>()
+    // Speech segment as PCM16, converted frame by frame. Allocated once in
+    // initialize for preSpeechPadFrames + maxSpeechFrames frames; only grown
+    // when maxSpeechFrames is 0 (unbounded)
+    private var speechPCM16: ShortArray = ShortArray(0)
+    private var speechLength = 0
+    // Frames of the segment after its pre-speech pad, bounded by maxSpeechFrames
+    private var segmentFrames = 0
+    // Samples of the current segment already sent as SPEECH_CHUNK events
+    private var speechStreamed = 0
+    // No event carries segment audio (speechEndByReference without chunks),
+    // so neither the segment nor its pad is stored
+    private var storeSpeech = true
+    
+    // Frames processed since the last reset, and the first frame of the open
+    // segment (pre-speech pad included); events report both in samples
+    private var frameIndex = 0L
+    private var segmentStart = 0L
+    
+    // Pre-speech pad: ring of the last preSpeechPadFrames frames
+    private var preSpeechRing: FloatArray = FloatArray(0)
+    private var preSpeechCount = 0
+    private var preSpeechNext = 0
+    
+    // Lock-free native ring (src/vad_ring.c) framing incoming samples;
+    // written by the capture thread or vad_process_audio (which reads this
+    // field from JNI), and read in place through inputView
+    private var inputRing: Long = 0
+    private var inputView: FloatBuffer? = null
+    private var frameBuffer: FloatArray = FloatArray(0)
+    
+    // Native resampler (src/vad_resample.c) for vad_process_audio input at
+    // inputSampleRate, also read from JNI; 0 when input is at sampleRate
+    private var inputResampler: Long = 0
     
     // Audio recording
     private var audioRecord: AudioRecord? = null
     private var recordingThread: Thread? = null
+    private var inferenceThread: Thread? = null
     private val isRecording = AtomicBoolean(false)
     
     // Callback - using native pointer for FFI
@@ -96,54 +338,141 @@ class VADHandleInternal {
     private var userDataPtr: Long = 0
     private var callbackValid = AtomicBoolean(false)
     
+    // Native event pool (src/vad_events.c); events stay alive until Dart
+    // releases them, which may be after this handle is destroyed
+    private var eventPool: Long = nativeEventPoolCreate()
+    
+    // Native status block (src/vad_status.c) polled by Dart without FFI calls;
+    // its address is read from JNI by vad_get_status_block
+    private var statusBlock: Long = nativeStatusCreate()
+    
+    // Native stats recorder (src/vad_stats.c) behind vad_get_stats, also read
+    // from JNI; a frame taking longer than frameBudgetNs counts as late
+    private var statsRecorder: Long = nativeStatsCreate()
+    private var frameBudgetNs = 0L
+    
+    // Native silence gate (src/vad_gate.c, VADConfigInternal.silenceGateFrames)
+    // deciding which frames skip the model
+    private var gate: Long = nativeGateCreate()
+    
+    // Native timeline trace (src/vad_trace.c) behind vad_trace_start; tracing
+    // mirrors its state so no stage crosses JNI while it is off
+    private var traceRecorder: Long = nativeTraceCreate()
+    @Volatile private var tracing = false
+    
+    // Event subscription (vad_set_event_mask / vad_set_frame_event_interval);
+    // checked before any event data is copied
+    @Volatile private var eventMask: Int = -1
+    @Volatile private var frameEventInterval: Int = 1
+    private var frameEventCountdown = 0
+    
+    // Warm-up (prewarm, VADConfigInternal.prewarmFrames): latency in
+    // microseconds. The first real frame after initialize is timed, and
+    // first waits for a background warm-up.
+    private var prewarmThread: Thread? = null
+    private var warmupFrames = 0
+    private var coldFrameUs = 0f
+    private var warmFrameUs = 0f
+    private var firstFrameUs = 0f
+    private var firstFramePending = false
+    
     // Last error
     private var _lastError: String = ""
     
     // JNI-compatible getter
     fun getLastError(): String = _lastError
     
-    // Stored speech end data
-    private var storedSpeechEndPCM16: ShortArray = ShortArray(0)
-    
     init {
         resetStates()
     }
     
     fun resetStates() {
-        // v6: single state tensor (2, 1, 128) = 256 floats
-        state = FloatArray(numLayers * hiddenSize)
-        contextBuffer = FloatArray(config.contextSize)
+        inference?.reset()
         
         _isSpeaking = false
         speechFrameCount = 0
         silenceFrameCount = 0
-        speechBuffer.clear()
-        preSpeechBuffer.clear()
+        clearSpeech()
+        preSpeechCount = 0
+        preSpeechNext = 0
+        frameIndex = 0L
+        segmentStart = 0L
         hasEmittedRealStart = false
-        audioBuffer.clear()
+        frameEventCountdown = 0
+        if (statusBlock != 0L) {
+            nativeStatusReset(statusBlock)
+        }
+        if (statsRecorder != 0L) {
+            nativeStatsReset(statsRecorder)
+        }
+        if (gate != 0L) {
+            nativeGateReset(gate)
+        }
+        if (inputRing != 0L) {
+            nativeRingReset(inputRing)
+        }
+        if (inputResampler != 0L) {
+            nativeResamplerReset(inputResampler)
+        }
     }
     
     fun destroy() {
         invalidateCallback()
         stopListening()
-        ortSession?.close()
-        ortSession = null
-        ortEnv?.close()
-        ortEnv = null
+        waitPrewarm()
+        if (inputRing != 0L) {
+            inputView = null
+            nativeRingDestroy(inputRing)
+            inputRing = 0
+        }
+        if (inputResampler != 0L) {
+            nativeResamplerDestroy(inputResampler)
+            inputResampler = 0
+        }
+        releaseSession()
+        if (eventPool != 0L) {
+            nativeEventPoolClose(eventPool)
+            eventPool = 0
+        }
+        if (statusBlock != 0L) {
+            nativeStatusDestroy(statusBlock)
+            statusBlock = 0
+        }
+        if (statsRecorder != 0L) {
+            nativeStatsDestroy(statsRecorder)
+            statsRecorder = 0
+        }
+        if (gate != 0L) {
+            nativeGateDestroy(gate)
+            gate = 0
+        }
+        tracing = false
+        if (traceRecorder != 0L) {
+            nativeTraceDestroy(traceRecorder)
+            traceRecorder = 0
+        }
     }
     
     // MARK: - Model Loading
     
     fun initialize(config: VADConfigInternal, modelPath: String?, context: Context): Int {
-        this.config = config
-        resetStates()
+        val prepared = prepare(config)
+        if (prepared != 0) {
+            return prepared
+        }
         
+        releaseSession()
         try {
             // Initialize ONNX Runtime
             Log.d(TAG, "Initializing ONNX Runtime environment...")
             ortEnv = OrtEnvironment.getEnvironment()
             Log.d(TAG, "ONNX Runtime environment created successfully")
             
+            if (config.preferInt8Model && modelPath.isNullOrEmpty() && loadInt8Model(context)) {
+                finishInitialize()
+                return 0
+            }
+            
             // Find model path
             val finalModelPath = when {
                 !modelPath.isNullOrEmpty() && File(modelPath).exists() -> {
@@ -171,22 +500,16 @@ class VADHandleInternal {
             }
             Log.d(TAG, "Model file verified: ${modelFile.length()} bytes at $finalModelPath")
             
-            Log.d(TAG, "Creating ONNX session options...")
-            val sessionOptions = OrtSession.SessionOptions()
-            sessionOptions.setOptimizationLevel(OrtSession.SessionOptions.OptLevel.ALL_OPT)
-            // Use CPU execution provider only - avoid NNAPI which may not support all operators
-            // This prevents the "this model don't Support" error from MirrorManager/NNAPI
-            
-            Log.d(TAG, "Creating ONNX session from model...")
-            ortSession = ortEnv!!.createSession(finalModelPath, sessionOptions)
-            Log.d(TAG, "ONNX session created successfully")
+            Log.d(TAG, "Acquiring shared ONNX session for model...")
+            ortSession = SharedModelSessions.acquire(ortEnv!!, finalModelPath, disableQdq = false)
+            Log.d(TAG, "ONNX session ready")
             
             // Log model info
             val inputNames = ortSession!!.inputNames
             val outputNames = ortSession!!.outputNames
             Log.d(TAG, "Model inputs: $inputNames, outputs: $outputNames")
             
-            sendEvent(VADEventType.INITIALIZED)
+            finishInitialize()
             return 0
             
         } catch (e: Exception) {
@@ -198,9 +521,134 @@ class VADHandleInternal {
         }
     }
     
-    private fun extractModelFromAssets(context: Context): String? {
-        val modelNames = listOf("silero_vad_v6.onnx", "silero_vad.onnx")
+    /**
+     * Apply the configuration and allocate the per-handle buffers, input
+     * ring and resampler
+     * @return 0 on success, negative error code on failure
+     */
+    private fun prepare(config: VADConfigInternal): Int {
+        // The warm-up thread runs on the session about to be released
+        waitPrewarm()
+        warmupFrames = 0
+        coldFrameUs = 0f
+        warmFrameUs = 0f
+        firstFrameUs = 0f
+        firstFramePending = true
+        
+        if (config.maxSpeechFrames != 0 && config.maxSpeechFrames < config.minSpeechFrames) {
+            _lastError = "maxSpeechFrames must be 0 or at least minSpeechFrames"
+            return -1
+        }
+        
+        this.config = config
+        frameBudgetNs = config.frameSamples * 1_000_000_000L / config.sampleRate
+        storeSpeech = !config.speechEndByReference || config.speechChunkSamples > 0
+        val boundedFrames = if (storeSpeech && config.maxSpeechFrames > 0) config.preSpeechPadFrames + config.maxSpeechFrames else 0
+        speechPCM16 = ShortArray(boundedFrames * config.frameSamples)
+        preSpeechRing = FloatArray(if (storeSpeech) maxOf(0, config.preSpeechPadFrames) * config.frameSamples else 0)
+        nativeGateConfigure(gate, config.silenceGateFrames, config.silenceGateDbfs, config.silenceGateNoiseMarginDb)
+        resetStates()
+        
+        // Room for 64 frames so a stalled inference thread does not drop capture
+        if (inputRing != 0L) {
+            inputView = null
+            nativeRingDestroy(inputRing)
+        }
+        inputRing = nativeRingCreate(config.frameSamples * 64, config.frameSamples)
+        frameBuffer = FloatArray(config.frameSamples)
+        if (inputRing == 0L) {
+            _lastError = "Failed to allocate input buffer"
+            return -2
+        }
+        inputView = nativeRingBuffer(inputRing)?.order(ByteOrder.nativeOrder())?.asFloatBuffer()
+        if (inputView == null) {
+            _lastError = "Failed to map input buffer"
+            return -2
+        }
+        
+        if (inputResampler != 0L) {
+            nativeResamplerDestroy(inputResampler)
+            inputResampler = 0
+        }
+        if (config.inputSampleRate != 0 && config.inputSampleRate != config.sampleRate) {
+            inputResampler = nativeResamplerCreate(config.inputSampleRate, config.sampleRate)
+            if (inputResampler == 0L) {
+                _lastError = "Unsupported input sample rate ${config.inputSampleRate}"
+                return -1
+            }
+        }
+        return 0
+    }
+    
+    /**
+     * Initialize from a serialized model instead of a file. The buffer is
+     * direct and borrowed from the caller: ONNX Runtime reads it while the
+     * session is created, and it is not used after this returns.
+     */
+    fun initializeFromMemory(config: VADConfigInternal, model: ByteBuffer): Int {
+        val prepared = prepare(config)
+        if (prepared != 0) {
+            return prepared
+        }
         
+        releaseSession()
+        try {
+            ortEnv = OrtEnvironment.getEnvironment()
+            ortSession = SharedModelSessions.acquire(ortEnv!!, model)
+            Log.d(TAG, "ONNX session ready (model from memory, ${model.capacity()} bytes)")
+            finishInitialize()
+            return 0
+        } catch (e: Exception) {
+            _lastError = "Initialization failed: ${e.javaClass.simpleName}: ${e.message}"
+            Log.e(TAG, "Initialization error: $_lastError", e)
+            return -2
+        }
+    }
+    
+    /**
+     * Bind this handle's inference tensors to its new session, start the
+     * warm-up and report the handle ready
+     */
+    private fun finishInitialize() {
+        inference = BoundInference(ortEnv!!, ortSession!!, config)
+        startPrewarm()
+        sendEvent(VADEventType.INITIALIZED)
+    }
+    
+    /**
+     * Load the bundled int8 model, if any. Its weights are DequantizeLinear
+     * constants; with QDQ fusion off ONNX Runtime folds them back to fp32 when
+     * the session is created, so inference runs the same kernels as fp32.
+     * @return false when the model is missing or fails to load (fall back to fp32)
+     */
+    private fun loadInt8Model(context: Context): Boolean {
+        val int8Path = extractModelFromAssets(context, listOf("silero_vad_v6_int8.onnx")) ?: return false
+        return try {
+            ortSession = SharedModelSessions.acquire(ortEnv!!, int8Path, disableQdq = true)
+            Log.d(TAG, "Int8 model loaded from $int8Path")
+            true
+        } catch (e: Exception) {
+            Log.w(TAG, "Int8 model not usable (${e.message}), falling back to fp32")
+            false
+        }
+    }
+    
+    /**
+     * Drop this handle's reference to its shared session. The environment is
+     * a process-wide singleton and is left open.
+     */
+    private fun releaseSession() {
+        inference?.close()
+        inference = null
+        ortSession?.let { SharedModelSessions.release(it) }
+        ortSession = null
+        ortEnv = null
+    }
+    
+    private fun extractModelFromAssets(
+        context: Context,
+        modelNames: List<String> = listOf("silero_vad_v6.onnx", "silero_vad.onnx")
+    ): String? {
         for (modelName in modelNames) {
             try {
                 val assetManager = context.assets
@@ -274,6 +722,19 @@ class VADHandleInternal {
             audioRecord?.startRecording()
             isRecording.set(true)
             
+            // Inference drains whole frames from the ring and parks when it is empty
+            inferenceThread = Thread {
+                while (isRecording.get()) {
+                    if (!drainFrames()) {
+                        LockSupport.parkNanos(FRAME_WAIT_NANOS)
+                    }
+                }
+            }.apply {
+                name = "VadPlusInferenceThread"
+                start()
+            }
+            
+            // Capture only converts into the ring, so it never waits on inference
             recordingThread = Thread {
                 val buffer = ShortArray(config.frameSamples)
                 
@@ -286,12 +747,16 @@ class VADHandleInternal {
                             continue
                         }
                         
-                        // Convert PCM16 to float
-                        val floatData = FloatArray(readResult) { i ->
-                            buffer[i].toFloat() / 32768.0f
+                        val traced = traceStart()
+                        val written = nativeRingWritePcm16(inputRing, buffer, readResult)
+                        if (written < readResult) {
+                            nativeStatsAddDropped(statsRecorder, readResult - written)
+                            if (config.isDebug) {
+                                Log.d(TAG, "Input ring full, dropping samples")
+                            }
                         }
-                        
-                        processAudioData(floatData)
+                        LockSupport.unpark(inferenceThread)
+                        traceSpan(VADTraceSpan.CAPTURE, readResult, traced)
                     }
                 }
             }.apply {
@@ -319,10 +784,15 @@ class VADHandleInternal {
         
         try {
             recordingThread?.join(1000)
+            inferenceThread?.let {
+                LockSupport.unpark(it)
+                it.join(1000)
+            }
         } catch (e: InterruptedException) {
             // Ignore
         }
         recordingThread = null
+        inferenceThread = null
         
         try {
             audioRecord?.stop()
@@ -354,26 +824,98 @@ class VADHandleInternal {
         }
     }
     
+    fun setEventMask(mask: Int) {
+        eventMask = mask
+    }
+    
+    fun setFrameEventInterval(interval: Int) {
+        frameEventInterval = maxOf(1, interval)
+    }
+    
+    private fun wantsEvent(type: Int): Boolean =
+        callbackValid.get() && (eventMask and (1 shl type)) != 0
+    
     // MARK: - Audio Processing
     
+    // Caller-fed audio; the caller acts as both producer and consumer of the ring,
+    // so this must not be mixed with microphone capture on the same handle
     fun processAudioData(data: FloatArray) {
-        audioBuffer.addAll(data.toList())
+        if (inputRing == 0L) return
         
-        while (audioBuffer.size >= config.frameSamples) {
-            val frame = audioBuffer.take(config.frameSamples).toFloatArray()
-            repeat(config.frameSamples) { audioBuffer.removeAt(0) }
-            processFrame(frame)
+        val traced = traceStart()
+        var offset = 0
+        while (offset < data.size) {
+            val written = nativeRingWrite(inputRing, data, offset, data.size - offset)
+            offset += written
+            if (!drainFrames() && written == 0) break
         }
+        traceSpan(VADTraceSpan.PROCESS_AUDIO, data.size, traced)
+    }
+    
+    // Called from vad_process_audio after it has written into the ring
+    fun drainInput() {
+        drainFrames()
+    }
+    
+    // Run every complete frame in the ring; frameBuffer is reused, consumers copy it
+    private fun drainFrames(): Boolean {
+        val view = inputView ?: return false
+        var processed = false
+        while (true) {
+            val index = nativeRingPeek(inputRing, config.frameSamples)
+            if (index < 0) break
+            view.position(index)
+            view.get(frameBuffer, 0, config.frameSamples)
+            nativeRingConsume(inputRing, config.frameSamples)
+            processFrame(frameBuffer)
+            processed = true
+        }
+        return processed
     }
     
     private fun processFrame(frame: FloatArray) {
         try {
-            val probability = runInference(frame)
+            val bound = inference ?: throw IllegalStateException("ONNX session not initialized")
+            if (firstFramePending) {
+                waitPrewarm()
+            }
+            val traced = tracing
+            val index = frameIndex.toInt()
+            val start = System.nanoTime()
+            val decision = nativeGatePush(gate, frame, config.frameSamples)
+            if (decision == VADGateDecision.SKIP) {
+                processGatedFrame(bound, frame, index, start, traced)
+                return
+            }
+            // After a gap the LSTM state of the last inferred frame is
+            // stale; restart from zero as at the start of a stream (src/vad_plus.c)
+            if (decision == VADGateDecision.RESUME) {
+                bound.clearState()
+            }
+            val probability = bound.run(frame)
+            val inferenceNs = System.nanoTime() - start
+            if (firstFramePending) {
+                firstFrameUs = inferenceNs / 1000f
+                if (coldFrameUs == 0f) {
+                    coldFrameUs = firstFrameUs
+                }
+                firstFramePending = false
+            }
             
             // Send frame processed event
             sendFrameEvent(probability, probability >= config.positiveSpeechThreshold, frame)
             
+            val logicStart = if (traced) System.nanoTime() else 0L
             processVADLogic(frame, probability)
+            nativeStatusPublishFrame(statusBlock, probability, _isSpeaking)
+            val end = System.nanoTime()
+            nativeStatsRecordFrame(statsRecorder, inputRing, inferenceNs, end - start, frameBudgetNs,
+                speechLength * 2L, speechPCM16.size * 2L + preSpeechRing.size * 4L)
+            if (traced) {
+                traceSpan(VADTraceSpan.INFERENCE, index, start, start + inferenceNs)
+                traceSpan(VADTraceSpan.VAD_LOGIC, index, logicStart, end)
+                traceSpan(VADTraceSpan.FRAME, index, start, end)
+            }
             
         } catch (e: Exception) {
             _lastError = e.message ?: "Inference error"
@@ -381,66 +923,144 @@ class VADHandleInternal {
         }
     }
     
-    // MARK: - ONNX Inference (v6)
+    // A frame the silence gate kept from the model counts as probability 0
+    private fun processGatedFrame(bound: BoundInference, frame: FloatArray, index: Int, start: Long, traced: Boolean) {
+        bound.skip(frame)
+        sendFrameEvent(0f, false, frame)
+        processVADLogic(frame, 0f)
+        nativeStatusPublishFrame(statusBlock, 0f, _isSpeaking)
+        nativeStatsRecordGated(statsRecorder, inputRing, speechLength * 2L, speechPCM16.size * 2L + preSpeechRing.size * 4L)
+        if (traced) {
+            traceSpan(VADTraceSpan.FRAME, index, start)
+        }
+    }
     
-    private fun runInference(frame: FloatArray): Float {
-        val session = ortSession ?: throw IllegalStateException("ONNX session not initialized")
-        val env = ortEnv ?: throw IllegalStateException("ONNX environment not initialized")
-        
-        // Prepare input with context - shape [1, frameSamples + contextSize]
-        val inputSize = config.frameSamples + config.contextSize
-        val inputWithContext = FloatArray(inputSize)
-        System.arraycopy(contextBuffer, 0, inputWithContext, 0, config.contextSize)
-        System.arraycopy(frame, 0, inputWithContext, config.contextSize, config.frameSamples)
-        
-        val inputShape = longArrayOf(1, inputSize.toLong())
-        val inputTensor = OnnxTensor.createTensor(env, FloatBuffer.wrap(inputWithContext), inputShape)
-        
-        // Prepare sample rate tensor - shape [1]
-        val srTensor = OnnxTensor.createTensor(env, LongBuffer.wrap(longArrayOf(config.sampleRate.toLong())), longArrayOf(1))
-        
-        // Prepare state tensor - shape [2, 1, 128]
-        val stateShape = longArrayOf(numLayers.toLong(), 1, hiddenSize.toLong())
-        val stateTensor = OnnxTensor.createTensor(env, FloatBuffer.wrap(state), stateShape)
-        
-        val inputs = mapOf(
-            "input" to inputTensor,
-            "sr" to srTensor,
-            "state" to stateTensor
-        )
-        
-        val outputs = session.run(inputs)
-        
-        // Get output probability
-        val outputTensor = outputs.get("output").get() as OnnxTensor
-        val outputBuffer = outputTensor.floatBuffer
-        val probability = outputBuffer.get(0)
-        
-        // Update state
-        val stateOutput = outputs.get("stateN").get() as OnnxTensor
-        val stateBuffer = stateOutput.floatBuffer
-        stateBuffer.get(state)
-        
-        // Update context buffer
-        val startIndex = inputWithContext.size - config.contextSize
-        System.arraycopy(inputWithContext, startIndex, contextBuffer, 0, config.contextSize)
-        
-        // Close tensors
-        inputTensor.close()
-        srTensor.close()
-        stateTensor.close()
-        outputs.close()
-        
-        return probability
+    // MARK: - Timeline Trace
+    
+    fun startTrace(eventsPerThread: Int): Int {
+        if (eventsPerThread < 0) {
+            _lastError = "eventsPerThread must not be negative"
+            return -1
+        }
+        nativeTraceStart(traceRecorder, eventsPerThread)
+        tracing = true
+        return 0
+    }
+    
+    fun stopTrace() {
+        tracing = false
+        nativeTraceStop(traceRecorder)
+    }
+    
+    fun dumpTrace(path: String): Int {
+        val error = nativeTraceDump(traceRecorder, path) ?: return 0
+        _lastError = error
+        return -1
+    }
+    
+    // Span start on the trace clock (System.nanoTime is CLOCK_MONOTONIC, as
+    // in vad_trace.c); 0 while tracing is off, which traceSpan skips
+    private fun traceStart(): Long = if (tracing) System.nanoTime() else 0L
+    
+    // An end of 0 is taken as now by the native side
+    private fun traceSpan(span: Int, arg: Int, start: Long, end: Long = 0L) {
+        if (start != 0L) {
+            nativeTraceRecord(traceRecorder, span, arg, start, end)
+        }
+    }
+    
+    // MARK: - Warm-up
+    
+    /**
+     * Run dummy frames on scratch state and context (their own bound
+     * tensors), so the handle's are untouched and no events are sent
+     * @return 0 on success, negative error code on failure
+     */
+    fun prewarm(frames: Int): Int {
+        if (ortSession == null) {
+            _lastError = "VAD not initialized"
+            return -2
+        }
+        if (frames <= 0) {
+            _lastError = "frames must be positive"
+            return -1
+        }
+        waitPrewarm()
+        return try {
+            runPrewarm(frames)
+            if (config.isDebug) {
+                Log.d(TAG, "Prewarmed $frames frames: cold $coldFrameUs us, warm $warmFrameUs us per frame")
+            }
+            0
+        } catch (e: Exception) {
+            _lastError = "Warm-up failed: ${e.message}"
+            -2
+        }
+    }
+    
+    /**
+     * Latency seen since initialize, for vad_get_warmup_info:
+     * [prewarm frames, cold us, warm us, first frame us]
+     */
+    fun getWarmupInfo(): FloatArray {
+        waitPrewarm()
+        return floatArrayOf(warmupFrames.toFloat(), coldFrameUs, warmFrameUs, firstFrameUs)
+    }
+    
+    private fun runPrewarm(frames: Int) = BoundInference(ortEnv!!, ortSession!!, config).use { scratch ->
+        val traced = traceStart()
+        val frame = FloatArray(config.frameSamples)
+        val random = java.util.Random(1)
+        var warmTotal = 0.0
+        var warmCount = 0
+        for (f in 0 until frames) {
+            // Low-level noise (about -40 dBFS); any input runs the same kernels
+            for (i in frame.indices) {
+                frame[i] = (random.nextFloat() - 0.5f) * 0.02f
+            }
+            val start = System.nanoTime()
+            scratch.run(frame)
+            val us = (System.nanoTime() - start) / 1000f
+            if (coldFrameUs == 0f) {
+                coldFrameUs = us
+            }
+            if (f >= frames / 2) {
+                warmTotal += us
+                warmCount++
+            }
+        }
+        warmupFrames = frames
+        warmFrameUs = if (warmCount > 0) (warmTotal / warmCount).toFloat() else 0f
+        traceSpan(VADTraceSpan.PREWARM, frames, traced)
+    }
+    
+    // Warm up in the background when the config asks for it
+    private fun startPrewarm() {
+        val frames = config.prewarmFrames
+        if (frames <= 0) return
+        prewarmThread = Thread {
+            try {
+                runPrewarm(frames)
+            } catch (e: Exception) {
+                Log.w(TAG, "Warm-up failed: ${e.message}")
+            }
+        }.apply {
+            name = "VadPlusPrewarmThread"
+            start()
+        }
+    }
+    
+    // Wait for the background warm-up, if it is running
+    private fun waitPrewarm() {
+        prewarmThread?.join()
+        prewarmThread = null
     }
     
     // MARK: - VAD Logic
     
     private fun processVADLogic(frame: FloatArray, probability: Float) {
-        preSpeechBuffer.add(frame.clone())
-        if (preSpeechBuffer.size > config.preSpeechPadFrames) {
-            preSpeechBuffer.removeAt(0)
-        }
+        val frameSamples = config.frameSamples
+        val index = frameIndex++
         
         if (!_isSpeaking) {
             if (probability >= config.positiveSpeechThreshold) {
@@ -449,15 +1069,28 @@ class VADHandleInternal {
                 silenceFrameCount = 0
                 hasEmittedRealStart = false
                 
-                for (preFrame in preSpeechBuffer) {
-                    speechBuffer.addAll(preFrame.toList())
+                // The pad holds the frames before this one, as many as were seen
+                segmentStart = index - minOf(index, config.preSpeechPadFrames.toLong())
+                
+                // Prepend the pre-speech pad, oldest frame first
+                clearSpeech()
+                if (storeSpeech) {
+                    val padFrames = config.preSpeechPadFrames
+                    for (i in 0 until preSpeechCount) {
+                        val slot = (preSpeechNext - preSpeechCount + i + padFrames) % padFrames
+                        appendSpeech(preSpeechRing, slot * frameSamples, frameSamples)
+                    }
+                    appendSpeech(frame, 0, frameSamples)
                 }
-                speechBuffer.addAll(frame.toList())
+                segmentFrames = 1
                 
-                sendEvent(VADEventType.SPEECH_START)
+                sendSegmentEvent(VADEventType.SPEECH_START, segmentStart, 0L)
             }
         } else {
-            speechBuffer.addAll(frame.toList())
+            if (storeSpeech) {
+                appendSpeech(frame, 0, frameSamples)
+            }
+            segmentFrames++
             
             if (probability >= config.positiveSpeechThreshold) {
                 speechFrameCount++
@@ -474,103 +1107,333 @@ class VADHandleInternal {
                     if (speechFrameCount >= config.minSpeechFrames) {
                         emitSpeechEnd()
                     } else {
-                        sendEvent(VADEventType.MISFIRE)
+                        sendSegmentEvent(VADEventType.MISFIRE, segmentStart, frameIndex)
                     }
                     
                     _isSpeaking = false
                     speechFrameCount = 0
                     silenceFrameCount = 0
-                    speechBuffer.clear()
+                    clearSpeech()
                     hasEmittedRealStart = false
                 }
             }
         }
+        
+        // Confirmed speech is streamed as it arrives, starting with the pre-speech pad
+        if (_isSpeaking && hasEmittedRealStart) {
+            streamSpeechChunks(false)
+        }
+        
+        // Only confirmed segments are split; an unconfirmed one runs on until it
+        // is confirmed or ends as a misfire
+        if (_isSpeaking && hasEmittedRealStart && config.maxSpeechFrames > 0 && segmentFrames >= config.maxSpeechFrames) {
+            splitSpeech()
+        }
+        
+        // Remember this frame for the pre-speech pad of a later segment; it is
+        // not part of its own pad, so it is not duplicated in the segment
+        if (config.preSpeechPadFrames > 0 && storeSpeech) {
+            System.arraycopy(frame, 0, preSpeechRing, preSpeechNext * frameSamples, frameSamples)
+            preSpeechNext = (preSpeechNext + 1) % config.preSpeechPadFrames
+            if (preSpeechCount < config.preSpeechPadFrames) {
+                preSpeechCount++
+            }
+        }
     }
     
-    internal fun emitSpeechEnd() {
-        val endPadSamples = config.endSpeechPadFrames * config.frameSamples
-        val totalSamples = speechBuffer.size
-        val keepSamples = maxOf(0, totalSamples - endPadSamples)
-        val finalBuffer = speechBuffer.take(keepSamples + endPadSamples)
-        
-        // Convert to PCM16
-        storedSpeechEndPCM16 = ShortArray(finalBuffer.size) { i ->
-            val clamped = finalBuffer[i].coerceIn(-1.0f, 1.0f)
-            (clamped * 32767).toInt().toShort()
+    private fun appendSpeech(samples: FloatArray, offset: Int, count: Int) {
+        if (speechLength + count > speechPCM16.size) {
+            speechPCM16 = speechPCM16.copyOf(maxOf(speechLength + count, speechPCM16.size * 2, count * 64))
         }
+        for (i in 0 until count) {
+            val clamped = samples[offset + i].coerceIn(-1.0f, 1.0f)
+            speechPCM16[speechLength + i] = (clamped * 32767).toInt().toShort()
+        }
+        speechLength += count
+    }
+    
+    private fun clearSpeech() {
+        speechLength = 0
+        speechStreamed = 0
+        segmentFrames = 0
+    }
+    
+    // Close a segment that reached maxSpeechFrames while speech goes on; the next
+    // frame continues in a new segment that confirms on its own speech frames,
+    // or ends as a misfire. Trailing silence keeps counting towards redemption.
+    private fun splitSpeech() {
+        emitSpeechEnd()
         
-        val durationMs = (finalBuffer.size.toDouble() / config.sampleRate * 1000).toInt()
+        clearSpeech()
+        segmentStart = frameIndex
+        speechFrameCount = 0
+        hasEmittedRealStart = false
+        sendSegmentEvent(VADEventType.SPEECH_START, segmentStart, 0L)
+    }
+    
+    // Send every complete chunk not yet streamed; at the end of the segment also
+    // the remainder (possibly empty), flagged as the last chunk
+    private fun streamSpeechChunks(endOfSegment: Boolean) {
+        val chunk = config.speechChunkSamples
+        if (chunk <= 0) return
         
-        sendSpeechEndEvent(storedSpeechEndPCM16.size, durationMs)
+        while (speechLength - speechStreamed >= chunk) {
+            sendSpeechChunkEvent(speechStreamed, chunk, false)
+            speechStreamed += chunk
+        }
+        if (endOfSegment) {
+            sendSpeechChunkEvent(speechStreamed, speechLength - speechStreamed, true)
+            speechStreamed = speechLength
+        }
+    }
+    
+    // The segment ends with the frame just processed
+    internal fun emitSpeechEnd() {
+        streamSpeechChunks(true)
+        if (!wantsEvent(VADEventType.SPEECH_END)) return
+        
+        val startSample = segmentStart * config.frameSamples
+        val endSample = frameIndex * config.frameSamples
+        val durationMs = ((endSample - startSample).toDouble() / config.sampleRate * 1000).toInt()
+        sendSpeechEndEvent(if (config.speechEndByReference) 0 else speechLength, durationMs, startSample, endSample)
     }
     
     fun forceEndSpeech() {
-        if (_isSpeaking && speechBuffer.isNotEmpty() && speechFrameCount >= config.minSpeechFrames) {
+        // A split on the last frame leaves an open segment with no frames yet
+        if (_isSpeaking && frameIndex > segmentStart && speechFrameCount >= config.minSpeechFrames) {
             emitSpeechEnd()
         }
         
         _isSpeaking = false
         speechFrameCount = 0
         silenceFrameCount = 0
-        speechBuffer.clear()
+        clearSpeech()
         hasEmittedRealStart = false
+        nativeStatusSetSpeaking(statusBlock, false)
     }
     
     // MARK: - Event Sending (Native Callbacks)
     
-    private fun sendEvent(type: Int) {
-        if (!callbackValid.get()) return
-        
+    // Run send under the callback lock if the callback is set; the trace shows
+    // the wait for the lock and the time in send, which invokes the callback
+    private inline fun dispatch(type: Int, send: () -> Unit) {
+        val requested = traceStart()
         callbackLock.withLock {
+            val acquired = if (requested != 0L) System.nanoTime() else 0L
+            traceSpan(VADTraceSpan.CALLBACK_LOCK, type, requested, acquired)
             if (callbackValid.get() && callbackPtr != 0L) {
-                nativeSendEvent(callbackPtr, userDataPtr, type)
+                send()
+                traceSpan(VADTraceSpan.CALLBACK, type, acquired)
             }
         }
     }
     
+    private fun sendEvent(type: Int) {
+        if (!wantsEvent(type)) return
+        
+        dispatch(type) {
+            nativeSendEvent(eventPool, statsRecorder, callbackPtr, userDataPtr, type)
+        }
+    }
+    
+    // SPEECH_START or MISFIRE with the segment's frame range
+    private fun sendSegmentEvent(type: Int, startFrame: Long, endFrame: Long) {
+        if (!wantsEvent(type)) return
+        
+        dispatch(type) {
+            nativeSendSegmentEvent(eventPool, statsRecorder, callbackPtr, userDataPtr, type,
+                startFrame * config.frameSamples, endFrame * config.frameSamples)
+        }
+    }
+    
     private fun sendFrameEvent(probability: Float, isSpeech: Boolean, frame: FloatArray) {
-        if (!callbackValid.get()) return
+        if (!wantsEvent(VADEventType.FRAME_PROCESSED)) return
         
-        callbackLock.withLock {
-            if (callbackValid.get() && callbackPtr != 0L) {
-                nativeSendFrameEvent(callbackPtr, userDataPtr, probability, isSpeech, frame, frame.size)
-            }
+        // Decimation: deliver the first frame, then every frameEventInterval-th
+        if (frameEventCountdown > 0) {
+            frameEventCountdown--
+            return
+        }
+        frameEventCountdown = frameEventInterval - 1
+        
+        dispatch(VADEventType.FRAME_PROCESSED) {
+            nativeSendFrameEvent(eventPool, statsRecorder, callbackPtr, userDataPtr, probability, isSpeech, frame, frame.size)
         }
     }
     
-    private fun sendSpeechEndEvent(audioLength: Int, durationMs: Int) {
+    private fun sendSpeechEndEvent(audioLength: Int, durationMs: Int, startSample: Long, endSample: Long) {
         if (!callbackValid.get()) return
         
-        callbackLock.withLock {
-            if (callbackValid.get() && callbackPtr != 0L) {
-                nativeSendSpeechEndEvent(callbackPtr, userDataPtr, storedSpeechEndPCM16, audioLength, durationMs)
-            }
+        dispatch(VADEventType.SPEECH_END) {
+            nativeSendSpeechEndEvent(eventPool, statsRecorder, callbackPtr, userDataPtr, speechPCM16, audioLength, durationMs,
+                startSample, endSample)
+        }
+    }
+    
+    private fun sendSpeechChunkEvent(offset: Int, length: Int, isLast: Boolean) {
+        if (!wantsEvent(VADEventType.SPEECH_CHUNK)) return
+        
+        dispatch(VADEventType.SPEECH_CHUNK) {
+            nativeSendSpeechChunkEvent(eventPool, statsRecorder, callbackPtr, userDataPtr, speechPCM16, offset, length, isLast)
         }
     }
     
     private fun sendErrorEvent(message: String, code: Int) {
-        if (!callbackValid.get()) return
+        if (!wantsEvent(VADEventType.ERROR)) return
         
-        callbackLock.withLock {
-            if (callbackValid.get() && callbackPtr != 0L) {
-                nativeSendErrorEvent(callbackPtr, userDataPtr, message, code)
-            }
+        dispatch(VADEventType.ERROR) {
+            nativeSendErrorEvent(eventPool, statsRecorder, callbackPtr, userDataPtr, message, code)
         }
     }
     
     companion object {
         private const val TAG = "VadPlusFFI"
+        private const val FRAME_WAIT_NANOS = 5_000_000L
         
         init {
             System.loadLibrary("vad_plus")
         }
         
+        // Native input ring (src/vad_ring.c)
+        @JvmStatic
+        private external fun nativeRingCreate(capacity: Int, maxWindow: Int): Long
+        
+        @JvmStatic
+        private external fun nativeRingDestroy(ring: Long)
+        
+        @JvmStatic
+        private external fun nativeRingReset(ring: Long)
+        
+        @JvmStatic
+        private external fun nativeRingWrite(ring: Long, source: FloatArray, offset: Int, count: Int): Int
+        
+        @JvmStatic
+        private external fun nativeRingWritePcm16(ring: Long, source: ShortArray, count: Int): Int
+        
+        @JvmStatic
+        private external fun nativeRingBuffer(ring: Long): ByteBuffer?
+        
+        @JvmStatic
+        private external fun nativeRingPeek(ring: Long, count: Int): Int
+        
+        @JvmStatic
+        private external fun nativeRingConsume(ring: Long, count: Int)
+        
+        // Native resampler (src/vad_resample.c)
+        @JvmStatic
+        private external fun nativeResamplerCreate(inputRate: Int, outputRate: Int): Long
+        
+        @JvmStatic
+        private external fun nativeResamplerDestroy(resampler: Long)
+        
+        @JvmStatic
+        private external fun nativeResamplerReset(resampler: Long)
+        
+        // Native event pool (src/vad_events.c)
+        @JvmStatic
+        private external fun nativeEventPoolCreate(): Long
+        
+        @JvmStatic
+        private external fun nativeEventPoolClose(pool: Long)
+        
+        // Native status block (src/vad_status.c)
+        @JvmStatic
+        private external fun nativeStatusCreate(): Long
+        
+        @JvmStatic
+        private external fun nativeStatusDestroy(status: Long)
+        
+        @JvmStatic
+        private external fun nativeStatusReset(status: Long)
+        
+        @JvmStatic
+        private external fun nativeStatusPublishFrame(status: Long, probability: Float, isSpeaking: Boolean)
+        
+        @JvmStatic
+        private external fun nativeStatusSetSpeaking(status: Long, isSpeaking: Boolean)
+        
+        // Native stats recorder (src/vad_stats.c)
+        @JvmStatic
+        private external fun nativeStatsCreate(): Long
+        
+        @JvmStatic
+        private external fun nativeStatsDestroy(stats: Long)
+        
+        @JvmStatic
+        private external fun nativeStatsReset(stats: Long)
+        
+        @JvmStatic
+        private external fun nativeStatsRecordFrame(
+            stats: Long,
+            ring: Long,
+            inferenceNs: Long,
+            frameNs: Long,
+            budgetNs: Long,
+            speechBytes: Long,
+            speechCapacityBytes: Long
+        )
+        
+        @JvmStatic
+        private external fun nativeStatsAddDropped(stats: Long, samples: Int)
+        
+        @JvmStatic
+        private external fun nativeStatsRecordGated(stats: Long, ring: Long, speechBytes: Long, speechCapacityBytes: Long)
+        
+        // Native silence gate (src/vad_gate.c)
+        @JvmStatic
+        private external fun nativeGateCreate(): Long
+        
+        @JvmStatic
+        private external fun nativeGateDestroy(gate: Long)
+        
+        @JvmStatic
+        private external fun nativeGateConfigure(gate: Long, holdFrames: Int, thresholdDbfs: Float, noiseMarginDb: Float)
+        
+        @JvmStatic
+        private external fun nativeGateReset(gate: Long)
+        
+        @JvmStatic
+        private external fun nativeGatePush(gate: Long, frame: FloatArray, count: Int): Int
+        
+        // Native timeline trace (src/vad_trace.c)
+        @JvmStatic
+        private external fun nativeTraceCreate(): Long
+        
+        @JvmStatic
+        private external fun nativeTraceDestroy(trace: Long)
+        
+        @JvmStatic
+        private external fun nativeTraceStart(trace: Long, eventsPerThread: Int)
+        
+        @JvmStatic
+        private external fun nativeTraceStop(trace: Long)
+        
+        @JvmStatic
+        private external fun nativeTraceRecord(trace: Long, span: Int, arg: Int, startNs: Long, endNs: Long)
+        
+        // Returns the error message, or null once the file is written
+        @JvmStatic
+        private external fun nativeTraceDump(trace: Long, path: String): String?
+        
         // Native methods for sending events to Dart
         @JvmStatic
-        private external fun nativeSendEvent(callbackPtr: Long, userDataPtr: Long, type: Int)
+        private external fun nativeSendEvent(eventPool: Long, stats: Long, callbackPtr: Long, userDataPtr: Long, type: Int)
+        
+        @JvmStatic
+        private external fun nativeSendSegmentEvent(
+            eventPool: Long,
+            stats: Long,
+            callbackPtr: Long,
+            userDataPtr: Long,
+            type: Int,
+            startSample: Long,
+            endSample: Long
+        )
         
         @JvmStatic
         private external fun nativeSendFrameEvent(
+            eventPool: Long,
+            stats: Long,
             callbackPtr: Long, 
             userDataPtr: Long, 
             probability: Float, 
@@ -581,15 +1444,33 @@ class VADHandleInternal {
         
         @JvmStatic
         private external fun nativeSendSpeechEndEvent(
+            eventPool: Long,
+            stats: Long,
             callbackPtr: Long, 
             userDataPtr: Long, 
             audioData: ShortArray, 
             audioLength: Int, 
-            durationMs: Int
+            durationMs: Int,
+            startSample: Long,
+            endSample: Long
+        )
+        
+        @JvmStatic
+        private external fun nativeSendSpeechChunkEvent(
+            eventPool: Long,
+            stats: Long,
+            callbackPtr: Long,
+            userDataPtr: Long,
+            audioData: ShortArray,
+            offset: Int,
+            audioLength: Int,
+            isLast: Boolean
         )
         
         @JvmStatic
         private external fun nativeSendErrorEvent(
+            eventPool: Long,
+            stats: Long,
             callbackPtr: Long, 
             userDataPtr: Long, 
             message: String, 
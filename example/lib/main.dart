@@ -258,6 +258,10 @@ class _MyAppState extends State<MyApp> {
       case VadStopped():
         _addLog('⏹️ VAD stopped');
         break;
+
+      case VadSpeechChunk():
+        // Only sent when VadConfig.speechChunkSamples is set
+        break;
     }
   }
 
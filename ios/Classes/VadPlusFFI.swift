@@ -1,5 +1,6 @@
 import Foundation
 import AVFoundation
+import CryptoKit
 import onnxruntime_objc
 
 // MARK: - VAD Configuration (matching C struct)
@@ -14,6 +15,15 @@ struct VADConfigInternal {
     var frameSamples: Int32 = 512
     var endSpeechPadFrames: Int32 = 3
     var isDebug: Bool = false
+    var speechChunkSamples: Int32 = 0
+    var maxSpeechFrames: Int32 = 938
+    var speechEndByReference: Bool = false
+    var inputSampleRate: Int32 = 0
+    var preferInt8Model: Bool = false
+    var prewarmFrames: Int32 = 0
+    var silenceGateFrames: Int32 = 0
+    var silenceGateDbfs: Float = -55
+    var silenceGateNoiseMarginDb: Float = 0
     
     var contextSize: Int {
         return sampleRate == 16000 ? 64 : 32
@@ -31,35 +41,277 @@ enum VADEventTypeInternal: Int32 {
     case misfire = 5
     case error = 6
     case stopped = 7
+    case speechChunk = 8
+}
+
+// MARK: - Timeline Trace Spans
+
+/// Pipeline stages matching VADTraceSpan in src/vad_trace.h
+enum VADTraceSpanInternal: Int32 {
+    case capture = 0
+    case processAudio = 1
+    case frame = 2
+    case inference = 3
+    case vadLogic = 4
+    case callbackLock = 5
+    case callback = 6
+    case prewarm = 7
+}
+
+// MARK: - Shared Model Sessions
+
+/// Process-wide ONNX Runtime sessions, one per model. A session is immutable
+/// once created and can run from several threads, so every handle using the
+/// same model shares it and keeps only its own state and context. Sessions are
+/// keyed by the model's content hash (remembered per path, file size and
+/// modification date) and dropped with their last reference.
+final class SharedModelSessions {
+    private final class Entry {
+        let session: ORTSession
+        var refs = 0
+        
+        init(session: ORTSession) {
+            self.session = session
+        }
+    }
+    
+    private struct FileDigest {
+        let size: UInt64
+        let modified: Date
+        let hash: String
+    }
+    
+    static let shared = SharedModelSessions()
+    
+    private let lock = NSLock()
+    private var env: ORTEnv?
+    private var entries: [String: Entry] = [:]
+    private var digests: [String: FileDigest] = [:]
+    
+    /// Get the session for a model file, creating it on first use.
+    /// Returns the session and the key to pass to release(key:).
+    /// - Parameter disableQdq: Keep DequantizeLinear weights out of QDQ fusion (int8 models)
+    func acquire(modelPath: String, disableQdq: Bool, debug: Bool) throws -> (session: ORTSession, key: String) {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        let key = try contentHash(modelPath) + (disableQdq ? ":qdq-off" : "")
+        return try acquire(key: key, disableQdq: disableQdq, debug: debug) { modelPath }
+    }
+    
+    /// Get the session for a serialized model, creating it on first use.
+    /// onnxruntime-objc only creates sessions from files, so a model not seen
+    /// before is written once to the temporary directory, named by its hash.
+    func acquire(modelData: Data, debug: Bool) throws -> (session: ORTSession, key: String) {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        // The data may hold either model; QDQ fusion off is a no-op for fp32
+        let hash = SHA256.hash(data: modelData).map { String(format: "%02x", $0) }.joined()
+        return try acquire(key: hash + ":qdq-off", disableQdq: true, debug: debug) {
+            let url = FileManager.default.temporaryDirectory.appendingPathComponent("vad_plus_\(hash).onnx")
+            let size = (try? FileManager.default.attributesOfItem(atPath: url.path)[.size] as? NSNumber)?.intValue
+            if size != modelData.count {
+                try modelData.write(to: url, options: .atomic)
+            }
+            return url.path
+        }
+    }
+    
+    /// Look up key, or create its session from the model file path() returns. Called with the lock held.
+    private func acquire(key: String, disableQdq: Bool, debug: Bool,
+                         path: () throws -> String) throws -> (session: ORTSession, key: String) {
+        if let entry = entries[key] {
+            entry.refs += 1
+            return (entry.session, key)
+        }
+        let modelPath = try path()
+        
+        if env == nil {
+            env = try ORTEnv(loggingLevel: debug ? .verbose : .error)
+        }
+        let sessionOptions = try ORTSessionOptions()
+        try sessionOptions.setGraphOptimizationLevel(.all)
+        try sessionOptions.setLogSeverityLevel(debug ? .verbose : .error)
+        if disableQdq {
+            try sessionOptions.addConfigEntry(withKey: "session.disable_quant_qdq", value: "1")
+        }
+        let entry = Entry(session: try ORTSession(env: env!, modelPath: modelPath, sessionOptions: sessionOptions))
+        entry.refs = 1
+        entries[key] = entry
+        return (entry.session, key)
+    }
+    
+    /// Drop a reference taken by acquire(); the session is released with the last one
+    func release(key: String) {
+        lock.lock()
+        defer { lock.unlock() }
+        
+        guard let entry = entries[key] else { return }
+        entry.refs -= 1
+        if entry.refs == 0 {
+            entries.removeValue(forKey: key)
+        }
+    }
+    
+    private func contentHash(_ path: String) throws -> String {
+        let attributes = try FileManager.default.attributesOfItem(atPath: path)
+        let size = (attributes[.size] as? NSNumber)?.uint64Value ?? 0
+        let modified = attributes[.modificationDate] as? Date ?? Date.distantPast
+        if let digest = digests[path], digest.size == size, digest.modified == modified {
+            return digest.hash
+        }
+        
+        let data = try Data(contentsOf: URL(fileURLWithPath: path), options: .mappedIfSafe)
+        let hash = SHA256.hash(data: data).map { String(format: "%02x", $0) }.joined()
+        digests[path] = FileDigest(size: size, modified: modified, hash: hash)
+        return hash
+    }
+}
+
+// MARK: - Bound Inference
+
+/// One stream's inference with its I/O tensors bound once. The input tensor
+/// wraps a buffer holding the context followed by the frame, the recurrent
+/// state ping-pongs between two buffers (one bound as input, the other as
+/// preallocated output) and the probability lands in a preallocated output.
+/// A frame is copied straight into the input after the context and the
+/// session runs on prebuilt name dictionaries, so steady state creates no
+/// tensors, buffers or dictionaries.
+final class BoundInference {
+    // v6: single state tensor (2, 1, 128) = 256 floats
+    private static let stateBytes = 2 * 128 * MemoryLayout<Float>.size
+    private static let stateShape: [NSNumber] = [2, 1, 128]
+    
+    private let session: ORTSession
+    private let contextSize: Int
+    private let frameSamples: Int
+    private let input: NSMutableData
+    private let states: [NSMutableData]
+    private let probability: NSMutableData
+    
+    // Indexed by the state buffer currently holding the state
+    private let inputs: [[String: ORTValue]]
+    private let outputs: [[String: ORTValue]]
+    private var current = 0
+    
+    init(session: ORTSession, config: VADConfigInternal) throws {
+        let floatSize = MemoryLayout<Float>.size
+        let contextSize = config.contextSize
+        let frameSamples = Int(config.frameSamples)
+        guard let input = NSMutableData(length: (contextSize + frameSamples) * floatSize),
+              let stateA = NSMutableData(length: Self.stateBytes),
+              let stateB = NSMutableData(length: Self.stateBytes),
+              let probability = NSMutableData(length: floatSize) else {
+            throw NSError(domain: "VadPlus", code: -2,
+                         userInfo: [NSLocalizedDescriptionKey: "Failed to allocate inference buffers"])
+        }
+        var sampleRate = Int64(config.sampleRate)
+        let sampleRateData = NSMutableData(bytes: &sampleRate, length: MemoryLayout<Int64>.size)
+        
+        let inputTensor = try ORTValue(tensorData: input, elementType: .float,
+                                       shape: [1, NSNumber(value: contextSize + frameSamples)])
+        let srTensor = try ORTValue(tensorData: sampleRateData, elementType: .int64, shape: [1])
+        let stateTensors = [
+            try ORTValue(tensorData: stateA, elementType: .float, shape: Self.stateShape),
+            try ORTValue(tensorData: stateB, elementType: .float, shape: Self.stateShape)
+        ]
+        let probabilityTensor = try ORTValue(tensorData: probability, elementType: .float, shape: [1, 1])
+        
+        self.session = session
+        self.contextSize = contextSize
+        self.frameSamples = frameSamples
+        self.input = input
+        self.states = [stateA, stateB]
+        self.probability = probability
+        inputs = (0..<2).map { ["input": inputTensor, "sr": srTensor, "state": stateTensors[$0]] }
+        outputs = (0..<2).map { ["output": probabilityTensor, "stateN": stateTensors[1 - $0]] }
+    }
+    
+    /// Run one frame, advancing the state and context
+    func run(frame: [Float]) throws -> Float {
+        let floatSize = MemoryLayout<Float>.size
+        let bytes = input.mutableBytes
+        frame.withUnsafeBytes { source in
+            (bytes + contextSize * floatSize).copyMemory(from: source.baseAddress!, byteCount: frameSamples * floatSize)
+        }
+        try session.run(withInputs: inputs[current], outputs: outputs[current], runOptions: nil)
+        current = 1 - current
+        
+        // The frame's tail is the next frame's context
+        memmove(bytes, bytes + frameSamples * floatSize, contextSize * floatSize)
+        return probability.bytes.load(as: Float.self)
+    }
+    
+    /// Advance the context past a frame the model does not run on
+    func skip(frame: [Float]) {
+        frame.withUnsafeBytes { source in
+            input.mutableBytes.copyMemory(from: source.baseAddress! + (frameSamples - contextSize) * MemoryLayout<Float>.size,
+                                          byteCount: contextSize * MemoryLayout<Float>.size)
+        }
+    }
+    
+    /// Clear the recurrent state, keeping the context
+    func clearState() {
+        states[current].resetBytes(in: NSRange(location: 0, length: Self.stateBytes))
+    }
+    
+    /// Clear the state and context
+    func reset() {
+        clearState()
+        input.resetBytes(in: NSRange(location: 0, length: contextSize * MemoryLayout<Float>.size))
+    }
 }
 
 // MARK: - VAD Handle Class
 
 class VADHandleInternal {
+    // Shared with other handles using the same model (SharedModelSessions)
     var ortSession: ORTSession?
-    var ortEnv: ORTEnv?
+    var sessionKey: String?
     
     var config = VADConfigInternal()
     
-    // VAD state for v6 model (2 * 1 * 128 = 256 floats)
-    var state: [Float] = []
-    let hiddenSize = 128
-    let numLayers = 2
-    
-    // Context buffer for v6
-    var contextBuffer: [Float] = []
+    // Model state and context, with the I/O tensors bound to the session
+    private var inference: BoundInference?
     
     // Speech detection state
     var isSpeaking = false
     var speechFrameCount = 0
     var silenceFrameCount = 0
-    var speechBuffer: [Float] = []
-    var preSpeechBuffer: [[Float]] = []
     var hasEmittedRealStart = false
     
+    // Speech segment as PCM16, converted frame by frame. Allocated once in
+    // initialize for preSpeechPadFrames + maxSpeechFrames frames; only grown
+    // when maxSpeechFrames is 0 (unbounded)
+    var speechPCM16: [Int16] = []
+    var speechLength = 0
+    // Frames of the segment after its pre-speech pad, bounded by maxSpeechFrames
+    var segmentFrames = 0
+    // Samples of the current segment already sent as speech chunk events
+    var speechStreamed = 0
+    // No event carries segment audio (speechEndByReference without chunks),
+    // so neither the segment nor its pad is stored
+    var storeSpeech = true
+    
+    // Frames processed since the last reset, and the first frame of the open
+    // segment (pre-speech pad included); events report both in samples
+    var frameIndex: Int64 = 0
+    var segmentStart: Int64 = 0
+    
+    // Pre-speech pad: ring of the last preSpeechPadFrames frames
+    var preSpeechRing: [Float] = []
+    var preSpeechCount = 0
+    var preSpeechNext = 0
+    
     // Audio buffer for accumulating samples
     var audioBuffer: [Float] = []
     
+    // Resampler (src/vad_resample.c) for vad_process_audio input at
+    // inputSampleRate, nil when input is at sampleRate
+    private var inputResampler: OpaquePointer?
+    private let resampledBlock = UnsafeMutablePointer<Float>.allocate(capacity: vadResamplerBlock)
+    
     // Audio engine for microphone capture
     var audioEngine: AVAudioEngine?
     var audioConverter: AVAudioConverter?
@@ -116,28 +368,67 @@ class VADHandleInternal {
         }
     }
     
+    // Native event pool; events outlive this handle until Dart releases them
+    private var eventPool: OpaquePointer? = vad_event_pool_create(vadEventPoolSlots, vadEventInlineBytes)
+    
+    // Native status block polled by Dart without FFI calls (vad_get_status_block)
+    let statusBlock: OpaquePointer? = vad_status_create()
+    
+    // Native stats recorder behind vad_get_stats; a frame taking longer than
+    // frameBudgetNs, the audio it holds, counts as late
+    private let statsRecorder: OpaquePointer? = vad_stats_create()
+    private var frameBudgetNs: UInt64 = 0
+    
+    // Native timeline trace behind vad_trace_start; spans are timed with
+    // vad_tracer_now, which is 0 while tracing is off
+    private let traceRecorder: OpaquePointer? = vad_tracer_create()
+    
+    // Native silence gate (VADConfigInternal.silenceGateFrames) deciding
+    // which frames reach the model
+    private let gate: OpaquePointer? = vad_gate_create()
+    
+    // Event subscription (vad_set_event_mask / vad_set_frame_event_interval),
+    // checked before any event data is copied; a stale read affects one frame at most
+    var eventMask: UInt32 = 0xFFFF_FFFF
+    var frameEventInterval: Int32 = 1
+    private var frameEventCountdown: Int32 = 0
+    
+    // Warm-up (prewarm, VADConfigInternal.prewarmFrames): latency in
+    // microseconds. The first real frame after initialize is timed, and
+    // first waits for a background warm-up.
+    private var prewarmGroup: DispatchGroup?
+    private(set) var warmupFrames: Int32 = 0
+    private(set) var coldFrameUs: Float = 0
+    private(set) var warmFrameUs: Float = 0
+    private(set) var firstFrameUs: Float = 0
+    private var firstFramePending = false
+    
     // Last error
     var lastError: String = ""
     
-    // Stored speech end data (for callback)
-    var storedSpeechEndPCM16: [Int16] = []
-    
     init() {
         resetStates()
     }
     
     func resetStates() {
-        // v6: single state tensor (2, 1, 128) = 256 floats
-        state = [Float](repeating: 0, count: numLayers * hiddenSize)
-        contextBuffer = [Float](repeating: 0, count: config.contextSize)
+        inference?.reset()
         
         isSpeaking = false
         speechFrameCount = 0
         silenceFrameCount = 0
-        speechBuffer = []
-        preSpeechBuffer = []
+        clearSpeech()
+        preSpeechCount = 0
+        preSpeechNext = 0
+        frameIndex = 0
+        segmentStart = 0
         hasEmittedRealStart = false
+        frameEventCountdown = 0
         audioBuffer = []
+        vad_resampler_reset(inputResampler)
+        vad_status_reset(statusBlock)
+        vad_stats_reset(statsRecorder)
+        vad_gate_reset(gate)
+        publishSpeechStats()
     }
     
     deinit {
@@ -149,44 +440,89 @@ class VADHandleInternal {
         audioConverter = nil
         outputFormat = nil
         isAudioSessionConfigured = false
-        ortSession = nil
-        ortEnv = nil
+        releaseSession()
+        vad_event_pool_close(eventPool)
+        vad_status_destroy(statusBlock)
+        vad_stats_destroy(statsRecorder)
+        vad_tracer_destroy(traceRecorder)
+        vad_gate_destroy(gate)
+        vad_resampler_destroy(inputResampler)
+        resampledBlock.deallocate()
     }
     
     // MARK: - Model Loading
     
-    func initialize(config: VADConfigInternal, modelPath: String?) throws {
-        self.config = config
-        resetStates()
-        
-        // Initialize ONNX Runtime
-        ortEnv = try ORTEnv(loggingLevel: config.isDebug ? .verbose : .error)
+    /// Apply the configuration and allocate the per-handle buffers and resampler
+    private func prepare(config: VADConfigInternal) throws {
+        // The warm-up runs on the session about to be released
+        waitPrewarm()
+        warmupFrames = 0
+        coldFrameUs = 0
+        warmFrameUs = 0
+        firstFrameUs = 0
+        firstFramePending = true
         
-        // Find model path
-        let finalModelPath: String
-        if let path = modelPath, !path.isEmpty {
-            finalModelPath = path
-        } else if let bundledPath = findBundledModel() {
-            finalModelPath = bundledPath
-        } else {
+        if config.maxSpeechFrames != 0 && config.maxSpeechFrames < config.minSpeechFrames {
             throw NSError(domain: "VadPlus", code: -1,
-                         userInfo: [NSLocalizedDescriptionKey: "ONNX model not found"])
+                         userInfo: [NSLocalizedDescriptionKey: "maxSpeechFrames must be 0 or at least minSpeechFrames"])
         }
         
-        let sessionOptions = try ORTSessionOptions()
-        try sessionOptions.setGraphOptimizationLevel(.all)
-        try sessionOptions.setLogSeverityLevel(config.isDebug ? .verbose : .error)
+        self.config = config
+        frameBudgetNs = UInt64(config.frameSamples) * 1_000_000_000 / UInt64(config.sampleRate)
+        vad_gate_configure(gate, config.silenceGateFrames, config.silenceGateDbfs, config.silenceGateNoiseMarginDb)
+        storeSpeech = !config.speechEndByReference || config.speechChunkSamples > 0
+        let boundedFrames = storeSpeech && config.maxSpeechFrames > 0 ? Int(config.preSpeechPadFrames + config.maxSpeechFrames) : 0
+        speechPCM16 = [Int16](repeating: 0, count: boundedFrames * Int(config.frameSamples))
+        let padFrames = storeSpeech ? max(0, Int(config.preSpeechPadFrames)) : 0
+        preSpeechRing = [Float](repeating: 0, count: padFrames * Int(config.frameSamples))
+        vad_resampler_destroy(inputResampler)
+        inputResampler = nil
+        if config.inputSampleRate != 0 && config.inputSampleRate != config.sampleRate {
+            inputResampler = vad_resampler_create(config.inputSampleRate, config.sampleRate)
+            if inputResampler == nil {
+                throw NSError(domain: "VadPlus", code: -1,
+                             userInfo: [NSLocalizedDescriptionKey: "Unsupported input sample rate \(config.inputSampleRate)"])
+            }
+        }
+        resetStates()
+    }
+    
+    func initialize(config: VADConfigInternal, modelPath: String?) throws {
+        try prepare(config: config)
+        releaseSession()
         
-        ortSession = try ORTSession(env: ortEnv!, modelPath: finalModelPath, sessionOptions: sessionOptions)
+        // Prefer the bundled int8 model when asked, falling back to fp32
+        var session: (session: ORTSession, key: String)? = nil
+        if config.preferInt8Model, modelPath?.isEmpty ?? true {
+            session = loadInt8Model()
+        }
         
-        if config.isDebug {
-            print("VadPlus: Model loaded from \(finalModelPath)")
+        if session == nil {
+            // Find model path
+            let finalModelPath: String
+            if let path = modelPath, !path.isEmpty {
+                finalModelPath = path
+            } else if let bundledPath = findBundledModel() {
+                finalModelPath = bundledPath
+            } else {
+                throw NSError(domain: "VadPlus", code: -1,
+                             userInfo: [NSLocalizedDescriptionKey: "ONNX model not found"])
+            }
+            
+            session = try SharedModelSessions.shared.acquire(modelPath: finalModelPath, disableQdq: false,
+                                                             debug: config.isDebug)
+            
+            if config.isDebug {
+                print("VadPlus: Model loaded from \(finalModelPath)")
+            }
         }
+        ortSession = session?.session
+        sessionKey = session?.key
         
         // Pre-configure audio session and engine for faster startup
         try preconfigureAudio()
         
-        sendEvent(type: .initialized)
+        try finishInitialize()
     }
     
     /// Pre-configures audio session and engine during initialization for faster start
@@ -240,9 +576,66 @@ class VADHandleInternal {
         }
     }
     
-    private func findBundledModel() -> String? {
-        let modelNames = ["silero_vad_v6", "silero_vad"]
+    /// Initialize from a serialized model instead of a file. The data is
+    /// borrowed from the caller and not used after this returns.
+    func initialize(config: VADConfigInternal, modelData: Data) throws {
+        try prepare(config: config)
+        releaseSession()
         
+        let session = try SharedModelSessions.shared.acquire(modelData: modelData, debug: config.isDebug)
+        ortSession = session.session
+        sessionKey = session.key
+        if config.isDebug {
+            print("VadPlus: Model loaded from memory (\(modelData.count) bytes)")
+        }
+        
+        // Pre-configure audio session and engine for faster startup
+        try preconfigureAudio()
+        
+        try finishInitialize()
+    }
+    
+    /// Load the bundled int8 model, if any. Its weights are DequantizeLinear
+    /// constants; with QDQ fusion off ONNX Runtime folds them back to fp32 when
+    /// the session is created, so inference runs the same kernels as fp32.
+    /// Returns nil when the model is missing or fails to load.
+    private func loadInt8Model() -> (session: ORTSession, key: String)? {
+        guard let path = findBundledModel(modelNames: ["silero_vad_v6_int8"]) else { return nil }
+        do {
+            let session = try SharedModelSessions.shared.acquire(modelPath: path, disableQdq: true,
+                                                                 debug: config.isDebug)
+            if config.isDebug {
+                print("VadPlus: Int8 model loaded from \(path)")
+            }
+            return session
+        } catch {
+            if config.isDebug {
+                print("VadPlus: Int8 model not usable (\(error.localizedDescription)), falling back to fp32")
+            }
+            return nil
+        }
+    }
+    
+    /// Bind this handle's inference tensors to its new session, start the
+    /// warm-up and report the handle ready
+    private func finishInitialize() throws {
+        guard let session = ortSession else { return }
+        inference = try BoundInference(session: session, config: config)
+        startPrewarm()
+        sendEvent(type: .initialized)
+    }
+    
+    /// Drop this handle's reference to its shared session
+    private func releaseSession() {
+        inference = nil
+        if let key = sessionKey {
+            SharedModelSessions.shared.release(key: key)
+        }
+        ortSession = nil
+        sessionKey = nil
+    }
+    
+    private func findBundledModel(modelNames: [String] = ["silero_vad_v6", "silero_vad"]) -> String? {
         // Try main bundle
         for name in modelNames {
             if let path = Bundle.main.path(forResource: name, ofType: "onnx") {
@@ -409,6 +802,7 @@ class VADHandleInternal {
             // This prevents crashes during hot reload when the Dart callback has been deleted
             guard self.callback != nil else { return }
             
+            let traced = vad_tracer_now(self.traceRecorder)
             var floatData: [Float]
             
             if let converter = converter {
@@ -429,6 +823,7 @@ class VADHandleInternal {
                 floatData = self.bufferToFloatArray(buffer)
             }
             
+            self.traceSpan(.capture, Int32(floatData.count), traced)
             self.processAudioData(floatData)
         }
         
@@ -482,16 +877,75 @@ class VADHandleInternal {
             audioBuffer.removeFirst(Int(config.frameSamples))
             processFrame(frame)
         }
+        vad_stats_set_queued(statsRecorder, Int32(audioBuffer.count))
+    }
+    
+    // Caller-fed audio (vad_process_audio), at inputSampleRate when set
+    func processInputAudio(_ samples: UnsafePointer<Float>, _ sampleCount: Int32) {
+        let traced = vad_tracer_now(traceRecorder)
+        defer { traceSpan(.processAudio, sampleCount, traced) }
+        guard let resampler = inputResampler else {
+            processAudioData(Array(UnsafeBufferPointer(start: samples, count: Int(sampleCount))))
+            return
+        }
+        
+        var input = samples
+        var remaining = sampleCount
+        while true {
+            var used: Int32 = 0
+            let produced = vad_resampler_process(resampler, input, remaining, &used, resampledBlock, Int32(vadResamplerBlock))
+            input += Int(used)
+            remaining -= used
+            processAudioData(Array(UnsafeBufferPointer(start: resampledBlock, count: Int(produced))))
+            if produced < Int32(vadResamplerBlock) {
+                break
+            }
+        }
     }
     
     private func processFrame(_ frame: [Float]) {
         do {
-            let probability = try runInference(frame: frame)
+            guard let bound = inference else {
+                throw NSError(domain: "VadPlus", code: -5,
+                             userInfo: [NSLocalizedDescriptionKey: "ONNX session not initialized"])
+            }
+            if firstFramePending {
+                waitPrewarm()
+            }
+            let traced = vad_tracer_now(traceRecorder)
+            let index = Int32(truncatingIfNeeded: frameIndex)
+            let decision = frame.withUnsafeBufferPointer { vad_gate_push(gate, $0.baseAddress, Int32($0.count)) }
+            if decision == vadGateSkip {
+                processGatedFrame(bound, frame, index, traced)
+                return
+            }
+            // After a gap the LSTM state of the last inferred frame is
+            // stale; restart it as the C engine does (vad_plus.c)
+            if decision == vadGateResume {
+                bound.clearState()
+            }
+            let start = DispatchTime.now().uptimeNanoseconds
+            let probability = try bound.run(frame: frame)
+            let inferenceNs = DispatchTime.now().uptimeNanoseconds - start
+            traceSpan(.inference, index, traced)
+            if firstFramePending {
+                firstFrameUs = Float(inferenceNs) / 1000
+                if coldFrameUs == 0 {
+                    coldFrameUs = firstFrameUs
+                }
+                firstFramePending = false
+            }
             
             // Send frame processed event
             sendFrameEvent(probability: probability, isSpeech: probability >= config.positiveSpeechThreshold, frame: frame)
             
+            let logicStart = vad_tracer_now(traceRecorder)
             processVADLogic(frame: frame, probability: probability)
+            vad_status_publish_frame(statusBlock, probability, isSpeaking ? 1 : 0)
+            publishSpeechStats()
+            traceSpan(.vadLogic, index, logicStart)
+            vad_stats_record_frame(statsRecorder, inferenceNs, DispatchTime.now().uptimeNanoseconds - start, frameBudgetNs)
+            traceSpan(.frame, index, traced)
             
         } catch {
             lastError = error.localizedDescription
@@ -499,72 +953,136 @@ class VADHandleInternal {
         }
     }
     
-    // MARK: - ONNX Inference (v6)
+    /// A frame kept from the model by the silence gate: probability 0
+    private func processGatedFrame(_ bound: BoundInference, _ frame: [Float], _ index: Int32, _ traced: UInt64) {
+        bound.skip(frame: frame)
+        vad_stats_add_gated(statsRecorder)
+        sendFrameEvent(probability: 0, isSpeech: false, frame: frame)
+        processVADLogic(frame: frame, probability: 0)
+        vad_status_publish_frame(statusBlock, 0, isSpeaking ? 1 : 0)
+        publishSpeechStats()
+        traceSpan(.frame, index, traced)
+    }
+    
+    /// Publish the speech storage in use and allocated to the stats recorder
+    private func publishSpeechStats() {
+        vad_stats_set_speech(statsRecorder, Int64(speechLength * 2),
+                             Int64(speechPCM16.count * 2 + preSpeechRing.count * 4))
+    }
+    
+    /// Fill a VADStats from the stats recorder and the event pool
+    func readStats(_ statsOut: UnsafeMutableRawPointer) {
+        vad_stats_read(statsRecorder, eventPool, statsOut)
+    }
+    
+    // MARK: - Timeline Trace
     
-    private func runInference(frame: [Float]) throws -> Float {
-        guard let session = ortSession else {
-            throw NSError(domain: "VadPlus", code: -5,
-                         userInfo: [NSLocalizedDescriptionKey: "ONNX session not initialized"])
+    func startTrace(eventsPerThread: Int32) {
+        vad_tracer_start(traceRecorder, eventsPerThread)
+    }
+    
+    func stopTrace() {
+        vad_tracer_stop(traceRecorder)
+    }
+    
+    /// Write the recorded spans as Chrome trace-event JSON
+    func dumpTrace(path: String) throws {
+        var error = [CChar](repeating: 0, count: 512)
+        let result = error.withUnsafeMutableBufferPointer {
+            vad_tracer_write_json(traceRecorder, path, $0.baseAddress, $0.count)
         }
-        
-        // Prepare input with context - shape [1, frameSamples + contextSize]
-        var inputWithContext = contextBuffer + frame
-        let inputSize = Int(config.frameSamples) + config.contextSize
-        let inputShape: [NSNumber] = [1, NSNumber(value: inputSize)]
-        let inputData = NSMutableData(bytes: &inputWithContext, length: inputWithContext.count * MemoryLayout<Float>.size)
-        let inputTensor = try ORTValue(tensorData: inputData, elementType: .float, shape: inputShape)
-        
-        // Prepare sample rate tensor - shape [1]
-        var sampleRateValue = Int64(config.sampleRate)
-        let srData = NSMutableData(bytes: &sampleRateValue, length: MemoryLayout<Int64>.size)
-        let srTensor = try ORTValue(tensorData: srData, elementType: .int64, shape: [1])
-        
-        // Prepare state tensor - shape [2, 1, 128]
-        let stateData = NSMutableData(bytes: state, length: state.count * MemoryLayout<Float>.size)
-        let stateTensor = try ORTValue(tensorData: stateData, elementType: .float,
-                                        shape: [NSNumber(value: numLayers), 1, NSNumber(value: hiddenSize)])
-        
-        let inputs: [String: ORTValue] = [
-            "input": inputTensor,
-            "sr": srTensor,
-            "state": stateTensor
-        ]
-        
-        let outputs = try session.run(
-            withInputs: inputs,
-            outputNames: Set(["output", "stateN"]),
-            runOptions: nil
-        )
-        
-        guard let outputTensor = outputs["output"],
-              let outputData = try outputTensor.tensorData() as? NSData else {
-            throw NSError(domain: "VadPlus", code: -6,
-                         userInfo: [NSLocalizedDescriptionKey: "Failed to get output tensor"])
+        if result != 0 {
+            let message = error.withUnsafeBufferPointer { String(cString: $0.baseAddress!) }
+            throw NSError(domain: "VadPlus", code: -1, userInfo: [NSLocalizedDescriptionKey: message])
         }
-        
-        var probability: Float = 0
-        outputData.getBytes(&probability, length: MemoryLayout<Float>.size)
-        
-        // Update state
-        if let stateOutput = outputs["stateN"],
-           let stateOutputData = try stateOutput.tensorData() as? NSData {
-            stateOutputData.getBytes(&state, length: state.count * MemoryLayout<Float>.size)
+    }
+    
+    /// Close a span opened with vad_tracer_now(); nothing while tracing is off
+    private func traceSpan(_ span: VADTraceSpanInternal, _ arg: Int32, _ start: UInt64) {
+        if start != 0 {
+            vad_tracer_record(traceRecorder, span.rawValue, arg, start, 0)
         }
-        
-        // Update context buffer
-        let startIndex = inputWithContext.count - config.contextSize
-        contextBuffer = Array(inputWithContext[startIndex...])
-        
-        return probability
+    }
+    
+    // MARK: - Warm-up
+    
+    /// Run dummy frames on scratch state and context (their own bound
+    /// tensors), so the handle's are untouched and no events are sent
+    func prewarm(frames: Int32) throws {
+        guard ortSession != nil else {
+            throw NSError(domain: "VadPlus", code: -2,
+                         userInfo: [NSLocalizedDescriptionKey: "VAD not initialized"])
+        }
+        guard frames > 0 else {
+            throw NSError(domain: "VadPlus", code: -1,
+                         userInfo: [NSLocalizedDescriptionKey: "frames must be positive"])
+        }
+        waitPrewarm()
+        try runPrewarm(frames: frames)
+        if config.isDebug {
+            print("VadPlus: Prewarmed \(frames) frames: cold \(coldFrameUs) us, warm \(warmFrameUs) us per frame")
+        }
+    }
+    
+    private func runPrewarm(frames: Int32) throws {
+        guard let session = ortSession else { return }
+        let traced = vad_tracer_now(traceRecorder)
+        defer { traceSpan(.prewarm, frames, traced) }
+        let scratch = try BoundInference(session: session, config: config)
+        var frame = [Float](repeating: 0, count: Int(config.frameSamples))
+        var seed: UInt32 = 1
+        var warmTotal = 0.0
+        var warmCount = 0
+        for f in 0..<frames {
+            // Low-level noise (about -40 dBFS); any input runs the same kernels
+            for i in frame.indices {
+                seed = seed &* 1664525 &+ 1013904223
+                frame[i] = (Float(seed >> 8) / 16777216 - 0.5) * 0.02
+            }
+            let start = DispatchTime.now().uptimeNanoseconds
+            _ = try scratch.run(frame: frame)
+            let us = Float(DispatchTime.now().uptimeNanoseconds - start) / 1000
+            if coldFrameUs == 0 {
+                coldFrameUs = us
+            }
+            if f >= frames / 2 {
+                warmTotal += Double(us)
+                warmCount += 1
+            }
+        }
+        warmupFrames = frames
+        warmFrameUs = warmCount > 0 ? Float(warmTotal / Double(warmCount)) : 0
+    }
+    
+    /// Warm up in the background when the config asks for it
+    private func startPrewarm() {
+        let frames = config.prewarmFrames
+        guard frames > 0 else { return }
+        let group = DispatchGroup()
+        prewarmGroup = group
+        DispatchQueue.global(qos: .userInitiated).async(group: group) {
+            do {
+                try self.runPrewarm(frames: frames)
+            } catch {
+                if self.config.isDebug {
+                    print("VadPlus: Warm-up failed: \(error.localizedDescription)")
+                }
+            }
+        }
+    }
+    
+    /// Wait for the background warm-up, if it is running
+    func waitPrewarm() {
+        prewarmGroup?.wait()
+        prewarmGroup = nil
     }
     
     // MARK: - VAD Logic
     
     private func processVADLogic(frame: [Float], probability: Float) {
-        preSpeechBuffer.append(frame)
-        if preSpeechBuffer.count > Int(config.preSpeechPadFrames) {
-            preSpeechBuffer.removeFirst()
-        }
+        let frameSamples = Int(config.frameSamples)
+        let index = frameIndex
+        frameIndex += 1
         
         if !isSpeaking {
             if probability >= config.positiveSpeechThreshold {
@@ -573,15 +1091,30 @@ class VADHandleInternal {
                 silenceFrameCount = 0
                 hasEmittedRealStart = false
                 
-                for preFrame in preSpeechBuffer {
-                    speechBuffer.append(contentsOf: preFrame)
+                // The pad holds the frames before this one, as many as were seen
+                segmentStart = index - min(index, Int64(config.preSpeechPadFrames))
+                
+                // Prepend the pre-speech pad, oldest frame first
+                clearSpeech()
+                if storeSpeech {
+                    let padFrames = Int(config.preSpeechPadFrames)
+                    for i in 0..<preSpeechCount {
+                        let slot = (preSpeechNext - preSpeechCount + i + padFrames) % padFrames
+                        preSpeechRing.withUnsafeBufferPointer {
+                            appendSpeech($0.baseAddress! + slot * frameSamples, count: frameSamples)
+                        }
+                    }
+                    frame.withUnsafeBufferPointer { appendSpeech($0.baseAddress!, count: frameSamples) }
                 }
-                speechBuffer.append(contentsOf: frame)
+                segmentFrames = 1
                 
-                sendEvent(type: .speechStart)
+                sendSegmentEvent(type: .speechStart, startFrame: segmentStart, endFrame: 0)
             }
         } else {
-            speechBuffer.append(contentsOf: frame)
+            if storeSpeech {
+                frame.withUnsafeBufferPointer { appendSpeech($0.baseAddress!, count: frameSamples) }
+            }
+            segmentFrames += 1
             
             if probability >= config.positiveSpeechThreshold {
                 speechFrameCount += 1
@@ -598,178 +1131,401 @@ class VADHandleInternal {
                     if speechFrameCount >= Int(config.minSpeechFrames) {
                         emitSpeechEnd()
                     } else {
-                        sendEvent(type: .misfire)
+                        sendSegmentEvent(type: .misfire, startFrame: segmentStart, endFrame: frameIndex)
                     }
                     
                     isSpeaking = false
                     speechFrameCount = 0
                     silenceFrameCount = 0
-                    speechBuffer = []
+                    clearSpeech()
                     hasEmittedRealStart = false
                 }
             }
         }
+        
+        // Confirmed speech is streamed as it arrives, starting with the pre-speech pad
+        if isSpeaking && hasEmittedRealStart {
+            streamSpeechChunks(endOfSegment: false)
+        }
+        
+        // Only confirmed segments are split; an unconfirmed one runs on until it
+        // is confirmed or ends as a misfire
+        if isSpeaking && hasEmittedRealStart && config.maxSpeechFrames > 0 && segmentFrames >= Int(config.maxSpeechFrames) {
+            splitSpeech()
+        }
+        
+        // Remember this frame for the pre-speech pad of a later segment; it is
+        // not part of its own pad, so it is not duplicated in the segment
+        let padFrames = Int(config.preSpeechPadFrames)
+        if padFrames > 0 && storeSpeech {
+            preSpeechRing.withUnsafeMutableBufferPointer { ring in
+                frame.withUnsafeBufferPointer { src in
+                    (ring.baseAddress! + preSpeechNext * frameSamples).update(from: src.baseAddress!, count: frameSamples)
+                }
+            }
+            preSpeechNext = (preSpeechNext + 1) % padFrames
+            preSpeechCount = min(preSpeechCount + 1, padFrames)
+        }
     }
     
-    // fileprivate to allow access from vad_force_end_speech FFI function
-    fileprivate func emitSpeechEnd() {
-        let endPadSamples = Int(config.endSpeechPadFrames) * Int(config.frameSamples)
-        let totalSamples = speechBuffer.count
-        let keepSamples = max(0, totalSamples - endPadSamples)
-        let finalBuffer = Array(speechBuffer.prefix(keepSamples + endPadSamples))
-        
-        // Convert to PCM16
-        storedSpeechEndPCM16 = finalBuffer.map { sample in
-            let clamped = max(-1.0, min(1.0, sample))
-            return Int16(clamped * 32767)
+    private func appendSpeech(_ samples: UnsafePointer<Float>, count: Int) {
+        if speechLength + count > speechPCM16.count {
+            let capacity = max(speechLength + count, speechPCM16.count * 2, count * 64)
+            speechPCM16.append(contentsOf: repeatElement(0, count: capacity - speechPCM16.count))
+        }
+        speechPCM16.withUnsafeMutableBufferPointer {
+            vad_float_to_pcm16(samples, $0.baseAddress! + speechLength, Int32(count))
         }
+        speechLength += count
+    }
+    
+    fileprivate func clearSpeech() {
+        speechLength = 0
+        speechStreamed = 0
+        segmentFrames = 0
+    }
+    
+    /// Closes a segment that reached maxSpeechFrames while speech goes on; the next
+    /// frame continues in a new segment that confirms on its own speech frames,
+    /// or ends as a misfire. Trailing silence keeps counting towards redemption.
+    private func splitSpeech() {
+        emitSpeechEnd()
         
-        let durationMs = Int32(Double(finalBuffer.count) / Double(config.sampleRate) * 1000)
+        clearSpeech()
+        segmentStart = frameIndex
+        speechFrameCount = 0
+        hasEmittedRealStart = false
+        sendSegmentEvent(type: .speechStart, startFrame: segmentStart, endFrame: 0)
+    }
+    
+    /// Sends every complete chunk not yet streamed; at the end of the segment also
+    /// the remainder (possibly empty), flagged as the last chunk
+    private func streamSpeechChunks(endOfSegment: Bool) {
+        let chunk = Int(config.speechChunkSamples)
+        guard chunk > 0 else { return }
         
-        sendSpeechEndEvent(audioLength: Int32(storedSpeechEndPCM16.count), durationMs: durationMs)
+        while speechLength - speechStreamed >= chunk {
+            sendSpeechChunkEvent(offset: speechStreamed, length: chunk, isLast: false)
+            speechStreamed += chunk
+        }
+        if endOfSegment {
+            sendSpeechChunkEvent(offset: speechStreamed, length: speechLength - speechStreamed, isLast: true)
+            speechStreamed = speechLength
+        }
+    }
+    
+    // The segment ends with the frame just processed; fileprivate to allow
+    // access from vad_force_end_speech FFI function
+    fileprivate func emitSpeechEnd() {
+        streamSpeechChunks(endOfSegment: true)
+        guard wantsEvent(.speechEnd) else { return }
+        
+        let startSample = segmentStart * Int64(config.frameSamples)
+        let endSample = frameIndex * Int64(config.frameSamples)
+        let durationMs = Int32(Double(endSample - startSample) / Double(config.sampleRate) * 1000)
+        sendSpeechEndEvent(
+            audioLength: config.speechEndByReference ? 0 : Int32(speechLength),
+            durationMs: durationMs,
+            startSample: startSample,
+            endSample: endSample
+        )
     }
     
     // MARK: - Event Sending
     
-    private func sendEvent(type: VADEventTypeInternal) {
-        // Allocate event on the heap since NativeCallable.listener processes
-        // the callback asynchronously on the Dart event loop
-        let eventPtr = UnsafeMutablePointer<VADEventCStruct>.allocate(capacity: 1)
-        eventPtr.initialize(to: VADEventCStruct())
-        eventPtr.pointee.type = type.rawValue
-        
+    // Events come from the native pool (src/vad_events.c) because
+    // NativeCallable.listener reads them asynchronously; Dart hands each one
+    // back with vad_event_release once it has copied the data.
+    
+    /// Delivers a pooled event, or returns it to the pool if the callback is gone
+    private func deliver(_ event: UnsafeMutablePointer<VADEventCStruct>) {
         // Safely invoke callback within serial queue to prevent race conditions
         // CRITICAL: The callback invocation MUST happen within the sync block
         // so that invalidateCallback() will wait for it to complete
         var didInvoke = false
+        let type = event.pointee.type
+        let requested = vad_tracer_now(traceRecorder)
         callbackQueue.sync {
+            traceSpan(.callbackLock, type, requested)
             guard _callbackValid, let cb = _callback else { return }
             let ud = _userData
-            cb(UnsafeRawPointer(eventPtr), ud)
+            let traced = vad_tracer_now(traceRecorder)
+            let start = DispatchTime.now().uptimeNanoseconds
+            cb(UnsafeRawPointer(event), ud)
+            vad_stats_record_callback(statsRecorder, DispatchTime.now().uptimeNanoseconds - start)
+            traceSpan(.callback, type, traced)
             didInvoke = true
         }
         
-        if didInvoke {
-            // Schedule cleanup after Dart has processed the event
-            DispatchQueue.main.asyncAfter(deadline: .now() + 0.5) {
-                eventPtr.deinitialize(count: 1)
-                eventPtr.deallocate()
-            }
-        } else {
-            // Callback was invalidated, clean up immediately
-            eventPtr.deinitialize(count: 1)
-            eventPtr.deallocate()
+        if !didInvoke {
+            // Callback was invalidated, release immediately
+            vad_event_pool_release(UnsafeRawPointer(event))
         }
     }
     
-    private func sendFrameEvent(probability: Float, isSpeech: Bool, frame: [Float]) {
-        // Allocate frame data copy that persists until Dart processes the callback
-        let frameCopy = UnsafeMutablePointer<Float>.allocate(capacity: frame.count)
-        for (i, sample) in frame.enumerated() {
-            frameCopy[i] = sample
+    /// Takes a zeroed event with payloadBytes of payload storage from the pool
+    private func acquireEvent(
+        type: VADEventTypeInternal,
+        payloadBytes: Int
+    ) -> (UnsafeMutablePointer<VADEventCStruct>, UnsafeMutableRawPointer?)? {
+        var payload: UnsafeMutableRawPointer? = nil
+        guard let raw = vad_event_pool_acquire(eventPool, type.rawValue, payloadBytes, &payload) else {
+            return nil
         }
+        return (raw.assumingMemoryBound(to: VADEventCStruct.self), payload)
+    }
+    
+    /// Whether an event of this type is subscribed; the callback itself is checked in deliver(_:)
+    private func wantsEvent(_ type: VADEventTypeInternal) -> Bool {
+        return eventMask & (UInt32(1) << UInt32(type.rawValue)) != 0
+    }
+    
+    private func sendEvent(type: VADEventTypeInternal) {
+        guard wantsEvent(type) else { return }
+        guard let acquired = acquireEvent(type: type, payloadBytes: 0) else { return }
+        let (event, _) = acquired
+        deliver(event)
+    }
+    
+    /// SPEECH_START or MISFIRE with the segment's frame range
+    private func sendSegmentEvent(type: VADEventTypeInternal, startFrame: Int64, endFrame: Int64) {
+        guard wantsEvent(type) else { return }
+        guard let acquired = acquireEvent(type: type, payloadBytes: 0) else { return }
+        let (event, _) = acquired
+        event.pointee.segment_start_sample = startFrame * Int64(config.frameSamples)
+        event.pointee.segment_end_sample = endFrame * Int64(config.frameSamples)
+        deliver(event)
+    }
+    
+    private func sendFrameEvent(probability: Float, isSpeech: Bool, frame: [Float]) {
+        guard wantsEvent(.frameProcessed) else { return }
         
-        // Allocate event on the heap
-        let eventPtr = UnsafeMutablePointer<VADEventCStruct>.allocate(capacity: 1)
-        eventPtr.initialize(to: VADEventCStruct())
-        eventPtr.pointee.type = VADEventTypeInternal.frameProcessed.rawValue
-        eventPtr.pointee.frame_probability = probability
-        eventPtr.pointee.frame_is_speech = isSpeech ? 1 : 0
-        eventPtr.pointee.frame_data = UnsafePointer(frameCopy)
-        eventPtr.pointee.frame_length = Int32(frame.count)
-        
-        var didInvoke = false
-        callbackQueue.sync {
-            guard _callbackValid, let cb = _callback else { return }
-            let ud = _userData
-            cb(UnsafeRawPointer(eventPtr), ud)
-            didInvoke = true
+        // Decimation: deliver the first frame, then every frameEventInterval-th
+        if frameEventCountdown > 0 {
+            frameEventCountdown -= 1
+            return
         }
+        frameEventCountdown = frameEventInterval - 1
         
-        if didInvoke {
-            DispatchQueue.main.asyncAfter(deadline: .now() + 0.5) {
-                frameCopy.deallocate()
-                eventPtr.deinitialize(count: 1)
-                eventPtr.deallocate()
-            }
-        } else {
-            frameCopy.deallocate()
-            eventPtr.deinitialize(count: 1)
-            eventPtr.deallocate()
+        let bytes = frame.count * MemoryLayout<Float>.stride
+        guard let acquired = acquireEvent(type: .frameProcessed, payloadBytes: bytes) else { return }
+        let (event, payload) = acquired
+        
+        if let payload = payload, bytes > 0 {
+            frame.withUnsafeBytes { payload.copyMemory(from: $0.baseAddress!, byteCount: bytes) }
+            event.pointee.frame_data = UnsafePointer(payload.assumingMemoryBound(to: Float.self))
         }
+        event.pointee.frame_probability = probability
+        event.pointee.frame_is_speech = isSpeech ? 1 : 0
+        event.pointee.frame_length = Int32(frame.count)
+        deliver(event)
     }
     
-    private func sendSpeechEndEvent(audioLength: Int32, durationMs: Int32) {
-        // Allocate audio data copy that persists until Dart processes the callback
-        let audioCopy = UnsafeMutablePointer<Int16>.allocate(capacity: storedSpeechEndPCM16.count)
-        for (i, sample) in storedSpeechEndPCM16.enumerated() {
-            audioCopy[i] = sample
-        }
-        
-        // Allocate event on the heap
-        let eventPtr = UnsafeMutablePointer<VADEventCStruct>.allocate(capacity: 1)
-        eventPtr.initialize(to: VADEventCStruct())
-        eventPtr.pointee.type = VADEventTypeInternal.speechEnd.rawValue
-        eventPtr.pointee.speech_end_audio_length = audioLength
-        eventPtr.pointee.speech_end_duration_ms = durationMs
-        eventPtr.pointee.speech_end_audio_data = UnsafePointer(audioCopy)
+    private func sendSpeechEndEvent(audioLength: Int32, durationMs: Int32, startSample: Int64, endSample: Int64) {
+        let bytes = Int(audioLength) * MemoryLayout<Int16>.stride
+        guard let acquired = acquireEvent(type: .speechEnd, payloadBytes: bytes) else { return }
+        let (event, payload) = acquired
         
-        var didInvoke = false
-        callbackQueue.sync {
-            guard _callbackValid, let cb = _callback else { return }
-            let ud = _userData
-            cb(UnsafeRawPointer(eventPtr), ud)
-            didInvoke = true
+        if let payload = payload, bytes > 0 {
+            speechPCM16.withUnsafeBytes { payload.copyMemory(from: $0.baseAddress!, byteCount: bytes) }
+            event.pointee.speech_end_audio_data = UnsafePointer(payload.assumingMemoryBound(to: Int16.self))
         }
+        event.pointee.speech_end_audio_length = audioLength
+        event.pointee.speech_end_duration_ms = durationMs
+        event.pointee.segment_start_sample = startSample
+        event.pointee.segment_end_sample = endSample
+        deliver(event)
+    }
+    
+    private func sendSpeechChunkEvent(offset: Int, length: Int, isLast: Bool) {
+        guard wantsEvent(.speechChunk) else { return }
+        let bytes = length * MemoryLayout<Int16>.stride
+        guard let acquired = acquireEvent(type: .speechChunk, payloadBytes: bytes) else { return }
+        let (event, payload) = acquired
         
-        if didInvoke {
-            // Schedule cleanup after Dart has processed the event
-            DispatchQueue.main.asyncAfter(deadline: .now() + 1.0) {
-                audioCopy.deallocate()
-                eventPtr.deinitialize(count: 1)
-                eventPtr.deallocate()
+        if let payload = payload, bytes > 0 {
+            speechPCM16.withUnsafeBytes {
+                payload.copyMemory(from: $0.baseAddress! + offset * MemoryLayout<Int16>.stride, byteCount: bytes)
             }
-        } else {
-            // Callback was invalidated, clean up immediately
-            audioCopy.deallocate()
-            eventPtr.deinitialize(count: 1)
-            eventPtr.deallocate()
+            event.pointee.speech_chunk_audio_data = UnsafePointer(payload.assumingMemoryBound(to: Int16.self))
         }
+        event.pointee.speech_chunk_audio_length = Int32(length)
+        event.pointee.speech_chunk_offset = Int32(offset)
+        event.pointee.speech_chunk_is_last = isLast ? 1 : 0
+        deliver(event)
     }
     
     private func sendErrorEvent(message: String, code: Int32) {
-        // Allocate error message copy
-        let messageCopy = strdup(message)
-        
-        // Allocate event on the heap
-        let eventPtr = UnsafeMutablePointer<VADEventCStruct>.allocate(capacity: 1)
-        eventPtr.initialize(to: VADEventCStruct())
-        eventPtr.pointee.type = VADEventTypeInternal.error.rawValue
-        eventPtr.pointee.error_code = code
-        eventPtr.pointee.error_message = UnsafePointer(messageCopy)
-        
-        var didInvoke = false
-        callbackQueue.sync {
-            guard _callbackValid, let cb = _callback else { return }
-            let ud = _userData
-            cb(UnsafeRawPointer(eventPtr), ud)
-            didInvoke = true
-        }
+        guard wantsEvent(.error) else { return }
+        let utf8 = Array(message.utf8)
+        guard let acquired = acquireEvent(type: .error, payloadBytes: utf8.count + 1) else { return }
+        let (event, payload) = acquired
         
-        if didInvoke {
-            DispatchQueue.main.asyncAfter(deadline: .now() + 0.5) {
-                free(messageCopy)
-                eventPtr.deinitialize(count: 1)
-                eventPtr.deallocate()
-            }
-        } else {
-            free(messageCopy)
-            eventPtr.deinitialize(count: 1)
-            eventPtr.deallocate()
+        if let payload = payload {
+            let chars = payload.assumingMemoryBound(to: UInt8.self)
+            chars.initialize(from: utf8, count: utf8.count)
+            chars[utf8.count] = 0
+            event.pointee.error_message = UnsafePointer(payload.assumingMemoryBound(to: CChar.self))
         }
+        event.pointee.error_code = code
+        deliver(event)
     }
 }
 
+// MARK: - Event Pool (src/vad_events.c)
+
+@_extern(c, "vad_event_pool_create")
+func vad_event_pool_create(_ slots: Int32, _ inlinePayloadBytes: Int) -> OpaquePointer?
+
+@_extern(c, "vad_event_pool_close")
+func vad_event_pool_close(_ pool: OpaquePointer?)
+
+@_extern(c, "vad_event_pool_acquire")
+func vad_event_pool_acquire(
+    _ pool: OpaquePointer?,
+    _ type: Int32,
+    _ payloadBytes: Int,
+    _ payload: UnsafeMutablePointer<UnsafeMutableRawPointer?>?
+) -> UnsafeMutableRawPointer?
+
+@_extern(c, "vad_event_pool_release")
+func vad_event_pool_release(_ event: UnsafeRawPointer?)
+
+// MARK: - Sample Conversion (src/vad_convert.c)
+
+@_extern(c, "vad_float_to_pcm16")
+func vad_float_to_pcm16(_ floatSamples: UnsafePointer<Float>?, _ pcm16Samples: UnsafeMutablePointer<Int16>?, _ sampleCount: Int32)
+
+@_extern(c, "vad_convert_s16_frames_to_f32")
+func vad_convert_s16_frames_to_f32(_ src: UnsafePointer<Int16>?, _ channels: Int32, _ stride: Int32, _ dst: UnsafeMutablePointer<Float>?, _ frames: Int32)
+
+@_extern(c, "vad_convert_f32_frames_to_f32")
+func vad_convert_f32_frames_to_f32(_ src: UnsafePointer<Float>?, _ channels: Int32, _ stride: Int32, _ dst: UnsafeMutablePointer<Float>?, _ frames: Int32)
+
+/// VADSampleFormat
+let vadSampleFormatF32: Int32 = 0
+let vadSampleFormatS16: Int32 = 1
+
+// MARK: - Status Block (src/vad_status.c)
+
+@_extern(c, "vad_status_create")
+func vad_status_create() -> OpaquePointer?
+
+@_extern(c, "vad_status_destroy")
+func vad_status_destroy(_ status: OpaquePointer?)
+
+@_extern(c, "vad_status_reset")
+func vad_status_reset(_ status: OpaquePointer?)
+
+@_extern(c, "vad_status_publish_frame")
+func vad_status_publish_frame(_ status: OpaquePointer?, _ probability: Float, _ isSpeaking: Int32)
+
+@_extern(c, "vad_status_set_speaking")
+func vad_status_set_speaking(_ status: OpaquePointer?, _ isSpeaking: Int32)
+
+// MARK: - Stats Recorder (src/vad_stats.c)
+
+@_extern(c, "vad_stats_create")
+func vad_stats_create() -> OpaquePointer?
+
+@_extern(c, "vad_stats_destroy")
+func vad_stats_destroy(_ stats: OpaquePointer?)
+
+@_extern(c, "vad_stats_reset")
+func vad_stats_reset(_ stats: OpaquePointer?)
+
+@_extern(c, "vad_stats_record_frame")
+func vad_stats_record_frame(_ stats: OpaquePointer?, _ inferenceNs: UInt64, _ frameNs: UInt64, _ budgetNs: UInt64)
+
+@_extern(c, "vad_stats_record_callback")
+func vad_stats_record_callback(_ stats: OpaquePointer?, _ ns: UInt64)
+
+@_extern(c, "vad_stats_set_queued")
+func vad_stats_set_queued(_ stats: OpaquePointer?, _ samples: Int32)
+
+@_extern(c, "vad_stats_set_speech")
+func vad_stats_set_speech(_ stats: OpaquePointer?, _ bytes: Int64, _ capacityBytes: Int64)
+
+@_extern(c, "vad_stats_add_gated")
+func vad_stats_add_gated(_ stats: OpaquePointer?)
+
+@_extern(c, "vad_stats_read")
+func vad_stats_read(_ stats: OpaquePointer?, _ events: OpaquePointer?, _ statsOut: UnsafeMutableRawPointer?)
+
+// MARK: - Timeline Trace (src/vad_trace.c)
+
+@_extern(c, "vad_tracer_create")
+func vad_tracer_create() -> OpaquePointer?
+
+@_extern(c, "vad_tracer_destroy")
+func vad_tracer_destroy(_ tracer: OpaquePointer?)
+
+@_extern(c, "vad_tracer_start")
+func vad_tracer_start(_ tracer: OpaquePointer?, _ eventsPerThread: Int32)
+
+@_extern(c, "vad_tracer_stop")
+func vad_tracer_stop(_ tracer: OpaquePointer?)
+
+@_extern(c, "vad_tracer_now")
+func vad_tracer_now(_ tracer: OpaquePointer?) -> UInt64
+
+@_extern(c, "vad_tracer_record")
+func vad_tracer_record(_ tracer: OpaquePointer?, _ span: Int32, _ arg: Int32, _ startNs: UInt64, _ endNs: UInt64)
+
+@_extern(c, "vad_tracer_write_json")
+func vad_tracer_write_json(_ tracer: OpaquePointer?, _ path: UnsafePointer<CChar>?, _ error: UnsafeMutablePointer<CChar>?, _ errorSize: Int) -> Int32
+
+// MARK: - Silence Gate (src/vad_gate.c)
+
+/// VAD_GATE_* in vad_gate.h
+let vadGateSkip: Int32 = 1
+let vadGateResume: Int32 = 2
+
+@_extern(c, "vad_gate_create")
+func vad_gate_create() -> OpaquePointer?
+
+@_extern(c, "vad_gate_destroy")
+func vad_gate_destroy(_ gate: OpaquePointer?)
+
+@_extern(c, "vad_gate_configure")
+func vad_gate_configure(_ gate: OpaquePointer?, _ holdFrames: Int32, _ thresholdDbfs: Float, _ noiseMarginDb: Float)
+
+@_extern(c, "vad_gate_reset")
+func vad_gate_reset(_ gate: OpaquePointer?)
+
+@_extern(c, "vad_gate_push")
+func vad_gate_push(_ gate: OpaquePointer?, _ frame: UnsafePointer<Float>?, _ count: Int32) -> Int32
+
+// MARK: - Resampler (src/vad_resample.c)
+
+@_extern(c, "vad_resampler_create")
+func vad_resampler_create(_ inputRate: Int32, _ outputRate: Int32) -> OpaquePointer?
+
+@_extern(c, "vad_resampler_destroy")
+func vad_resampler_destroy(_ resampler: OpaquePointer?)
+
+@_extern(c, "vad_resampler_reset")
+func vad_resampler_reset(_ resampler: OpaquePointer?)
+
+@_extern(c, "vad_resampler_process")
+func vad_resampler_process(
+    _ resampler: OpaquePointer?,
+    _ input: UnsafePointer<Float>?,
+    _ inputCount: Int32,
+    _ inputUsed: UnsafeMutablePointer<Int32>?,
+    _ output: UnsafeMutablePointer<Float>?,
+    _ outputCapacity: Int32
+) -> Int32
+
+/// Resampler output block (VAD_RESAMPLER_BLOCK)
+let vadResamplerBlock = 1024
+
+/// Pooled events per handle (VAD_EVENT_POOL_SLOTS)
+let vadEventPoolSlots: Int32 = 64
+
+/// Inline event payload: one frame at the largest supported frame size
+let vadEventInlineBytes = 512 * MemoryLayout<Float>.stride
+
 // MARK: - C-Compatible Event Structure
 
 /// Flat C-compatible event structure (easier for FFI than nested unions)
@@ -792,6 +1548,16 @@ public struct VADEventCStruct {
     public var error_message: UnsafePointer<CChar>? = nil
     public var error_code: Int32 = 0
     
+    // Speech chunk data
+    public var speech_chunk_audio_data: UnsafePointer<Int16>? = nil
+    public var speech_chunk_audio_length: Int32 = 0
+    public var speech_chunk_offset: Int32 = 0
+    public var speech_chunk_is_last: Int32 = 0  // 0 = false, 1 = true
+    
+    // Segment position (speech start, speech end, misfire)
+    public var segment_start_sample: Int64 = 0
+    public var segment_end_sample: Int64 = 0
+    
     public init() {}
 }
 
@@ -839,7 +1605,16 @@ public func vad_config_default(_ configOut: UnsafeMutableRawPointer?) {
         sample_rate: 16000,
         frame_samples: 512,
         end_speech_pad_frames: 3,
-        is_debug: 0
+        is_debug: 0,
+        speech_chunk_samples: 0,
+        max_speech_frames: 938,
+        speech_end_by_reference: 0,
+        input_sample_rate: 0,
+        prefer_int8_model: 0,
+        prewarm_frames: 0,
+        silence_gate_frames: 0,
+        silence_gate_dbfs: -55,
+        silence_gate_noise_margin_db: 0
     )
 }
 
@@ -857,13 +1632,9 @@ public func vad_destroy(_ handle: UnsafeMutableRawPointer?) {
     removeHandle(handle)
 }
 
-@_cdecl("vad_init")
-public func vad_init(_ handle: UnsafeMutableRawPointer?, _ configPtr: UnsafeRawPointer?, _ modelPath: UnsafePointer<CChar>?) -> Int32 {
-    guard let h = getHandle(handle), let configPtr = configPtr else { return -1 }
-    
-    let config = configPtr.assumingMemoryBound(to: VADConfigC.self).pointee
-    
-    let internalConfig = VADConfigInternal(
+/// Swift configuration for a C config
+private func makeInternalConfig(_ config: VADConfigC) -> VADConfigInternal {
+    return VADConfigInternal(
         positiveSpeechThreshold: config.positive_speech_threshold,
         negativeSpeechThreshold: config.negative_speech_threshold,
         preSpeechPadFrames: config.pre_speech_pad_frames,
@@ -872,8 +1643,26 @@ public func vad_init(_ handle: UnsafeMutableRawPointer?, _ configPtr: UnsafeRawP
         sampleRate: config.sample_rate,
         frameSamples: config.frame_samples,
         endSpeechPadFrames: config.end_speech_pad_frames,
-        isDebug: config.is_debug != 0
+        isDebug: config.is_debug != 0,
+        speechChunkSamples: max(0, config.speech_chunk_samples),
+        maxSpeechFrames: max(0, config.max_speech_frames),
+        speechEndByReference: config.speech_end_by_reference != 0,
+        inputSampleRate: config.input_sample_rate,
+        preferInt8Model: config.prefer_int8_model != 0,
+        prewarmFrames: max(0, config.prewarm_frames),
+        silenceGateFrames: max(0, config.silence_gate_frames),
+        silenceGateDbfs: config.silence_gate_dbfs,
+        silenceGateNoiseMarginDb: max(0, config.silence_gate_noise_margin_db)
     )
+}
+
+@_cdecl("vad_init")
+public func vad_init(_ handle: UnsafeMutableRawPointer?, _ configPtr: UnsafeRawPointer?, _ modelPath: UnsafePointer<CChar>?) -> Int32 {
+    guard let h = getHandle(handle), let configPtr = configPtr else { return -1 }
+    
+    let config = configPtr.assumingMemoryBound(to: VADConfigC.self).pointee
+    
+    let internalConfig = makeInternalConfig(config)
     
     let pathStr: String? = modelPath != nil ? String(cString: modelPath!) : nil
     
@@ -886,6 +1675,26 @@ public func vad_init(_ handle: UnsafeMutableRawPointer?, _ configPtr: UnsafeRawP
     }
 }
 
+@_cdecl("vad_init_from_memory")
+public func vad_init_from_memory(_ handle: UnsafeMutableRawPointer?, _ configPtr: UnsafeRawPointer?,
+                                 _ data: UnsafeRawPointer?, _ length: Int) -> Int32 {
+    guard let h = getHandle(handle), let configPtr = configPtr, let data = data, length > 0 else { return -1 }
+    
+    let config = configPtr.assumingMemoryBound(to: VADConfigC.self).pointee
+    let internalConfig = makeInternalConfig(config)
+    
+    // Borrow the caller's buffer for the duration of the call
+    let modelData = Data(bytesNoCopy: UnsafeMutableRawPointer(mutating: data), count: length, deallocator: .none)
+    
+    do {
+        try h.initialize(config: internalConfig, modelData: modelData)
+        return 0
+    } catch {
+        h.lastError = error.localizedDescription
+        return -2
+    }
+}
+
 @_cdecl("vad_set_callback")
 public func vad_set_callback(
     _ handle: UnsafeMutableRawPointer?,
@@ -903,6 +1712,18 @@ public func vad_invalidate_callback(_ handle: UnsafeMutableRawPointer?) {
     h.invalidateCallback()
 }
 
+@_cdecl("vad_set_event_mask")
+public func vad_set_event_mask(_ handle: UnsafeMutableRawPointer?, _ mask: UInt32) {
+    guard let h = getHandle(handle) else { return }
+    h.eventMask = mask
+}
+
+@_cdecl("vad_set_frame_event_interval")
+public func vad_set_frame_event_interval(_ handle: UnsafeMutableRawPointer?, _ interval: Int32) {
+    guard let h = getHandle(handle) else { return }
+    h.frameEventInterval = max(1, interval)
+}
+
 @_cdecl("vad_start")
 public func vad_start(_ handle: UnsafeMutableRawPointer?) -> Int32 {
     guard let h = getHandle(handle) else { return -1 }
@@ -926,8 +1747,40 @@ public func vad_stop(_ handle: UnsafeMutableRawPointer?) {
 public func vad_process_audio(_ handle: UnsafeMutableRawPointer?, _ samples: UnsafePointer<Float>?, _ sampleCount: Int32) -> Int32 {
     guard let h = getHandle(handle), let samples = samples, sampleCount > 0 else { return -1 }
     
-    let audioData = Array(UnsafeBufferPointer(start: samples, count: Int(sampleCount)))
-    h.processAudioData(audioData)
+    h.processInputAudio(samples, sampleCount)
+    return 0
+}
+
+@_cdecl("vad_process_audio_ex")
+public func vad_process_audio_ex(
+    _ handle: UnsafeMutableRawPointer?,
+    _ data: UnsafeRawPointer?,
+    _ frames: Int32,
+    _ format: Int32,
+    _ channels: Int32,
+    _ stride: Int32
+) -> Int32 {
+    guard let h = getHandle(handle), let data = data, frames > 0 else { return -1 }
+    let stride = stride == 0 ? channels : stride
+    guard channels >= 1, stride >= channels else {
+        h.lastError = "Invalid layout: \(channels) channels with stride \(stride)"
+        return -1
+    }
+    
+    // The Swift path frames [Float] arrays, so every layout is converted into one by the shared C code
+    var samples = [Float](repeating: 0, count: Int(frames))
+    switch format {
+    case vadSampleFormatF32:
+        vad_convert_f32_frames_to_f32(data.assumingMemoryBound(to: Float.self), channels, stride, &samples, frames)
+    case vadSampleFormatS16:
+        vad_convert_s16_frames_to_f32(data.assumingMemoryBound(to: Int16.self), channels, stride, &samples, frames)
+    default:
+        h.lastError = "Unsupported sample format \(format)"
+        return -1
+    }
+    samples.withUnsafeBufferPointer { buffer in
+        h.processInputAudio(buffer.baseAddress!, frames)
+    }
     return 0
 }
 
@@ -941,15 +1794,17 @@ public func vad_reset(_ handle: UnsafeMutableRawPointer?) {
 public func vad_force_end_speech(_ handle: UnsafeMutableRawPointer?) {
     guard let h = getHandle(handle) else { return }
     
-    if h.isSpeaking && !h.speechBuffer.isEmpty && h.speechFrameCount >= Int(h.config.minSpeechFrames) {
+    // A split on the last frame leaves an open segment with no frames yet
+    if h.isSpeaking && h.frameIndex > h.segmentStart && h.speechFrameCount >= Int(h.config.minSpeechFrames) {
         h.emitSpeechEnd()
     }
     
     h.isSpeaking = false
     h.speechFrameCount = 0
     h.silenceFrameCount = 0
-    h.speechBuffer = []
+    h.clearSpeech()
     h.hasEmittedRealStart = false
+    vad_status_set_speaking(h.statusBlock, 0)
 }
 
 @_cdecl("vad_is_speaking")
@@ -958,31 +1813,82 @@ public func vad_is_speaking(_ handle: UnsafeMutableRawPointer?) -> Int32 {
     return h.isSpeaking ? 1 : 0
 }
 
-@_cdecl("vad_get_last_error")
-public func vad_get_last_error(_ handle: UnsafeMutableRawPointer?) -> UnsafePointer<CChar>? {
+@_cdecl("vad_get_status_block")
+public func vad_get_status_block(_ handle: UnsafeMutableRawPointer?) -> UnsafeRawPointer? {
     guard let h = getHandle(handle) else { return nil }
-    return (h.lastError as NSString).utf8String
+    return UnsafeRawPointer(h.statusBlock)
 }
 
-@_cdecl("vad_float_to_pcm16")
-public func vad_float_to_pcm16(_ floatSamples: UnsafePointer<Float>?, _ pcm16Samples: UnsafeMutablePointer<Int16>?, _ sampleCount: Int32) {
-    guard let floatSamples = floatSamples, let pcm16Samples = pcm16Samples, sampleCount > 0 else { return }
-    
-    for i in 0..<Int(sampleCount) {
-        let clamped = max(-1.0, min(1.0, floatSamples[i]))
-        pcm16Samples[i] = Int16(clamped * 32767)
+@_cdecl("vad_prewarm")
+public func vad_prewarm(_ handle: UnsafeMutableRawPointer?, _ nFrames: Int32) -> Int32 {
+    guard let h = getHandle(handle) else { return -1 }
+    do {
+        try h.prewarm(frames: nFrames)
+        return 0
+    } catch {
+        h.lastError = error.localizedDescription
+        return (error as NSError).code == -1 ? -1 : -2
     }
 }
 
-@_cdecl("vad_pcm16_to_float")
-public func vad_pcm16_to_float(_ pcm16Samples: UnsafePointer<Int16>?, _ floatSamples: UnsafeMutablePointer<Float>?, _ sampleCount: Int32) {
-    guard let pcm16Samples = pcm16Samples, let floatSamples = floatSamples, sampleCount > 0 else { return }
-    
-    for i in 0..<Int(sampleCount) {
-        floatSamples[i] = Float(pcm16Samples[i]) / 32768.0
+@_cdecl("vad_get_warmup_info")
+public func vad_get_warmup_info(_ handle: UnsafeMutableRawPointer?, _ infoOut: UnsafeMutableRawPointer?) -> Int32 {
+    guard let h = getHandle(handle), let infoOut = infoOut else { return -1 }
+    h.waitPrewarm()
+    infoOut.assumingMemoryBound(to: VADWarmupInfoC.self).pointee = VADWarmupInfoC(
+        prewarm_frames: h.warmupFrames,
+        cold_frame_us: h.coldFrameUs,
+        warm_frame_us: h.warmFrameUs,
+        first_frame_us: h.firstFrameUs
+    )
+    return 0
+}
+
+@_cdecl("vad_get_stats")
+public func vad_get_stats(_ handle: UnsafeMutableRawPointer?, _ statsOut: UnsafeMutableRawPointer?) -> Int32 {
+    guard let h = getHandle(handle), let statsOut = statsOut else { return -1 }
+    h.readStats(statsOut)
+    return 0
+}
+
+@_cdecl("vad_trace_start")
+public func vad_trace_start(_ handle: UnsafeMutableRawPointer?, _ eventsPerThread: Int32) -> Int32 {
+    guard let h = getHandle(handle) else { return -1 }
+    guard eventsPerThread >= 0 else {
+        h.lastError = "events_per_thread must not be negative"
+        return -1
+    }
+    h.startTrace(eventsPerThread: eventsPerThread)
+    return 0
+}
+
+@_cdecl("vad_trace_stop")
+public func vad_trace_stop(_ handle: UnsafeMutableRawPointer?) {
+    guard let h = getHandle(handle) else { return }
+    h.stopTrace()
+}
+
+@_cdecl("vad_trace_dump")
+public func vad_trace_dump(_ handle: UnsafeMutableRawPointer?, _ path: UnsafePointer<CChar>?) -> Int32 {
+    guard let h = getHandle(handle), let path = path else { return -1 }
+    do {
+        try h.dumpTrace(path: String(cString: path))
+        return 0
+    } catch {
+        h.lastError = error.localizedDescription
+        return -1
     }
 }
 
+@_cdecl("vad_get_last_error")
+public func vad_get_last_error(_ handle: UnsafeMutableRawPointer?) -> UnsafePointer<CChar>? {
+    guard let h = getHandle(handle) else { return nil }
+    return (h.lastError as NSString).utf8String
+}
+
+// vad_float_to_pcm16 and vad_pcm16_to_float are exported by the shared C
+// sources (src/vad_plus.c, vectorized in src/vad_convert.c)
+
 // MARK: - C-Compatible Config Structure
 /// Note: Using Int32 instead of Bool for C compatibility with @_cdecl
 
@@ -996,6 +1902,15 @@ public struct VADConfigC {
     public var frame_samples: Int32
     public var end_speech_pad_frames: Int32
     public var is_debug: Int32  // 0 = false, 1 = true (Bool not C-compatible)
+    public var speech_chunk_samples: Int32
+    public var max_speech_frames: Int32
+    public var speech_end_by_reference: Int32  // 0 = false, 1 = true
+    public var input_sample_rate: Int32  // 0 = sample_rate
+    public var prefer_int8_model: Int32  // 0 = false, 1 = true
+    public var prewarm_frames: Int32  // 0 = no warm-up
+    public var silence_gate_frames: Int32  // 0 = gate off
+    public var silence_gate_dbfs: Float
+    public var silence_gate_noise_margin_db: Float  // 0 = fixed threshold
     
     public init(
         positive_speech_threshold: Float = 0.5,
@@ -1006,7 +1921,16 @@ public struct VADConfigC {
         sample_rate: Int32 = 16000,
         frame_samples: Int32 = 512,
         end_speech_pad_frames: Int32 = 3,
-        is_debug: Int32 = 0
+        is_debug: Int32 = 0,
+        speech_chunk_samples: Int32 = 0,
+        max_speech_frames: Int32 = 938,
+        speech_end_by_reference: Int32 = 0,
+        input_sample_rate: Int32 = 0,
+        prefer_int8_model: Int32 = 0,
+        prewarm_frames: Int32 = 0,
+        silence_gate_frames: Int32 = 0,
+        silence_gate_dbfs: Float = -55,
+        silence_gate_noise_margin_db: Float = 0
     ) {
         self.positive_speech_threshold = positive_speech_threshold
         self.negative_speech_threshold = negative_speech_threshold
@@ -1017,6 +1941,23 @@ public struct VADConfigC {
         self.frame_samples = frame_samples
         self.end_speech_pad_frames = end_speech_pad_frames
         self.is_debug = is_debug
+        self.speech_chunk_samples = speech_chunk_samples
+        self.max_speech_frames = max_speech_frames
+        self.speech_end_by_reference = speech_end_by_reference
+        self.input_sample_rate = input_sample_rate
+        self.prefer_int8_model = prefer_int8_model
+        self.prewarm_frames = prewarm_frames
+        self.silence_gate_frames = silence_gate_frames
+        self.silence_gate_dbfs = silence_gate_dbfs
+        self.silence_gate_noise_margin_db = silence_gate_noise_margin_db
     }
 }
 
+/// Matches VADWarmupInfo in vad_plus.h
+public struct VADWarmupInfoC {
+    public var prewarm_frames: Int32
+    public var cold_frame_us: Float
+    public var warm_frame_us: Float
+    public var first_frame_us: Float
+}
+
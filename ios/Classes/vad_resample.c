@@ -0,0 +1,3 @@
+// Relative import to be able to reuse the C sources.
+// See the comment in ../vad_plus.podspec for more information.
+#include "../../src/vad_resample.c"
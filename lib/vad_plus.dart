@@ -26,6 +26,15 @@ class VadConfig {
     this.frameSamples = 512,
     this.endSpeechPadFrames = 3,
     this.isDebug = false,
+    this.speechChunkSamples = 0,
+    this.maxSpeechFrames = 938,
+    this.speechEndByReference = false,
+    this.inputSampleRate = 0,
+    this.preferInt8Model = false,
+    this.prewarmFrames = 0,
+    this.silenceGateFrames = 0,
+    this.silenceGateDbfs = -55.0,
+    this.silenceGateNoiseMarginDb = 0.0,
   });
 
   /// Create configuration optimized for Silero VAD at 16kHz.
@@ -39,6 +48,15 @@ class VadConfig {
     this.frameSamples = 512,
     this.endSpeechPadFrames = 3,
     this.isDebug = false,
+    this.speechChunkSamples = 0,
+    this.maxSpeechFrames = 938,
+    this.speechEndByReference = false,
+    this.inputSampleRate = 0,
+    this.preferInt8Model = false,
+    this.prewarmFrames = 0,
+    this.silenceGateFrames = 0,
+    this.silenceGateDbfs = -55.0,
+    this.silenceGateNoiseMarginDb = 0.0,
   });
 
   /// Create configuration optimized for Silero VAD at 8kHz.
@@ -52,6 +70,15 @@ class VadConfig {
     this.frameSamples = 256,
     this.endSpeechPadFrames = 3,
     this.isDebug = false,
+    this.speechChunkSamples = 0,
+    this.maxSpeechFrames = 938,
+    this.speechEndByReference = false,
+    this.inputSampleRate = 0,
+    this.preferInt8Model = false,
+    this.prewarmFrames = 0,
+    this.silenceGateFrames = 0,
+    this.silenceGateDbfs = -55.0,
+    this.silenceGateNoiseMarginDb = 0.0,
   });
 
   /// Threshold for detecting speech start (0.0 - 1.0).
@@ -89,6 +116,184 @@ class VadConfig {
   /// Enable debug logging.
   /// Default: false
   final bool isDebug;
+
+  /// Stream confirmed speech as [VadSpeechChunk] events of this many samples,
+  /// so downstream processing can start before the speech ends.
+  /// Default: 0 (off, audio only arrives with [VadSpeechEnd])
+  final int speechChunkSamples;
+
+  /// Longest speech segment in frames, not counting the pre-speech pad.
+  /// Longer confirmed speech is split: the segment ends with [VadSpeechEnd] and
+  /// the next one starts right away. That one needs [minSpeechFrames] speech
+  /// frames of its own before [VadRealSpeechStart], and ends as [VadMisfire] if
+  /// none follow. Segment storage is allocated once for this length. Must be 0
+  /// or at least [minSpeechFrames].
+  /// Default: 938 (about 30 s; 0 = unbounded, storage grows as needed)
+  final int maxSpeechFrames;
+
+  /// Send [VadSpeechEnd] without audio, only its sample range
+  /// ([VadSpeechEnd.startSample] to [VadSpeechEnd.endSample]), for callers
+  /// that keep the input stream themselves. Segment audio is then not stored
+  /// at all, unless [speechChunkSamples] asks for chunks.
+  /// Default: false
+  final bool speechEndByReference;
+
+  /// Sample rate of the audio passed to [VadPlus.processAudio], when it
+  /// differs from [sampleRate] (for example 48000 or 44100). The audio is
+  /// resampled natively before framing; sample positions in events still
+  /// count samples at [sampleRate]. Microphone capture is not affected.
+  /// Default: 0 (same as [sampleRate])
+  final int inputSampleRate;
+
+  /// Load the int8-quantized model (`silero_vad_v6_int8.onnx`, written by
+  /// the `vad_plus_quantize` tool) when it is bundled and no model path is
+  /// given, falling back to the fp32 model otherwise. On Linux and Windows the
+  /// native engine then runs int8 kernels; ONNX Runtime (Android, iOS, macOS)
+  /// folds the weights back to fp32 when loading, so there only the file is
+  /// smaller.
+  /// Default: false
+  final bool preferInt8Model;
+
+  /// Dummy frames to run in the background right after initialization, as
+  /// [VadPlus.prewarm] does, so the first real frame does not pay for cold
+  /// caches and lazy allocations. The first real frame waits for the warm-up.
+  /// Default: 0 (none)
+  final int prewarmFrames;
+
+  /// Silence gate: once more than this many frames in a row are quieter than
+  /// [silenceGateDbfs], later quiet frames skip model inference and count as
+  /// probability 0, until a louder frame arrives. The gate has only been
+  /// measured on synthetic audio so far; tune it on your own recordings.
+  /// Default: 0 (off, every frame is inferred)
+  final int silenceGateFrames;
+
+  /// Frame RMS level in dBFS under which the silence gate treats a frame as
+  /// silent. A frame peaking 20 dB or more above it is never silent.
+  /// Default: -55.0
+  final double silenceGateDbfs;
+
+  /// Lets the silence gate follow the background noise: frames within this
+  /// many dB of the tracked noise floor are silent too, as long as that stays
+  /// under -35 dBFS.
+  /// Default: 0.0 (fixed [silenceGateDbfs] only)
+  final double silenceGateNoiseMarginDb;
+}
+
+// ============================================================================
+// VAD Warm-up
+// ============================================================================
+
+/// Cold versus warm per-frame inference latency, from [VadPlus.warmupInfo].
+class VadWarmupInfo {
+  /// Cold versus warm per-frame inference latency.
+  const VadWarmupInfo({
+    required this.prewarmFrames,
+    required this.coldFrameUs,
+    required this.warmFrameUs,
+    required this.firstFrameUs,
+  });
+
+  /// Frames run by the last warm-up, 0 if there was none.
+  final int prewarmFrames;
+
+  /// Latency of the first inference after initialization (a warm-up frame
+  /// if there was a warm-up), in microseconds.
+  final double coldFrameUs;
+
+  /// Mean latency over the second half of the warm-up frames, in
+  /// microseconds; 0 without a warm-up.
+  final double warmFrameUs;
+
+  /// Latency of the first real frame after initialization, in microseconds;
+  /// 0 until it has been processed.
+  final double firstFrameUs;
+}
+
+// ============================================================================
+// VAD Runtime Statistics
+// ============================================================================
+
+/// Latency percentiles in microseconds, from a log-bucketed histogram
+/// (within about 6% of the true value; [max] is exact).
+class VadLatency {
+  /// Latency percentiles in microseconds.
+  const VadLatency({
+    required this.p50,
+    required this.p95,
+    required this.p99,
+    required this.max,
+  });
+
+  /// Median.
+  final double p50;
+
+  /// 95th percentile.
+  final double p95;
+
+  /// 99th percentile.
+  final double p99;
+
+  /// Largest value seen.
+  final double max;
+}
+
+/// Runtime counters of a VAD instance, from [VadPlus.stats]. Everything
+/// counts from initialization, [VadPlus.stop] or [VadPlus.reset].
+class VadStats {
+  /// Runtime counters of a VAD instance.
+  const VadStats({
+    required this.framesProcessed,
+    required this.lateFrames,
+    required this.droppedSamples,
+    required this.callbacks,
+    required this.inference,
+    required this.callback,
+    required this.queuedSamples,
+    required this.pendingEvents,
+    required this.speechBufferBytes,
+    required this.speechCapacityBytes,
+    required this.gatedFrames,
+    required this.droppedEvents,
+  });
+
+  /// Frames run through the model.
+  final int framesProcessed;
+
+  /// Frames that took longer to process than the audio they hold.
+  final int lateFrames;
+
+  /// Captured samples dropped because the input queue was full (microphone
+  /// capture only).
+  final int droppedSamples;
+
+  /// Events passed to the native callback.
+  final int callbacks;
+
+  /// Model inference latency per frame.
+  final VadLatency inference;
+
+  /// Time spent in the native callback per event.
+  final VadLatency callback;
+
+  /// Samples received but not yet processed.
+  final int queuedSamples;
+
+  /// Events delivered but not yet consumed on the Dart side.
+  final int pendingEvents;
+
+  /// Bytes of audio stored for the current speech segment.
+  final int speechBufferBytes;
+
+  /// Bytes allocated for speech storage.
+  final int speechCapacityBytes;
+
+  /// Frames the silence gate kept from the model
+  /// ([VadConfig.silenceGateFrames]); not counted in [framesProcessed].
+  final int gatedFrames;
+
+  /// Events dropped because too many were still waiting to be consumed on
+  /// the Dart side.
+  final int droppedEvents;
 }
 
 // ============================================================================
@@ -109,19 +314,38 @@ class VadInitialized extends VadEvent {
 /// Emitted when speech starts (initial detection).
 class VadSpeechStart extends VadEvent {
   /// Emitted when speech starts (initial detection).
-  const VadSpeechStart();
+  const VadSpeechStart({this.startSample = 0});
+
+  /// First sample of the segment, pre-speech pad included.
+  ///
+  /// Sample positions count from the first sample processed after
+  /// initialization, [VadPlus.stop] or [VadPlus.reset].
+  final int startSample;
 }
 
 /// Emitted when speech ends with recorded audio.
 class VadSpeechEnd extends VadEvent {
   /// Emitted when speech ends with recorded audio.
-  const VadSpeechEnd({required this.audioData, required this.durationMs});
+  const VadSpeechEnd({
+    required this.audioData,
+    required this.durationMs,
+    this.startSample = 0,
+    this.endSample = 0,
+  });
 
-  /// PCM16 audio data of the speech segment.
+  /// PCM16 audio data of the speech segment, the input samples from
+  /// [startSample] to [endSample]. Empty when
+  /// [VadConfig.speechEndByReference] is set.
   final Int16List audioData;
 
   /// Duration of the speech segment in milliseconds.
   final int durationMs;
+
+  /// First sample of the segment, pre-speech pad included.
+  final int startSample;
+
+  /// One past the last sample of the segment, trailing silence included.
+  final int endSample;
 }
 
 /// Emitted for each processed audio frame.
@@ -152,7 +376,13 @@ class VadRealSpeechStart extends VadEvent {
 /// Emitted when detected speech was too short (misfire).
 class VadMisfire extends VadEvent {
   /// Emitted when detected speech was too short (misfire).
-  const VadMisfire();
+  const VadMisfire({this.startSample = 0, this.endSample = 0});
+
+  /// First sample of the discarded segment, pre-speech pad included.
+  final int startSample;
+
+  /// One past the last sample of the discarded segment.
+  final int endSample;
 }
 
 /// Emitted when an error occurs.
@@ -173,6 +403,99 @@ class VadStopped extends VadEvent {
   const VadStopped();
 }
 
+/// Emitted while a confirmed speech segment is still open, when
+/// [VadConfig.speechChunkSamples] is set.
+///
+/// The chunks of a segment, in order, hold the same audio as its
+/// [VadSpeechEnd], starting with the pre-speech pad.
+class VadSpeechChunk extends VadEvent {
+  /// Emitted while a confirmed speech segment is still open.
+  const VadSpeechChunk({
+    required this.audioData,
+    required this.offset,
+    required this.isLast,
+  });
+
+  /// PCM16 audio data of this chunk.
+  final Int16List audioData;
+
+  /// Position of the first sample within the speech segment.
+  final int offset;
+
+  /// Whether this is the final chunk (which may be empty), sent just before
+  /// [VadSpeechEnd].
+  final bool isLast;
+}
+
+/// Bits for [VadPlus.setEventMask], one per event type.
+abstract final class VadEventMask {
+  static const int initialized = 1 << VADEventType.initialized;
+  static const int speechStart = 1 << VADEventType.speechStart;
+  static const int speechEnd = 1 << VADEventType.speechEnd;
+  static const int frameProcessed = 1 << VADEventType.frameProcessed;
+  static const int realSpeechStart = 1 << VADEventType.realSpeechStart;
+  static const int misfire = 1 << VADEventType.misfire;
+  static const int error = 1 << VADEventType.error;
+  static const int stopped = 1 << VADEventType.stopped;
+  static const int speechChunk = 1 << VADEventType.speechChunk;
+
+  /// Every event type (the default).
+  static const int all = 0xFFFFFFFF;
+
+  /// Every event type except [VadFrameProcessed].
+  static const int allButFrames = all & ~frameProcessed;
+}
+
+/// Typed-list views over the native VADStatusBlock.
+///
+/// The counters are written under a seqlock: a read is retried while the
+/// sequence word is odd or changes across it. is_speaking is a single word and
+/// needs no retry.
+class _StatusView {
+  _StatusView(Pointer<VADStatusBlock> block)
+    : _words = block.cast<Uint32>().asTypedList(_historyOffset),
+      _floats = block.cast<Float>().asTypedList(
+        _historyOffset + VAD_STATUS_HISTORY,
+      );
+
+  // Word offsets into VADStatusBlock
+  static const int _sequence = 0;
+  static const int _isSpeaking = 1;
+  static const int _frameCount = 2;
+  static const int _lastProbability = 3;
+  static const int _historyOffset = 16;
+
+  final Uint32List _words;
+  final Float32List _floats;
+
+  bool get isSpeaking => _words[_isSpeaking] != 0;
+
+  int get frameCount => _read(() => _words[_frameCount]);
+
+  double get lastProbability => _read(() => _floats[_lastProbability]);
+
+  Float32List history(int count) => _read(() {
+    final available = _words[_frameCount];
+    var length = count < available ? count : available;
+    if (length > VAD_STATUS_HISTORY) length = VAD_STATUS_HISTORY;
+    final result = Float32List(length < 0 ? 0 : length);
+    for (var i = 0; i < result.length; i++) {
+      final frame = available - result.length + i;
+      result[i] = _floats[_historyOffset + frame % VAD_STATUS_HISTORY];
+    }
+    return result;
+  });
+
+  T _read<T>(T Function() body) {
+    while (true) {
+      final before = _words[_sequence];
+      if (before.isOdd) continue;
+      final value = body();
+      if (_words[_sequence] == before) return value;
+    }
+  }
+}
+
 // ============================================================================
 // VAD Plus - Main API
 // ============================================================================
@@ -213,6 +536,9 @@ class VadPlus {
   // Native callback for receiving events from the native side
   NativeCallable<VADEventCallbackNative>? _nativeCallback;
 
+  // Live status polled straight from native memory
+  _StatusView? _status;
+
   // Static registry for hot reload cleanup
   // When a new VadPlus instance is initialized, any previous active instance
   // is automatically disposed to prevent callback
@@ -229,19 +555,39 @@ class VadPlus {
   bool get isRunning => _isRunning;
 
   /// Whether speech is currently being detected.
-  bool get isSpeaking {
-    if (_handle == null) return false;
-    return _bindings.vad_is_speaking(_handle!);
-  }
+  ///
+  /// Reads native memory directly, so it is cheap enough to poll every
+  /// display frame.
+  bool get isSpeaking => _status?.isSpeaking ?? false;
+
+  /// Speech probability of the most recent frame.
+  double get lastProbability => _status?.lastProbability ?? 0.0;
+
+  /// Frames processed since initialization or the last [reset].
+  int get frameCount => _status?.frameCount ?? 0;
+
+  /// Number of recent frame probabilities kept for [probabilityHistory].
+  static const int statusHistoryLength = VAD_STATUS_HISTORY;
+
+  /// Probabilities of up to the last [statusHistoryLength] frames, oldest
+  /// first, read without FFI calls (e.g. for a level meter).
+  Float32List probabilityHistory({int count = statusHistoryLength}) =>
+      _status?.history(count) ?? Float32List(0);
 
   /// Initialize the VAD with the given configuration.
   ///
   /// [config] - VAD configuration options.
   /// [modelPath] - Optional path to custom ONNX model file.
+  /// [modelBytes] - Optional serialized ONNX model, used instead of a file
+  /// (e.g. a model embedded in the app); takes precedence over [modelPath].
   Future<void> initialize({
     VadConfig config = const VadConfig(),
     String? modelPath,
+    Uint8List? modelBytes,
   }) async {
+    if (modelBytes != null && modelBytes.isEmpty) {
+      throw ArgumentError.value(modelBytes, 'modelBytes', 'must not be empty');
+    }
     if (_isInitialized) {
       throw StateError('VAD is already initialized. Call dispose() first.');
     }
@@ -270,6 +616,11 @@ class VadPlus {
       throw Exception('Failed to create VAD handle');
     }
 
+    final statusBlock = _bindings.vad_get_status_block(_handle!);
+    if (statusBlock != nullptr) {
+      _status = _StatusView(statusBlock);
+    }
+
     // Set active instance for static callback
     _activeInstance = this;
 
@@ -287,21 +638,35 @@ class VadPlus {
     nativeConfig.ref.frame_samples = config.frameSamples;
     nativeConfig.ref.end_speech_pad_frames = config.endSpeechPadFrames;
     nativeConfig.ref.is_debug = config.isDebug ? 1 : 0;
-
-    // Prepare model path
-    final Pointer<Char> nativeModelPath;
-    if (modelPath != null) {
+    nativeConfig.ref.speech_chunk_samples = config.speechChunkSamples;
+    nativeConfig.ref.max_speech_frames = config.maxSpeechFrames;
+    nativeConfig.ref.speech_end_by_reference = config.speechEndByReference ? 1 : 0;
+    nativeConfig.ref.input_sample_rate = config.inputSampleRate;
+    nativeConfig.ref.prefer_int8_model = config.preferInt8Model ? 1 : 0;
+    nativeConfig.ref.prewarm_frames = config.prewarmFrames;
+    nativeConfig.ref.silence_gate_frames = config.silenceGateFrames;
+    nativeConfig.ref.silence_gate_dbfs = config.silenceGateDbfs;
+    nativeConfig.ref.silence_gate_noise_margin_db = config.silenceGateNoiseMarginDb;
+
+    // Prepare model path, or the model itself (only read during the call)
+    Pointer<Char> nativeModelPath = nullptr;
+    Pointer<Uint8> nativeModel = nullptr;
+    if (modelBytes != null) {
+      nativeModel = calloc<Uint8>(modelBytes.length);
+      nativeModel.asTypedList(modelBytes.length).setAll(0, modelBytes);
+    } else if (modelPath != null) {
       nativeModelPath = modelPath.toNativeUtf8().cast<Char>();
-    } else {
-      nativeModelPath = nullptr;
     }
 
     try {
-      final result = _bindings.vad_init(
-        _handle!,
-        nativeConfig,
-        nativeModelPath,
-      );
+      final result = modelBytes != null
+          ? _bindings.vad_init_from_memory(
+              _handle!,
+              nativeConfig,
+              nativeModel.cast<Void>(),
+              modelBytes.length,
+            )
+          : _bindings.vad_init(_handle!, nativeConfig, nativeModelPath);
       if (result != 0) {
         final error = _getLastError();
         throw Exception('Failed to initialize VAD (code: $result): $error');
@@ -309,9 +674,12 @@ class VadPlus {
       _isInitialized = true;
     } finally {
       calloc.free(nativeConfig);
-      if (modelPath != null) {
+      if (nativeModelPath != nullptr) {
         calloc.free(nativeModelPath);
       }
+      if (nativeModel != nullptr) {
+        calloc.free(nativeModel);
+      }
     }
   }
 
@@ -341,7 +709,8 @@ class VadPlus {
   /// Process audio samples directly (without microphone capture).
   ///
   /// Use this when you have your own audio source.
-  /// [samples] - Float32 audio samples normalized to -1.0 to 1.0.
+  /// [samples] - Float32 audio samples normalized to -1.0 to 1.0, at
+  /// [VadConfig.inputSampleRate] when set.
   void processAudio(Float32List samples) {
     _ensureInitialized();
 
@@ -356,6 +725,166 @@ class VadPlus {
     }
   }
 
+  /// Process PCM16 audio directly, mono or interleaved.
+  ///
+  /// The samples are converted to float natively while they are framed, so
+  /// no float copy is made. [samples] holds [channels] interleaved channels;
+  /// [channel] picks one of them, or all of them are averaged when it is
+  /// null. The audio is at [VadConfig.inputSampleRate] when set.
+  void processAudioPcm16(
+    Int16List samples, {
+    int channels = 1,
+    int? channel,
+  }) {
+    _ensureInitialized();
+    if (channels < 1 ||
+        (channel != null && (channel < 0 || channel >= channels))) {
+      throw ArgumentError('Invalid channel $channel of $channels');
+    }
+
+    final frames = samples.length ~/ channels;
+    if (frames == 0) return;
+    final nativeSamples = calloc<Int16>(samples.length);
+    try {
+      nativeSamples.asTypedList(samples.length).setAll(0, samples);
+      _bindings.vad_process_audio_ex(
+        _handle!,
+        (nativeSamples + (channel ?? 0)).cast(),
+        frames,
+        VADSampleFormat.s16,
+        channel == null ? channels : 1,
+        channels,
+      );
+    } finally {
+      calloc.free(nativeSamples);
+    }
+  }
+
+  /// Run [frames] dummy frames so later frames run at warm latency.
+  ///
+  /// The VAD state is left untouched and no events are emitted. The latency
+  /// seen is reported by [warmupInfo].
+  void prewarm(int frames) {
+    _ensureInitialized();
+    final result = _bindings.vad_prewarm(_handle!, frames);
+    if (result != 0) {
+      final error = _getLastError();
+      throw Exception('Failed to prewarm VAD (code: $result): $error');
+    }
+  }
+
+  /// Cold versus warm per-frame latency since initialization.
+  ///
+  /// Waits for a warm-up started by [VadConfig.prewarmFrames] to finish.
+  VadWarmupInfo get warmupInfo {
+    _ensureInitialized();
+    final info = calloc<VADWarmupInfo>();
+    try {
+      _bindings.vad_get_warmup_info(_handle!, info);
+      return VadWarmupInfo(
+        prewarmFrames: info.ref.prewarm_frames,
+        coldFrameUs: info.ref.cold_frame_us,
+        warmFrameUs: info.ref.warm_frame_us,
+        firstFrameUs: info.ref.first_frame_us,
+      );
+    } finally {
+      calloc.free(info);
+    }
+  }
+
+  /// Runtime counters and latency percentiles.
+  ///
+  /// Recording is always on; reading is cheap enough to poll, e.g. once a
+  /// second for a debug overlay.
+  VadStats get stats {
+    _ensureInitialized();
+    final stats = calloc<VADStats>();
+    try {
+      _bindings.vad_get_stats(_handle!, stats);
+      final s = stats.ref;
+      return VadStats(
+        framesProcessed: s.frames_processed,
+        lateFrames: s.late_frames,
+        droppedSamples: s.dropped_samples,
+        callbacks: s.callbacks,
+        inference: VadLatency(
+          p50: s.inference_p50_us,
+          p95: s.inference_p95_us,
+          p99: s.inference_p99_us,
+          max: s.inference_max_us,
+        ),
+        callback: VadLatency(
+          p50: s.callback_p50_us,
+          p95: s.callback_p95_us,
+          p99: s.callback_p99_us,
+          max: s.callback_max_us,
+        ),
+        queuedSamples: s.queued_samples,
+        pendingEvents: s.pending_events,
+        speechBufferBytes: s.speech_buffer_bytes,
+        speechCapacityBytes: s.speech_capacity_bytes,
+        gatedFrames: s.gated_frames,
+        droppedEvents: s.dropped_events,
+      );
+    } finally {
+      calloc.free(stats);
+    }
+  }
+
+  /// Start recording a timeline trace of the native pipeline.
+  ///
+  /// Every stage (capture, framing, inference, VAD logic, and each event's
+  /// wait for the callback lock and time in the callback) is recorded as a
+  /// span into a per-thread ring keeping the latest [eventsPerThread] spans
+  /// (0 for 65536). Spans of an earlier trace are discarded. Write the trace
+  /// with [dumpTrace].
+  void startTrace({int eventsPerThread = 0}) {
+    _ensureInitialized();
+    final result = _bindings.vad_trace_start(_handle!, eventsPerThread);
+    if (result != 0) {
+      final error = _getLastError();
+      throw Exception('Failed to start trace (code: $result): $error');
+    }
+  }
+
+  /// Stop recording the trace; the spans are kept for [dumpTrace].
+  void stopTrace() {
+    if (_handle != null) {
+      _bindings.vad_trace_stop(_handle!);
+    }
+  }
+
+  /// Write the trace as Chrome trace-event JSON to [path].
+  ///
+  /// Open the file in Perfetto (ui.perfetto.dev) or chrome://tracing.
+  /// Call [stopTrace] first for a consistent snapshot.
+  void dumpTrace(String path) {
+    _ensureInitialized();
+    final nativePath = path.toNativeUtf8().cast<Char>();
+    try {
+      final result = _bindings.vad_trace_dump(_handle!, nativePath);
+      if (result != 0) {
+        final error = _getLastError();
+        throw Exception('Failed to write trace (code: $result): $error');
+      }
+    } finally {
+      calloc.free(nativePath);
+    }
+  }
+
+  /// Choose which events are emitted on [events].
+  ///
+  /// [mask] - OR of [VadEventMask] bits. Disabled events are dropped on the
+  /// native side before their data is copied, so e.g.
+  /// [VadEventMask.allButFrames] removes the per-frame cost when only speech
+  /// segments are needed.
+  /// [frameInterval] - Emit only every Nth [VadFrameProcessed] event.
+  void setEventMask(int mask, {int frameInterval = 1}) {
+    _ensureInitialized();
+    _bindings.vad_set_event_mask(_handle!, mask);
+    _bindings.vad_set_frame_event_interval(_handle!, frameInterval);
+  }
+
   /// Reset VAD state (clear buffers and speech detection state).
   void reset() {
     if (_handle != null) {
@@ -399,6 +928,8 @@ class VadPlus {
       _previousInstance = null;
     }
 
+    // The status block is freed with the handle
+    _status = null;
     if (_handle != null) {
       _bindings.vad_destroy(_handle!);
       _handle = null;
@@ -445,21 +976,23 @@ class VadPlus {
   }
 
   /// Static callback handler that receives events from native code.
-  /// Called synchronously from the native side (via DispatchQueue.main).
+  /// Runs later on the Dart event loop; the event stays valid until it is
+  /// handed back with vad_event_release, which must happen exactly once.
   static void _onNativeEvent(
     Pointer<VADEvent> eventPtr,
     Pointer<Void> userData,
   ) {
-    final instance = _activeInstance;
-    if (instance == null || eventPtr == nullptr) return;
-
-    // Check if instance is disposed to avoid processing stale events
-    if (instance._isDisposed) return;
+    if (eventPtr == nullptr) return;
 
-    // Read and copy data from the pointer immediately since we're called
-    // synchronously and the pointer is only valid during this call
-    final event = eventPtr.ref;
-    instance._processNativeEvent(event);
+    final instance = _activeInstance;
+    try {
+      // Stale events for a disposed instance are only released
+      if (instance != null && !instance._isDisposed) {
+        instance._processNativeEvent(eventPtr.ref);
+      }
+    } finally {
+      _bindings.vad_event_release(instance?._handle ?? nullptr, eventPtr);
+    }
   }
 
   static VadPlus? _activeInstance;
@@ -469,33 +1002,32 @@ class VadPlus {
       case VADEventType.initialized:
         _eventController.add(const VadInitialized());
       case VADEventType.speechStart:
-        _eventController.add(const VadSpeechStart());
+        _eventController.add(
+          VadSpeechStart(startSample: event.segment_start_sample),
+        );
       case VADEventType.speechEnd:
         final audioLength = event.speech_end_audio_length;
         final audioPtr = event.speech_end_audio_data;
-        if (audioPtr != nullptr && audioLength > 0) {
-          // Copy the audio data immediately while pointer is valid
-          final audioData = Int16List(audioLength);
-          for (var i = 0; i < audioLength; i++) {
-            audioData[i] = audioPtr[i];
-          }
-          _eventController.add(
-            VadSpeechEnd(
-              audioData: audioData,
-              durationMs: event.speech_end_duration_ms,
-            ),
-          );
-        }
+        // Copy the audio data immediately while pointer is valid; there is
+        // none when the segment is sent by reference
+        final audioData = audioPtr != nullptr && audioLength > 0
+            ? Int16List.fromList(audioPtr.asTypedList(audioLength))
+            : Int16List(0);
+        _eventController.add(
+          VadSpeechEnd(
+            audioData: audioData,
+            durationMs: event.speech_end_duration_ms,
+            startSample: event.segment_start_sample,
+            endSample: event.segment_end_sample,
+          ),
+        );
       case VADEventType.frameProcessed:
         final frameLength = event.frame_length;
         final framePtr = event.frame_data;
         Float32List audioData;
         if (framePtr != nullptr && frameLength > 0) {
           // Copy the audio data immediately while pointer is valid
-          audioData = Float32List(frameLength);
-          for (var i = 0; i < frameLength; i++) {
-            audioData[i] = framePtr[i];
-          }
+          audioData = Float32List.fromList(framePtr.asTypedList(frameLength));
         } else {
           audioData = Float32List(0);
         }
@@ -509,7 +1041,12 @@ class VadPlus {
       case VADEventType.realSpeechStart:
         _eventController.add(const VadRealSpeechStart());
       case VADEventType.misfire:
-        _eventController.add(const VadMisfire());
+        _eventController.add(
+          VadMisfire(
+            startSample: event.segment_start_sample,
+            endSample: event.segment_end_sample,
+          ),
+        );
       case VADEventType.error:
         final messagePtr = event.error_message;
         final message = messagePtr != nullptr
@@ -518,6 +1055,18 @@ class VadPlus {
         _eventController.add(
           VadError(message: message, code: event.error_code),
         );
+      case VADEventType.speechChunk:
+        final audioLength = event.speech_chunk_audio_length;
+        final audioPtr = event.speech_chunk_audio_data;
+        _eventController.add(
+          VadSpeechChunk(
+            audioData: audioPtr != nullptr && audioLength > 0
+                ? Int16List.fromList(audioPtr.asTypedList(audioLength))
+                : Int16List(0),
+            offset: event.speech_chunk_offset,
+            isLast: event.speech_chunk_is_last != 0,
+          ),
+        );
       case VADEventType.stopped:
         _eventController.add(const VadStopped());
     }
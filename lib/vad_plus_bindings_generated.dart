@@ -99,6 +99,43 @@ class VadPlusBindings {
         )
       >();
 
+  /// Initialize VAD with configuration and a model held in memory, e.g. embedded
+  /// in the application binary, instead of a file
+  /// The buffer is borrowed: it is read during the call only, never copied or
+  /// kept, so it may be read-only and can be freed as soon as the call returns.
+  /// On iOS/macOS, where ONNX Runtime only opens model files, a model not seen
+  /// before is written once to the temporary directory instead.
+  /// prefer_int8_model is ignored; the buffer's model is used as is.
+  int vad_init_from_memory(
+    ffi.Pointer<VADHandle> handle,
+    ffi.Pointer<VADConfig> config,
+    ffi.Pointer<ffi.Void> data,
+    int length,
+  ) {
+    return _vad_init_from_memory(handle, config, data, length);
+  }
+
+  late final _vad_init_from_memoryPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<VADHandle>,
+            ffi.Pointer<VADConfig>,
+            ffi.Pointer<ffi.Void>,
+            ffi.Size,
+          )
+        >
+      >('vad_init_from_memory');
+  late final _vad_init_from_memory = _vad_init_from_memoryPtr
+      .asFunction<
+        int Function(
+          ffi.Pointer<VADHandle>,
+          ffi.Pointer<VADConfig>,
+          ffi.Pointer<ffi.Void>,
+          int,
+        )
+      >();
+
   /// Set the event callback for VAD events
   void vad_set_callback(
     ffi.Pointer<VADHandle> handle,
@@ -140,6 +177,30 @@ class VadPlusBindings {
   late final _vad_invalidate_callback = _vad_invalidate_callbackPtr
       .asFunction<void Function(ffi.Pointer<VADHandle>)>();
 
+  /// Choose which event types reach the callback
+  void vad_set_event_mask(ffi.Pointer<VADHandle> handle, int mask) {
+    return _vad_set_event_mask(handle, mask);
+  }
+
+  late final _vad_set_event_maskPtr =
+      _lookup<
+        ffi.NativeFunction<ffi.Void Function(ffi.Pointer<VADHandle>, ffi.Uint32)>
+      >('vad_set_event_mask');
+  late final _vad_set_event_mask = _vad_set_event_maskPtr
+      .asFunction<void Function(ffi.Pointer<VADHandle>, int)>();
+
+  /// Deliver only every Nth VAD_EVENT_FRAME_PROCESSED event
+  void vad_set_frame_event_interval(ffi.Pointer<VADHandle> handle, int interval) {
+    return _vad_set_frame_event_interval(handle, interval);
+  }
+
+  late final _vad_set_frame_event_intervalPtr =
+      _lookup<
+        ffi.NativeFunction<ffi.Void Function(ffi.Pointer<VADHandle>, ffi.Int32)>
+      >('vad_set_frame_event_interval');
+  late final _vad_set_frame_event_interval = _vad_set_frame_event_intervalPtr
+      .asFunction<void Function(ffi.Pointer<VADHandle>, int)>();
+
   // ============================================================================
   // VAD Control
   // ============================================================================
@@ -192,6 +253,43 @@ class VadPlusBindings {
         int Function(ffi.Pointer<VADHandle>, ffi.Pointer<ffi.Float>, int)
       >();
 
+  /// Process PCM16 or float audio, mono or interleaved
+  int vad_process_audio_ex(
+    ffi.Pointer<VADHandle> handle,
+    ffi.Pointer<ffi.Void> data,
+    int frames,
+    int format,
+    int channels,
+    int stride,
+  ) {
+    return _vad_process_audio_ex(handle, data, frames, format, channels, stride);
+  }
+
+  late final _vad_process_audio_exPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Int32 Function(
+            ffi.Pointer<VADHandle>,
+            ffi.Pointer<ffi.Void>,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Int32,
+            ffi.Int32,
+          )
+        >
+      >('vad_process_audio_ex');
+  late final _vad_process_audio_ex = _vad_process_audio_exPtr
+      .asFunction<
+        int Function(
+          ffi.Pointer<VADHandle>,
+          ffi.Pointer<ffi.Void>,
+          int,
+          int,
+          int,
+          int,
+        )
+      >();
+
   /// Reset VAD state
   void vad_reset(ffi.Pointer<VADHandle> handle) {
     return _vad_reset(handle);
@@ -229,6 +327,141 @@ class VadPlusBindings {
   late final _vad_is_speaking = _vad_is_speakingPtr
       .asFunction<int Function(ffi.Pointer<VADHandle>)>();
 
+  /// Get the handle's live status block, valid until vad_destroy
+  ffi.Pointer<VADStatusBlock> vad_get_status_block(
+    ffi.Pointer<VADHandle> handle,
+  ) {
+    return _vad_get_status_block(handle);
+  }
+
+  late final _vad_get_status_blockPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Pointer<VADStatusBlock> Function(ffi.Pointer<VADHandle>)
+        >
+      >('vad_get_status_block');
+  late final _vad_get_status_block = _vad_get_status_blockPtr
+      .asFunction<
+        ffi.Pointer<VADStatusBlock> Function(ffi.Pointer<VADHandle>)
+      >();
+
+  /// Run n_frames dummy frames on scratch state, leaving the handle's state
+  /// untouched and emitting no events
+  int vad_prewarm(ffi.Pointer<VADHandle> handle, int n_frames) {
+    return _vad_prewarm(handle, n_frames);
+  }
+
+  late final _vad_prewarmPtr =
+      _lookup<
+        ffi.NativeFunction<ffi.Int32 Function(ffi.Pointer<VADHandle>, ffi.Int32)>
+      >('vad_prewarm');
+  late final _vad_prewarm = _vad_prewarmPtr
+      .asFunction<int Function(ffi.Pointer<VADHandle>, int)>();
+
+  /// Get cold and warm per-frame latency, waiting for a background warm-up
+  int vad_get_warmup_info(
+    ffi.Pointer<VADHandle> handle,
+    ffi.Pointer<VADWarmupInfo> info_out,
+  ) {
+    return _vad_get_warmup_info(handle, info_out);
+  }
+
+  late final _vad_get_warmup_infoPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Int32 Function(ffi.Pointer<VADHandle>, ffi.Pointer<VADWarmupInfo>)
+        >
+      >('vad_get_warmup_info');
+  late final _vad_get_warmup_info = _vad_get_warmup_infoPtr
+      .asFunction<
+        int Function(ffi.Pointer<VADHandle>, ffi.Pointer<VADWarmupInfo>)
+      >();
+
+  /// Get runtime counters and latency percentiles; callable from any thread
+  /// while audio is processed
+  int vad_get_stats(
+    ffi.Pointer<VADHandle> handle,
+    ffi.Pointer<VADStats> stats_out,
+  ) {
+    return _vad_get_stats(handle, stats_out);
+  }
+
+  late final _vad_get_statsPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Int32 Function(ffi.Pointer<VADHandle>, ffi.Pointer<VADStats>)
+        >
+      >('vad_get_stats');
+  late final _vad_get_stats = _vad_get_statsPtr
+      .asFunction<int Function(ffi.Pointer<VADHandle>, ffi.Pointer<VADStats>)>();
+
+  /// Start recording a timeline of the pipeline stages into per-thread
+  /// lock-free rings of events_per_thread spans (0 for the default)
+  int vad_trace_start(ffi.Pointer<VADHandle> handle, int events_per_thread) {
+    return _vad_trace_start(handle, events_per_thread);
+  }
+
+  late final _vad_trace_startPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Int32 Function(ffi.Pointer<VADHandle>, ffi.Int32)
+        >
+      >('vad_trace_start');
+  late final _vad_trace_start = _vad_trace_startPtr
+      .asFunction<int Function(ffi.Pointer<VADHandle>, int)>();
+
+  /// Stop recording; the spans are kept for vad_trace_dump
+  void vad_trace_stop(ffi.Pointer<VADHandle> handle) {
+    return _vad_trace_stop(handle);
+  }
+
+  late final _vad_trace_stopPtr =
+      _lookup<ffi.NativeFunction<ffi.Void Function(ffi.Pointer<VADHandle>)>>(
+        'vad_trace_stop',
+      );
+  late final _vad_trace_stop = _vad_trace_stopPtr
+      .asFunction<void Function(ffi.Pointer<VADHandle>)>();
+
+  /// Write the spans of the last trace as Chrome trace-event JSON (Perfetto)
+  int vad_trace_dump(
+    ffi.Pointer<VADHandle> handle,
+    ffi.Pointer<ffi.Char> path,
+  ) {
+    return _vad_trace_dump(handle, path);
+  }
+
+  late final _vad_trace_dumpPtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Int32 Function(ffi.Pointer<VADHandle>, ffi.Pointer<ffi.Char>)
+        >
+      >('vad_trace_dump');
+  late final _vad_trace_dump = _vad_trace_dumpPtr
+      .asFunction<
+        int Function(ffi.Pointer<VADHandle>, ffi.Pointer<ffi.Char>)
+      >();
+
+  /// Return an event delivered to the callback to the handle's event pool
+  /// Every delivered event must be released, from any thread, even after
+  /// vad_destroy; the handle may be null
+  void vad_event_release(
+    ffi.Pointer<VADHandle> handle,
+    ffi.Pointer<VADEvent> event,
+  ) {
+    return _vad_event_release(handle, event);
+  }
+
+  late final _vad_event_releasePtr =
+      _lookup<
+        ffi.NativeFunction<
+          ffi.Void Function(ffi.Pointer<VADHandle>, ffi.Pointer<VADEvent>)
+        >
+      >('vad_event_release');
+  late final _vad_event_release = _vad_event_releasePtr
+      .asFunction<
+        void Function(ffi.Pointer<VADHandle>, ffi.Pointer<VADEvent>)
+      >();
+
   /// Get the last error message
   ffi.Pointer<ffi.Char> vad_get_last_error(ffi.Pointer<VADHandle> handle) {
     return _vad_get_last_error(handle);
@@ -329,6 +562,39 @@ final class VADConfig extends ffi.Struct {
   /// 0 = false, 1 = true (using Int32 for C compatibility)
   @ffi.Int32()
   external int is_debug;
+
+  @ffi.Int32()
+  external int speech_chunk_samples;
+
+  @ffi.Int32()
+  external int max_speech_frames;
+
+  /// 0 = false, 1 = true (using Int32 for C compatibility)
+  @ffi.Int32()
+  external int speech_end_by_reference;
+
+  /// 0 = same as sample_rate
+  @ffi.Int32()
+  external int input_sample_rate;
+
+  /// 0 = false, 1 = true (using Int32 for C compatibility)
+  @ffi.Int32()
+  external int prefer_int8_model;
+
+  /// 0 = no warm-up
+  @ffi.Int32()
+  external int prewarm_frames;
+
+  /// 0 = silence gate off
+  @ffi.Int32()
+  external int silence_gate_frames;
+
+  @ffi.Float()
+  external double silence_gate_dbfs;
+
+  /// 0 = fixed silence_gate_dbfs only
+  @ffi.Float()
+  external double silence_gate_noise_margin_db;
 }
 
 /// Opaque VAD Handle
@@ -366,6 +632,128 @@ final class VADEvent extends ffi.Struct {
 
   @ffi.Int32()
   external int error_code;
+
+  // Speech chunk data
+  external ffi.Pointer<ffi.Int16> speech_chunk_audio_data;
+
+  @ffi.Int32()
+  external int speech_chunk_audio_length;
+
+  @ffi.Int32()
+  external int speech_chunk_offset;
+
+  /// 0 = false, 1 = true (using Int32 for C compatibility)
+  @ffi.Int32()
+  external int speech_chunk_is_last;
+
+  // Segment position (speech start, speech end, misfire)
+  @ffi.Int64()
+  external int segment_start_sample;
+
+  @ffi.Int64()
+  external int segment_end_sample;
+}
+
+/// Number of recent frame probabilities kept in VADStatusBlock.history
+const int VAD_STATUS_HISTORY = 64;
+
+/// Live handle status in native memory (seqlock-protected, see vad_plus.h)
+final class VADStatusBlock extends ffi.Struct {
+  /// Seqlock counter, odd while the writer is updating
+  @ffi.Uint32()
+  external int sequence;
+
+  /// 1 while speech is detected, 0 otherwise
+  @ffi.Int32()
+  external int is_speaking;
+
+  /// Frames processed since the last reset (wraps at 2^32)
+  @ffi.Uint32()
+  external int frame_count;
+
+  @ffi.Float()
+  external double last_probability;
+
+  @ffi.Uint32()
+  external int history_length;
+
+  @ffi.Array.multi([11])
+  external ffi.Array<ffi.Uint32> reserved;
+
+  @ffi.Array.multi([VAD_STATUS_HISTORY])
+  external ffi.Array<ffi.Float> history;
+}
+
+/// Cold versus warm per-frame inference latency (see vad_plus.h)
+final class VADWarmupInfo extends ffi.Struct {
+  @ffi.Int32()
+  external int prewarm_frames;
+
+  @ffi.Float()
+  external double cold_frame_us;
+
+  @ffi.Float()
+  external double warm_frame_us;
+
+  @ffi.Float()
+  external double first_frame_us;
+}
+
+/// Runtime counters and latency percentiles of a handle (see vad_plus.h)
+final class VADStats extends ffi.Struct {
+  @ffi.Uint64()
+  external int frames_processed;
+
+  @ffi.Uint64()
+  external int late_frames;
+
+  @ffi.Uint64()
+  external int dropped_samples;
+
+  @ffi.Uint64()
+  external int callbacks;
+
+  @ffi.Float()
+  external double inference_p50_us;
+
+  @ffi.Float()
+  external double inference_p95_us;
+
+  @ffi.Float()
+  external double inference_p99_us;
+
+  @ffi.Float()
+  external double inference_max_us;
+
+  @ffi.Float()
+  external double callback_p50_us;
+
+  @ffi.Float()
+  external double callback_p95_us;
+
+  @ffi.Float()
+  external double callback_p99_us;
+
+  @ffi.Float()
+  external double callback_max_us;
+
+  @ffi.Int32()
+  external int queued_samples;
+
+  @ffi.Int32()
+  external int pending_events;
+
+  @ffi.Int64()
+  external int speech_buffer_bytes;
+
+  @ffi.Int64()
+  external int speech_capacity_bytes;
+
+  @ffi.Uint64()
+  external int gated_frames;
+
+  @ffi.Uint64()
+  external int dropped_events;
 }
 
 /// Native callback type definition (receives pointer to event for C compatibility)
@@ -393,4 +781,11 @@ abstract class VADEventType {
   static const int misfire = 5;
   static const int error = 6;
   static const int stopped = 7;
+  static const int speechChunk = 8;
+}
+
+/// Sample format constants (VADSampleFormat)
+abstract class VADSampleFormat {
+  static const int f32 = 0;
+  static const int s16 = 1;
 }
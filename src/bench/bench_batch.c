@@ -0,0 +1,152 @@
+// Frames per second on one core for N independent streams, running the model
+// once per stream versus one batched pass over all streams.
+//
+// Usage: vad_plus_bench_batch [model.onnx]
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vad_model.h"
+#include "vad_platform.h"
+
+#ifndef VAD_PLUS_BENCH_MODEL
+#define VAD_PLUS_BENCH_MODEL "silero_vad_v6.onnx"
+#endif
+
+#define TARGET_NS 500000000ull
+
+static const int32_t kBatchSizes[] = {1, 8, 32, 128};
+
+typedef struct BenchStreams
+{
+  int32_t count;
+  int32_t input_length;
+  float *inputs;
+  float *states;
+  const float **input_ptrs;
+  float **state_ptrs;
+  float *probabilities;
+} BenchStreams;
+
+static void streams_init(BenchStreams *s, const VADModelRate *rate, int32_t count)
+{
+  s->count = count;
+  s->input_length = rate->context_size + rate->frame_samples;
+  s->inputs = (float *)vad_aligned_alloc((size_t)count * s->input_length * sizeof(float));
+  s->states = (float *)vad_aligned_alloc((size_t)count * VAD_MODEL_STATE_SIZE * sizeof(float));
+  s->input_ptrs = (const float **)malloc((size_t)count * sizeof(float *));
+  s->state_ptrs = (float **)malloc((size_t)count * sizeof(float *));
+  s->probabilities = (float *)malloc((size_t)count * sizeof(float));
+
+  // Different audio per stream: noise with a stream-specific tone
+  uint32_t seed = 7;
+  for (int32_t n = 0; n < count; n++)
+  {
+    float *input = s->inputs + (size_t)n * s->input_length;
+    for (int32_t i = 0; i < s->input_length; i++)
+    {
+      seed = seed * 1664525u + 1013904223u;
+      float noise = ((float)(seed >> 8) / 16777216.0f - 0.5f) * 0.1f;
+      input[i] = noise + 0.3f * sinf(0.05f * (float)(n + 1) * (float)i);
+    }
+    s->input_ptrs[n] = input;
+    s->state_ptrs[n] = s->states + (size_t)n * VAD_MODEL_STATE_SIZE;
+  }
+  memset(s->states, 0, (size_t)count * VAD_MODEL_STATE_SIZE * sizeof(float));
+}
+
+static void streams_free(BenchStreams *s)
+{
+  vad_aligned_free(s->inputs);
+  vad_aligned_free(s->states);
+  free(s->input_ptrs);
+  free(s->state_ptrs);
+  free(s->probabilities);
+}
+
+static void step_sequential(const VADModelRate *rate, BenchStreams *s)
+{
+  for (int32_t n = 0; n < s->count; n++)
+    s->probabilities[n] = vad_model_infer(rate, s->input_ptrs[n], s->state_ptrs[n]);
+}
+
+static void step_batched(const VADModelRate *rate, BenchStreams *s)
+{
+  vad_model_infer_batch(rate, s->input_ptrs, s->state_ptrs, s->count, s->probabilities);
+}
+
+/// Frames per second of one stepping strategy
+static double measure(const VADModelRate *rate, BenchStreams *s,
+                      void (*step)(const VADModelRate *, BenchStreams *))
+{
+  step(rate, s);
+
+  uint64_t steps = 0;
+  uint64_t start = vad_now_ns();
+  uint64_t elapsed;
+  do
+  {
+    step(rate, s);
+    steps++;
+    elapsed = vad_now_ns() - start;
+  } while (elapsed < TARGET_NS);
+
+  return (double)steps * s->count / ((double)elapsed / 1e9);
+}
+
+int main(int argc, char **argv)
+{
+  const char *model_path = argc > 1 ? argv[1] : VAD_PLUS_BENCH_MODEL;
+
+  VADModel model;
+  char error[256];
+  if (vad_model_load_file(&model, model_path, error, sizeof(error)) != 0)
+  {
+    fprintf(stderr, "%s\n", error);
+    return 1;
+  }
+  const VADModelRate *rate = vad_model_get_rate(&model, 16000);
+  if (rate == NULL)
+  {
+    fprintf(stderr, "Model has no 16 kHz weights\n");
+    return 1;
+  }
+
+  printf("%-8s %16s %16s %10s %12s\n", "batch", "sequential fps", "batched fps", "speedup", "max |dp|");
+  for (size_t b = 0; b < sizeof(kBatchSizes) / sizeof(kBatchSizes[0]); b++)
+  {
+    int32_t count = kBatchSizes[b];
+
+    // Both paths must agree before timing them
+    BenchStreams check_a, check_b;
+    streams_init(&check_a, rate, count);
+    streams_init(&check_b, rate, count);
+    float max_diff = 0.0f;
+    for (int32_t step = 0; step < 10; step++)
+    {
+      step_sequential(rate, &check_a);
+      step_batched(rate, &check_b);
+      for (int32_t n = 0; n < count; n++)
+      {
+        float diff = fabsf(check_a.probabilities[n] - check_b.probabilities[n]);
+        if (diff > max_diff)
+          max_diff = diff;
+      }
+    }
+    streams_free(&check_a);
+    streams_free(&check_b);
+
+    BenchStreams streams;
+    streams_init(&streams, rate, count);
+    double sequential = measure(rate, &streams, step_sequential);
+    double batched = measure(rate, &streams, step_batched);
+    streams_free(&streams);
+
+    printf("%-8d %16.0f %16.0f %9.2fx %12.2e\n", count, sequential, batched, batched / sequential, max_diff);
+  }
+
+  vad_model_free(&model);
+  return 0;
+}
@@ -0,0 +1,176 @@
+// Throughput of the sample conversion routines for every instruction set
+// supported by this CPU, in millions of samples per second.
+//
+// Usage: vad_plus_bench_convert [samples_per_call]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vad_convert.h"
+#include "vad_platform.h"
+
+#define DEFAULT_SAMPLES 4096
+#define TARGET_NS 200000000ull
+
+typedef struct BenchBuffers
+{
+  int16_t *s16;
+  int16_t *s16_out;
+  int32_t *s32;
+  uint8_t *u8;
+  float *f32;
+  float *f32_out;
+  int32_t count;
+} BenchBuffers;
+
+typedef void (*BenchKernel)(BenchBuffers *buffers);
+
+static void run_s16_to_f32(BenchBuffers *b)
+{
+  vad_convert_s16_to_f32(b->s16, b->f32_out, b->count);
+}
+
+static void run_s32_to_f32(BenchBuffers *b)
+{
+  vad_convert_s32_to_f32(b->s32, b->f32_out, b->count);
+}
+
+static void run_u8_to_f32(BenchBuffers *b)
+{
+  vad_convert_u8_to_f32(b->u8, b->f32_out, b->count);
+}
+
+static void run_f32_to_s16(BenchBuffers *b)
+{
+  vad_convert_f32_to_s16(b->f32, b->s16_out, b->count);
+}
+
+static void run_f32_clamp(BenchBuffers *b)
+{
+  vad_convert_f32_clamp(b->f32, b->f32_out, b->count);
+}
+
+// Stereo kernels read count interleaved samples (count / 2 frames)
+static void run_s16_stereo_to_mono(BenchBuffers *b)
+{
+  vad_convert_s16_stereo_to_f32_mono(b->s16, b->f32_out, b->count / 2);
+}
+
+static void run_f32_stereo_to_mono(BenchBuffers *b)
+{
+  vad_convert_f32_stereo_to_mono(b->f32, b->f32_out, b->count / 2);
+}
+
+static void run_s16_pick_right(BenchBuffers *b)
+{
+  vad_convert_s16_channel_to_f32(b->s16, 2, 1, b->f32_out, b->count / 2);
+}
+
+// Sum of squares and peak, kept in the output so the call is not dropped
+static void run_f32_level(BenchBuffers *b)
+{
+  vad_convert_f32_level(b->f32, b->count, &b->f32_out[0], &b->f32_out[1]);
+}
+
+static const struct
+{
+  const char *name;
+  BenchKernel kernel;
+} kKernels[] = {
+    {"s16_to_f32", run_s16_to_f32},
+    {"s32_to_f32", run_s32_to_f32},
+    {"u8_to_f32", run_u8_to_f32},
+    {"f32_to_s16", run_f32_to_s16},
+    {"f32_clamp", run_f32_clamp},
+    {"s16_stereo_to_mono", run_s16_stereo_to_mono},
+    {"f32_stereo_to_mono", run_f32_stereo_to_mono},
+    {"s16_pick_channel", run_s16_pick_right},
+    {"f32_level", run_f32_level},
+};
+
+#define KERNEL_COUNT ((int32_t)(sizeof(kKernels) / sizeof(kKernels[0])))
+
+/// Samples per second of one kernel, timed over at least TARGET_NS
+static double measure(BenchKernel kernel, BenchBuffers *buffers)
+{
+  for (int32_t i = 0; i < 100; i++)
+    kernel(buffers);
+
+  uint64_t iterations = 0;
+  uint64_t start = vad_now_ns();
+  uint64_t elapsed;
+  do
+  {
+    for (int32_t i = 0; i < 1000; i++)
+      kernel(buffers);
+    iterations += 1000;
+    elapsed = vad_now_ns() - start;
+  } while (elapsed < TARGET_NS);
+
+  return (double)iterations * buffers->count / ((double)elapsed / 1e9);
+}
+
+int main(int argc, char **argv)
+{
+  BenchBuffers buffers;
+  buffers.count = argc > 1 ? atoi(argv[1]) : DEFAULT_SAMPLES;
+  if (buffers.count <= 0)
+  {
+    fprintf(stderr, "Invalid sample count\n");
+    return 1;
+  }
+
+  size_t count = (size_t)buffers.count;
+  buffers.s16 = (int16_t *)vad_aligned_alloc(count * sizeof(int16_t));
+  buffers.s16_out = (int16_t *)vad_aligned_alloc(count * sizeof(int16_t));
+  buffers.s32 = (int32_t *)vad_aligned_alloc(count * sizeof(int32_t));
+  buffers.u8 = (uint8_t *)vad_aligned_alloc(count);
+  buffers.f32 = (float *)vad_aligned_alloc(count * sizeof(float));
+  buffers.f32_out = (float *)vad_aligned_alloc(count * sizeof(float));
+
+  uint32_t seed = 1;
+  for (size_t i = 0; i < count; i++)
+  {
+    seed = seed * 1664525u + 1013904223u;
+    buffers.s16[i] = (int16_t)(seed >> 16);
+    buffers.s32[i] = (int32_t)seed;
+    buffers.u8[i] = (uint8_t)(seed >> 24);
+    // Some samples out of [-1, 1] to exercise the clamp
+    buffers.f32[i] = ((float)(seed >> 8) / 16777216.0f - 0.5f) * 2.5f;
+  }
+
+  static const VADConvertIsa kIsas[] = {VAD_CONVERT_ISA_SCALAR, VAD_CONVERT_ISA_SSE2, VAD_CONVERT_ISA_AVX2,
+                                        VAD_CONVERT_ISA_NEON};
+  VADConvertIsa best = vad_convert_detect_isa();
+
+  printf("samples per call: %d, default isa: %s\n", buffers.count, vad_convert_isa_name(best));
+  printf("%-20s", "Msamples/s");
+  for (size_t k = 0; k < sizeof(kIsas) / sizeof(kIsas[0]); k++)
+  {
+    if (vad_convert_set_isa(kIsas[k]) == 0)
+      printf("%12s", vad_convert_isa_name(kIsas[k]));
+  }
+  printf("\n");
+
+  for (int32_t n = 0; n < KERNEL_COUNT; n++)
+  {
+    printf("%-20s", kKernels[n].name);
+    for (size_t k = 0; k < sizeof(kIsas) / sizeof(kIsas[0]); k++)
+    {
+      if (vad_convert_set_isa(kIsas[k]) != 0)
+        continue;
+      printf("%12.1f", measure(kKernels[n].kernel, &buffers) / 1e6);
+    }
+    printf("\n");
+  }
+
+  vad_convert_set_isa(best);
+  vad_aligned_free(buffers.s16);
+  vad_aligned_free(buffers.s16_out);
+  vad_aligned_free(buffers.s32);
+  vad_aligned_free(buffers.u8);
+  vad_aligned_free(buffers.f32);
+  vad_aligned_free(buffers.f32_out);
+  return 0;
+}
@@ -0,0 +1,120 @@
+// Cost of frame events on the processing thread, with VAD_EVENT_FRAME_PROCESSED
+// delivered for every frame, every 4th frame, or masked off.
+//
+// The callback models what the Dart listener does with each event: one heap
+// array per frame event holding a copy of the frame, then vad_event_release().
+// Times are per processed frame and include inference.
+//
+// Usage: vad_plus_bench_events [model.onnx]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vad_plus.h"
+#include "vad_platform.h"
+
+#ifndef VAD_PLUS_BENCH_MODEL
+#define VAD_PLUS_BENCH_MODEL "silero_vad_v6.onnx"
+#endif
+
+#define TARGET_NS 1000000000ull
+#define PACKET_SAMPLES 512
+
+typedef struct ConsumerStats
+{
+  VADHandle *handle;
+  uint64_t events;
+  uint64_t allocations;
+  uint64_t bytes;
+  float checksum;
+} ConsumerStats;
+
+static void on_event(const VADEvent *event, void *user_data)
+{
+  ConsumerStats *stats = (ConsumerStats *)user_data;
+  stats->events++;
+
+  if (event->type == VAD_EVENT_FRAME_PROCESSED && event->frame_length > 0)
+  {
+    size_t size = (size_t)event->frame_length * sizeof(float);
+    float *copy = (float *)malloc(size);
+    memcpy(copy, event->frame_data, size);
+    stats->checksum += copy[0];
+    stats->allocations++;
+    stats->bytes += size;
+    free(copy);
+  }
+  vad_event_release(stats->handle, event);
+}
+
+static const struct
+{
+  const char *name;
+  uint32_t mask;
+  int32_t interval;
+} kModes[] = {
+    {"all events", VAD_EVENT_MASK_ALL, 1},
+    {"frame every 4th", VAD_EVENT_MASK_ALL, 4},
+    {"frame masked", VAD_EVENT_MASK_ALL & ~VAD_EVENT_MASK(VAD_EVENT_FRAME_PROCESSED), 1},
+};
+
+int main(int argc, char **argv)
+{
+  const char *model_path = argc > 1 ? argv[1] : VAD_PLUS_BENCH_MODEL;
+
+  // Alternating tone bursts and near-silence, so speech events fire as well
+  static float audio[16000 * 4];
+  int32_t audio_length = (int32_t)(sizeof(audio) / sizeof(audio[0]));
+  uint32_t seed = 3;
+  for (int32_t i = 0; i < audio_length; i++)
+  {
+    seed = seed * 1664525u + 1013904223u;
+    float noise = ((float)(seed >> 8) / 16777216.0f - 0.5f) * 0.01f;
+    float tone = ((i / 16000) % 2 == 0) ? 0.4f * (float)((i / 40) % 2 ? 1 : -1) : 0.0f;
+    audio[i] = noise + tone;
+  }
+
+  printf("%-18s %12s %12s %14s %14s\n", "mode", "ns/frame", "events/s", "allocs/frame", "bytes/frame");
+  for (size_t m = 0; m < sizeof(kModes) / sizeof(kModes[0]); m++)
+  {
+    ConsumerStats stats;
+    memset(&stats, 0, sizeof(stats));
+
+    VADHandle *handle = vad_create();
+    VADConfig config;
+    vad_config_default(&config);
+    if (handle == NULL || vad_init(handle, &config, model_path) != 0)
+    {
+      fprintf(stderr, "%s\n", handle ? vad_get_last_error(handle) : "vad_create failed");
+      return 1;
+    }
+    stats.handle = handle;
+    vad_set_callback(handle, on_event, &stats);
+    vad_set_event_mask(handle, kModes[m].mask);
+    vad_set_frame_event_interval(handle, kModes[m].interval);
+
+    // Warm-up pass, then reset the counters
+    vad_process_audio(handle, audio, audio_length);
+    stats.events = stats.allocations = stats.bytes = 0;
+
+    uint64_t samples = 0;
+    uint64_t start = vad_now_ns();
+    uint64_t elapsed;
+    do
+    {
+      for (int32_t offset = 0; offset + PACKET_SAMPLES <= audio_length; offset += PACKET_SAMPLES)
+        vad_process_audio(handle, audio + offset, PACKET_SAMPLES);
+      samples += (uint64_t)(audio_length / PACKET_SAMPLES) * PACKET_SAMPLES;
+      elapsed = vad_now_ns() - start;
+    } while (elapsed < TARGET_NS);
+
+    double frames = (double)samples / config.frame_samples;
+    printf("%-18s %12.0f %12.0f %14.3f %14.1f\n", kModes[m].name, (double)elapsed / frames,
+           (double)stats.events / ((double)elapsed / 1e9), (double)stats.allocations / frames,
+           (double)stats.bytes / frames);
+
+    vad_destroy(handle);
+  }
+  return 0;
+}
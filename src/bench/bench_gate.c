@@ -0,0 +1,380 @@
+// CPU saved by the silence gate (VADConfig.silence_gate_frames) and what it
+// costs in detection. Each input is streamed through vad_process_audio() in
+// 10 ms packets with the gate off, then on, and the two runs are compared:
+//
+//   gated %      frames that skipped the model
+//   ms/min       processing time per minute of audio, gate off and on
+//   saved %      processing time saved by the gate
+//   segments     speech segments (VAD_EVENT_SPEECH_END), gate off and on
+//   start/end    mean and largest shift of the segment bounds, in ms, over
+//                the segments found by both runs
+//   flipped %    frames on the other side of positive_speech_threshold
+//
+// Usage: vad_plus_bench_gate [--frames K] [--dbfs D] [--margin DB]
+//                            [--model model.onnx] [audio.wav ...]
+//   The WAV files are the corpus, e.g. recorded calls (any format
+//   vad_file_open() reads; other rates than 16000 Hz are resampled by the
+//   handle). Without any, a synthetic signal (3 s of a voiced signal at
+//   varying loudness, then 5 s of silence, repeated for 2 minutes) is used
+//   over three noise floors: -70, -56 and -46 dBFS. Numbers from the
+//   synthetic signal show how the gate behaves, not what it saves or costs
+//   on real calls; quote only corpus runs as call-audio results.
+//   The gate defaults to --frames 8 --dbfs -55 --margin 6.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vad_file.h"
+#include "vad_platform.h"
+#include "vad_plus.h"
+
+#ifndef VAD_PLUS_BENCH_MODEL
+#define VAD_PLUS_BENCH_MODEL "silero_vad_v6.onnx"
+#endif
+
+#define SAMPLE_RATE 16000
+#define SYNTHETIC_SECONDS 120
+#define PERIOD_SAMPLES (8 * SAMPLE_RATE)
+#define TWO_PI 6.283185307179586
+
+// Timed passes per run; the fastest counts
+#define PASSES 3
+
+typedef struct BenchInput
+{
+  char name[256];
+  float *samples;
+  int32_t length;
+  int32_t sample_rate;
+} BenchInput;
+
+/// Segments and per-frame decisions of one run
+typedef struct RunResult
+{
+  VADHandle *handle;
+  float positive_threshold;
+  int64_t *starts;
+  int64_t *ends;
+  int32_t segments;
+  int32_t segment_capacity;
+  uint8_t *speech;
+  int32_t frames;
+  int32_t frame_capacity;
+  double ns;
+  VADStats stats;
+} RunResult;
+
+// ============================================================================
+// Inputs
+// ============================================================================
+
+/// One 8 s period: 3 s of a crude voiced signal (gliding pitch, two moving
+/// formants, 4 Hz syllable envelope) followed by 5 s of silence
+static void synthesize_period(float *period)
+{
+  double phase = 0.0;
+  for (int32_t i = 0; i < PERIOD_SAMPLES; i++)
+  {
+    double t = (double)i / SAMPLE_RATE;
+    double f0 = 120.0 + 20.0 * sin(TWO_PI * 0.7 * t) + 8.0 * sin(TWO_PI * 5.3 * t);
+    double f1 = 500.0 + 300.0 * sin(TWO_PI * 3.1 * t);
+    double f2 = 1500.0 + 600.0 * sin(TWO_PI * 2.3 * t + 1.0);
+    phase += TWO_PI * f0 / SAMPLE_RATE;
+
+    double voice = 0.0;
+    for (int32_t h = 1; h < 30; h++)
+    {
+      double fh = h * f0;
+      double gain = exp(-pow((fh - f1) / 150.0, 2.0)) + 0.6 * exp(-pow((fh - f2) / 200.0, 2.0)) + 0.1 / h;
+      voice += gain * sin(h * phase);
+    }
+    double envelope = t < 3.0 ? (0.5 + 0.5 * sin(TWO_PI * 4.0 * t)) * 0.15 : 0.0;
+    period[i] = (float)(envelope * voice);
+  }
+}
+
+/// The synthetic period repeated at three loudness levels, over uniform noise
+/// with an RMS level of noise_dbfs
+static int32_t synthesize(BenchInput *input, const float *period, float noise_dbfs)
+{
+  snprintf(input->name, sizeof(input->name), "synthetic, noise %.0f dBFS", noise_dbfs);
+  input->sample_rate = SAMPLE_RATE;
+  input->length = SYNTHETIC_SECONDS * SAMPLE_RATE;
+  input->samples = (float *)malloc((size_t)input->length * sizeof(float));
+  if (input->samples == NULL)
+    return -1;
+
+  // Uniform noise over [-a/2, a/2] has an RMS of a / sqrt(12)
+  float amplitude = sqrtf(12.0f) * powf(10.0f, noise_dbfs / 20.0f);
+  uint32_t seed = 11;
+  for (int32_t i = 0; i < input->length; i++)
+  {
+    seed = seed * 1664525u + 1013904223u;
+    float noise = ((float)(seed >> 8) / 16777216.0f - 0.5f) * amplitude;
+    float loudness = 0.3f + 0.35f * (float)((i / PERIOD_SAMPLES) % 3);
+    input->samples[i] = noise + loudness * period[i % PERIOD_SAMPLES];
+  }
+  return 0;
+}
+
+/// Decode a WAV file to mono float at its own rate
+/// @return 0 on success
+static int32_t load_input(const char *path, BenchInput *input)
+{
+  VADFile file;
+  char error[256];
+  if (vad_file_open(&file, path, error, sizeof(error)) != 0)
+  {
+    fprintf(stderr, "%s: %s\n", path, error);
+    return -1;
+  }
+  if (file.sample_rate == 0 || file.frames <= 0 || file.frames > INT32_MAX)
+  {
+    fprintf(stderr, "%s: not a WAV file with samples\n", path);
+    vad_file_close(&file);
+    return -1;
+  }
+
+  snprintf(input->name, sizeof(input->name), "%s", path);
+  input->length = (int32_t)file.frames;
+  input->sample_rate = file.sample_rate;
+  input->samples = (float *)malloc((size_t)input->length * sizeof(float));
+  if (input->samples == NULL)
+  {
+    vad_file_close(&file);
+    return -1;
+  }
+  vad_file_read(&file, 0, input->length, input->samples);
+  vad_file_close(&file);
+  return 0;
+}
+
+// ============================================================================
+// Runs
+// ============================================================================
+
+static void on_event(const VADEvent *event, void *user_data)
+{
+  RunResult *run = (RunResult *)user_data;
+  if (event->type == VAD_EVENT_FRAME_PROCESSED && run->frames < run->frame_capacity)
+  {
+    run->speech[run->frames++] = event->frame_probability >= run->positive_threshold;
+  }
+  else if (event->type == VAD_EVENT_SPEECH_END && run->segments < run->segment_capacity)
+  {
+    run->starts[run->segments] = event->segment_start_sample;
+    run->ends[run->segments] = event->segment_end_sample;
+    run->segments++;
+  }
+  vad_event_release(run->handle, event);
+}
+
+/// Stream the input through a handle PASSES times, keeping the fastest pass
+/// and the segments and decisions of the last one
+/// @return 0 on success
+static int32_t run_input(const char *model_path, const VADConfig *config, const BenchInput *input, RunResult *run)
+{
+  VADHandle *handle = vad_create();
+  if (handle == NULL)
+    return -1;
+  if (vad_init(handle, config, model_path) != 0)
+  {
+    fprintf(stderr, "%s\n", vad_get_last_error(handle));
+    vad_destroy(handle);
+    return -1;
+  }
+  run->handle = handle;
+  run->positive_threshold = config->positive_speech_threshold;
+  vad_set_callback(handle, on_event, run);
+  // Speech audio is not needed, only the segment bounds
+  vad_set_event_mask(handle, VAD_EVENT_MASK(VAD_EVENT_FRAME_PROCESSED) | VAD_EVENT_MASK(VAD_EVENT_SPEECH_END));
+
+  int32_t packet = input->sample_rate / 100;
+  run->ns = 0.0;
+  for (int32_t pass = 0; pass < PASSES; pass++)
+  {
+    vad_reset(handle);
+    run->segments = 0;
+    run->frames = 0;
+    uint64_t start = vad_now_ns();
+    for (int32_t offset = 0; offset < input->length; offset += packet)
+    {
+      int32_t count = input->length - offset < packet ? input->length - offset : packet;
+      vad_process_audio(handle, input->samples + offset, count);
+    }
+    double elapsed = (double)(vad_now_ns() - start);
+    if (pass == 0 || elapsed < run->ns)
+      run->ns = elapsed;
+  }
+  vad_get_stats(handle, &run->stats);
+  vad_destroy(handle);
+  run->handle = NULL;
+  return 0;
+}
+
+static int32_t alloc_run(RunResult *run, int32_t frames)
+{
+  memset(run, 0, sizeof(RunResult));
+  run->segment_capacity = frames / 4 + 1;
+  run->frame_capacity = frames + 1;
+  run->starts = (int64_t *)malloc((size_t)run->segment_capacity * sizeof(int64_t));
+  run->ends = (int64_t *)malloc((size_t)run->segment_capacity * sizeof(int64_t));
+  run->speech = (uint8_t *)malloc((size_t)run->frame_capacity);
+  return run->starts != NULL && run->ends != NULL && run->speech != NULL ? 0 : -1;
+}
+
+static void free_run(RunResult *run)
+{
+  free(run->starts);
+  free(run->ends);
+  free(run->speech);
+}
+
+// ============================================================================
+// Comparison
+// ============================================================================
+
+typedef struct Delta
+{
+  int32_t matched;
+  double start_mean_ms;
+  double start_max_ms;
+  double end_mean_ms;
+  double end_max_ms;
+} Delta;
+
+/// Pair each reference segment with the first overlapping gated one, in order
+static Delta compare_segments(const RunResult *reference, const RunResult *gated)
+{
+  Delta delta;
+  memset(&delta, 0, sizeof(delta));
+  int32_t j = 0;
+  for (int32_t i = 0; i < reference->segments; i++)
+  {
+    while (j < gated->segments && gated->ends[j] <= reference->starts[i])
+      j++;
+    if (j == gated->segments)
+      break;
+    if (gated->starts[j] >= reference->ends[i])
+      continue;
+
+    double start_ms = fabs((double)(gated->starts[j] - reference->starts[i])) * 1000.0 / SAMPLE_RATE;
+    double end_ms = fabs((double)(gated->ends[j] - reference->ends[i])) * 1000.0 / SAMPLE_RATE;
+    delta.start_mean_ms += start_ms;
+    delta.end_mean_ms += end_ms;
+    delta.start_max_ms = start_ms > delta.start_max_ms ? start_ms : delta.start_max_ms;
+    delta.end_max_ms = end_ms > delta.end_max_ms ? end_ms : delta.end_max_ms;
+    delta.matched++;
+    j++;
+  }
+  if (delta.matched > 0)
+  {
+    delta.start_mean_ms /= delta.matched;
+    delta.end_mean_ms /= delta.matched;
+  }
+  return delta;
+}
+
+static double flipped_percent(const RunResult *reference, const RunResult *gated)
+{
+  int32_t frames = reference->frames < gated->frames ? reference->frames : gated->frames;
+  int32_t flipped = 0;
+  for (int32_t i = 0; i < frames; i++)
+    flipped += reference->speech[i] != gated->speech[i];
+  return frames > 0 ? 100.0 * flipped / frames : 0.0;
+}
+
+static int32_t bench_input(const char *model_path, const VADConfig *gate_config, const BenchInput *input)
+{
+  VADConfig config;
+  vad_config_default(&config);
+  config.input_sample_rate = input->sample_rate;
+  int32_t frames = (int32_t)((int64_t)input->length * SAMPLE_RATE / input->sample_rate / config.frame_samples);
+
+  RunResult off;
+  RunResult on;
+  int32_t result = -1;
+  if (alloc_run(&off, frames) == 0 && alloc_run(&on, frames) == 0 && run_input(model_path, &config, input, &off) == 0)
+  {
+    config.silence_gate_frames = gate_config->silence_gate_frames;
+    config.silence_gate_dbfs = gate_config->silence_gate_dbfs;
+    config.silence_gate_noise_margin_db = gate_config->silence_gate_noise_margin_db;
+    result = run_input(model_path, &config, input, &on);
+  }
+  if (result == 0)
+  {
+    double minutes = (double)input->length / input->sample_rate / 60.0;
+    uint64_t total = on.stats.frames_processed + on.stats.gated_frames;
+    Delta delta = compare_segments(&off, &on);
+    printf("%-28s %7.1f %8.1f %8.1f %7.1f %5d/%-5d %7d %6.1f/%-6.0f %6.1f/%-6.0f %8.2f\n", input->name,
+           total > 0 ? 100.0 * (double)on.stats.gated_frames / (double)total : 0.0, off.ns / 1e6 / minutes,
+           on.ns / 1e6 / minutes, 100.0 * (1.0 - on.ns / off.ns), off.segments, on.segments, delta.matched,
+           delta.start_mean_ms, delta.start_max_ms, delta.end_mean_ms, delta.end_max_ms, flipped_percent(&off, &on));
+  }
+  free_run(&off);
+  free_run(&on);
+  return result;
+}
+
+int main(int argc, char **argv)
+{
+  const char *model_path = VAD_PLUS_BENCH_MODEL;
+  VADConfig gate;
+  vad_config_default(&gate);
+  gate.silence_gate_frames = 8;
+  gate.silence_gate_noise_margin_db = 6.0f;
+
+  int32_t first_input = argc;
+  for (int32_t i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+      gate.silence_gate_frames = atoi(argv[++i]);
+    else if (strcmp(argv[i], "--dbfs") == 0 && i + 1 < argc)
+      gate.silence_gate_dbfs = (float)atof(argv[++i]);
+    else if (strcmp(argv[i], "--margin") == 0 && i + 1 < argc)
+      gate.silence_gate_noise_margin_db = (float)atof(argv[++i]);
+    else if (strcmp(argv[i], "--model") == 0 && i + 1 < argc)
+      model_path = argv[++i];
+    else
+    {
+      first_input = i;
+      break;
+    }
+  }
+
+  printf("gate: %d frames, %.1f dBFS, noise margin %.1f dB\n", gate.silence_gate_frames, gate.silence_gate_dbfs,
+         gate.silence_gate_noise_margin_db);
+  if (first_input >= argc)
+    printf("inputs: SYNTHETIC (no WAV files given); not representative of call audio\n");
+  printf("\n");
+  printf("%-28s %7s %8s %8s %7s %11s %7s %13s %13s %8s\n", "input", "gated %", "ms/min", "gated", "saved %",
+         "segments", "matched", "start ms", "end ms", "flipped %");
+  printf("%-28s %7s %8s %8s %7s %11s %7s %13s %13s %8s\n", "", "", "off", "on", "", "off/on", "", "mean/max",
+         "mean/max", "");
+
+  int32_t failed = 0;
+  if (first_input >= argc)
+  {
+    static float period[PERIOD_SAMPLES];
+    static const float kNoiseDbfs[] = {-70.0f, -56.0f, -46.0f};
+    synthesize_period(period);
+    for (size_t i = 0; i < sizeof(kNoiseDbfs) / sizeof(kNoiseDbfs[0]); i++)
+    {
+      BenchInput input;
+      if (synthesize(&input, period, kNoiseDbfs[i]) != 0 || bench_input(model_path, &gate, &input) != 0)
+        failed = 1;
+      free(input.samples);
+    }
+  }
+  for (int32_t i = first_input; i < argc; i++)
+  {
+    BenchInput input;
+    memset(&input, 0, sizeof(input));
+    if (load_input(argv[i], &input) != 0 || bench_input(model_path, &gate, &input) != 0)
+      failed = 1;
+    free(input.samples);
+  }
+  return failed;
+}
@@ -0,0 +1,215 @@
+// Creation time and resident memory of 1, 10 and 100 VAD handles. Handles
+// initialized from the same model share one copy of its weights through the
+// model cache; the "own-copy" columns show what the same number of
+// handles cost when each one loads its own copy (vad_model_load_file()),
+// model loads only.
+//
+// A cold start from the model file (vad_init()) is then compared with one from
+// the model already in memory (vad_init_from_memory()), as when it is embedded
+// in the application binary.
+//
+// Last, the latency of the first real frame after a cold init is shown without
+// and with a warm-up (VADConfig.prewarm_frames), next to the warm per-frame
+// latency reported by vad_get_warmup_info().
+//
+// Usage: vad_plus_bench_handles [model.onnx]
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "vad_model.h"
+#include "vad_platform.h"
+#include "vad_plus.h"
+
+#if _WIN32
+#include <psapi.h>
+#endif
+
+#ifndef VAD_PLUS_BENCH_MODEL
+#define VAD_PLUS_BENCH_MODEL "silero_vad_v6.onnx"
+#endif
+
+static const int32_t kHandleCounts[] = {1, 10, 100};
+
+/// Resident set size in bytes (0 if unknown)
+static size_t resident_bytes(void)
+{
+#if _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return 0;
+  return counters.WorkingSetSize;
+#else
+  FILE *file = fopen("/proc/self/statm", "r");
+  if (file == NULL)
+    return 0;
+  unsigned long size = 0, resident = 0;
+  int fields = fscanf(file, "%lu %lu", &size, &resident);
+  fclose(file);
+  return fields == 2 ? (size_t)resident * (size_t)sysconf(_SC_PAGESIZE) : 0;
+#endif
+}
+
+/// Create and initialize count handles; reports the time and memory they took
+/// @return 0 on success
+static int32_t measure_handles(const char *model_path, int32_t count, double *ms, double *kb)
+{
+  VADHandle **handles = (VADHandle **)calloc((size_t)count, sizeof(VADHandle *));
+  if (handles == NULL)
+    return -1;
+
+  VADConfig config;
+  vad_config_default(&config);
+
+  int32_t result = 0;
+  size_t before = resident_bytes();
+  uint64_t start = vad_now_ns();
+  for (int32_t i = 0; i < count && result == 0; i++)
+  {
+    handles[i] = vad_create();
+    if (handles[i] == NULL || vad_init(handles[i], &config, model_path) != 0)
+    {
+      fprintf(stderr, "Handle %d: %s\n", i, handles[i] != NULL ? vad_get_last_error(handles[i]) : "out of memory");
+      result = -1;
+    }
+  }
+  *ms = (double)(vad_now_ns() - start) / 1e6;
+  *kb = ((double)resident_bytes() - (double)before) / 1024.0;
+
+  for (int32_t i = 0; i < count; i++)
+    vad_destroy(handles[i]);
+  free(handles);
+  return result;
+}
+
+/// Load count private copies of the model, as handles did before the cache
+/// @return 0 on success
+static int32_t measure_private_loads(const char *model_path, int32_t count, double *ms, double *kb)
+{
+  VADModel *models = (VADModel *)calloc((size_t)count, sizeof(VADModel));
+  if (models == NULL)
+    return -1;
+
+  char error[256];
+  int32_t result = 0;
+  size_t before = resident_bytes();
+  uint64_t start = vad_now_ns();
+  for (int32_t i = 0; i < count && result == 0; i++)
+  {
+    if (vad_model_load_file(&models[i], model_path, error, sizeof(error)) != 0)
+    {
+      fprintf(stderr, "%s\n", error);
+      result = -1;
+    }
+  }
+  *ms = (double)(vad_now_ns() - start) / 1e6;
+  *kb = ((double)resident_bytes() - (double)before) / 1024.0;
+
+  for (int32_t i = 0; i < count; i++)
+    vad_model_free(&models[i]);
+  free(models);
+  return result;
+}
+
+/// Time one cold init (empty model cache) from the file or from memory
+/// @return Milliseconds, or a negative value on failure
+static double measure_cold_init(const char *model_path, const void *data, size_t length)
+{
+  VADConfig config;
+  vad_config_default(&config);
+  VADHandle *handle = vad_create();
+  if (handle == NULL)
+    return -1.0;
+
+  uint64_t start = vad_now_ns();
+  int32_t result = data != NULL ? vad_init_from_memory(handle, &config, data, length)
+                                : vad_init(handle, &config, model_path);
+  double ms = (double)(vad_now_ns() - start) / 1e6;
+  if (result != 0)
+  {
+    fprintf(stderr, "%s\n", vad_get_last_error(handle));
+    ms = -1.0;
+  }
+  vad_destroy(handle);
+  return ms;
+}
+
+/// First real frame after a cold init, with prewarm_frames dummy frames before it
+/// @return 0 on success
+static int32_t measure_first_frame(const char *model_path, int32_t prewarm_frames, VADWarmupInfo *info)
+{
+  VADConfig config;
+  vad_config_default(&config);
+  config.prewarm_frames = prewarm_frames;
+  VADHandle *handle = vad_create();
+  if (handle == NULL)
+    return -1;
+
+  int32_t result = vad_init(handle, &config, model_path);
+  if (result == 0)
+  {
+    float *silence = (float *)calloc((size_t)config.frame_samples, sizeof(float));
+    result = silence != NULL ? vad_process_audio(handle, silence, config.frame_samples) : -1;
+    free(silence);
+  }
+  if (result == 0)
+    result = vad_get_warmup_info(handle, info);
+  if (result != 0)
+    fprintf(stderr, "%s\n", vad_get_last_error(handle));
+  vad_destroy(handle);
+  return result;
+}
+
+int main(int argc, char **argv)
+{
+  const char *model_path = argc > 1 ? argv[1] : VAD_PLUS_BENCH_MODEL;
+
+  printf("%-8s %14s %14s %14s %16s %16s\n", "handles", "shared ms", "ms/handle", "shared RSS KB",
+         "own-copy ms", "own-copy KB");
+  for (size_t c = 0; c < sizeof(kHandleCounts) / sizeof(kHandleCounts[0]); c++)
+  {
+    int32_t count = kHandleCounts[c];
+    double shared_ms, shared_kb, private_ms, private_kb;
+    if (measure_handles(model_path, count, &shared_ms, &shared_kb) != 0 ||
+        measure_private_loads(model_path, count, &private_ms, &private_kb) != 0)
+      return 1;
+    printf("%-8d %14.2f %14.3f %14.0f %16.2f %16.0f\n", count, shared_ms, shared_ms / count, shared_kb, private_ms,
+           private_kb);
+  }
+
+  void *data;
+  size_t length;
+  char error[256];
+  if (vad_model_read_file(model_path, &data, &length, error, sizeof(error)) != 0)
+  {
+    fprintf(stderr, "%s\n", error);
+    return 1;
+  }
+  double file_ms = 1e30, memory_ms = 1e30;
+  for (int32_t round = 0; round < 5; round++)
+  {
+    double ms = measure_cold_init(model_path, NULL, 0);
+    double mem = measure_cold_init(NULL, data, length);
+    if (ms < 0.0 || mem < 0.0)
+    {
+      free(data);
+      return 1;
+    }
+    file_ms = ms < file_ms ? ms : file_ms;
+    memory_ms = mem < memory_ms ? mem : memory_ms;
+  }
+  free(data);
+  printf("\ncold init (best of 5): from file %.2f ms, from memory %.2f ms\n", file_ms, memory_ms);
+
+  static const int32_t kPrewarmFrames[] = {0, 8, 32};
+  printf("\n%-14s %14s %14s %14s\n", "prewarm frames", "cold us", "warm us", "first frame us");
+  for (size_t p = 0; p < sizeof(kPrewarmFrames) / sizeof(kPrewarmFrames[0]); p++)
+  {
+    VADWarmupInfo info;
+    if (measure_first_frame(model_path, kPrewarmFrames[p], &info) != 0)
+      return 1;
+    printf("%-14d %14.1f %14.1f %14.1f\n", info.prewarm_frames, info.cold_frame_us, info.warm_frame_us,
+           info.first_frame_us);
+  }
+  return 0;
+}
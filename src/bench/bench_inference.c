@@ -0,0 +1,303 @@
+// Per-frame inference latency of the native engine, optionally compared
+// against ONNX Runtime on the same audio.
+//
+// Usage: vad_plus_bench_inference [model.onnx] [audio.wav]
+//   audio.wav must be 16-bit PCM mono at 16000 or 8000 Hz. Without it a
+//   synthetic 30 second signal (tone bursts over noise) at 16 kHz is used.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vad_model.h"
+#include "vad_platform.h"
+
+#ifdef VAD_PLUS_BENCH_HAVE_ORT
+#include <onnxruntime_c_api.h>
+#endif
+
+#ifndef VAD_PLUS_BENCH_MODEL
+#define VAD_PLUS_BENCH_MODEL "silero_vad_v6.onnx"
+#endif
+
+#define WARMUP_FRAMES 50
+
+typedef struct BenchAudio
+{
+  float *samples;
+  int32_t length;
+  int32_t sample_rate;
+} BenchAudio;
+
+static uint32_t read_u32(const uint8_t *p)
+{
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static uint16_t read_u16(const uint8_t *p)
+{
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static int load_wav(const char *path, BenchAudio *audio)
+{
+  FILE *file = fopen(path, "rb");
+  if (file == NULL)
+    return -1;
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  uint8_t *data = (uint8_t *)malloc((size_t)size);
+  if (data == NULL || fread(data, 1, (size_t)size, file) != (size_t)size || size < 12 ||
+      memcmp(data, "RIFF", 4) != 0 || memcmp(data + 8, "WAVE", 4) != 0)
+  {
+    free(data);
+    fclose(file);
+    return -1;
+  }
+  fclose(file);
+
+  int32_t channels = 0, bits = 0;
+  long offset = 12;
+  while (offset + 8 <= size)
+  {
+    uint32_t chunk_size = read_u32(data + offset + 4);
+    const uint8_t *chunk = data + offset + 8;
+    if (memcmp(data + offset, "fmt ", 4) == 0 && chunk_size >= 16)
+    {
+      channels = read_u16(chunk + 2);
+      audio->sample_rate = (int32_t)read_u32(chunk + 4);
+      bits = read_u16(chunk + 14);
+    }
+    else if (memcmp(data + offset, "data", 4) == 0 && channels == 1 && bits == 16)
+    {
+      if (chunk_size > (uint32_t)(size - offset - 8))
+        chunk_size = (uint32_t)(size - offset - 8);
+      audio->length = (int32_t)(chunk_size / 2);
+      audio->samples = (float *)malloc((size_t)audio->length * sizeof(float));
+      for (int32_t i = 0; i < audio->length; i++)
+        audio->samples[i] = (float)(int16_t)read_u16(chunk + 2 * i) / 32768.0f;
+      free(data);
+      return 0;
+    }
+    offset += 8 + chunk_size + (chunk_size & 1);
+  }
+  free(data);
+  return -1;
+}
+
+static void synthesize(BenchAudio *audio)
+{
+  audio->sample_rate = 16000;
+  audio->length = 30 * audio->sample_rate;
+  audio->samples = (float *)malloc((size_t)audio->length * sizeof(float));
+  uint32_t seed = 12345;
+  for (int32_t i = 0; i < audio->length; i++)
+  {
+    seed = seed * 1664525u + 1013904223u;
+    float noise = ((float)(seed >> 8) / 16777216.0f - 0.5f) * 0.02f;
+    float t = (float)i / audio->sample_rate;
+    // Voiced-like bursts: 2 s on, 1 s off, 150 Hz fundamental with harmonics
+    float burst = fmodf(t, 3.0f) < 2.0f ? 1.0f : 0.0f;
+    float tone = 0.3f * sinf(2.0f * 3.14159265f * 150.0f * t) + 0.15f * sinf(2.0f * 3.14159265f * 450.0f * t) +
+                 0.08f * sinf(2.0f * 3.14159265f * 1200.0f * t);
+    audio->samples[i] = noise + burst * tone;
+  }
+}
+
+static int compare_double(const void *a, const void *b)
+{
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+static void report(const char *name, double *times_us, int32_t count)
+{
+  double sum = 0.0;
+  for (int32_t i = 0; i < count; i++)
+    sum += times_us[i];
+  qsort(times_us, (size_t)count, sizeof(double), compare_double);
+  printf("%-14s frames=%d mean=%.2fus p50=%.2fus p99=%.2fus max=%.2fus\n", name, count, sum / count,
+         times_us[count / 2], times_us[(int32_t)(count * 0.99)], times_us[count - 1]);
+}
+
+/// Run the model over all frames, recording per-frame latency and probability
+static void run_native(const VADModelRate *rate, const BenchAudio *audio, int32_t frames, double *times_us,
+                       float *probabilities)
+{
+  float state[VAD_MODEL_STATE_SIZE] = {0};
+  float *input = (float *)vad_aligned_alloc((size_t)(rate->context_size + rate->frame_samples) * sizeof(float));
+  memset(input, 0, (size_t)rate->context_size * sizeof(float));
+
+  for (int32_t f = 0; f < frames; f++)
+  {
+    memcpy(input + rate->context_size, audio->samples + (size_t)f * rate->frame_samples,
+           (size_t)rate->frame_samples * sizeof(float));
+    uint64_t start = vad_now_ns();
+    probabilities[f] = vad_model_infer(rate, input, state);
+    times_us[f] = (double)(vad_now_ns() - start) / 1000.0;
+    memcpy(input, input + rate->frame_samples, (size_t)rate->context_size * sizeof(float));
+  }
+  vad_aligned_free(input);
+}
+
+#ifdef VAD_PLUS_BENCH_HAVE_ORT
+
+#define ORT_CHECK(expr)                                                   \
+  do                                                                      \
+  {                                                                       \
+    OrtStatus *status_ = (expr);                                          \
+    if (status_ != NULL)                                                  \
+    {                                                                     \
+      fprintf(stderr, "onnxruntime: %s\n", ort->GetErrorMessage(status_)); \
+      ort->ReleaseStatus(status_);                                        \
+      exit(1);                                                            \
+    }                                                                     \
+  } while (0)
+
+static void run_onnxruntime(const char *model_path, const VADModelRate *rate, const BenchAudio *audio,
+                            int32_t frames, double *times_us, float *probabilities)
+{
+  const OrtApi *ort = OrtGetApiBase()->GetApi(ORT_API_VERSION);
+  OrtEnv *env;
+  OrtSessionOptions *options;
+  OrtSession *session;
+  OrtMemoryInfo *memory;
+  ORT_CHECK(ort->CreateEnv(ORT_LOGGING_LEVEL_WARNING, "vad_plus_bench", &env));
+  ORT_CHECK(ort->CreateSessionOptions(&options));
+  ORT_CHECK(ort->SetIntraOpNumThreads(options, 1));
+  ORT_CHECK(ort->SetSessionGraphOptimizationLevel(options, ORT_ENABLE_ALL));
+#if _WIN32
+  wchar_t wide_path[1024];
+  mbstowcs(wide_path, model_path, 1024);
+  ORT_CHECK(ort->CreateSession(env, wide_path, options, &session));
+#else
+  ORT_CHECK(ort->CreateSession(env, model_path, options, &session));
+#endif
+  ORT_CHECK(ort->CreateCpuMemoryInfo(OrtArenaAllocator, OrtMemTypeDefault, &memory));
+
+  int32_t input_length = rate->context_size + rate->frame_samples;
+  float *input = (float *)calloc((size_t)input_length, sizeof(float));
+  float state[VAD_MODEL_STATE_SIZE] = {0};
+  int64_t sr = rate->sample_rate;
+  const int64_t input_shape[2] = {1, input_length};
+  const int64_t sr_shape[1] = {1};
+  const int64_t state_shape[3] = {2, 1, VAD_MODEL_HIDDEN_SIZE};
+  const char *input_names[3] = {"input", "sr", "state"};
+  const char *output_names[2] = {"output", "stateN"};
+
+  for (int32_t f = 0; f < frames; f++)
+  {
+    memcpy(input + rate->context_size, audio->samples + (size_t)f * rate->frame_samples,
+           (size_t)rate->frame_samples * sizeof(float));
+
+    uint64_t start = vad_now_ns();
+    OrtValue *inputs[3] = {NULL, NULL, NULL};
+    OrtValue *outputs[2] = {NULL, NULL};
+    ORT_CHECK(ort->CreateTensorWithDataAsOrtValue(memory, input, (size_t)input_length * sizeof(float), input_shape, 2,
+                                                  ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, &inputs[0]));
+    ORT_CHECK(ort->CreateTensorWithDataAsOrtValue(memory, &sr, sizeof(sr), sr_shape, 1,
+                                                  ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64, &inputs[1]));
+    ORT_CHECK(ort->CreateTensorWithDataAsOrtValue(memory, state, sizeof(state), state_shape, 3,
+                                                  ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT, &inputs[2]));
+    ORT_CHECK(ort->Run(session, NULL, input_names, (const OrtValue *const *)inputs, 3, output_names, 2, outputs));
+
+    float *output;
+    float *state_out;
+    ORT_CHECK(ort->GetTensorMutableData(outputs[0], (void **)&output));
+    ORT_CHECK(ort->GetTensorMutableData(outputs[1], (void **)&state_out));
+    probabilities[f] = output[0];
+    memcpy(state, state_out, sizeof(state));
+    times_us[f] = (double)(vad_now_ns() - start) / 1000.0;
+
+    for (int32_t i = 0; i < 3; i++)
+      ort->ReleaseValue(inputs[i]);
+    for (int32_t i = 0; i < 2; i++)
+      ort->ReleaseValue(outputs[i]);
+    memcpy(input, input + rate->frame_samples, (size_t)rate->context_size * sizeof(float));
+  }
+
+  free(input);
+  ort->ReleaseMemoryInfo(memory);
+  ort->ReleaseSession(session);
+  ort->ReleaseSessionOptions(options);
+  ort->ReleaseEnv(env);
+}
+
+#endif // VAD_PLUS_BENCH_HAVE_ORT
+
+int main(int argc, char **argv)
+{
+  const char *model_path = argc > 1 ? argv[1] : VAD_PLUS_BENCH_MODEL;
+  BenchAudio audio = {0};
+
+  if (argc > 2)
+  {
+    if (load_wav(argv[2], &audio) != 0)
+    {
+      fprintf(stderr, "Cannot read %s (expected 16-bit PCM mono WAV)\n", argv[2]);
+      return 1;
+    }
+  }
+  else
+  {
+    synthesize(&audio);
+  }
+
+  VADModel model;
+  char error[256];
+  uint64_t load_start = vad_now_ns();
+  if (vad_model_load_file(&model, model_path, error, sizeof(error)) != 0)
+  {
+    fprintf(stderr, "%s\n", error);
+    return 1;
+  }
+  printf("model load: %.2f ms\n", (double)(vad_now_ns() - load_start) / 1e6);
+
+  const VADModelRate *rate = vad_model_get_rate(&model, audio.sample_rate);
+  if (rate == NULL)
+  {
+    fprintf(stderr, "Model has no weights for %d Hz\n", audio.sample_rate);
+    return 1;
+  }
+
+  int32_t frames = audio.length / rate->frame_samples;
+  if (frames <= WARMUP_FRAMES)
+  {
+    fprintf(stderr, "Audio too short (%d frames)\n", frames);
+    return 1;
+  }
+
+  double *times_us = (double *)malloc((size_t)frames * sizeof(double));
+  float *native = (float *)malloc((size_t)frames * sizeof(float));
+  run_native(rate, &audio, frames, times_us, native);
+  report("native", times_us + WARMUP_FRAMES, frames - WARMUP_FRAMES);
+
+  int32_t speech_frames = 0;
+  for (int32_t f = 0; f < frames; f++)
+    speech_frames += native[f] >= 0.5f;
+  printf("speech frames: %d / %d\n", speech_frames, frames);
+
+#ifdef VAD_PLUS_BENCH_HAVE_ORT
+  float *reference = (float *)malloc((size_t)frames * sizeof(float));
+  run_onnxruntime(model_path, rate, &audio, frames, times_us, reference);
+  report("onnxruntime", times_us + WARMUP_FRAMES, frames - WARMUP_FRAMES);
+
+  float max_diff = 0.0f;
+  for (int32_t f = 0; f < frames; f++)
+  {
+    float diff = fabsf(native[f] - reference[f]);
+    if (diff > max_diff)
+      max_diff = diff;
+  }
+  printf("max |p_native - p_onnxruntime| = %.6f\n", max_diff);
+  free(reference);
+#endif
+
+  free(native);
+  free(times_us);
+  free(audio.samples);
+  vad_model_free(&model);
+  return 0;
+}
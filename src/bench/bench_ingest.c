@@ -0,0 +1,206 @@
+// Cost per vad_process_audio call of getting samples from the caller into
+// whole frames, for the Android ingestion paths:
+//
+//   legacy  per-call heap array + copy, appended to a growing list that is
+//           shifted down one sample at a time as frames are taken
+//           (NewFloatArray/SetFloatArrayRegion + MutableList<Float>)
+//   ring    copy into the native input ring, frames read in place from it
+//           (vad_ring_write + direct ByteBuffer)
+//
+// and for interleaved stereo PCM16 (telephony sources, vad_process_audio_ex):
+//
+//   convert downmix into a per-call float array, then write it to the ring
+//   fused   downmix while writing into the ring (vad_ring_write_s16_frames)
+//
+// Only the data movement is modelled; JNI transitions and boxing, which the
+// legacy path also paid on every call, are not included.
+//
+// Usage: vad_plus_bench_ingest [frame_samples]
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vad_convert.h"
+#include "vad_platform.h"
+#include "vad_ring.h"
+
+#define TARGET_NS 300000000ull
+
+static const int32_t kPacketSizes[] = {160, 320, 480, 512, 1024};
+
+typedef struct IngestState
+{
+  int32_t frame_samples;
+  float *frame;
+  float checksum;
+
+  // legacy
+  float *list;
+  int32_t list_length;
+  int32_t list_capacity;
+
+  // ring
+  VADRing *ring;
+} IngestState;
+
+static void consume_frame(IngestState *s)
+{
+  // Stand-in for inference touching the frame
+  s->checksum += s->frame[0] + s->frame[s->frame_samples - 1];
+}
+
+typedef void (*IngestFn)(IngestState *s, const void *packet, int32_t count);
+
+static void drain_ring(IngestState *s)
+{
+  const float *window;
+  while ((window = vad_ring_peek(s->ring, s->frame_samples)) != NULL)
+  {
+    memcpy(s->frame, window, (size_t)s->frame_samples * sizeof(float));
+    vad_ring_consume(s->ring, s->frame_samples);
+    consume_frame(s);
+  }
+}
+
+static void ingest_legacy(IngestState *s, const void *data, int32_t count)
+{
+  const float *packet = (const float *)data;
+  float *array = (float *)malloc((size_t)count * sizeof(float));
+  memcpy(array, packet, (size_t)count * sizeof(float));
+
+  if (s->list_length + count > s->list_capacity)
+  {
+    s->list_capacity = (s->list_length + count) * 2;
+    s->list = (float *)realloc(s->list, (size_t)s->list_capacity * sizeof(float));
+  }
+  memcpy(s->list + s->list_length, array, (size_t)count * sizeof(float));
+  s->list_length += count;
+  free(array);
+
+  while (s->list_length >= s->frame_samples)
+  {
+    memcpy(s->frame, s->list, (size_t)s->frame_samples * sizeof(float));
+    for (int32_t i = 0; i < s->frame_samples; i++)
+    {
+      s->list_length--;
+      memmove(s->list, s->list + 1, (size_t)s->list_length * sizeof(float));
+    }
+    consume_frame(s);
+  }
+}
+
+static void ingest_ring(IngestState *s, const void *data, int32_t count)
+{
+  const float *packet = (const float *)data;
+  int32_t offset = 0;
+  while (offset < count)
+  {
+    offset += vad_ring_write(s->ring, packet + offset, count - offset);
+    drain_ring(s);
+  }
+}
+
+static void ingest_convert(IngestState *s, const void *data, int32_t count)
+{
+  const int16_t *packet = (const int16_t *)data;
+  float *array = (float *)malloc((size_t)count * sizeof(float));
+  vad_convert_s16_stereo_to_f32_mono(packet, array, count);
+
+  int32_t offset = 0;
+  while (offset < count)
+  {
+    offset += vad_ring_write(s->ring, array + offset, count - offset);
+    drain_ring(s);
+  }
+  free(array);
+}
+
+static void ingest_fused(IngestState *s, const void *data, int32_t count)
+{
+  const int16_t *packet = (const int16_t *)data;
+  int32_t offset = 0;
+  while (offset < count)
+  {
+    offset += vad_ring_write_s16_frames(s->ring, packet + 2 * offset, 2, 2, count - offset);
+    drain_ring(s);
+  }
+}
+
+/// Nanoseconds per call of one ingestion path
+static double measure(IngestState *s, const void *packet, int32_t count, IngestFn ingest)
+{
+  for (int32_t i = 0; i < 100; i++)
+    ingest(s, packet, count);
+
+  uint64_t calls = 0;
+  uint64_t start = vad_now_ns();
+  uint64_t elapsed;
+  do
+  {
+    for (int32_t i = 0; i < 100; i++)
+      ingest(s, packet, count);
+    calls += 100;
+    elapsed = vad_now_ns() - start;
+  } while (elapsed < TARGET_NS);
+
+  return (double)elapsed / (double)calls;
+}
+
+int main(int argc, char **argv)
+{
+  IngestState state;
+  memset(&state, 0, sizeof(state));
+  state.frame_samples = argc > 1 ? atoi(argv[1]) : 512;
+  if (state.frame_samples <= 0)
+  {
+    fprintf(stderr, "Invalid frame size\n");
+    return 1;
+  }
+
+  // Same sizing as VADHandleInternal.initialize
+  state.ring = vad_ring_create(state.frame_samples * 64, state.frame_samples);
+  state.frame = (float *)vad_aligned_alloc((size_t)state.frame_samples * sizeof(float));
+  float *packet = (float *)vad_aligned_alloc(1024 * sizeof(float));
+  int16_t *stereo = (int16_t *)vad_aligned_alloc(2 * 1024 * sizeof(int16_t));
+  if (state.ring == NULL || state.frame == NULL || packet == NULL || stereo == NULL)
+  {
+    fprintf(stderr, "Out of memory\n");
+    return 1;
+  }
+  for (int32_t i = 0; i < 1024; i++)
+    packet[i] = (float)(i % 97) / 97.0f - 0.5f;
+  for (int32_t i = 0; i < 2 * 1024; i++)
+    stereo[i] = (int16_t)((i % 193) * 256 - 24576);
+
+  printf("frame samples: %d\n", state.frame_samples);
+  printf("%-8s %14s %14s %10s\n", "packet", "legacy ns", "ring ns", "speedup");
+  for (size_t p = 0; p < sizeof(kPacketSizes) / sizeof(kPacketSizes[0]); p++)
+  {
+    int32_t count = kPacketSizes[p];
+    double legacy = measure(&state, packet, count, ingest_legacy);
+    double ring = measure(&state, packet, count, ingest_ring);
+    printf("%-8d %14.1f %14.1f %9.1fx\n", count, legacy, ring, legacy / ring);
+  }
+
+  printf("\ninterleaved stereo PCM16, downmixed\n");
+  printf("%-8s %14s %14s %10s\n", "frames", "convert ns", "fused ns", "speedup");
+  for (size_t p = 0; p < sizeof(kPacketSizes) / sizeof(kPacketSizes[0]); p++)
+  {
+    int32_t count = kPacketSizes[p];
+    double convert = measure(&state, stereo, count, ingest_convert);
+    double fused = measure(&state, stereo, count, ingest_fused);
+    printf("%-8d %14.1f %14.1f %9.1fx\n", count, convert, fused, convert / fused);
+  }
+
+  // Keep the frame consumer observable
+  if (state.checksum == 12345.0f)
+    printf("\n");
+
+  free(state.list);
+  vad_aligned_free(state.frame);
+  vad_aligned_free(packet);
+  vad_aligned_free(stereo);
+  vad_ring_destroy(state.ring);
+  return 0;
+}
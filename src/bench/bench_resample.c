@@ -0,0 +1,155 @@
+// Cost and accuracy of the streaming resampler (vad_resample.c) for common
+// capture rates. CPU time is measured on noise fed in 10 ms blocks, as a
+// capture callback would; accuracy is the SNR of a 1 kHz tone against the
+// exact tone at the output rate, and for downsampling the level of a tone just
+// above the output Nyquist rate that must be filtered out.
+//
+// Usage: vad_plus_bench_resample [seconds]
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "vad_platform.h"
+#include "vad_resample.h"
+
+#define TWO_PI 6.283185307179586
+#define OUTPUT_CHUNK 4096
+
+typedef struct RatePair
+{
+  int32_t input_rate;
+  int32_t output_rate;
+} RatePair;
+
+static const RatePair kPairs[] = {
+    {48000, 16000}, {44100, 16000}, {32000, 16000}, {22050, 16000},
+    {8000, 16000},  {48000, 8000},  {44100, 8000},
+};
+
+static int32_t gcd(int32_t a, int32_t b)
+{
+  while (b != 0)
+  {
+    int32_t t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+/// Run the whole input through in blocks of block samples
+/// @return Number of output samples
+static int64_t run(VADResampler *resampler, const float *input, int64_t count, int32_t block, float *output,
+                   int64_t output_capacity)
+{
+  static float scratch[OUTPUT_CHUNK];
+  int64_t produced = 0;
+  for (int64_t offset = 0; offset < count; offset += block)
+  {
+    int32_t remaining = count - offset < block ? (int32_t)(count - offset) : block;
+    const float *samples = input + offset;
+    for (;;)
+    {
+      int32_t used;
+      int32_t n = vad_resampler_process(resampler, samples, remaining, &used, scratch, OUTPUT_CHUNK);
+      samples += used;
+      remaining -= used;
+      for (int32_t i = 0; i < n && produced < output_capacity; i++)
+        output[produced++] = scratch[i];
+      if (n < OUTPUT_CHUNK)
+        break;
+    }
+  }
+  return produced;
+}
+
+/// Level of the output relative to a unit tone of frequency hz at the input,
+/// and its error against the exact tone at the output rate
+static void measure_tone(const RatePair *pair, double hz, double *level_db, double *snr_db)
+{
+  int64_t count = pair->input_rate * 2;
+  int64_t output_count = (int64_t)pair->output_rate * 2;
+  float *input = (float *)malloc((size_t)count * sizeof(float));
+  float *output = (float *)malloc((size_t)output_count * sizeof(float));
+  for (int64_t i = 0; i < count; i++)
+    input[i] = (float)(0.5 * sin(TWO_PI * hz * (double)i / pair->input_rate));
+
+  VADResampler *resampler = vad_resampler_create(pair->input_rate, pair->output_rate);
+  int64_t produced = run(resampler, input, count, pair->input_rate / 100, output, output_count);
+  int32_t skip = vad_resampler_taps(resampler);
+  vad_resampler_destroy(resampler);
+
+  double signal = 0.0;
+  double error = 0.0;
+  double power = 0.0;
+  for (int64_t n = skip; n < produced - skip; n++)
+  {
+    double expected = 0.5 * sin(TWO_PI * hz * (double)n / pair->output_rate);
+    signal += expected * expected;
+    error += (output[n] - expected) * (output[n] - expected);
+    power += (double)output[n] * output[n];
+  }
+  *level_db = 10.0 * log10(power / signal + 1e-30);
+  *snr_db = 10.0 * log10(signal / (error + 1e-30));
+  free(input);
+  free(output);
+}
+
+int main(int argc, char **argv)
+{
+  double seconds = argc > 1 ? atof(argv[1]) : 60.0;
+
+  printf("%-16s %6s %9s %14s %12s %9s %12s\n", "rates", "taps", "bank KB", "CPU us/audio s", "x realtime",
+         "SNR dB", "alias dB");
+
+  for (size_t p = 0; p < sizeof(kPairs) / sizeof(kPairs[0]); p++)
+  {
+    const RatePair *pair = &kPairs[p];
+    int64_t count = (int64_t)(seconds * pair->input_rate);
+    int64_t output_count = (int64_t)(seconds * pair->output_rate) + 1;
+    float *input = (float *)malloc((size_t)count * sizeof(float));
+    float *output = (float *)malloc((size_t)output_count * sizeof(float));
+    uint32_t seed = 7;
+    for (int64_t i = 0; i < count; i++)
+    {
+      seed = seed * 1664525u + 1013904223u;
+      input[i] = ((float)(seed >> 8) / 16777216.0f - 0.5f) * 0.5f;
+    }
+
+    VADResampler *resampler = vad_resampler_create(pair->input_rate, pair->output_rate);
+    if (resampler == NULL)
+    {
+      fprintf(stderr, "Unsupported rates %d -> %d\n", pair->input_rate, pair->output_rate);
+      return 1;
+    }
+    int32_t taps = vad_resampler_taps(resampler);
+    int32_t phases = pair->output_rate / gcd(pair->input_rate, pair->output_rate);
+
+    uint64_t start = vad_now_ns();
+    run(resampler, input, count, pair->input_rate / 100, output, output_count);
+    double elapsed = (double)(vad_now_ns() - start) / 1e9;
+    vad_resampler_destroy(resampler);
+
+    double level;
+    double snr;
+    measure_tone(pair, 1000.0, &level, &snr);
+    char alias[16] = "-";
+    if (pair->output_rate < pair->input_rate)
+    {
+      double rejected;
+      double unused;
+      measure_tone(pair, pair->output_rate * 0.55, &rejected, &unused);
+      snprintf(alias, sizeof(alias), "%.1f", rejected);
+    }
+
+    char rates[32];
+    snprintf(rates, sizeof(rates), "%d->%d", pair->input_rate, pair->output_rate);
+    printf("%-16s %6d %9.1f %14.1f %12.0f %9.1f %12s\n", rates, taps,
+           (double)phases * taps * sizeof(float) / 1024.0, elapsed / seconds * 1e6, seconds / elapsed, snr, alias);
+
+    free(input);
+    free(output);
+  }
+  return 0;
+}
@@ -0,0 +1,276 @@
+// Real-time factor of offline segmentation on a long recording: a synthetic
+// multi-hour PCM16 WAV (voiced bursts over noise) is written to disk, then
+// segmented with vad_segment_file() and, for comparison, streamed through
+// vad_process_audio() with speech events collected from the callback.
+//
+// The chunked parallel mode is then timed for 1, 2, 4, ... threads up to the
+// core count, and its accuracy measured against the sequential pass for
+// several lead-in lengths: segments whose bounds differ, and the share of
+// speech samples covered by only one of the two results.
+//
+// Usage: vad_plus_bench_segment [hours] [model.onnx]
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vad_plus.h"
+#include "vad_platform.h"
+
+#ifndef VAD_PLUS_BENCH_MODEL
+#define VAD_PLUS_BENCH_MODEL "silero_vad_v6.onnx"
+#endif
+
+#define SAMPLE_RATE 16000
+#define BLOCK_SAMPLES 16000
+#define PERIOD_SAMPLES (8 * SAMPLE_RATE)
+#define TWO_PI 6.283185307179586
+#define WAV_PATH "vad_plus_bench_segment.wav"
+
+static void write_u32(FILE *file, uint32_t value)
+{
+  uint8_t bytes[4] = {(uint8_t)value, (uint8_t)(value >> 8), (uint8_t)(value >> 16), (uint8_t)(value >> 24)};
+  fwrite(bytes, 1, 4, file);
+}
+
+static void write_u16(FILE *file, uint16_t value)
+{
+  uint8_t bytes[2] = {(uint8_t)value, (uint8_t)(value >> 8)};
+  fwrite(bytes, 1, 2, file);
+}
+
+/// One 8 s period: 3 s of a crude voiced signal (gliding pitch, two moving
+/// formants, 4 Hz syllable envelope) followed by 5 s of silence
+static void synthesize_period(float *period)
+{
+  double phase = 0.0;
+  for (int32_t i = 0; i < PERIOD_SAMPLES; i++)
+  {
+    double t = (double)i / SAMPLE_RATE;
+    double f0 = 120.0 + 20.0 * sin(TWO_PI * 0.7 * t) + 8.0 * sin(TWO_PI * 5.3 * t);
+    double f1 = 500.0 + 300.0 * sin(TWO_PI * 3.1 * t);
+    double f2 = 1500.0 + 600.0 * sin(TWO_PI * 2.3 * t + 1.0);
+    phase += TWO_PI * f0 / SAMPLE_RATE;
+
+    double voice = 0.0;
+    for (int32_t h = 1; h < 30; h++)
+    {
+      double fh = h * f0;
+      double gain = exp(-pow((fh - f1) / 150.0, 2.0)) + 0.6 * exp(-pow((fh - f2) / 200.0, 2.0)) + 0.1 / h;
+      voice += gain * sin(h * phase);
+    }
+    double envelope = t < 3.0 ? (0.5 + 0.5 * sin(TWO_PI * 4.0 * t)) * 0.15 : 0.0;
+    period[i] = (float)(envelope * voice);
+  }
+}
+
+/// Write total samples of mono PCM16: the synthetic period repeated, with noise
+static int32_t write_wav(const char *path, int64_t total)
+{
+  FILE *file = fopen(path, "wb");
+  if (file == NULL)
+    return -1;
+
+  uint32_t data_bytes = (uint32_t)(total * 2);
+  fwrite("RIFF", 1, 4, file);
+  write_u32(file, 36 + data_bytes);
+  fwrite("WAVEfmt ", 1, 8, file);
+  write_u32(file, 16);
+  write_u16(file, 1);
+  write_u16(file, 1);
+  write_u32(file, SAMPLE_RATE);
+  write_u32(file, SAMPLE_RATE * 2);
+  write_u16(file, 2);
+  write_u16(file, 16);
+  fwrite("data", 1, 4, file);
+  write_u32(file, data_bytes);
+
+  static float period[PERIOD_SAMPLES];
+  static int16_t block[BLOCK_SAMPLES];
+  synthesize_period(period);
+  uint32_t seed = 11;
+  for (int64_t written = 0; written < total; written += BLOCK_SAMPLES)
+  {
+    int64_t count = total - written < BLOCK_SAMPLES ? total - written : BLOCK_SAMPLES;
+    for (int64_t i = 0; i < count; i++)
+    {
+      int64_t n = written + i;
+      seed = seed * 1664525u + 1013904223u;
+      float noise = ((float)(seed >> 8) / 16777216.0f - 0.5f) * 0.01f;
+      block[i] = (int16_t)((noise + period[n % PERIOD_SAMPLES]) * 32767.0f);
+    }
+    fwrite(block, sizeof(int16_t), (size_t)count, file);
+  }
+  return fclose(file) == 0 ? 0 : -1;
+}
+
+typedef struct StreamState
+{
+  VADHandle *handle;
+  int64_t segments;
+} StreamState;
+
+static void on_event(const VADEvent *event, void *user_data)
+{
+  StreamState *stream = (StreamState *)user_data;
+  if (event->type == VAD_EVENT_SPEECH_END)
+    stream->segments++;
+  vad_event_release(stream->handle, event);
+}
+
+/// Samples inside a segment of a but not of b, plus the reverse
+static int64_t coverage_difference(const VADSegment *a, int32_t a_count, const VADSegment *b, int32_t b_count)
+{
+  int64_t covered = 0;
+  int64_t common = 0;
+  for (int32_t i = 0; i < a_count; i++)
+    covered += a[i].end_sample - a[i].start_sample;
+  for (int32_t j = 0; j < b_count; j++)
+    covered += b[j].end_sample - b[j].start_sample;
+
+  for (int32_t i = 0, j = 0; i < a_count && j < b_count;)
+  {
+    int64_t start = a[i].start_sample > b[j].start_sample ? a[i].start_sample : b[j].start_sample;
+    int64_t end = a[i].end_sample < b[j].end_sample ? a[i].end_sample : b[j].end_sample;
+    if (end > start)
+      common += end - start;
+    if (a[i].end_sample < b[j].end_sample)
+      i++;
+    else
+      j++;
+  }
+  return covered - 2 * common;
+}
+
+/// Segments of a with no identical segment in b
+static int32_t unmatched_segments(const VADSegment *a, int32_t a_count, const VADSegment *b, int32_t b_count)
+{
+  int32_t unmatched = 0;
+  for (int32_t i = 0, j = 0; i < a_count; i++)
+  {
+    while (j < b_count && b[j].start_sample < a[i].start_sample)
+      j++;
+    if (j == b_count || b[j].start_sample != a[i].start_sample || b[j].end_sample != a[i].end_sample)
+      unmatched++;
+  }
+  return unmatched;
+}
+
+static double speech_samples(const VADSegment *segments, int32_t count)
+{
+  double total = 0.0;
+  for (int32_t i = 0; i < count; i++)
+    total += (double)(segments[i].end_sample - segments[i].start_sample);
+  return total;
+}
+
+int main(int argc, char **argv)
+{
+  double hours = argc > 1 ? atof(argv[1]) : 1.0;
+  const char *model_path = argc > 2 ? argv[2] : VAD_PLUS_BENCH_MODEL;
+  int64_t total = (int64_t)(hours * 3600.0 * SAMPLE_RATE);
+  double audio_seconds = (double)total / SAMPLE_RATE;
+
+  VADHandle *handle = vad_create();
+  VADConfig config;
+  vad_config_default(&config);
+  if (handle == NULL || vad_init(handle, &config, model_path) != 0)
+  {
+    fprintf(stderr, "%s\n", handle ? vad_get_last_error(handle) : "vad_create failed");
+    return 1;
+  }
+  if (write_wav(WAV_PATH, total) != 0)
+  {
+    fprintf(stderr, "Failed to write %s\n", WAV_PATH);
+    return 1;
+  }
+
+  printf("%.2f h of 16 kHz PCM16 (%.0f MB)\n\n", hours, (double)total * 2 / 1e6);
+  printf("%-22s %10s %10s %12s %10s\n", "path", "wall s", "RTF", "x realtime", "segments");
+
+  // Offline: mmap, no events, no speech audio copies
+  VADSegment *segments = NULL;
+  int32_t count = 0;
+  uint64_t start = vad_now_ns();
+  if (vad_segment_file(handle, WAV_PATH, NULL, &segments, &count) != 0)
+  {
+    fprintf(stderr, "%s\n", vad_get_last_error(handle));
+    remove(WAV_PATH);
+    return 1;
+  }
+  double elapsed = (double)(vad_now_ns() - start) / 1e9;
+  printf("%-22s %10.2f %10.5f %12.0f %10d\n", "vad_segment_file", elapsed, elapsed / audio_seconds,
+         audio_seconds / elapsed, count);
+
+  // Streaming: read the file in blocks, convert, and collect SPEECH_END events
+  StreamState stream = {handle, 0};
+  vad_set_callback(handle, on_event, &stream);
+  vad_set_event_mask(handle, VAD_EVENT_MASK_ALL & ~VAD_EVENT_MASK(VAD_EVENT_FRAME_PROCESSED));
+
+  static int16_t pcm[BLOCK_SAMPLES];
+  static float samples[BLOCK_SAMPLES];
+  FILE *file = fopen(WAV_PATH, "rb");
+  fseek(file, 44, SEEK_SET);
+  start = vad_now_ns();
+  size_t read;
+  while ((read = fread(pcm, sizeof(int16_t), BLOCK_SAMPLES, file)) > 0)
+  {
+    vad_pcm16_to_float(pcm, samples, (int32_t)read);
+    vad_process_audio(handle, samples, (int32_t)read);
+  }
+  vad_force_end_speech(handle);
+  elapsed = (double)(vad_now_ns() - start) / 1e9;
+  fclose(file);
+  printf("%-22s %10.2f %10.5f %12.0f %10lld\n", "vad_process_audio", elapsed, elapsed / audio_seconds,
+         audio_seconds / elapsed, (long long)stream.segments);
+  vad_set_callback(handle, NULL, NULL);
+
+  // Core-count scaling of the chunked mode (default chunking and lead-in)
+  VADSegmentOptions options;
+  vad_segment_options_default(&options);
+  int32_t cores = vad_cpu_count();
+  printf("\nchunked: %d frames per chunk, %d lead-in frames, %d cores\n\n", options.chunk_frames,
+         options.lead_in_frames, cores);
+  printf("%-8s %10s %12s %10s %10s\n", "threads", "wall s", "x realtime", "speedup", "segments");
+  double sequential = elapsed;
+  for (int32_t threads = 1; threads <= cores; threads *= 2)
+  {
+    options.threads = threads;
+    VADSegment *parallel = NULL;
+    int32_t parallel_count = 0;
+    start = vad_now_ns();
+    vad_segment_file(handle, WAV_PATH, &options, &parallel, &parallel_count);
+    elapsed = (double)(vad_now_ns() - start) / 1e9;
+    if (threads == 1)
+      sequential = elapsed;
+    printf("%-8d %10.2f %12.0f %9.2fx %10d\n", threads, elapsed, audio_seconds / elapsed, sequential / elapsed,
+           parallel_count);
+    vad_segments_free(parallel);
+    if (threads < cores && threads * 2 > cores)
+      threads = cores / 2;
+  }
+
+  // Accuracy against the sequential pass, per lead-in length
+  static const int32_t kLeadIns[] = {0, 8, 32, 64, 128, 256, 512};
+  double reference_speech = speech_samples(segments, count);
+  options.threads = 0;
+  printf("\n%-8s %10s %12s %14s\n", "lead-in", "segments", "bounds diff", "speech diff %");
+  for (size_t i = 0; i < sizeof(kLeadIns) / sizeof(kLeadIns[0]); i++)
+  {
+    options.lead_in_frames = kLeadIns[i];
+    VADSegment *parallel = NULL;
+    int32_t parallel_count = 0;
+    vad_segment_file(handle, WAV_PATH, &options, &parallel, &parallel_count);
+    int32_t differing = unmatched_segments(segments, count, parallel, parallel_count);
+    int64_t difference = coverage_difference(segments, count, parallel, parallel_count);
+    printf("%-8d %10d %12d %14.4f\n", kLeadIns[i], parallel_count, differing,
+           reference_speech > 0.0 ? 100.0 * (double)difference / reference_speech : 0.0);
+    vad_segments_free(parallel);
+  }
+
+  vad_segments_free(segments);
+  vad_destroy(handle);
+  remove(WAV_PATH);
+  return 0;
+}
@@ -0,0 +1,661 @@
+// Per-stage cost of the native pipeline, in ns per frame, for regression
+// tracking between releases:
+//
+//   framing         10 ms packets copied into the input window after the context
+//   inference       vad_model_infer()
+//   hysteresis      vad_segmenter_push() on the frame probabilities
+//   pcm16_to_float  PCM16 input conversion (vad_process_audio_ex)
+//   float_to_pcm16  speech segment storage
+//   event_dispatch  frame event from the pool, frame copied in, released
+//
+// followed by the whole pipeline (vad_process_audio() with every event
+// delivered and released): ns per frame, real-time factor and heap
+// allocations per frame in steady state, with the inference and callback
+// latency percentiles of the last pass (vad_get_stats()), and again with a
+// timeline trace recording (vad_trace_start()). Peak RSS is reported for the
+// run.
+//
+// Usage: vad_plus_bench [--json FILE] [--model model.onnx] [audio.wav ...]
+//   Each WAV file (any format vad_file_open() reads; other rates than 16000
+//   and 8000 Hz are resampled to 16000 Hz) is one input. Without any, a
+//   synthetic 30 second signal (tone bursts over noise) at 16 kHz is used.
+//   --json writes the results as JSON to FILE ("-" for stdout) as well.
+//
+// Allocation counts need the GNU linker's --wrap (Linux); elsewhere they are
+// reported as null.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vad_convert.h"
+#include "vad_events.h"
+#include "vad_file.h"
+#include "vad_model.h"
+#include "vad_platform.h"
+#include "vad_plus.h"
+#include "vad_resample.h"
+#include "vad_segmenter.h"
+
+#if _WIN32
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#ifndef VAD_PLUS_BENCH_MODEL
+#define VAD_PLUS_BENCH_MODEL "silero_vad_v6.onnx"
+#endif
+
+// Each stage is repeated over the input until this much time has passed
+#define STAGE_MIN_NS 200000000ull
+
+typedef struct BenchInput
+{
+  char name[256];
+  float *samples;
+  int32_t length;
+  int32_t sample_rate;
+} BenchInput;
+
+enum
+{
+  STAGE_FRAMING,
+  STAGE_INFERENCE,
+  STAGE_HYSTERESIS,
+  STAGE_PCM16_TO_FLOAT,
+  STAGE_FLOAT_TO_PCM16,
+  STAGE_EVENT_DISPATCH,
+  STAGE_COUNT
+};
+
+static const char *const kStageNames[STAGE_COUNT] = {
+    "framing", "inference", "hysteresis", "pcm16_to_float", "float_to_pcm16", "event_dispatch",
+};
+
+typedef struct BenchResult
+{
+  int32_t frames;
+  double seconds;
+  double stage_ns[STAGE_COUNT];
+  double total_ns;
+  double traced_ns; // Pipeline with vad_trace_start()
+  double rtf;
+  double allocations_per_frame; // negative when not counted
+  int32_t segments;
+  VADStats stats; // Last pipeline pass
+} BenchResult;
+
+// ============================================================================
+// Allocation counting (GNU ld --wrap, see CMakeLists.txt)
+// ============================================================================
+
+#ifdef VAD_PLUS_BENCH_COUNT_ALLOCS
+static volatile int64_t g_allocations = 0;
+
+void *__real_malloc(size_t size);
+void *__real_calloc(size_t count, size_t size);
+void *__real_realloc(void *ptr, size_t size);
+int __real_posix_memalign(void **ptr, size_t alignment, size_t size);
+
+void *__wrap_malloc(size_t size)
+{
+  __atomic_fetch_add(&g_allocations, 1, __ATOMIC_RELAXED);
+  return __real_malloc(size);
+}
+
+void *__wrap_calloc(size_t count, size_t size)
+{
+  __atomic_fetch_add(&g_allocations, 1, __ATOMIC_RELAXED);
+  return __real_calloc(count, size);
+}
+
+void *__wrap_realloc(void *ptr, size_t size)
+{
+  __atomic_fetch_add(&g_allocations, 1, __ATOMIC_RELAXED);
+  return __real_realloc(ptr, size);
+}
+
+int __wrap_posix_memalign(void **ptr, size_t alignment, size_t size)
+{
+  __atomic_fetch_add(&g_allocations, 1, __ATOMIC_RELAXED);
+  return __real_posix_memalign(ptr, alignment, size);
+}
+
+static int64_t allocation_count(void)
+{
+  return __atomic_load_n(&g_allocations, __ATOMIC_RELAXED);
+}
+#else
+static int64_t allocation_count(void)
+{
+  return -1;
+}
+#endif
+
+/// Peak resident set size in KB (0 if unknown)
+static int64_t peak_rss_kb(void)
+{
+#if _WIN32
+  PROCESS_MEMORY_COUNTERS counters;
+  if (!K32GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters)))
+    return 0;
+  return (int64_t)(counters.PeakWorkingSetSize / 1024);
+#else
+  struct rusage usage;
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+    return 0;
+#if __APPLE__
+  return (int64_t)usage.ru_maxrss / 1024;
+#else
+  return (int64_t)usage.ru_maxrss;
+#endif
+#endif
+}
+
+// ============================================================================
+// Inputs
+// ============================================================================
+
+static void synthesize(BenchInput *input)
+{
+  snprintf(input->name, sizeof(input->name), "synthetic");
+  input->sample_rate = 16000;
+  input->length = 30 * input->sample_rate;
+  input->samples = (float *)malloc((size_t)input->length * sizeof(float));
+  uint32_t seed = 12345;
+  for (int32_t i = 0; i < input->length; i++)
+  {
+    seed = seed * 1664525u + 1013904223u;
+    float noise = ((float)(seed >> 8) / 16777216.0f - 0.5f) * 0.02f;
+    float t = (float)i / input->sample_rate;
+    // Voiced-like bursts: 2 s on, 1 s off, 150 Hz fundamental with harmonics
+    float burst = fmodf(t, 3.0f) < 2.0f ? 1.0f : 0.0f;
+    float tone = 0.3f * sinf(2.0f * 3.14159265f * 150.0f * t) + 0.15f * sinf(2.0f * 3.14159265f * 450.0f * t) +
+                 0.08f * sinf(2.0f * 3.14159265f * 1200.0f * t);
+    input->samples[i] = noise + burst * tone;
+  }
+}
+
+/// Resample samples to 16 kHz, replacing them
+/// @return 0 on success
+static int32_t resample_to_16k(BenchInput *input)
+{
+  VADResampler *resampler = vad_resampler_create(input->sample_rate, 16000);
+  int32_t capacity = (int32_t)((int64_t)input->length * 16000 / input->sample_rate) + VAD_RESAMPLER_BLOCK;
+  float *output = (float *)malloc((size_t)capacity * sizeof(float));
+  if (resampler == NULL || output == NULL)
+  {
+    vad_resampler_destroy(resampler);
+    free(output);
+    return -1;
+  }
+
+  int32_t length = 0;
+  const float *samples = input->samples;
+  int32_t remaining = input->length;
+  for (;;)
+  {
+    int32_t used;
+    int32_t produced =
+        vad_resampler_process(resampler, samples, remaining, &used, output + length, VAD_RESAMPLER_BLOCK);
+    samples += used;
+    remaining -= used;
+    length += produced;
+    if (produced < VAD_RESAMPLER_BLOCK || capacity - length < VAD_RESAMPLER_BLOCK)
+      break;
+  }
+  vad_resampler_destroy(resampler);
+
+  free(input->samples);
+  input->samples = output;
+  input->length = length;
+  input->sample_rate = 16000;
+  return 0;
+}
+
+/// Decode a WAV file to mono float at a model rate
+/// @return 0 on success
+static int32_t load_input(const char *path, BenchInput *input)
+{
+  VADFile file;
+  char error[256];
+  if (vad_file_open(&file, path, error, sizeof(error)) != 0)
+  {
+    fprintf(stderr, "%s: %s\n", path, error);
+    return -1;
+  }
+  if (file.sample_rate == 0 || file.frames <= 0 || file.frames > INT32_MAX)
+  {
+    fprintf(stderr, "%s: not a WAV file with samples\n", path);
+    vad_file_close(&file);
+    return -1;
+  }
+
+  snprintf(input->name, sizeof(input->name), "%s", path);
+  input->length = (int32_t)file.frames;
+  input->sample_rate = file.sample_rate;
+  input->samples = (float *)malloc((size_t)input->length * sizeof(float));
+  if (input->samples == NULL)
+  {
+    vad_file_close(&file);
+    return -1;
+  }
+  vad_file_read(&file, 0, input->length, input->samples);
+  vad_file_close(&file);
+
+  if (input->sample_rate != 16000 && input->sample_rate != 8000 && resample_to_16k(input) != 0)
+  {
+    fprintf(stderr, "%s: cannot resample from %d Hz\n", path, input->sample_rate);
+    return -1;
+  }
+  return 0;
+}
+
+// ============================================================================
+// Stages
+// ============================================================================
+
+typedef struct StageContext
+{
+  const VADModelRate *rate;
+  const VADConfig *config;
+  const BenchInput *input;
+  int32_t frames;
+  float *window; // context + frame
+  float *probabilities;
+  int16_t *pcm16;
+  float *converted;
+  VADEventPool *events;
+  float checksum;
+} StageContext;
+
+/// One pass of a stage over every frame of the input
+static void run_stage(StageContext *ctx, int32_t stage)
+{
+  int32_t frame_samples = ctx->config->frame_samples;
+  int32_t context_size = ctx->rate->context_size;
+  const float *samples = ctx->input->samples;
+
+  switch (stage)
+  {
+  case STAGE_FRAMING:
+  {
+    // As feed_frames() in vad_plus.c, from 10 ms packets
+    int32_t packet = ctx->input->sample_rate / 100;
+    int32_t length = ctx->frames * frame_samples;
+    int32_t pending = 0;
+    float *frame = ctx->window + context_size;
+    for (int32_t offset = 0; offset < length;)
+    {
+      int32_t end = offset + packet < length ? offset + packet : length;
+      while (offset < end)
+      {
+        int32_t count = frame_samples - pending;
+        if (count > end - offset)
+          count = end - offset;
+        memcpy(frame + pending, samples + offset, (size_t)count * sizeof(float));
+        pending += count;
+        offset += count;
+        if (pending == frame_samples)
+        {
+          ctx->checksum += frame[0];
+          memcpy(ctx->window, frame + frame_samples - context_size, (size_t)context_size * sizeof(float));
+          pending = 0;
+        }
+      }
+    }
+    break;
+  }
+  case STAGE_INFERENCE:
+  {
+    float state[VAD_MODEL_STATE_SIZE];
+    memset(state, 0, sizeof(state));
+    memset(ctx->window, 0, (size_t)context_size * sizeof(float));
+    for (int32_t f = 0; f < ctx->frames; f++)
+    {
+      memcpy(ctx->window + context_size, samples + (size_t)f * frame_samples, (size_t)frame_samples * sizeof(float));
+      ctx->probabilities[f] = vad_model_infer(ctx->rate, ctx->window, state);
+      memcpy(ctx->window, ctx->window + frame_samples, (size_t)context_size * sizeof(float));
+    }
+    break;
+  }
+  case STAGE_HYSTERESIS:
+  {
+    VADSegmenter segmenter;
+    vad_segmenter_init(&segmenter, ctx->config);
+    uint32_t transitions = 0;
+    for (int32_t f = 0; f < ctx->frames; f++)
+      transitions |= vad_segmenter_push(&segmenter, ctx->probabilities[f]);
+    ctx->checksum += (float)transitions;
+    break;
+  }
+  case STAGE_PCM16_TO_FLOAT:
+    for (int32_t f = 0; f < ctx->frames; f++)
+      vad_convert_s16_to_f32(ctx->pcm16 + (size_t)f * frame_samples, ctx->converted, frame_samples);
+    ctx->checksum += ctx->converted[0];
+    break;
+  case STAGE_FLOAT_TO_PCM16:
+    for (int32_t f = 0; f < ctx->frames; f++)
+      vad_convert_f32_to_s16(samples + (size_t)f * frame_samples, ctx->pcm16 + (size_t)f * frame_samples,
+                             frame_samples);
+    break;
+  case STAGE_EVENT_DISPATCH:
+    for (int32_t f = 0; f < ctx->frames; f++)
+    {
+      void *payload;
+      VADEvent *event = vad_event_pool_acquire(ctx->events, VAD_EVENT_FRAME_PROCESSED,
+                                               (size_t)frame_samples * sizeof(float), &payload);
+      if (event == NULL)
+        continue;
+      memcpy(payload, samples + (size_t)f * frame_samples, (size_t)frame_samples * sizeof(float));
+      event->frame_probability = ctx->probabilities[f];
+      event->frame_is_speech = ctx->probabilities[f] >= ctx->config->positive_speech_threshold;
+      event->frame_data = (float *)payload;
+      event->frame_length = frame_samples;
+      vad_event_pool_release(event);
+    }
+    break;
+  }
+}
+
+/// ns per frame of a stage, repeated until STAGE_MIN_NS has passed
+static double time_stage(StageContext *ctx, int32_t stage)
+{
+  uint64_t elapsed = 0;
+  int64_t passes = 0;
+  do
+  {
+    uint64_t start = vad_now_ns();
+    run_stage(ctx, stage);
+    elapsed += vad_now_ns() - start;
+    passes++;
+  } while (elapsed < STAGE_MIN_NS);
+  return (double)elapsed / ((double)passes * ctx->frames);
+}
+
+// ============================================================================
+// Whole pipeline
+// ============================================================================
+
+typedef struct PipelineStats
+{
+  VADHandle *handle;
+  int32_t segments;
+} PipelineStats;
+
+static void on_event(const VADEvent *event, void *user_data)
+{
+  PipelineStats *stats = (PipelineStats *)user_data;
+  if (event->type == VAD_EVENT_SPEECH_END)
+    stats->segments++;
+  vad_event_release(stats->handle, event);
+}
+
+/// Feed the input through a handle in 10 ms packets
+static void run_pipeline(VADHandle *handle, const BenchInput *input, int32_t length)
+{
+  int32_t packet = input->sample_rate / 100;
+  for (int32_t offset = 0; offset < length; offset += packet)
+    vad_process_audio(handle, input->samples + offset, length - offset < packet ? length - offset : packet);
+}
+
+/// Time the whole pipeline; the first pass warms the pools (and allocates
+/// the trace ring) and is not counted. A traced run only sets traced_ns.
+/// @return 0 on success
+static int32_t measure_pipeline(const char *model_path, const VADConfig *config, const BenchInput *input,
+                                int32_t frames, int32_t traced, BenchResult *result)
+{
+  VADHandle *handle = vad_create();
+  if (handle == NULL)
+    return -1;
+  if (vad_init(handle, config, model_path) != 0)
+  {
+    fprintf(stderr, "%s\n", vad_get_last_error(handle));
+    vad_destroy(handle);
+    return -1;
+  }
+  PipelineStats stats = {handle, 0};
+  vad_set_callback(handle, on_event, &stats);
+  if (traced)
+    vad_trace_start(handle, 0);
+
+  int32_t length = frames * config->frame_samples;
+  run_pipeline(handle, input, length);
+
+  uint64_t elapsed = 0;
+  int64_t passes = 0;
+  int64_t allocations = 0;
+  do
+  {
+    vad_reset(handle);
+    stats.segments = 0;
+    int64_t before = allocation_count();
+    uint64_t start = vad_now_ns();
+    run_pipeline(handle, input, length);
+    elapsed += vad_now_ns() - start;
+    allocations += allocation_count() - before;
+    passes++;
+  } while (elapsed < STAGE_MIN_NS);
+  if (!traced)
+    vad_get_stats(handle, &result->stats);
+  vad_destroy(handle);
+
+  if (traced)
+  {
+    result->traced_ns = (double)elapsed / ((double)passes * frames);
+    return 0;
+  }
+  result->total_ns = (double)elapsed / ((double)passes * frames);
+  result->rtf = (double)elapsed / passes / 1e9 / result->seconds;
+  result->allocations_per_frame = allocation_count() < 0 ? -1.0 : (double)allocations / ((double)passes * frames);
+  result->segments = stats.segments;
+  return 0;
+}
+
+/// Measure every stage and the whole pipeline on one input
+/// @return 0 on success
+static int32_t bench_input(const char *model_path, const VADModel *model, const BenchInput *input,
+                           BenchResult *result)
+{
+  const VADModelRate *rate = vad_model_get_rate(model, input->sample_rate);
+  if (rate == NULL)
+  {
+    fprintf(stderr, "%s: no model for %d Hz\n", input->name, input->sample_rate);
+    return -1;
+  }
+  VADConfig config;
+  vad_config_default(&config);
+  config.sample_rate = input->sample_rate;
+  config.frame_samples = rate->frame_samples;
+
+  memset(result, 0, sizeof(*result));
+  result->frames = input->length / config.frame_samples;
+  result->seconds = (double)result->frames * config.frame_samples / input->sample_rate;
+  if (result->frames == 0)
+  {
+    fprintf(stderr, "%s: shorter than one frame\n", input->name);
+    return -1;
+  }
+
+  size_t frame_bytes = (size_t)config.frame_samples * sizeof(float);
+  StageContext ctx;
+  memset(&ctx, 0, sizeof(ctx));
+  ctx.rate = rate;
+  ctx.config = &config;
+  ctx.input = input;
+  ctx.frames = result->frames;
+  ctx.window = (float *)vad_aligned_alloc((size_t)(rate->context_size + config.frame_samples) * sizeof(float));
+  ctx.probabilities = (float *)malloc((size_t)result->frames * sizeof(float));
+  ctx.pcm16 = (int16_t *)malloc((size_t)result->frames * config.frame_samples * sizeof(int16_t));
+  ctx.converted = (float *)vad_aligned_alloc(frame_bytes);
+  ctx.events = vad_event_pool_create(VAD_EVENT_POOL_SLOTS, frame_bytes);
+
+  int32_t status = -1;
+  if (ctx.window != NULL && ctx.probabilities != NULL && ctx.pcm16 != NULL && ctx.converted != NULL &&
+      ctx.events != NULL)
+  {
+    memset(ctx.window, 0, (size_t)rate->context_size * sizeof(float));
+    vad_convert_f32_to_s16(input->samples, ctx.pcm16, result->frames * config.frame_samples);
+    // Inference first: hysteresis and event dispatch use its probabilities
+    static const int32_t kOrder[STAGE_COUNT] = {STAGE_INFERENCE,      STAGE_FRAMING,        STAGE_HYSTERESIS,
+                                                STAGE_PCM16_TO_FLOAT, STAGE_FLOAT_TO_PCM16, STAGE_EVENT_DISPATCH};
+    for (int32_t s = 0; s < STAGE_COUNT; s++)
+      result->stage_ns[kOrder[s]] = time_stage(&ctx, kOrder[s]);
+    status = measure_pipeline(model_path, &config, input, result->frames, 0, result);
+    if (status == 0)
+      status = measure_pipeline(model_path, &config, input, result->frames, 1, result);
+  }
+
+  vad_event_pool_close(ctx.events);
+  vad_aligned_free(ctx.converted);
+  free(ctx.pcm16);
+  free(ctx.probabilities);
+  vad_aligned_free(ctx.window);
+  return status;
+}
+
+// ============================================================================
+// Reports
+// ============================================================================
+
+static void print_table(const BenchInput *inputs, const BenchResult *results, int32_t count)
+{
+  for (int32_t i = 0; i < count; i++)
+  {
+    const BenchResult *r = &results[i];
+    printf("%s (%d Hz, %d frames, %.1f s)\n", inputs[i].name, inputs[i].sample_rate, r->frames, r->seconds);
+    for (int32_t s = 0; s < STAGE_COUNT; s++)
+      printf("  %-16s %12.1f ns/frame\n", kStageNames[s], r->stage_ns[s]);
+    printf("  %-16s %12.1f ns/frame  rtf %.5f  %d segments\n", "pipeline", r->total_ns, r->rtf, r->segments);
+    if (r->allocations_per_frame >= 0.0)
+      printf("  %-16s %12.4f per frame\n", "allocations", r->allocations_per_frame);
+    else
+      printf("  %-16s %12s\n", "allocations", "not counted");
+    printf("  %-16s %12.1f ns/frame  (%+.1f%%)\n", "pipeline traced", r->traced_ns,
+           (r->traced_ns / r->total_ns - 1.0) * 100.0);
+    const VADStats *st = &r->stats;
+    printf("  %-16s p50 %.1f  p95 %.1f  p99 %.1f  max %.1f us\n", "inference", st->inference_p50_us,
+           st->inference_p95_us, st->inference_p99_us, st->inference_max_us);
+    printf("  %-16s p50 %.2f  p95 %.2f  p99 %.2f  max %.2f us  (%llu events)\n", "callback", st->callback_p50_us,
+           st->callback_p95_us, st->callback_p99_us, st->callback_max_us, (unsigned long long)st->callbacks);
+  }
+  printf("peak RSS %lld KB\n", (long long)peak_rss_kb());
+}
+
+/// Write a string as a JSON string literal
+static void write_json_string(FILE *out, const char *text)
+{
+  fputc('"', out);
+  for (const char *p = text; *p != '\0'; p++)
+  {
+    if (*p == '"' || *p == '\\')
+      fprintf(out, "\\%c", *p);
+    else if ((unsigned char)*p < 0x20)
+      fprintf(out, "\\u%04x", (unsigned char)*p);
+    else
+      fputc(*p, out);
+  }
+  fputc('"', out);
+}
+
+static void write_json(FILE *out, const char *model_path, const BenchInput *inputs, const BenchResult *results,
+                       int32_t count)
+{
+  fprintf(out, "{\n  \"model\": ");
+  write_json_string(out, model_path);
+  fprintf(out, ",\n  \"isa\": \"%s\",\n  \"peak_rss_kb\": %lld,\n  \"inputs\": [", vad_convert_isa_name(vad_convert_get_isa()),
+          (long long)peak_rss_kb());
+  for (int32_t i = 0; i < count; i++)
+  {
+    const BenchResult *r = &results[i];
+    fprintf(out, "%s\n    {\n      \"name\": ", i > 0 ? "," : "");
+    write_json_string(out, inputs[i].name);
+    fprintf(out, ",\n      \"sample_rate\": %d,\n      \"frames\": %d,\n      \"seconds\": %.3f,\n",
+            inputs[i].sample_rate, r->frames, r->seconds);
+    fprintf(out, "      \"stages_ns_per_frame\": {");
+    for (int32_t s = 0; s < STAGE_COUNT; s++)
+      fprintf(out, "%s\"%s\": %.1f", s > 0 ? ", " : "", kStageNames[s], r->stage_ns[s]);
+    fprintf(out, "},\n      \"pipeline_ns_per_frame\": %.1f,\n      \"rtf\": %.6f,\n", r->total_ns, r->rtf);
+    fprintf(out, "      \"traced_pipeline_ns_per_frame\": %.1f,\n", r->traced_ns);
+    if (r->allocations_per_frame >= 0.0)
+      fprintf(out, "      \"allocations_per_frame\": %.4f,\n", r->allocations_per_frame);
+    else
+      fprintf(out, "      \"allocations_per_frame\": null,\n");
+    const VADStats *st = &r->stats;
+    fprintf(out, "      \"inference_us\": {\"p50\": %.1f, \"p95\": %.1f, \"p99\": %.1f, \"max\": %.1f},\n",
+            st->inference_p50_us, st->inference_p95_us, st->inference_p99_us, st->inference_max_us);
+    fprintf(out, "      \"callback_us\": {\"p50\": %.2f, \"p95\": %.2f, \"p99\": %.2f, \"max\": %.2f},\n",
+            st->callback_p50_us, st->callback_p95_us, st->callback_p99_us, st->callback_max_us);
+    fprintf(out, "      \"late_frames\": %llu,\n", (unsigned long long)st->late_frames);
+    fprintf(out, "      \"segments\": %d\n    }", r->segments);
+  }
+  fprintf(out, "\n  ]\n}\n");
+}
+
+int main(int argc, char **argv)
+{
+  const char *model_path = VAD_PLUS_BENCH_MODEL;
+  const char *json_path = NULL;
+  const char **wav_paths = (const char **)calloc((size_t)argc, sizeof(char *));
+  int32_t wav_count = 0;
+  for (int i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--json") == 0 && i + 1 < argc)
+      json_path = argv[++i];
+    else if (strcmp(argv[i], "--model") == 0 && i + 1 < argc)
+      model_path = argv[++i];
+    else
+      wav_paths[wav_count++] = argv[i];
+  }
+
+  int32_t count = wav_count > 0 ? wav_count : 1;
+  BenchInput *inputs = (BenchInput *)calloc((size_t)count, sizeof(BenchInput));
+  BenchResult *results = (BenchResult *)calloc((size_t)count, sizeof(BenchResult));
+  if (wav_paths == NULL || inputs == NULL || results == NULL)
+    return 1;
+
+  VADModel model;
+  char error[256];
+  if (vad_model_load_file(&model, model_path, error, sizeof(error)) != 0)
+  {
+    fprintf(stderr, "%s\n", error);
+    return 1;
+  }
+
+  int32_t status = 0;
+  if (wav_count == 0)
+    synthesize(&inputs[0]);
+  for (int32_t i = 0; i < wav_count && status == 0; i++)
+    status = load_input(wav_paths[i], &inputs[i]);
+  for (int32_t i = 0; i < count && status == 0; i++)
+    status = bench_input(model_path, &model, &inputs[i], &results[i]);
+
+  if (status == 0)
+  {
+    // JSON on stdout is not mixed with the table
+    if (json_path == NULL || strcmp(json_path, "-") != 0)
+      print_table(inputs, results, count);
+    FILE *out = json_path == NULL ? NULL : strcmp(json_path, "-") == 0 ? stdout : fopen(json_path, "w");
+    if (json_path != NULL && out == NULL)
+    {
+      fprintf(stderr, "Cannot write %s\n", json_path);
+      status = -1;
+    }
+    else if (out != NULL)
+    {
+      write_json(out, model_path, inputs, results, count);
+      if (out != stdout)
+        fclose(out);
+    }
+  }
+
+  for (int32_t i = 0; i < count; i++)
+    free(inputs[i].samples);
+  free(inputs);
+  free(results);
+  free(wav_paths);
+  vad_model_free(&model);
+  return status == 0 ? 0 : 1;
+}
@@ -0,0 +1,625 @@
+// Writes an int8-quantized copy of the Silero VAD model. The encoder conv and
+// LSTM weights (the bulk of the compute) are stored as int8 with one
+// symmetric scale per output channel; every other tensor stays fp32.
+//
+// Each quantized weight W, a Constant node in the exported graph, is replaced
+// by Constants W_quantized (int8), W_scale (float) and W_zero_point (int8,
+// zero) feeding a DequantizeLinear node that outputs W again. The rest of the
+// graph is untouched, so ONNX Runtime (Android, iOS, macOS) runs the file as
+// is, and the native engine picks the int8 weights up by name.
+//
+// Usage: vad_plus_quantize [input.onnx] output.onnx
+
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifndef VAD_PLUS_BENCH_MODEL
+#define VAD_PLUS_BENCH_MODEL "silero_vad_v6.onnx"
+#endif
+
+// Field numbers from onnx.proto3
+#define MODEL_GRAPH 7
+#define MODEL_OPSET_IMPORT 8
+#define OPSET_DOMAIN 1
+#define OPSET_VERSION 2
+#define GRAPH_NODE 1
+#define NODE_INPUT 1
+#define NODE_OUTPUT 2
+#define NODE_NAME 3
+#define NODE_OP_TYPE 4
+#define NODE_ATTRIBUTE 5
+#define ATTRIBUTE_NAME 1
+#define ATTRIBUTE_INT 3
+#define ATTRIBUTE_TENSOR 5
+#define ATTRIBUTE_GRAPH 6
+#define ATTRIBUTE_GRAPHS 11
+#define ATTRIBUTE_TYPE 20
+#define ATTRIBUTE_TYPE_INT 2
+#define ATTRIBUTE_TYPE_TENSOR 4
+#define TENSOR_DIMS 1
+#define TENSOR_DATA_TYPE 2
+#define TENSOR_FLOAT_DATA 4
+#define TENSOR_RAW_DATA 9
+#define TENSOR_FLOAT 1
+#define TENSOR_INT8 3
+
+#define WIRE_VARINT 0
+#define WIRE_FIXED64 1
+#define WIRE_LENGTH 2
+#define WIRE_FIXED32 5
+
+// DequantizeLinear gained the axis attribute (per-channel scales) in opset 13
+#define MIN_OPSET 13
+#define MAX_RANK 8
+#define MAX_DEPTH 16
+#define MAX_NAME 1024
+
+// Weights worth quantizing; the STFT basis, biases and output head stay fp32
+static const char *const kQuantizedWeights[] = {
+    "encoder.0.reparam_conv.weight", "encoder.1.reparam_conv.weight", "encoder.2.reparam_conv.weight",
+    "encoder.3.reparam_conv.weight", "decoder.rnn.weight_ih",         "decoder.rnn.weight_hh",
+};
+
+typedef struct Buffer
+{
+  uint8_t *data;
+  size_t length;
+  size_t capacity;
+} Buffer;
+
+typedef struct Field
+{
+  uint32_t number;
+  uint32_t wire_type;
+  uint64_t varint;
+  const uint8_t *data;
+  size_t length;
+} Field;
+
+typedef struct Reader
+{
+  const uint8_t *cur;
+  const uint8_t *end;
+} Reader;
+
+typedef struct Stats
+{
+  int32_t weights;
+  size_t float_bytes;
+  size_t int8_bytes;
+} Stats;
+
+// ============================================================================
+// Protobuf
+// ============================================================================
+
+static void put(Buffer *buffer, const void *data, size_t length)
+{
+  if (buffer->length + length > buffer->capacity)
+  {
+    size_t capacity = buffer->capacity > 0 ? buffer->capacity : 4096;
+    while (capacity < buffer->length + length)
+      capacity *= 2;
+    uint8_t *grown = (uint8_t *)realloc(buffer->data, capacity);
+    if (grown == NULL)
+    {
+      fprintf(stderr, "Out of memory\n");
+      exit(1);
+    }
+    buffer->data = grown;
+    buffer->capacity = capacity;
+  }
+  memcpy(buffer->data + buffer->length, data, length);
+  buffer->length += length;
+}
+
+static void put_varint(Buffer *buffer, uint64_t value)
+{
+  uint8_t bytes[10];
+  size_t count = 0;
+  do
+  {
+    bytes[count++] = (uint8_t)((value & 0x7f) | (value > 0x7f ? 0x80 : 0));
+    value >>= 7;
+  } while (value != 0);
+  put(buffer, bytes, count);
+}
+
+static void put_int_field(Buffer *buffer, uint32_t number, uint64_t value)
+{
+  put_varint(buffer, (uint64_t)number << 3 | WIRE_VARINT);
+  put_varint(buffer, value);
+}
+
+static void put_bytes_field(Buffer *buffer, uint32_t number, const void *data, size_t length)
+{
+  put_varint(buffer, (uint64_t)number << 3 | WIRE_LENGTH);
+  put_varint(buffer, length);
+  put(buffer, data, length);
+}
+
+static void put_string_field(Buffer *buffer, uint32_t number, const char *text)
+{
+  put_bytes_field(buffer, number, text, strlen(text));
+}
+
+static int32_t read_varint(Reader *reader, uint64_t *value)
+{
+  uint64_t result = 0;
+  for (int shift = 0; shift < 64; shift += 7)
+  {
+    if (reader->cur >= reader->end)
+      return -1;
+    uint8_t byte = *reader->cur++;
+    result |= (uint64_t)(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0)
+    {
+      *value = result;
+      return 0;
+    }
+  }
+  return -1;
+}
+
+/// Read the next field. Returns 1 when a field was read, 0 at end, -1 on error.
+static int32_t next_field(Reader *reader, Field *field)
+{
+  if (reader->cur >= reader->end)
+    return 0;
+
+  uint64_t key;
+  if (read_varint(reader, &key) != 0)
+    return -1;
+  field->number = (uint32_t)(key >> 3);
+  field->wire_type = (uint32_t)(key & 7);
+  field->varint = 0;
+  field->data = NULL;
+  field->length = 0;
+
+  size_t size = 0;
+  switch (field->wire_type)
+  {
+  case WIRE_VARINT:
+    return read_varint(reader, &field->varint) == 0 ? 1 : -1;
+  case WIRE_FIXED64:
+    size = 8;
+    break;
+  case WIRE_FIXED32:
+    size = 4;
+    break;
+  case WIRE_LENGTH:
+  {
+    uint64_t length;
+    if (read_varint(reader, &length) != 0)
+      return -1;
+    size = (size_t)length;
+    break;
+  }
+  default:
+    return -1;
+  }
+  if (size > (size_t)(reader->end - reader->cur))
+    return -1;
+  field->data = reader->cur;
+  field->length = size;
+  reader->cur += size;
+  return 1;
+}
+
+// ============================================================================
+// Quantization
+// ============================================================================
+
+typedef struct FloatTensor
+{
+  int64_t dims[MAX_RANK];
+  int32_t rank;
+  const uint8_t *data;
+  size_t length;
+  int32_t data_type;
+} FloatTensor;
+
+static int32_t parse_tensor(const uint8_t *data, size_t length, FloatTensor *tensor)
+{
+  memset(tensor, 0, sizeof(*tensor));
+  Reader reader = {data, data + length};
+  Field field;
+  int32_t status;
+  while ((status = next_field(&reader, &field)) > 0)
+  {
+    if (field.number == TENSOR_DIMS && field.wire_type == WIRE_VARINT && tensor->rank < MAX_RANK)
+    {
+      tensor->dims[tensor->rank++] = (int64_t)field.varint;
+    }
+    else if (field.number == TENSOR_DIMS && field.wire_type == WIRE_LENGTH)
+    {
+      Reader packed = {field.data, field.data + field.length};
+      uint64_t dim;
+      while (packed.cur < packed.end && tensor->rank < MAX_RANK && read_varint(&packed, &dim) == 0)
+        tensor->dims[tensor->rank++] = (int64_t)dim;
+    }
+    else if (field.number == TENSOR_DATA_TYPE)
+    {
+      tensor->data_type = (int32_t)field.varint;
+    }
+    else if (field.number == TENSOR_RAW_DATA ||
+             (field.number == TENSOR_FLOAT_DATA && field.wire_type == WIRE_LENGTH && tensor->data == NULL))
+    {
+      tensor->data = field.data;
+      tensor->length = field.length;
+    }
+  }
+  return status;
+}
+
+static void put_tensor(Buffer *buffer, const int64_t *dims, int32_t rank, int32_t data_type, const void *data,
+                       size_t length)
+{
+  Buffer packed = {0};
+  for (int32_t i = 0; i < rank; i++)
+    put_varint(&packed, (uint64_t)dims[i]);
+  put_bytes_field(buffer, TENSOR_DIMS, packed.data, packed.length);
+  put_int_field(buffer, TENSOR_DATA_TYPE, (uint64_t)data_type);
+  put_bytes_field(buffer, TENSOR_RAW_DATA, data, length);
+  free(packed.data);
+}
+
+/// Append a Constant node producing the given tensor
+static void put_constant(Buffer *graph, const char *output, const int64_t *dims, int32_t rank, int32_t data_type,
+                         const void *data, size_t length)
+{
+  Buffer tensor = {0};
+  Buffer attribute = {0};
+  Buffer node = {0};
+  put_tensor(&tensor, dims, rank, data_type, data, length);
+  put_string_field(&attribute, ATTRIBUTE_NAME, "value");
+  put_bytes_field(&attribute, ATTRIBUTE_TENSOR, tensor.data, tensor.length);
+  put_int_field(&attribute, ATTRIBUTE_TYPE, ATTRIBUTE_TYPE_TENSOR);
+  put_string_field(&node, NODE_OUTPUT, output);
+  put_string_field(&node, NODE_NAME, output);
+  put_string_field(&node, NODE_OP_TYPE, "Constant");
+  put_bytes_field(&node, NODE_ATTRIBUTE, attribute.data, attribute.length);
+  put_bytes_field(graph, GRAPH_NODE, node.data, node.length);
+  free(tensor.data);
+  free(attribute.data);
+  free(node.data);
+}
+
+/// Append the int8 Constants and the DequantizeLinear node replacing the
+/// Constant node named output
+static int32_t put_quantized(Buffer *graph, const char *output, const FloatTensor *tensor, Stats *stats)
+{
+  int64_t count = 1;
+  for (int32_t i = 0; i < tensor->rank; i++)
+    count *= tensor->dims[i];
+  if (tensor->rank < 1 || count <= 0 || tensor->length < (size_t)count * sizeof(float))
+    return -1;
+
+  int64_t channels = tensor->dims[0];
+  int64_t per_channel = count / channels;
+  int8_t *quantized = (int8_t *)malloc((size_t)count);
+  float *scales = (float *)malloc((size_t)channels * sizeof(float));
+  int8_t *zero_points = (int8_t *)calloc((size_t)channels, 1);
+  if (quantized == NULL || scales == NULL || zero_points == NULL)
+  {
+    fprintf(stderr, "Out of memory\n");
+    exit(1);
+  }
+
+  for (int64_t c = 0; c < channels; c++)
+  {
+    const uint8_t *row = tensor->data + (size_t)(c * per_channel) * sizeof(float);
+    float peak = 0.0f;
+    for (int64_t i = 0; i < per_channel; i++)
+    {
+      float value;
+      memcpy(&value, row + i * sizeof(float), sizeof(float));
+      peak = fabsf(value) > peak ? fabsf(value) : peak;
+    }
+    scales[c] = peak > 0.0f ? peak / 127.0f : 1.0f;
+    for (int64_t i = 0; i < per_channel; i++)
+    {
+      float value;
+      memcpy(&value, row + i * sizeof(float), sizeof(float));
+      quantized[c * per_channel + i] = (int8_t)lrintf(value / scales[c]);
+    }
+  }
+
+  char name[MAX_NAME + 32];
+  const char *inputs[3] = {"_quantized", "_scale", "_zero_point"};
+  snprintf(name, sizeof(name), "%s%s", output, inputs[0]);
+  put_constant(graph, name, tensor->dims, tensor->rank, TENSOR_INT8, quantized, (size_t)count);
+  snprintf(name, sizeof(name), "%s%s", output, inputs[1]);
+  put_constant(graph, name, &channels, 1, TENSOR_FLOAT, scales, (size_t)channels * sizeof(float));
+  snprintf(name, sizeof(name), "%s%s", output, inputs[2]);
+  put_constant(graph, name, &channels, 1, TENSOR_INT8, zero_points, (size_t)channels);
+
+  Buffer attribute = {0};
+  Buffer node = {0};
+  put_string_field(&attribute, ATTRIBUTE_NAME, "axis");
+  put_int_field(&attribute, ATTRIBUTE_INT, 0);
+  put_int_field(&attribute, ATTRIBUTE_TYPE, ATTRIBUTE_TYPE_INT);
+  for (int32_t i = 0; i < 3; i++)
+  {
+    snprintf(name, sizeof(name), "%s%s", output, inputs[i]);
+    put_string_field(&node, NODE_INPUT, name);
+  }
+  put_string_field(&node, NODE_OUTPUT, output);
+  snprintf(name, sizeof(name), "%s_DequantizeLinear", output);
+  put_string_field(&node, NODE_NAME, name);
+  put_string_field(&node, NODE_OP_TYPE, "DequantizeLinear");
+  put_bytes_field(&node, NODE_ATTRIBUTE, attribute.data, attribute.length);
+  put_bytes_field(graph, GRAPH_NODE, node.data, node.length);
+
+  stats->weights++;
+  stats->float_bytes += (size_t)count * sizeof(float);
+  stats->int8_bytes += (size_t)count + (size_t)channels * (sizeof(float) + 1);
+  free(attribute.data);
+  free(node.data);
+  free(quantized);
+  free(scales);
+  free(zero_points);
+  return 0;
+}
+
+static int32_t is_quantized_weight(const uint8_t *name, size_t length)
+{
+  for (size_t i = 0; i < sizeof(kQuantizedWeights) / sizeof(kQuantizedWeights[0]); i++)
+  {
+    size_t suffix = strlen(kQuantizedWeights[i]);
+    if (length >= suffix && memcmp(name + length - suffix, kQuantizedWeights[i], suffix) == 0)
+      return 1;
+  }
+  return 0;
+}
+
+// ============================================================================
+// Graph Rewriting
+// ============================================================================
+
+static int32_t rewrite_graph(const uint8_t *data, size_t length, Buffer *out, int32_t depth, Stats *stats);
+
+/// Copy an attribute, rewriting the subgraphs it holds
+static int32_t rewrite_attribute(const uint8_t *data, size_t length, Buffer *out, int32_t depth, Stats *stats)
+{
+  Reader reader = {data, data + length};
+  Field field;
+  int32_t status;
+  const uint8_t *start = reader.cur;
+  while ((status = next_field(&reader, &field)) > 0)
+  {
+    if ((field.number == ATTRIBUTE_GRAPH || field.number == ATTRIBUTE_GRAPHS) && field.wire_type == WIRE_LENGTH)
+    {
+      Buffer graph = {0};
+      if (rewrite_graph(field.data, field.length, &graph, depth + 1, stats) != 0)
+      {
+        free(graph.data);
+        return -1;
+      }
+      put_bytes_field(out, field.number, graph.data, graph.length);
+      free(graph.data);
+    }
+    else
+    {
+      put(out, start, (size_t)(reader.cur - start));
+    }
+    start = reader.cur;
+  }
+  return status;
+}
+
+/// Copy a node into the graph, replacing it when it is a weight to quantize
+static int32_t rewrite_node(const uint8_t *data, size_t length, Buffer *graph, int32_t depth, Stats *stats)
+{
+  Reader reader = {data, data + length};
+  Field field;
+  int32_t status;
+  int32_t is_constant = 0;
+  int32_t outputs = 0;
+  char output[MAX_NAME] = {0};
+  FloatTensor value = {0};
+  int32_t has_value = 0;
+  while ((status = next_field(&reader, &field)) > 0)
+  {
+    if (field.wire_type != WIRE_LENGTH)
+      continue;
+    if (field.number == NODE_OP_TYPE)
+    {
+      is_constant = field.length == 8 && memcmp(field.data, "Constant", 8) == 0;
+    }
+    else if (field.number == NODE_OUTPUT)
+    {
+      if (outputs++ == 0 && field.length < sizeof(output))
+        memcpy(output, field.data, field.length);
+    }
+    else if (field.number == NODE_ATTRIBUTE)
+    {
+      Reader attribute = {field.data, field.data + field.length};
+      Field attribute_field;
+      while (next_field(&attribute, &attribute_field) > 0)
+      {
+        if (attribute_field.number == ATTRIBUTE_TENSOR && attribute_field.wire_type == WIRE_LENGTH &&
+            parse_tensor(attribute_field.data, attribute_field.length, &value) == 0)
+          has_value = 1;
+      }
+    }
+  }
+  if (status < 0)
+    return -1;
+
+  if (is_constant && has_value && outputs == 1 && value.data_type == TENSOR_FLOAT && value.data != NULL &&
+      is_quantized_weight((const uint8_t *)output, strlen(output)))
+    return put_quantized(graph, output, &value, stats);
+
+  Buffer node = {0};
+  const uint8_t *start = data;
+  reader.cur = data;
+  while ((status = next_field(&reader, &field)) > 0)
+  {
+    if (field.number == NODE_ATTRIBUTE && field.wire_type == WIRE_LENGTH)
+    {
+      Buffer attribute = {0};
+      if (rewrite_attribute(field.data, field.length, &attribute, depth, stats) != 0)
+      {
+        free(attribute.data);
+        free(node.data);
+        return -1;
+      }
+      put_bytes_field(&node, NODE_ATTRIBUTE, attribute.data, attribute.length);
+      free(attribute.data);
+    }
+    else
+    {
+      put(&node, start, (size_t)(reader.cur - start));
+    }
+    start = reader.cur;
+  }
+  put_bytes_field(graph, GRAPH_NODE, node.data, node.length);
+  free(node.data);
+  return status;
+}
+
+static int32_t rewrite_graph(const uint8_t *data, size_t length, Buffer *out, int32_t depth, Stats *stats)
+{
+  if (depth > MAX_DEPTH)
+    return -1;
+
+  Reader reader = {data, data + length};
+  Field field;
+  int32_t status;
+  const uint8_t *start = reader.cur;
+  while ((status = next_field(&reader, &field)) > 0)
+  {
+    if (field.number == GRAPH_NODE && field.wire_type == WIRE_LENGTH)
+    {
+      if (rewrite_node(field.data, field.length, out, depth, stats) != 0)
+        return -1;
+    }
+    else
+    {
+      put(out, start, (size_t)(reader.cur - start));
+    }
+    start = reader.cur;
+  }
+  return status;
+}
+
+/// Opset of the default (ai.onnx) domain, 0 if not imported
+static int64_t default_opset(const uint8_t *data, size_t length)
+{
+  Reader reader = {data, data + length};
+  Field field;
+  while (next_field(&reader, &field) > 0)
+  {
+    if (field.number != MODEL_OPSET_IMPORT || field.wire_type != WIRE_LENGTH)
+      continue;
+    Reader opset = {field.data, field.data + field.length};
+    Field opset_field;
+    int64_t version = 0;
+    int32_t default_domain = 1;
+    while (next_field(&opset, &opset_field) > 0)
+    {
+      if (opset_field.number == OPSET_DOMAIN && opset_field.length > 0 &&
+          !(opset_field.length == 7 && memcmp(opset_field.data, "ai.onnx", 7) == 0))
+        default_domain = 0;
+      else if (opset_field.number == OPSET_VERSION)
+        version = (int64_t)opset_field.varint;
+    }
+    if (default_domain)
+      return version;
+  }
+  return 0;
+}
+
+int main(int argc, char **argv)
+{
+  if (argc < 2)
+  {
+    fprintf(stderr, "Usage: %s [input.onnx] output.onnx\n", argv[0]);
+    return 1;
+  }
+  const char *input_path = argc > 2 ? argv[1] : VAD_PLUS_BENCH_MODEL;
+  const char *output_path = argv[argc > 2 ? 2 : 1];
+
+  FILE *file = fopen(input_path, "rb");
+  if (file == NULL)
+  {
+    fprintf(stderr, "Cannot open %s\n", input_path);
+    return 1;
+  }
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  uint8_t *model = size > 0 ? (uint8_t *)malloc((size_t)size) : NULL;
+  if (model == NULL || fread(model, 1, (size_t)size, file) != (size_t)size)
+  {
+    fprintf(stderr, "Cannot read %s\n", input_path);
+    fclose(file);
+    return 1;
+  }
+  fclose(file);
+
+  int64_t opset = default_opset(model, (size_t)size);
+  if (opset < MIN_OPSET)
+  {
+    fprintf(stderr, "Model opset %lld is too old for per-channel DequantizeLinear (needs %d)\n", (long long)opset,
+            MIN_OPSET);
+    return 1;
+  }
+
+  Buffer out = {0};
+  Stats stats = {0};
+  Reader reader = {model, model + size};
+  Field field;
+  int32_t status;
+  const uint8_t *start = reader.cur;
+  while ((status = next_field(&reader, &field)) > 0)
+  {
+    if (field.number == MODEL_GRAPH && field.wire_type == WIRE_LENGTH)
+    {
+      Buffer graph = {0};
+      if (rewrite_graph(field.data, field.length, &graph, 0, &stats) != 0)
+      {
+        status = -1;
+        break;
+      }
+      put_bytes_field(&out, MODEL_GRAPH, graph.data, graph.length);
+      free(graph.data);
+    }
+    else
+    {
+      put(&out, start, (size_t)(reader.cur - start));
+    }
+    start = reader.cur;
+  }
+  if (status < 0)
+  {
+    fprintf(stderr, "%s is not a valid ONNX model\n", input_path);
+    return 1;
+  }
+  if (stats.weights == 0)
+  {
+    fprintf(stderr, "No Silero VAD weights to quantize in %s\n", input_path);
+    return 1;
+  }
+
+  file = fopen(output_path, "wb");
+  if (file == NULL || fwrite(out.data, 1, out.length, file) != out.length)
+  {
+    fprintf(stderr, "Cannot write %s\n", output_path);
+    if (file != NULL)
+      fclose(file);
+    return 1;
+  }
+  fclose(file);
+
+  printf("quantized %d weights: %.1f KB fp32 -> %.1f KB int8\n", stats.weights, stats.float_bytes / 1024.0,
+         stats.int8_bytes / 1024.0);
+  printf("%s: %ld -> %zu bytes\n", output_path, size, out.length);
+  free(out.data);
+  free(model);
+  return 0;
+}
@@ -0,0 +1,195 @@
+// VADConfig defaults on every platform match vad_config_default(): the Dart
+// VadConfig constructor, the Kotlin and Swift config classes and the
+// vad_config_default exported by the Android and iOS/macOS libraries are
+// read from their sources and compared field by field.
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vad_plus.h"
+
+#ifndef VAD_PLUS_SOURCE_ROOT
+#define VAD_PLUS_SOURCE_ROOT "../.."
+#endif
+
+typedef struct ConfigField
+{
+  const char *c_name;
+  const char *camel_name;
+  double value;
+} ConfigField;
+
+typedef struct SourceBlock
+{
+  const char *path;
+  /// The block starts at the first start marker after the (optional) anchor
+  const char *anchor;
+  const char *start;
+  const char *end;
+  /// Fields are named as in C (1) or in camel case (0)
+  int32_t c_names;
+} SourceBlock;
+
+static const SourceBlock kBlocks[] = {
+    {"lib/vad_plus.dart", NULL, "const VadConfig({", "});", 0},
+    {"android/src/main/kotlin/dev/miracle/vad_plus/VadPlusFFI.kt", NULL, "data class VADConfigInternal(", "\n)", 0},
+    {"android/src/main/jni/vad_plus_jni.cpp", NULL, "void vad_config_default(", "\n    }", 1},
+    {"ios/Classes/VadPlusFFI.swift", NULL, "struct VADConfigInternal {", "\n}", 0},
+    {"ios/Classes/VadPlusFFI.swift", NULL, "public func vad_config_default(", "\n}", 1},
+    {"ios/Classes/VadPlusFFI.swift", "public struct VADConfigC", "public init(", ") {", 1},
+    {"macos/Classes/VadPlusFFI.swift", NULL, "struct VADConfigInternal {", "\n}", 0},
+    {"macos/Classes/VadPlusFFI.swift", NULL, "public func vad_config_default(", "\n}", 1},
+    {"macos/Classes/VadPlusFFI.swift", "public struct VADConfigC", "public init(", ") {", 1},
+};
+
+static char *read_source(const char *relative)
+{
+  char path[1024];
+  snprintf(path, sizeof(path), "%s/%s", VAD_PLUS_SOURCE_ROOT, relative);
+  FILE *file = fopen(path, "rb");
+  if (file == NULL)
+    return NULL;
+  fseek(file, 0, SEEK_END);
+  long size = ftell(file);
+  fseek(file, 0, SEEK_SET);
+  char *text = (char *)malloc((size_t)size + 1);
+  if (text != NULL)
+  {
+    size_t read = fread(text, 1, (size_t)size, file);
+    text[read] = '\0';
+  }
+  fclose(file);
+  return text;
+}
+
+static int32_t is_word_char(char c)
+{
+  return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+/// Find the default given to name in [begin, end): the first number, true or
+/// false after it on the same line (type names such as Int32 are skipped)
+/// @return 1 if found
+static int32_t find_default(const char *begin, const char *end, const char *name, double *value)
+{
+  size_t length = strlen(name);
+  for (const char *p = begin; p + length <= end; p++)
+  {
+    if (memcmp(p, name, length) != 0 || (p > begin && is_word_char(p[-1])) || is_word_char(p[length]))
+      continue;
+
+    for (const char *q = p + length; q < end && *q != '\n'; q++)
+    {
+      if (*q == '/')
+        break;
+      if ((*q >= '0' && *q <= '9') || *q == '-' || *q == '.')
+      {
+        *value = strtod(q, NULL);
+        return 1;
+      }
+      if (is_word_char(*q))
+      {
+        const char *word = q;
+        while (q < end && is_word_char(*q))
+          q++;
+        if (q - word == 4 && memcmp(word, "true", 4) == 0)
+        {
+          *value = 1.0;
+          return 1;
+        }
+        if (q - word == 5 && memcmp(word, "false", 5) == 0)
+        {
+          *value = 0.0;
+          return 1;
+        }
+        q--;
+      }
+    }
+  }
+  return 0;
+}
+
+int main(void)
+{
+  VADConfig config;
+  vad_config_default(&config);
+
+  const ConfigField fields[] = {
+      {"positive_speech_threshold", "positiveSpeechThreshold", config.positive_speech_threshold},
+      {"negative_speech_threshold", "negativeSpeechThreshold", config.negative_speech_threshold},
+      {"pre_speech_pad_frames", "preSpeechPadFrames", config.pre_speech_pad_frames},
+      {"redemption_frames", "redemptionFrames", config.redemption_frames},
+      {"min_speech_frames", "minSpeechFrames", config.min_speech_frames},
+      {"sample_rate", "sampleRate", config.sample_rate},
+      {"frame_samples", "frameSamples", config.frame_samples},
+      {"end_speech_pad_frames", "endSpeechPadFrames", config.end_speech_pad_frames},
+      {"is_debug", "isDebug", config.is_debug},
+      {"speech_chunk_samples", "speechChunkSamples", config.speech_chunk_samples},
+      {"max_speech_frames", "maxSpeechFrames", config.max_speech_frames},
+      {"speech_end_by_reference", "speechEndByReference", config.speech_end_by_reference},
+      {"input_sample_rate", "inputSampleRate", config.input_sample_rate},
+      {"prefer_int8_model", "preferInt8Model", config.prefer_int8_model},
+      {"prewarm_frames", "prewarmFrames", config.prewarm_frames},
+      {"silence_gate_frames", "silenceGateFrames", config.silence_gate_frames},
+      {"silence_gate_dbfs", "silenceGateDbfs", config.silence_gate_dbfs},
+      {"silence_gate_noise_margin_db", "silenceGateNoiseMarginDb", config.silence_gate_noise_margin_db},
+  };
+  const size_t field_count = sizeof(fields) / sizeof(fields[0]);
+
+  // Every VADConfig field is 4 bytes: a field added to the struct but not to
+  // the table above fails here
+  if (sizeof(VADConfig) != field_count * 4)
+  {
+    fprintf(stderr, "VADConfig has fields missing from this test\n");
+    return 1;
+  }
+
+  int failures = 0;
+  for (size_t b = 0; b < sizeof(kBlocks) / sizeof(kBlocks[0]); b++)
+  {
+    const SourceBlock *block = &kBlocks[b];
+    char *text = read_source(block->path);
+    if (text == NULL)
+    {
+      fprintf(stderr, "%s: cannot read\n", block->path);
+      failures++;
+      continue;
+    }
+
+    const char *anchor = block->anchor != NULL ? strstr(text, block->anchor) : text;
+    const char *begin = anchor != NULL ? strstr(anchor, block->start) : NULL;
+    const char *end = begin != NULL ? strstr(begin, block->end) : NULL;
+    if (end == NULL)
+    {
+      fprintf(stderr, "%s: block '%s' not found\n", block->path, block->start);
+      failures++;
+      free(text);
+      continue;
+    }
+
+    for (size_t f = 0; f < field_count; f++)
+    {
+      const char *name = block->c_names ? fields[f].c_name : fields[f].camel_name;
+      double value;
+      if (!find_default(begin, end, name, &value))
+      {
+        fprintf(stderr, "%s ('%s'): no default for %s\n", block->path, block->start, name);
+        failures++;
+      }
+      else if (fabs(value - fields[f].value) > 1e-6)
+      {
+        fprintf(stderr, "%s ('%s'): %s defaults to %g, vad_config_default() to %g\n", block->path, block->start,
+                name, value, fields[f].value);
+        failures++;
+      }
+    }
+    free(text);
+  }
+
+  if (failures != 0)
+    return 1;
+  printf("test_config_defaults: ok\n");
+  return 0;
+}
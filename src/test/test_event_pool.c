@@ -0,0 +1,102 @@
+// Event pool checks: overflow slots are reused and capped, repeated releases
+// are ignored, and events stay releasable after the owner closes the pool.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "vad_events.h"
+
+#define CHECK(condition)                                              \
+  do                                                                  \
+  {                                                                   \
+    if (!(condition))                                                 \
+    {                                                                 \
+      fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #condition); \
+      return 1;                                                       \
+    }                                                                 \
+  } while (0)
+
+#define SLOTS 4
+#define INLINE_BYTES 64
+#define CAPACITY (SLOTS + VAD_EVENT_POOL_MAX_OVERFLOW)
+
+static const VADEvent *g_events[CAPACITY];
+
+static int test_overflow_release(void)
+{
+  VADEventPool *pool = vad_event_pool_create(SLOTS, INLINE_BYTES);
+  CHECK(pool != NULL);
+
+  // Fill every slot, then two overflow events
+  for (int32_t i = 0; i < SLOTS + 2; i++)
+  {
+    void *payload;
+    g_events[i] = vad_event_pool_acquire(pool, VAD_EVENT_FRAME_PROCESSED, INLINE_BYTES, &payload);
+    CHECK(g_events[i] != NULL && payload != NULL);
+  }
+
+  // A repeated release of an overflow event is ignored
+  vad_event_pool_release(g_events[SLOTS]);
+  vad_event_pool_release(g_events[SLOTS]);
+  VADEventPoolStats stats;
+  vad_event_pool_get_stats(pool, &stats);
+  CHECK(stats.outstanding == SLOTS + 1);
+
+  // The released overflow slot is reused, with a larger payload
+  void *payload;
+  const VADEvent *reused = vad_event_pool_acquire(pool, VAD_EVENT_SPEECH_END, 4096, &payload);
+  CHECK(reused == g_events[SLOTS] && payload != NULL);
+  g_events[SLOTS] = reused;
+
+  // Events outlive the owner's reference
+  vad_event_pool_close(pool);
+  for (int32_t i = 0; i < SLOTS + 2; i++)
+  {
+    vad_event_pool_release(g_events[i]);
+    if (i == 0)
+      vad_event_pool_release(g_events[i]);
+  }
+  return 0;
+}
+
+static int test_overflow_cap(void)
+{
+  VADEventPool *pool = vad_event_pool_create(SLOTS, INLINE_BYTES);
+  CHECK(pool != NULL);
+
+  for (int32_t i = 0; i < CAPACITY; i++)
+  {
+    g_events[i] = vad_event_pool_acquire(pool, VAD_EVENT_SPEECH_START, 0, NULL);
+    CHECK(g_events[i] != NULL);
+  }
+  CHECK(vad_event_pool_acquire(pool, VAD_EVENT_SPEECH_START, 0, NULL) == NULL);
+  CHECK(vad_event_pool_acquire(pool, VAD_EVENT_SPEECH_START, 0, NULL) == NULL);
+
+  VADEventPoolStats stats;
+  vad_event_pool_get_stats(pool, &stats);
+  CHECK(stats.outstanding == CAPACITY);
+  CHECK(stats.dropped == 2);
+
+  // Releasing one event makes room again
+  vad_event_pool_release(g_events[CAPACITY - 1]);
+  g_events[CAPACITY - 1] = vad_event_pool_acquire(pool, VAD_EVENT_SPEECH_START, 0, NULL);
+  CHECK(g_events[CAPACITY - 1] != NULL);
+
+  for (int32_t i = 0; i < CAPACITY; i++)
+    vad_event_pool_release(g_events[i]);
+  vad_event_pool_get_stats(pool, &stats);
+  CHECK(stats.outstanding == 0);
+  vad_event_pool_close(pool);
+  return 0;
+}
+
+int main(void)
+{
+  int failures = 0;
+  failures += test_overflow_release();
+  failures += test_overflow_cap();
+  if (failures != 0)
+    return 1;
+  printf("test_event_pool: ok\n");
+  return 0;
+}
@@ -0,0 +1,170 @@
+// Model loader checks on small synthetic ONNX files: a model with the v6
+// shapes loads and runs, and one whose encoder is wider than the inference
+// scratch is rejected instead of loaded.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vad_model.h"
+
+#define CHECK(condition)                                              \
+  do                                                                  \
+  {                                                                   \
+    if (!(condition))                                                 \
+    {                                                                 \
+      fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #condition); \
+      return 1;                                                       \
+    }                                                                 \
+  } while (0)
+
+// Serialized ModelProto under construction
+typedef struct Writer
+{
+  uint8_t *data;
+  size_t length;
+  size_t capacity;
+} Writer;
+
+static void put_bytes(Writer *writer, const void *bytes, size_t count)
+{
+  if (writer->length + count > writer->capacity)
+  {
+    size_t capacity = writer->capacity * 2 + count;
+    uint8_t *data = (uint8_t *)realloc(writer->data, capacity);
+    if (data == NULL)
+    {
+      fprintf(stderr, "Out of memory\n");
+      exit(1);
+    }
+    writer->data = data;
+    writer->capacity = capacity;
+  }
+  memcpy(writer->data + writer->length, bytes, count);
+  writer->length += count;
+}
+
+static void put_varint(Writer *writer, uint64_t value)
+{
+  uint8_t byte;
+  do
+  {
+    byte = (uint8_t)(value & 0x7F);
+    value >>= 7;
+    if (value != 0)
+      byte |= 0x80;
+    put_bytes(writer, &byte, 1);
+  } while (value != 0);
+}
+
+static void put_length_field(Writer *writer, uint32_t number, const void *bytes, size_t count)
+{
+  put_varint(writer, (uint64_t)number << 3 | 2);
+  put_varint(writer, count);
+  put_bytes(writer, bytes, count);
+}
+
+/// Append a float initializer of the given shape, filled with zeros
+static void put_initializer(Writer *graph, const char *name, int32_t rank, const int64_t *dims)
+{
+  Writer tensor = {0};
+  size_t elements = 1;
+  for (int32_t i = 0; i < rank; i++)
+  {
+    put_varint(&tensor, 1 << 3 | 0);
+    put_varint(&tensor, (uint64_t)dims[i]);
+    elements *= (size_t)dims[i];
+  }
+  put_varint(&tensor, 2 << 3 | 0);
+  put_varint(&tensor, 1);
+  put_length_field(&tensor, 8, name, strlen(name));
+  float *values = (float *)calloc(elements, sizeof(float));
+  put_length_field(&tensor, 9, values, elements * sizeof(float));
+  free(values);
+
+  put_length_field(graph, 5, tensor.data, tensor.length);
+  free(tensor.data);
+}
+
+/// Build a 16kHz model whose first encoder layer has the given width
+static Writer build_model(int64_t first_width)
+{
+  const int64_t hidden = VAD_MODEL_HIDDEN_SIZE;
+  Writer graph = {0};
+
+  int64_t basis[3] = {258, 1, 256};
+  put_initializer(&graph, "stft.forward_basis_buffer", 3, basis);
+
+  int64_t widths[VAD_MODEL_ENCODER_LAYERS + 1] = {129, first_width, hidden, hidden, hidden};
+  for (int32_t i = 0; i < VAD_MODEL_ENCODER_LAYERS; i++)
+  {
+    char name[64];
+    int64_t weight[3] = {widths[i + 1], widths[i], 3};
+    int64_t bias[1] = {widths[i + 1]};
+    snprintf(name, sizeof(name), "encoder.%d.reparam_conv.weight", i);
+    put_initializer(&graph, name, 3, weight);
+    snprintf(name, sizeof(name), "encoder.%d.reparam_conv.bias", i);
+    put_initializer(&graph, name, 1, bias);
+  }
+
+  int64_t lstm_weight[2] = {4 * hidden, hidden};
+  int64_t lstm_bias[1] = {4 * hidden};
+  int64_t decoder_weight[3] = {1, hidden, 1};
+  int64_t decoder_bias[1] = {1};
+  put_initializer(&graph, "decoder.rnn.weight_ih", 2, lstm_weight);
+  put_initializer(&graph, "decoder.rnn.weight_hh", 2, lstm_weight);
+  put_initializer(&graph, "decoder.rnn.bias_ih", 1, lstm_bias);
+  put_initializer(&graph, "decoder.rnn.bias_hh", 1, lstm_bias);
+  put_initializer(&graph, "decoder.decoder.2.weight", 3, decoder_weight);
+  put_initializer(&graph, "decoder.decoder.2.bias", 1, decoder_bias);
+
+  Writer model = {0};
+  put_length_field(&model, 7, graph.data, graph.length);
+  free(graph.data);
+  return model;
+}
+
+static int test_v6_shapes_load(void)
+{
+  Writer bytes = build_model(VAD_MODEL_HIDDEN_SIZE);
+  VADModel model;
+  char error[256];
+  int32_t result = vad_model_load_buffer(&model, bytes.data, bytes.length, error, sizeof(error));
+  free(bytes.data);
+  CHECK(result == 0);
+
+  const VADModelRate *rate = vad_model_get_rate(&model, 16000);
+  CHECK(rate != NULL);
+  float input[576] = {0};
+  float state[VAD_MODEL_STATE_SIZE] = {0};
+  float probability = vad_model_infer(rate, input, state);
+  vad_model_free(&model);
+  CHECK(probability > 0.49f && probability < 0.51f);
+  return 0;
+}
+
+static int test_oversized_conv_rejected(void)
+{
+  // 200 channels: 800 outputs over 4 steps and a 600-float column in the next
+  // layer, both past the inference scratch
+  Writer bytes = build_model(200);
+  VADModel model;
+  char error[256];
+  int32_t result = vad_model_load_buffer(&model, bytes.data, bytes.length, error, sizeof(error));
+  free(bytes.data);
+  CHECK(result == -2);
+  CHECK(model.storage == NULL);
+  CHECK(strstr(error, "Silero VAD v6") != NULL);
+  return 0;
+}
+
+int main(void)
+{
+  int failures = 0;
+  failures += test_v6_shapes_load();
+  failures += test_oversized_conv_rejected();
+  if (failures != 0)
+    return 1;
+  printf("test_model_loader: ok\n");
+  return 0;
+}
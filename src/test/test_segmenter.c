@@ -0,0 +1,161 @@
+// Segmenter checks on synthetic probability sequences: segments split at
+// max_speech_frames with the right bounds, a continuation confirms on its own
+// speech frames or ends as a misfire, and max_speech_frames below
+// min_speech_frames is rejected at init.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "vad_plus.h"
+#include "vad_segmenter.h"
+
+#define CHECK(condition)                                              \
+  do                                                                  \
+  {                                                                   \
+    if (!(condition))                                                 \
+    {                                                                 \
+      fprintf(stderr, "%s:%d: %s\n", __FILE__, __LINE__, #condition); \
+      return 1;                                                       \
+    }                                                                 \
+  } while (0)
+
+// Probabilities above the positive threshold (0.5), below the negative one
+// (0.35), and in between
+#define S 0.9f
+#define Q 0.1f
+#define A 0.4f
+
+static void init_segmenter(VADSegmenter *segmenter, int32_t pad, int32_t redemption, int32_t min, int32_t max)
+{
+  VADConfig config;
+  vad_config_default(&config);
+  config.pre_speech_pad_frames = pad;
+  config.redemption_frames = redemption;
+  config.min_speech_frames = min;
+  config.max_speech_frames = max;
+  vad_segmenter_init(segmenter, &config);
+}
+
+/// Push every probability and record the transitions of each frame
+static void push_all(VADSegmenter *segmenter, const float *probabilities, int32_t count, uint32_t *transitions)
+{
+  for (int32_t i = 0; i < count; i++)
+    transitions[i] = vad_segmenter_push(segmenter, probabilities[i]);
+}
+
+static int test_split_mid_speech(void)
+{
+  VADSegmenter segmenter;
+  init_segmenter(&segmenter, 2, 3, 2, 6);
+
+  const float probabilities[] = {Q, Q, Q, S, S, S, S, S, S, S, S, Q, Q, Q};
+  uint32_t transitions[14];
+  push_all(&segmenter, probabilities, 9, transitions);
+
+  CHECK(transitions[3] == VAD_SEGMENTER_START);
+  CHECK(transitions[4] == VAD_SEGMENTER_REAL_START);
+  CHECK(transitions[5] == 0 && transitions[6] == 0 && transitions[7] == 0);
+  // Sixth frame after the pad
+  CHECK(transitions[8] == VAD_SEGMENTER_SPLIT);
+  CHECK(segmenter.ended_start == 1 && segmenter.ended_end == 9);
+  CHECK(segmenter.is_speaking && !segmenter.has_emitted_real_start);
+
+  // The continuation confirms on its own second speech frame
+  push_all(&segmenter, probabilities + 9, 5, transitions + 9);
+  CHECK(transitions[9] == 0);
+  CHECK(transitions[10] == VAD_SEGMENTER_REAL_START);
+  CHECK(transitions[11] == 0 && transitions[12] == 0);
+  CHECK(transitions[13] == VAD_SEGMENTER_END);
+  CHECK(segmenter.ended_start == 9 && segmenter.ended_end == 14);
+  CHECK(!segmenter.is_speaking);
+  return 0;
+}
+
+static int test_split_on_last_frame(void)
+{
+  VADSegmenter segmenter;
+  init_segmenter(&segmenter, 0, 3, 2, 4);
+
+  const float probabilities[] = {S, S, S, S};
+  uint32_t transitions[4];
+  push_all(&segmenter, probabilities, 4, transitions);
+  CHECK(transitions[0] == VAD_SEGMENTER_START);
+  CHECK(transitions[1] == VAD_SEGMENTER_REAL_START);
+  CHECK(transitions[3] == VAD_SEGMENTER_SPLIT);
+  CHECK(segmenter.ended_start == 0 && segmenter.ended_end == 4);
+
+  // The continuation has no frames yet and is not speech
+  CHECK(vad_segmenter_close(&segmenter) == 0);
+  CHECK(segmenter.ended_start == 4 && segmenter.ended_end == 4);
+  CHECK(!segmenter.is_speaking);
+  return 0;
+}
+
+static int test_continuation_misfire(void)
+{
+  VADSegmenter segmenter;
+  init_segmenter(&segmenter, 0, 3, 2, 4);
+
+  // Silence right after the split, then one speech frame too few
+  const float probabilities[] = {S, S, S, S, Q, Q, Q, S, Q, Q, Q};
+  uint32_t transitions[11];
+  push_all(&segmenter, probabilities, 7, transitions);
+  CHECK(transitions[3] == VAD_SEGMENTER_SPLIT);
+  CHECK(transitions[4] == 0 && transitions[5] == 0);
+  CHECK(transitions[6] == VAD_SEGMENTER_MISFIRE);
+  CHECK(segmenter.ended_start == 4 && segmenter.ended_end == 7);
+
+  push_all(&segmenter, probabilities + 7, 4, transitions + 7);
+  CHECK(transitions[7] == VAD_SEGMENTER_START);
+  CHECK(transitions[10] == VAD_SEGMENTER_MISFIRE);
+  CHECK(segmenter.ended_start == 7 && segmenter.ended_end == 11);
+  return 0;
+}
+
+static int test_unconfirmed_not_split(void)
+{
+  VADSegmenter segmenter;
+  init_segmenter(&segmenter, 0, 3, 3, 3);
+
+  // Ambiguous frames carry the segment past max_speech_frames before it is
+  // confirmed; it splits on the frame that confirms it
+  const float probabilities[] = {S, A, A, A, S, S};
+  uint32_t transitions[6];
+  push_all(&segmenter, probabilities, 6, transitions);
+  CHECK(transitions[0] == VAD_SEGMENTER_START);
+  CHECK(transitions[1] == 0 && transitions[2] == 0 && transitions[3] == 0 && transitions[4] == 0);
+  CHECK(transitions[5] == (VAD_SEGMENTER_REAL_START | VAD_SEGMENTER_SPLIT));
+  CHECK(segmenter.ended_start == 0 && segmenter.ended_end == 6);
+  return 0;
+}
+
+static int test_max_below_min_rejected(void)
+{
+  VADHandle *handle = vad_create();
+  CHECK(handle != NULL);
+
+  VADConfig config;
+  vad_config_default(&config);
+  config.min_speech_frames = 10;
+  config.max_speech_frames = 5;
+  int32_t result = vad_init(handle, &config, NULL);
+  const char *error = vad_get_last_error(handle);
+  int rejected = result == -1 && error != NULL && strstr(error, "max_speech_frames") != NULL;
+  vad_destroy(handle);
+  CHECK(rejected);
+  return 0;
+}
+
+int main(void)
+{
+  int failures = 0;
+  failures += test_split_mid_speech();
+  failures += test_split_on_last_frame();
+  failures += test_continuation_misfire();
+  failures += test_unconfirmed_not_split();
+  failures += test_max_below_min_rejected();
+  if (failures != 0)
+    return 1;
+  printf("test_segmenter: ok\n");
+  return 0;
+}
@@ -0,0 +1,886 @@
+#include "vad_convert.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define VAD_CONVERT_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define VAD_TARGET_SSE2
+#define VAD_TARGET_AVX2
+#else
+// Per-function targets so the library builds without -mavx2 and still runs
+// on CPUs without AVX2
+#define VAD_TARGET_SSE2 __attribute__((target("sse2")))
+#define VAD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#elif defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+#define VAD_CONVERT_NEON 1
+#include <arm_neon.h>
+#endif
+
+#define S16_SCALE (1.0f / 32768.0f)
+#define S32_SCALE (1.0f / 2147483648.0f)
+#define U8_SCALE (1.0f / 128.0f)
+#define STEREO_S16_SCALE (1.0f / 65536.0f)
+
+// f32_level sums squares in this many lanes, sample i into lane i % 8, so
+// every variant adds the same values in the same order
+#define LEVEL_LANES 8
+
+typedef struct VADConvertOps
+{
+  void (*s16_to_f32)(const int16_t *src, float *dst, int32_t count);
+  void (*s32_to_f32)(const int32_t *src, float *dst, int32_t count);
+  void (*u8_to_f32)(const uint8_t *src, float *dst, int32_t count);
+  void (*f32_to_s16)(const float *src, int16_t *dst, int32_t count);
+  void (*f32_clamp)(const float *src, float *dst, int32_t count);
+  void (*s16_stereo_to_f32_mono)(const int16_t *src, float *dst, int32_t frames);
+  void (*f32_stereo_to_mono)(const float *src, float *dst, int32_t frames);
+  void (*s16_stereo_channel_to_f32)(const int16_t *src, int32_t channel, float *dst, int32_t frames);
+  void (*f32_level)(const float *src, int32_t count, float *sum_squares, float *peak);
+} VADConvertOps;
+
+// ============================================================================
+// Scalar
+// ============================================================================
+
+static void s16_to_f32_scalar(const int16_t *src, float *dst, int32_t count)
+{
+  for (int32_t i = 0; i < count; i++)
+    dst[i] = (float)src[i] * S16_SCALE;
+}
+
+static void s32_to_f32_scalar(const int32_t *src, float *dst, int32_t count)
+{
+  for (int32_t i = 0; i < count; i++)
+    dst[i] = (float)src[i] * S32_SCALE;
+}
+
+static void u8_to_f32_scalar(const uint8_t *src, float *dst, int32_t count)
+{
+  for (int32_t i = 0; i < count; i++)
+    dst[i] = (float)((int32_t)src[i] - 128) * U8_SCALE;
+}
+
+static void f32_to_s16_scalar(const float *src, int16_t *dst, int32_t count)
+{
+  for (int32_t i = 0; i < count; i++)
+  {
+    float clamped = src[i];
+    if (clamped > 1.0f)
+      clamped = 1.0f;
+    if (clamped < -1.0f)
+      clamped = -1.0f;
+    dst[i] = (int16_t)(clamped * 32767.0f);
+  }
+}
+
+static void f32_clamp_scalar(const float *src, float *dst, int32_t count)
+{
+  for (int32_t i = 0; i < count; i++)
+  {
+    float clamped = src[i];
+    if (clamped > 1.0f)
+      clamped = 1.0f;
+    if (clamped < -1.0f)
+      clamped = -1.0f;
+    dst[i] = clamped;
+  }
+}
+
+static void s16_stereo_to_f32_mono_scalar(const int16_t *src, float *dst, int32_t frames)
+{
+  for (int32_t i = 0; i < frames; i++)
+    dst[i] = (float)((int32_t)src[2 * i] + src[2 * i + 1]) * STEREO_S16_SCALE;
+}
+
+static void f32_stereo_to_mono_scalar(const float *src, float *dst, int32_t frames)
+{
+  for (int32_t i = 0; i < frames; i++)
+    dst[i] = (src[2 * i] + src[2 * i + 1]) * 0.5f;
+}
+
+static void s16_stereo_channel_to_f32_scalar(const int16_t *src, int32_t channel, float *dst, int32_t frames)
+{
+  for (int32_t i = 0; i < frames; i++)
+    dst[i] = (float)src[2 * i + channel] * S16_SCALE;
+}
+
+/// Add samples first to count - 1 into the level lanes and the peak
+static void f32_level_lanes(const float *src, int32_t first, int32_t count, float *lanes, float *peak)
+{
+  float max = *peak;
+  for (int32_t i = first; i < count; i++)
+  {
+    float x = src[i];
+    lanes[i % LEVEL_LANES] += x * x;
+    float magnitude = x < 0.0f ? -x : x;
+    if (magnitude > max)
+      max = magnitude;
+  }
+  *peak = max;
+}
+
+static float sum_level_lanes(const float *lanes)
+{
+  float sum = 0.0f;
+  for (int32_t k = 0; k < LEVEL_LANES; k++)
+    sum += lanes[k];
+  return sum;
+}
+
+/// Largest of the lane maxima of a vector variant
+static float max_of(const float *values, int32_t count)
+{
+  float max = 0.0f;
+  for (int32_t k = 0; k < count; k++)
+  {
+    if (values[k] > max)
+      max = values[k];
+  }
+  return max;
+}
+
+static void f32_level_scalar(const float *src, int32_t count, float *sum_squares, float *peak)
+{
+  float lanes[LEVEL_LANES] = {0.0f};
+  *peak = 0.0f;
+  f32_level_lanes(src, 0, count, lanes, peak);
+  *sum_squares = sum_level_lanes(lanes);
+}
+
+static const VADConvertOps kScalarOps = {
+    s16_to_f32_scalar,
+    s32_to_f32_scalar,
+    u8_to_f32_scalar,
+    f32_to_s16_scalar,
+    f32_clamp_scalar,
+    s16_stereo_to_f32_mono_scalar,
+    f32_stereo_to_mono_scalar,
+    s16_stereo_channel_to_f32_scalar,
+    f32_level_scalar,
+};
+
+// Vector variants process whole blocks and hand the remainder to the scalar
+// code, which keeps results identical at every length.
+
+#ifdef VAD_CONVERT_X86
+
+// ============================================================================
+// SSE2
+// ============================================================================
+
+VAD_TARGET_SSE2 static void s16_to_f32_sse2(const int16_t *src, float *dst, int32_t count)
+{
+  const __m128 scale = _mm_set1_ps(S16_SCALE);
+  int32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m128i x = _mm_loadu_si128((const __m128i *)(src + i));
+    // Duplicate each sample into both halves of a 32-bit lane, then shift
+    // arithmetically to sign extend (SSE2 has no pmovsxwd)
+    __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(x, x), 16);
+    __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(x, x), 16);
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+    _mm_storeu_ps(dst + i + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+  }
+  s16_to_f32_scalar(src + i, dst + i, count - i);
+}
+
+VAD_TARGET_SSE2 static void s32_to_f32_sse2(const int32_t *src, float *dst, int32_t count)
+{
+  const __m128 scale = _mm_set1_ps(S32_SCALE);
+  int32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128i x = _mm_loadu_si128((const __m128i *)(src + i));
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(x), scale));
+  }
+  s32_to_f32_scalar(src + i, dst + i, count - i);
+}
+
+VAD_TARGET_SSE2 static void u8_to_f32_sse2(const uint8_t *src, float *dst, int32_t count)
+{
+  const __m128 scale = _mm_set1_ps(U8_SCALE);
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i bias = _mm_set1_epi32(128);
+  int32_t i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    __m128i x = _mm_loadu_si128((const __m128i *)(src + i));
+    __m128i words[2] = {_mm_unpacklo_epi8(x, zero), _mm_unpackhi_epi8(x, zero)};
+    for (int32_t k = 0; k < 2; k++)
+    {
+      __m128i lo = _mm_sub_epi32(_mm_unpacklo_epi16(words[k], zero), bias);
+      __m128i hi = _mm_sub_epi32(_mm_unpackhi_epi16(words[k], zero), bias);
+      _mm_storeu_ps(dst + i + 8 * k, _mm_mul_ps(_mm_cvtepi32_ps(lo), scale));
+      _mm_storeu_ps(dst + i + 8 * k + 4, _mm_mul_ps(_mm_cvtepi32_ps(hi), scale));
+    }
+  }
+  u8_to_f32_scalar(src + i, dst + i, count - i);
+}
+
+VAD_TARGET_SSE2 static void f32_to_s16_sse2(const float *src, int16_t *dst, int32_t count)
+{
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 minus_one = _mm_set1_ps(-1.0f);
+  const __m128 scale = _mm_set1_ps(32767.0f);
+  int32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m128 a = _mm_max_ps(_mm_min_ps(_mm_loadu_ps(src + i), one), minus_one);
+    __m128 b = _mm_max_ps(_mm_min_ps(_mm_loadu_ps(src + i + 4), one), minus_one);
+    __m128i ia = _mm_cvttps_epi32(_mm_mul_ps(a, scale));
+    __m128i ib = _mm_cvttps_epi32(_mm_mul_ps(b, scale));
+    _mm_storeu_si128((__m128i *)(dst + i), _mm_packs_epi32(ia, ib));
+  }
+  f32_to_s16_scalar(src + i, dst + i, count - i);
+}
+
+VAD_TARGET_SSE2 static void f32_clamp_sse2(const float *src, float *dst, int32_t count)
+{
+  const __m128 one = _mm_set1_ps(1.0f);
+  const __m128 minus_one = _mm_set1_ps(-1.0f);
+  int32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    _mm_storeu_ps(dst + i, _mm_max_ps(_mm_min_ps(_mm_loadu_ps(src + i), one), minus_one));
+  f32_clamp_scalar(src + i, dst + i, count - i);
+}
+
+VAD_TARGET_SSE2 static void s16_stereo_to_f32_mono_sse2(const int16_t *src, float *dst, int32_t frames)
+{
+  const __m128 scale = _mm_set1_ps(STEREO_S16_SCALE);
+  const __m128i ones = _mm_set1_epi16(1);
+  int32_t i = 0;
+  for (; i + 4 <= frames; i += 4)
+  {
+    // pmaddwd adds each L/R pair into one 32-bit lane
+    __m128i sum = _mm_madd_epi16(_mm_loadu_si128((const __m128i *)(src + 2 * i)), ones);
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(sum), scale));
+  }
+  s16_stereo_to_f32_mono_scalar(src + 2 * i, dst + i, frames - i);
+}
+
+VAD_TARGET_SSE2 static void f32_stereo_to_mono_sse2(const float *src, float *dst, int32_t frames)
+{
+  const __m128 half = _mm_set1_ps(0.5f);
+  int32_t i = 0;
+  for (; i + 4 <= frames; i += 4)
+  {
+    __m128 a = _mm_loadu_ps(src + 2 * i);
+    __m128 b = _mm_loadu_ps(src + 2 * i + 4);
+    __m128 left = _mm_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    __m128 right = _mm_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_add_ps(left, right), half));
+  }
+  f32_stereo_to_mono_scalar(src + 2 * i, dst + i, frames - i);
+}
+
+VAD_TARGET_SSE2 static void s16_stereo_channel_to_f32_sse2(const int16_t *src, int32_t channel, float *dst,
+                                                           int32_t frames)
+{
+  const __m128 scale = _mm_set1_ps(S16_SCALE);
+  int32_t i = 0;
+  for (; i + 4 <= frames; i += 4)
+  {
+    // Each 32-bit lane holds one frame: left in the low half, right in the high half
+    __m128i x = _mm_loadu_si128((const __m128i *)(src + 2 * i));
+    __m128i picked = channel == 0 ? _mm_srai_epi32(_mm_slli_epi32(x, 16), 16) : _mm_srai_epi32(x, 16);
+    _mm_storeu_ps(dst + i, _mm_mul_ps(_mm_cvtepi32_ps(picked), scale));
+  }
+  s16_stereo_channel_to_f32_scalar(src + 2 * i, channel, dst + i, frames - i);
+}
+
+VAD_TARGET_SSE2 static void f32_level_sse2(const float *src, int32_t count, float *sum_squares, float *peak)
+{
+  const __m128 sign = _mm_set1_ps(-0.0f);
+  __m128 lo = _mm_setzero_ps();
+  __m128 hi = _mm_setzero_ps();
+  __m128 max = _mm_setzero_ps();
+  int32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m128 a = _mm_loadu_ps(src + i);
+    __m128 b = _mm_loadu_ps(src + i + 4);
+    lo = _mm_add_ps(lo, _mm_mul_ps(a, a));
+    hi = _mm_add_ps(hi, _mm_mul_ps(b, b));
+    // The running max is the second operand, so NaN samples are skipped as
+    // in the scalar code
+    max = _mm_max_ps(_mm_andnot_ps(sign, a), max);
+    max = _mm_max_ps(_mm_andnot_ps(sign, b), max);
+  }
+  float lanes[LEVEL_LANES];
+  float maxes[4];
+  _mm_storeu_ps(lanes, lo);
+  _mm_storeu_ps(lanes + 4, hi);
+  _mm_storeu_ps(maxes, max);
+  *peak = max_of(maxes, 4);
+  f32_level_lanes(src, i, count, lanes, peak);
+  *sum_squares = sum_level_lanes(lanes);
+}
+
+static const VADConvertOps kSse2Ops = {
+    s16_to_f32_sse2,
+    s32_to_f32_sse2,
+    u8_to_f32_sse2,
+    f32_to_s16_sse2,
+    f32_clamp_sse2,
+    s16_stereo_to_f32_mono_sse2,
+    f32_stereo_to_mono_sse2,
+    s16_stereo_channel_to_f32_sse2,
+    f32_level_sse2,
+};
+
+// ============================================================================
+// AVX2
+// ============================================================================
+
+VAD_TARGET_AVX2 static void s16_to_f32_avx2(const int16_t *src, float *dst, int32_t count)
+{
+  const __m256 scale = _mm256_set1_ps(S16_SCALE);
+  int32_t i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    __m256i lo = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(src + i)));
+    __m256i hi = _mm256_cvtepi16_epi32(_mm_loadu_si128((const __m128i *)(src + i + 8)));
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(lo), scale));
+    _mm256_storeu_ps(dst + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), scale));
+  }
+  s16_to_f32_scalar(src + i, dst + i, count - i);
+}
+
+VAD_TARGET_AVX2 static void s32_to_f32_avx2(const int32_t *src, float *dst, int32_t count)
+{
+  const __m256 scale = _mm256_set1_ps(S32_SCALE);
+  int32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    __m256i x = _mm256_loadu_si256((const __m256i *)(src + i));
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(x), scale));
+  }
+  s32_to_f32_scalar(src + i, dst + i, count - i);
+}
+
+VAD_TARGET_AVX2 static void u8_to_f32_avx2(const uint8_t *src, float *dst, int32_t count)
+{
+  const __m256 scale = _mm256_set1_ps(U8_SCALE);
+  const __m256i bias = _mm256_set1_epi32(128);
+  int32_t i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    __m128i x = _mm_loadu_si128((const __m128i *)(src + i));
+    __m256i lo = _mm256_sub_epi32(_mm256_cvtepu8_epi32(x), bias);
+    __m256i hi = _mm256_sub_epi32(_mm256_cvtepu8_epi32(_mm_srli_si128(x, 8)), bias);
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(lo), scale));
+    _mm256_storeu_ps(dst + i + 8, _mm256_mul_ps(_mm256_cvtepi32_ps(hi), scale));
+  }
+  u8_to_f32_scalar(src + i, dst + i, count - i);
+}
+
+VAD_TARGET_AVX2 static void f32_to_s16_avx2(const float *src, int16_t *dst, int32_t count)
+{
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 minus_one = _mm256_set1_ps(-1.0f);
+  const __m256 scale = _mm256_set1_ps(32767.0f);
+  int32_t i = 0;
+  for (; i + 16 <= count; i += 16)
+  {
+    __m256 a = _mm256_max_ps(_mm256_min_ps(_mm256_loadu_ps(src + i), one), minus_one);
+    __m256 b = _mm256_max_ps(_mm256_min_ps(_mm256_loadu_ps(src + i + 8), one), minus_one);
+    __m256i ia = _mm256_cvttps_epi32(_mm256_mul_ps(a, scale));
+    __m256i ib = _mm256_cvttps_epi32(_mm256_mul_ps(b, scale));
+    // vpackssdw packs within 128-bit lanes; restore sample order afterwards
+    __m256i packed = _mm256_permute4x64_epi64(_mm256_packs_epi32(ia, ib), _MM_SHUFFLE(3, 1, 2, 0));
+    _mm256_storeu_si256((__m256i *)(dst + i), packed);
+  }
+  f32_to_s16_scalar(src + i, dst + i, count - i);
+}
+
+VAD_TARGET_AVX2 static void f32_clamp_avx2(const float *src, float *dst, int32_t count)
+{
+  const __m256 one = _mm256_set1_ps(1.0f);
+  const __m256 minus_one = _mm256_set1_ps(-1.0f);
+  int32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+    _mm256_storeu_ps(dst + i, _mm256_max_ps(_mm256_min_ps(_mm256_loadu_ps(src + i), one), minus_one));
+  f32_clamp_scalar(src + i, dst + i, count - i);
+}
+
+VAD_TARGET_AVX2 static void s16_stereo_to_f32_mono_avx2(const int16_t *src, float *dst, int32_t frames)
+{
+  const __m256 scale = _mm256_set1_ps(STEREO_S16_SCALE);
+  const __m256i ones = _mm256_set1_epi16(1);
+  int32_t i = 0;
+  for (; i + 8 <= frames; i += 8)
+  {
+    __m256i sum = _mm256_madd_epi16(_mm256_loadu_si256((const __m256i *)(src + 2 * i)), ones);
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(sum), scale));
+  }
+  s16_stereo_to_f32_mono_scalar(src + 2 * i, dst + i, frames - i);
+}
+
+VAD_TARGET_AVX2 static void f32_stereo_to_mono_avx2(const float *src, float *dst, int32_t frames)
+{
+  const __m256 half = _mm256_set1_ps(0.5f);
+  int32_t i = 0;
+  for (; i + 8 <= frames; i += 8)
+  {
+    __m256 a = _mm256_loadu_ps(src + 2 * i);
+    __m256 b = _mm256_loadu_ps(src + 2 * i + 8);
+    __m256 left = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(2, 0, 2, 0));
+    __m256 right = _mm256_shuffle_ps(a, b, _MM_SHUFFLE(3, 1, 3, 1));
+    __m256 mono = _mm256_mul_ps(_mm256_add_ps(left, right), half);
+    // The in-lane shuffles leave frames as 0 1 4 5 | 2 3 6 7
+    mono = _mm256_castpd_ps(_mm256_permute4x64_pd(_mm256_castps_pd(mono), _MM_SHUFFLE(3, 1, 2, 0)));
+    _mm256_storeu_ps(dst + i, mono);
+  }
+  f32_stereo_to_mono_scalar(src + 2 * i, dst + i, frames - i);
+}
+
+VAD_TARGET_AVX2 static void s16_stereo_channel_to_f32_avx2(const int16_t *src, int32_t channel, float *dst,
+                                                           int32_t frames)
+{
+  const __m256 scale = _mm256_set1_ps(S16_SCALE);
+  int32_t i = 0;
+  for (; i + 8 <= frames; i += 8)
+  {
+    __m256i x = _mm256_loadu_si256((const __m256i *)(src + 2 * i));
+    __m256i picked = channel == 0 ? _mm256_srai_epi32(_mm256_slli_epi32(x, 16), 16) : _mm256_srai_epi32(x, 16);
+    _mm256_storeu_ps(dst + i, _mm256_mul_ps(_mm256_cvtepi32_ps(picked), scale));
+  }
+  s16_stereo_channel_to_f32_scalar(src + 2 * i, channel, dst + i, frames - i);
+}
+
+VAD_TARGET_AVX2 static void f32_level_avx2(const float *src, int32_t count, float *sum_squares, float *peak)
+{
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  __m256 sum = _mm256_setzero_ps();
+  __m256 max = _mm256_setzero_ps();
+  int32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    // Multiply and add stay separate (no FMA) as in the scalar code
+    __m256 x = _mm256_loadu_ps(src + i);
+    sum = _mm256_add_ps(sum, _mm256_mul_ps(x, x));
+    max = _mm256_max_ps(_mm256_andnot_ps(sign, x), max);
+  }
+  float lanes[LEVEL_LANES];
+  float maxes[8];
+  _mm256_storeu_ps(lanes, sum);
+  _mm256_storeu_ps(maxes, max);
+  *peak = max_of(maxes, 8);
+  f32_level_lanes(src, i, count, lanes, peak);
+  *sum_squares = sum_level_lanes(lanes);
+}
+
+static const VADConvertOps kAvx2Ops = {
+    s16_to_f32_avx2,
+    s32_to_f32_avx2,
+    u8_to_f32_avx2,
+    f32_to_s16_avx2,
+    f32_clamp_avx2,
+    s16_stereo_to_f32_mono_avx2,
+    f32_stereo_to_mono_avx2,
+    s16_stereo_channel_to_f32_avx2,
+    f32_level_avx2,
+};
+
+static int32_t cpu_has_sse2(void)
+{
+#if defined(__x86_64__) || defined(_M_X64)
+  return 1;
+#elif defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 1);
+  return (info[3] >> 26) & 1;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("sse2") != 0;
+#endif
+}
+
+static int32_t cpu_has_avx2(void)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7)
+    return 0;
+  __cpuid(info, 1);
+  // AVX and OSXSAVE, and the OS must save YMM state
+  if (((info[2] >> 27) & 1) == 0 || ((info[2] >> 28) & 1) == 0 || (_xgetbv(0) & 6) != 6)
+    return 0;
+  __cpuidex(info, 7, 0);
+  return (info[1] >> 5) & 1;
+#else
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") != 0;
+#endif
+}
+
+#endif // VAD_CONVERT_X86
+
+#ifdef VAD_CONVERT_NEON
+
+// ============================================================================
+// NEON
+// ============================================================================
+
+static void s16_to_f32_neon(const int16_t *src, float *dst, int32_t count)
+{
+  int32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    int16x8_t x = vld1q_s16(src + i);
+    vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(x))), S16_SCALE));
+    vst1q_f32(dst + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(x))), S16_SCALE));
+  }
+  s16_to_f32_scalar(src + i, dst + i, count - i);
+}
+
+static void s32_to_f32_neon(const int32_t *src, float *dst, int32_t count)
+{
+  int32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vld1q_s32(src + i)), S32_SCALE));
+  s32_to_f32_scalar(src + i, dst + i, count - i);
+}
+
+static void u8_to_f32_neon(const uint8_t *src, float *dst, int32_t count)
+{
+  const int16x8_t bias = vdupq_n_s16(128);
+  int32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    int16x8_t x = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(src + i))), bias);
+    vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(x))), U8_SCALE));
+    vst1q_f32(dst + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(x))), U8_SCALE));
+  }
+  u8_to_f32_scalar(src + i, dst + i, count - i);
+}
+
+static void f32_to_s16_neon(const float *src, int16_t *dst, int32_t count)
+{
+  const float32x4_t one = vdupq_n_f32(1.0f);
+  const float32x4_t minus_one = vdupq_n_f32(-1.0f);
+  int32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    float32x4_t a = vmaxq_f32(vminq_f32(vld1q_f32(src + i), one), minus_one);
+    float32x4_t b = vmaxq_f32(vminq_f32(vld1q_f32(src + i + 4), one), minus_one);
+    // vcvtq_s32_f32 truncates toward zero like the scalar cast
+    int32x4_t ia = vcvtq_s32_f32(vmulq_n_f32(a, 32767.0f));
+    int32x4_t ib = vcvtq_s32_f32(vmulq_n_f32(b, 32767.0f));
+    vst1q_s16(dst + i, vcombine_s16(vqmovn_s32(ia), vqmovn_s32(ib)));
+  }
+  f32_to_s16_scalar(src + i, dst + i, count - i);
+}
+
+static void f32_clamp_neon(const float *src, float *dst, int32_t count)
+{
+  const float32x4_t one = vdupq_n_f32(1.0f);
+  const float32x4_t minus_one = vdupq_n_f32(-1.0f);
+  int32_t i = 0;
+  for (; i + 4 <= count; i += 4)
+    vst1q_f32(dst + i, vmaxq_f32(vminq_f32(vld1q_f32(src + i), one), minus_one));
+  f32_clamp_scalar(src + i, dst + i, count - i);
+}
+
+static void s16_stereo_to_f32_mono_neon(const int16_t *src, float *dst, int32_t frames)
+{
+  int32_t i = 0;
+  for (; i + 8 <= frames; i += 8)
+  {
+    int16x8x2_t x = vld2q_s16(src + 2 * i);
+    int32x4_t lo = vaddl_s16(vget_low_s16(x.val[0]), vget_low_s16(x.val[1]));
+    int32x4_t hi = vaddl_s16(vget_high_s16(x.val[0]), vget_high_s16(x.val[1]));
+    vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(lo), STEREO_S16_SCALE));
+    vst1q_f32(dst + i + 4, vmulq_n_f32(vcvtq_f32_s32(hi), STEREO_S16_SCALE));
+  }
+  s16_stereo_to_f32_mono_scalar(src + 2 * i, dst + i, frames - i);
+}
+
+static void f32_stereo_to_mono_neon(const float *src, float *dst, int32_t frames)
+{
+  int32_t i = 0;
+  for (; i + 4 <= frames; i += 4)
+  {
+    float32x4x2_t x = vld2q_f32(src + 2 * i);
+    vst1q_f32(dst + i, vmulq_n_f32(vaddq_f32(x.val[0], x.val[1]), 0.5f));
+  }
+  f32_stereo_to_mono_scalar(src + 2 * i, dst + i, frames - i);
+}
+
+static void s16_stereo_channel_to_f32_neon(const int16_t *src, int32_t channel, float *dst, int32_t frames)
+{
+  int32_t i = 0;
+  for (; i + 8 <= frames; i += 8)
+  {
+    int16x8x2_t x = vld2q_s16(src + 2 * i);
+    int16x8_t picked = channel == 0 ? x.val[0] : x.val[1];
+    vst1q_f32(dst + i, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_low_s16(picked))), S16_SCALE));
+    vst1q_f32(dst + i + 4, vmulq_n_f32(vcvtq_f32_s32(vmovl_s16(vget_high_s16(picked))), S16_SCALE));
+  }
+  s16_stereo_channel_to_f32_scalar(src + 2 * i, channel, dst + i, frames - i);
+}
+
+static void f32_level_neon(const float *src, int32_t count, float *sum_squares, float *peak)
+{
+  float32x4_t lo = vdupq_n_f32(0.0f);
+  float32x4_t hi = vdupq_n_f32(0.0f);
+  float32x4_t max = vdupq_n_f32(0.0f);
+  int32_t i = 0;
+  for (; i + 8 <= count; i += 8)
+  {
+    float32x4_t a = vld1q_f32(src + i);
+    float32x4_t b = vld1q_f32(src + i + 4);
+    // vmulq + vaddq rather than a fused vfmaq, as in the scalar code
+    lo = vaddq_f32(lo, vmulq_f32(a, a));
+    hi = vaddq_f32(hi, vmulq_f32(b, b));
+    // Select on a compare rather than vmaxq, which propagates NaN
+    float32x4_t abs_a = vabsq_f32(a);
+    float32x4_t abs_b = vabsq_f32(b);
+    max = vbslq_f32(vcgtq_f32(abs_a, max), abs_a, max);
+    max = vbslq_f32(vcgtq_f32(abs_b, max), abs_b, max);
+  }
+  float lanes[LEVEL_LANES];
+  float maxes[4];
+  vst1q_f32(lanes, lo);
+  vst1q_f32(lanes + 4, hi);
+  vst1q_f32(maxes, max);
+  *peak = max_of(maxes, 4);
+  f32_level_lanes(src, i, count, lanes, peak);
+  *sum_squares = sum_level_lanes(lanes);
+}
+
+static const VADConvertOps kNeonOps = {
+    s16_to_f32_neon,
+    s32_to_f32_neon,
+    u8_to_f32_neon,
+    f32_to_s16_neon,
+    f32_clamp_neon,
+    s16_stereo_to_f32_mono_neon,
+    f32_stereo_to_mono_neon,
+    s16_stereo_channel_to_f32_neon,
+    f32_level_neon,
+};
+
+#endif // VAD_CONVERT_NEON
+
+// ============================================================================
+// Dispatch
+// ============================================================================
+
+// Selected on first use. Concurrent first calls all store the same values,
+// so no locking is needed.
+static const VADConvertOps *g_ops = NULL;
+static VADConvertIsa g_isa = VAD_CONVERT_ISA_SCALAR;
+
+static const VADConvertOps *ops_for(VADConvertIsa isa)
+{
+  switch (isa)
+  {
+#ifdef VAD_CONVERT_X86
+  case VAD_CONVERT_ISA_SSE2:
+    return cpu_has_sse2() ? &kSse2Ops : NULL;
+  case VAD_CONVERT_ISA_AVX2:
+    return cpu_has_avx2() ? &kAvx2Ops : NULL;
+#endif
+#ifdef VAD_CONVERT_NEON
+  case VAD_CONVERT_ISA_NEON:
+    return &kNeonOps;
+#endif
+  case VAD_CONVERT_ISA_SCALAR:
+    return &kScalarOps;
+  default:
+    return NULL;
+  }
+}
+
+static const VADConvertOps *get_ops(void)
+{
+  const VADConvertOps *ops = g_ops;
+  if (ops == NULL)
+  {
+    VADConvertIsa isa = vad_convert_detect_isa();
+    ops = ops_for(isa);
+    g_isa = isa;
+    g_ops = ops;
+  }
+  return ops;
+}
+
+VADConvertIsa vad_convert_detect_isa(void)
+{
+  static const VADConvertIsa kPreference[] = {VAD_CONVERT_ISA_AVX2, VAD_CONVERT_ISA_NEON, VAD_CONVERT_ISA_SSE2};
+  for (size_t i = 0; i < sizeof(kPreference) / sizeof(kPreference[0]); i++)
+  {
+    if (ops_for(kPreference[i]) != NULL)
+      return kPreference[i];
+  }
+  return VAD_CONVERT_ISA_SCALAR;
+}
+
+VADConvertIsa vad_convert_get_isa(void)
+{
+  get_ops();
+  return g_isa;
+}
+
+int32_t vad_convert_set_isa(VADConvertIsa isa)
+{
+  const VADConvertOps *ops = ops_for(isa);
+  if (ops == NULL)
+    return -1;
+  g_isa = isa;
+  g_ops = ops;
+  return 0;
+}
+
+const char *vad_convert_isa_name(VADConvertIsa isa)
+{
+  switch (isa)
+  {
+  case VAD_CONVERT_ISA_SCALAR:
+    return "scalar";
+  case VAD_CONVERT_ISA_SSE2:
+    return "sse2";
+  case VAD_CONVERT_ISA_AVX2:
+    return "avx2";
+  case VAD_CONVERT_ISA_NEON:
+    return "neon";
+  }
+  return "unknown";
+}
+
+void vad_convert_s16_to_f32(const int16_t *src, float *dst, int32_t count)
+{
+  if (count > 0)
+    get_ops()->s16_to_f32(src, dst, count);
+}
+
+void vad_convert_s32_to_f32(const int32_t *src, float *dst, int32_t count)
+{
+  if (count > 0)
+    get_ops()->s32_to_f32(src, dst, count);
+}
+
+void vad_convert_u8_to_f32(const uint8_t *src, float *dst, int32_t count)
+{
+  if (count > 0)
+    get_ops()->u8_to_f32(src, dst, count);
+}
+
+void vad_convert_f32_to_s16(const float *src, int16_t *dst, int32_t count)
+{
+  if (count > 0)
+    get_ops()->f32_to_s16(src, dst, count);
+}
+
+void vad_convert_f32_clamp(const float *src, float *dst, int32_t count)
+{
+  if (count > 0)
+    get_ops()->f32_clamp(src, dst, count);
+}
+
+void vad_convert_s16_stereo_to_f32_mono(const int16_t *src, float *dst, int32_t frames)
+{
+  if (frames > 0)
+    get_ops()->s16_stereo_to_f32_mono(src, dst, frames);
+}
+
+void vad_convert_f32_stereo_to_mono(const float *src, float *dst, int32_t frames)
+{
+  if (frames > 0)
+    get_ops()->f32_stereo_to_mono(src, dst, frames);
+}
+
+void vad_convert_s16_channel_to_f32(const int16_t *src, int32_t channels, int32_t channel, float *dst,
+                                    int32_t frames)
+{
+  if (frames <= 0 || channels <= 0 || channel < 0 || channel >= channels)
+    return;
+
+  if (channels == 1)
+  {
+    get_ops()->s16_to_f32(src, dst, frames);
+  }
+  else if (channels == 2)
+  {
+    get_ops()->s16_stereo_channel_to_f32(src, channel, dst, frames);
+  }
+  else
+  {
+    for (int32_t i = 0; i < frames; i++)
+      dst[i] = (float)src[(int64_t)i * channels + channel] * S16_SCALE;
+  }
+}
+
+void vad_convert_s16_frames_to_f32(const int16_t *src, int32_t channels, int32_t stride, float *dst, int32_t frames)
+{
+  if (frames <= 0 || channels <= 0 || stride < channels)
+    return;
+
+  if (stride == 1)
+  {
+    get_ops()->s16_to_f32(src, dst, frames);
+  }
+  else if (stride == 2 && channels == 2)
+  {
+    get_ops()->s16_stereo_to_f32_mono(src, dst, frames);
+  }
+  else if (stride == 2)
+  {
+    get_ops()->s16_stereo_channel_to_f32(src, 0, dst, frames);
+  }
+  else
+  {
+    float scale = S16_SCALE / (float)channels;
+    for (int32_t i = 0; i < frames; i++)
+    {
+      const int16_t *frame = src + (int64_t)i * stride;
+      int32_t sum = 0;
+      for (int32_t c = 0; c < channels; c++)
+        sum += frame[c];
+      dst[i] = (float)sum * scale;
+    }
+  }
+}
+
+void vad_convert_f32_frames_to_f32(const float *src, int32_t channels, int32_t stride, float *dst, int32_t frames)
+{
+  if (frames <= 0 || channels <= 0 || stride < channels)
+    return;
+
+  if (stride == 1)
+  {
+    memcpy(dst, src, (size_t)frames * sizeof(float));
+  }
+  else if (stride == 2 && channels == 2)
+  {
+    get_ops()->f32_stereo_to_mono(src, dst, frames);
+  }
+  else
+  {
+    float scale = 1.0f / (float)channels;
+    for (int32_t i = 0; i < frames; i++)
+    {
+      const float *frame = src + (int64_t)i * stride;
+      float sum = 0.0f;
+      for (int32_t c = 0; c < channels; c++)
+        sum += frame[c];
+      dst[i] = sum * scale;
+    }
+  }
+}
+
+void vad_convert_f32_level(const float *src, int32_t count, float *sum_squares_out, float *peak_out)
+{
+  *sum_squares_out = 0.0f;
+  *peak_out = 0.0f;
+  if (count > 0)
+    get_ops()->f32_level(src, count, sum_squares_out, peak_out);
+}
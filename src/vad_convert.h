@@ -0,0 +1,85 @@
+#ifndef VAD_CONVERT_H
+#define VAD_CONVERT_H
+
+// Sample format conversion shared by every platform implementation.
+// Each routine has scalar, SSE2, AVX2 and NEON variants; the best one for the
+// running CPU is picked on first use. All variants produce bit-identical
+// results to the scalar code.
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Instruction set used by the conversion routines
+typedef enum VADConvertIsa
+{
+    VAD_CONVERT_ISA_SCALAR = 0,
+    VAD_CONVERT_ISA_SSE2 = 1,
+    VAD_CONVERT_ISA_AVX2 = 2,
+    VAD_CONVERT_ISA_NEON = 3,
+} VADConvertIsa;
+
+/// Best instruction set supported by this CPU and build
+VADConvertIsa vad_convert_detect_isa(void);
+
+/// Instruction set currently in use
+VADConvertIsa vad_convert_get_isa(void);
+
+/// Force an instruction set (benchmarks and testing)
+/// @return 0 on success, -1 if the CPU or build does not support it
+int32_t vad_convert_set_isa(VADConvertIsa isa);
+
+/// Human readable name of an instruction set
+const char *vad_convert_isa_name(VADConvertIsa isa);
+
+/// PCM16 to float (x / 32768)
+void vad_convert_s16_to_f32(const int16_t *src, float *dst, int32_t count);
+
+/// PCM32 to float (x / 2147483648)
+void vad_convert_s32_to_f32(const int32_t *src, float *dst, int32_t count);
+
+/// Unsigned 8-bit PCM to float ((x - 128) / 128)
+void vad_convert_u8_to_f32(const uint8_t *src, float *dst, int32_t count);
+
+/// Float to PCM16, clamping to [-1, 1] first (x * 32767, truncated)
+void vad_convert_f32_to_s16(const float *src, int16_t *dst, int32_t count);
+
+/// Saturating clamp of float samples to [-1, 1] (src and dst may alias)
+void vad_convert_f32_clamp(const float *src, float *dst, int32_t count);
+
+/// Interleaved stereo PCM16 to mono float, averaging both channels
+void vad_convert_s16_stereo_to_f32_mono(const int16_t *src, float *dst, int32_t frames);
+
+/// Interleaved stereo float to mono float, averaging both channels
+void vad_convert_f32_stereo_to_mono(const float *src, float *dst, int32_t frames);
+
+/// Pick one channel of interleaved PCM16 as float
+/// @param channels Number of interleaved channels
+/// @param channel Channel to extract (0-based)
+void vad_convert_s16_channel_to_f32(const int16_t *src, int32_t channels, int32_t channel, float *dst,
+                                    int32_t frames);
+
+/// Interleaved PCM16 to mono float: output i is the average of the channels
+/// adjacent samples starting at src[i * stride] (channels = 1 picks one
+/// channel, channels = stride downmixes all of them)
+/// @param channels Number of adjacent channels averaged (1 to stride)
+/// @param stride Samples from one frame to the next
+void vad_convert_s16_frames_to_f32(const int16_t *src, int32_t channels, int32_t stride, float *dst, int32_t frames);
+
+/// Interleaved float to mono float, as vad_convert_s16_frames_to_f32()
+void vad_convert_f32_frames_to_f32(const float *src, int32_t channels, int32_t stride, float *dst, int32_t frames);
+
+/// Level of float samples, for the silence gate: sum of squares (accumulated
+/// in 8 interleaved lanes by every variant, so they agree unless the compiler
+/// fuses the scalar multiply-add) and largest magnitude. NaN samples are
+/// left out of the peak. Both are 0 for count <= 0.
+void vad_convert_f32_level(const float *src, int32_t count, float *sum_squares_out, float *peak_out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VAD_CONVERT_H */
@@ -0,0 +1,343 @@
+#include "vad_events.h"
+
+#include <string.h>
+
+#include "vad_platform.h"
+
+/// Retained slabs for payloads larger than the inline slab
+#define LARGE_SLAB_COUNT 4
+
+#define SLOT_LIVE 0x56414445u
+#define SLOT_FREE 0x66726565u
+
+typedef struct EventSlot
+{
+  /// First member, so the event pointer handed out is also the slot pointer
+  VADEvent event;
+  uint32_t magic;
+  VADEventPool *pool;
+  /// Index in pool->slots, or -1 for an overflow slot
+  int32_t index;
+  /// Large slab in use, or -1
+  int32_t large;
+  /// Inline slab of a pooled slot, or the payload buffer of an overflow slot
+  void *inline_payload;
+  /// Overflow slots only: payload buffer size, the next overflow slot and
+  /// the next free one
+  size_t payload_capacity;
+  struct EventSlot *next;
+  struct EventSlot *next_free;
+} EventSlot;
+
+typedef struct LargeSlab
+{
+  void *data;
+  size_t capacity;
+  int32_t in_use;
+} LargeSlab;
+
+struct VADEventPool
+{
+  vad_mutex_t lock;
+  int32_t closed;
+
+  EventSlot *slots;
+  int32_t slot_count;
+  int32_t *free_slots;
+  int32_t free_count;
+
+  size_t inline_bytes;
+  unsigned char *inline_storage;
+
+  LargeSlab large[LARGE_SLAB_COUNT];
+
+  // Overflow slots, used once every pooled slot is out. They are kept for the
+  // pool's lifetime and reused, never freed on release, so a repeated release
+  // still finds a slot header; at most VAD_EVENT_POOL_MAX_OVERFLOW exist
+  EventSlot *overflow;
+  EventSlot *overflow_free;
+  int32_t overflow_count;
+
+  int64_t acquired;
+  int64_t allocations;
+  int64_t dropped;
+  int32_t outstanding;
+};
+
+static size_t round_up(size_t value, size_t alignment)
+{
+  return (value + alignment - 1) / alignment * alignment;
+}
+
+static void pool_free(VADEventPool *pool)
+{
+  while (pool->overflow != NULL)
+  {
+    EventSlot *slot = pool->overflow;
+    pool->overflow = slot->next;
+    vad_aligned_free(slot->inline_payload);
+    free(slot);
+  }
+  for (int32_t i = 0; i < LARGE_SLAB_COUNT; i++)
+    vad_aligned_free(pool->large[i].data);
+  vad_aligned_free(pool->inline_storage);
+  free(pool->free_slots);
+  free(pool->slots);
+  vad_mutex_destroy(&pool->lock);
+  free(pool);
+}
+
+VADEventPool *vad_event_pool_create(int32_t slots, size_t inline_payload_bytes)
+{
+  if (slots <= 0)
+    return NULL;
+
+  VADEventPool *pool = (VADEventPool *)calloc(1, sizeof(VADEventPool));
+  if (pool == NULL)
+    return NULL;
+  vad_mutex_init(&pool->lock);
+
+  pool->slot_count = slots;
+  pool->inline_bytes = round_up(inline_payload_bytes, VAD_ALIGNMENT);
+  pool->slots = (EventSlot *)calloc((size_t)slots, sizeof(EventSlot));
+  pool->free_slots = (int32_t *)malloc((size_t)slots * sizeof(int32_t));
+  if (pool->inline_bytes > 0)
+    pool->inline_storage = (unsigned char *)vad_aligned_alloc((size_t)slots * pool->inline_bytes);
+  if (pool->slots == NULL || pool->free_slots == NULL || (pool->inline_bytes > 0 && pool->inline_storage == NULL))
+  {
+    pool_free(pool);
+    return NULL;
+  }
+
+  for (int32_t i = 0; i < slots; i++)
+  {
+    EventSlot *slot = &pool->slots[i];
+    slot->magic = SLOT_FREE;
+    slot->pool = pool;
+    slot->index = i;
+    slot->large = -1;
+    slot->inline_payload = pool->inline_bytes > 0 ? pool->inline_storage + (size_t)i * pool->inline_bytes : NULL;
+    // Hand out low indices first so a quiet stream touches few cache lines
+    pool->free_slots[i] = slots - 1 - i;
+  }
+  pool->free_count = slots;
+  return pool;
+}
+
+void vad_event_pool_close(VADEventPool *pool)
+{
+  if (pool == NULL)
+    return;
+
+  vad_mutex_lock(&pool->lock);
+  pool->closed = 1;
+  int32_t unused = pool->outstanding == 0;
+  vad_mutex_unlock(&pool->lock);
+
+  if (unused)
+    pool_free(pool);
+}
+
+/// Pick a large slab for bytes of payload; called with the lock held
+static int32_t take_large(VADEventPool *pool, size_t bytes)
+{
+  // Prefer a free slab that already fits, else grow the largest free one
+  int32_t best = -1;
+  for (int32_t i = 0; i < LARGE_SLAB_COUNT; i++)
+  {
+    LargeSlab *slab = &pool->large[i];
+    if (slab->in_use)
+      continue;
+    if (slab->capacity >= bytes)
+    {
+      slab->in_use = 1;
+      return i;
+    }
+    if (best < 0 || slab->capacity > pool->large[best].capacity)
+      best = i;
+  }
+  if (best < 0)
+    return -1;
+
+  // Grow by half again so slowly lengthening segments do not reallocate every time
+  size_t capacity = round_up(bytes + bytes / 2, VAD_ALIGNMENT);
+  void *data = vad_aligned_alloc(capacity);
+  if (data == NULL)
+    return -1;
+  vad_aligned_free(pool->large[best].data);
+  pool->large[best].data = data;
+  pool->large[best].capacity = capacity;
+  pool->large[best].in_use = 1;
+  pool->allocations++;
+  return best;
+}
+
+/// Take a free overflow slot with room for bytes of payload, adding one or
+/// growing its payload if needed; called with the lock held
+/// @return Slot, or NULL when the overflow slots are exhausted or memory ran out
+static EventSlot *take_overflow(VADEventPool *pool, size_t bytes)
+{
+  EventSlot *slot = pool->overflow_free;
+  if (slot == NULL)
+  {
+    if (pool->overflow_count >= VAD_EVENT_POOL_MAX_OVERFLOW)
+      return NULL;
+    slot = (EventSlot *)calloc(1, sizeof(EventSlot));
+    if (slot == NULL)
+      return NULL;
+    slot->magic = SLOT_FREE;
+    slot->pool = pool;
+    slot->index = -1;
+    slot->large = -1;
+    slot->next = pool->overflow;
+    pool->overflow = slot;
+    pool->overflow_count++;
+    pool->allocations++;
+  }
+  else
+  {
+    pool->overflow_free = slot->next_free;
+  }
+
+  if (slot->payload_capacity < bytes)
+  {
+    size_t capacity = round_up(bytes, VAD_ALIGNMENT);
+    void *data = vad_aligned_alloc(capacity);
+    if (data == NULL)
+    {
+      slot->next_free = pool->overflow_free;
+      pool->overflow_free = slot;
+      return NULL;
+    }
+    vad_aligned_free(slot->inline_payload);
+    slot->inline_payload = data;
+    slot->payload_capacity = capacity;
+    pool->allocations++;
+  }
+  return slot;
+}
+
+VADEvent *vad_event_pool_acquire(VADEventPool *pool, int32_t type, size_t payload_bytes, void **payload)
+{
+  if (pool == NULL)
+    return NULL;
+
+  EventSlot *slot = NULL;
+  void *data = NULL;
+
+  vad_mutex_lock(&pool->lock);
+  if (pool->closed)
+  {
+    vad_mutex_unlock(&pool->lock);
+    return NULL;
+  }
+
+  if (pool->free_count > 0)
+  {
+    slot = &pool->slots[pool->free_slots[--pool->free_count]];
+    if (payload_bytes <= pool->inline_bytes)
+    {
+      data = slot->inline_payload;
+    }
+    else
+    {
+      slot->large = take_large(pool, payload_bytes);
+      if (slot->large >= 0)
+        data = pool->large[slot->large].data;
+    }
+
+    if (payload_bytes > 0 && data == NULL)
+    {
+      // No slab left for this payload; give the slot back and overflow
+      pool->free_slots[pool->free_count++] = slot->index;
+      slot = NULL;
+    }
+  }
+
+  if (slot == NULL)
+  {
+    slot = take_overflow(pool, payload_bytes);
+    if (slot == NULL)
+    {
+      // A consumer that never releases cannot grow memory without bound
+      pool->dropped++;
+      vad_mutex_unlock(&pool->lock);
+      return NULL;
+    }
+    data = payload_bytes > 0 ? slot->inline_payload : NULL;
+  }
+
+  slot->magic = SLOT_LIVE;
+  pool->acquired++;
+  pool->outstanding++;
+  vad_mutex_unlock(&pool->lock);
+
+  memset(&slot->event, 0, sizeof(VADEvent));
+  slot->event.type = type;
+  if (payload != NULL)
+    *payload = data;
+  return &slot->event;
+}
+
+void vad_event_pool_release(const VADEvent *event)
+{
+  if (event == NULL)
+    return;
+
+  EventSlot *slot = (EventSlot *)event;
+  VADEventPool *pool = slot->pool;
+
+  vad_mutex_lock(&pool->lock);
+  if (slot->magic != SLOT_LIVE)
+  {
+    vad_mutex_unlock(&pool->lock);
+    return;
+  }
+  slot->magic = SLOT_FREE;
+
+  if (slot->large >= 0)
+  {
+    pool->large[slot->large].in_use = 0;
+    slot->large = -1;
+  }
+  if (slot->index >= 0)
+  {
+    pool->free_slots[pool->free_count++] = slot->index;
+  }
+  else
+  {
+    slot->next_free = pool->overflow_free;
+    pool->overflow_free = slot;
+  }
+
+  pool->outstanding--;
+  int32_t unused = pool->closed && pool->outstanding == 0;
+  vad_mutex_unlock(&pool->lock);
+
+  if (unused)
+    pool_free(pool);
+}
+
+void vad_event_pool_get_stats(VADEventPool *pool, VADEventPoolStats *stats_out)
+{
+  if (pool == NULL || stats_out == NULL)
+    return;
+
+  vad_mutex_lock(&pool->lock);
+  stats_out->acquired = pool->acquired;
+  stats_out->allocations = pool->allocations;
+  stats_out->dropped = pool->dropped;
+  stats_out->outstanding = pool->outstanding;
+  vad_mutex_unlock(&pool->lock);
+}
+
+// ============================================================================
+// FFI Export (all platforms)
+// ============================================================================
+
+FFI_PLUGIN_EXPORT void vad_event_release(VADHandle *handle, const VADEvent *event)
+{
+  // The event knows its pool, which outlives the handle until released
+  (void)handle;
+  vad_event_pool_release(event);
+}
@@ -0,0 +1,82 @@
+#ifndef VAD_EVENTS_H
+#define VAD_EVENTS_H
+
+// Pooled event memory shared by every platform implementation.
+//
+// NativeCallable.listener reads events asynchronously on the Dart event loop,
+// so an event and its payload must stay valid until the consumer hands it
+// back with vad_event_release(). Each handle owns a pool of event slots, each
+// with an inline payload slab big enough for a frame; larger payloads (speech
+// segments) come from a few retained large slabs. Once the slabs have grown to
+// the largest segment seen, steady-state delivery does no heap allocation.
+// If every slot is out, events go to overflow slots kept by the pool, up to
+// VAD_EVENT_POOL_MAX_OVERFLOW of them; past that, events are dropped and
+// counted, so a consumer that never releases cannot grow memory without bound.
+//
+// The pool is reference counted: its owner holds one reference, dropped by
+// vad_event_pool_close(), and every outstanding event holds one. Releasing an
+// event after its handle is gone is therefore valid. A repeated release of
+// the same event is ignored as long as the pool is alive, i.e. while the owner
+// or another event still holds it; once the last reference is gone the event
+// memory is freed with the pool, and any later release of it is invalid.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vad_plus.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Default number of event slots per handle
+#define VAD_EVENT_POOL_SLOTS 64
+
+/// Overflow events a pool keeps beyond its slots (about two minutes of 32 ms
+/// frame events awaiting release)
+#define VAD_EVENT_POOL_MAX_OVERFLOW 4096
+
+typedef struct VADEventPool VADEventPool;
+
+/// Pool counters
+typedef struct VADEventPoolStats
+{
+    /// Events handed out since creation
+    int64_t acquired;
+    /// Heap allocations (an overflow slot created, or a slab or overflow payload grew)
+    int64_t allocations;
+    /// Events not handed out because every pooled and overflow slot was out
+    int64_t dropped;
+    /// Events not yet released
+    int32_t outstanding;
+} VADEventPoolStats;
+
+/// Create a pool
+/// @param slots Number of pooled events
+/// @param inline_payload_bytes Payload bytes reserved per slot (e.g. one frame of floats)
+/// @return Pool, or NULL on allocation failure
+VADEventPool *vad_event_pool_create(int32_t slots, size_t inline_payload_bytes);
+
+/// Drop the owner's reference. The pool is freed once every outstanding
+/// event has been released, so consumers may release after the handle is gone.
+void vad_event_pool_close(VADEventPool *pool);
+
+/// Take a zeroed event of the given type
+/// @param payload_bytes Payload storage needed, returned through payload (may be 0)
+/// @return Event, or NULL if the pool is closed, every slot is out (counted
+///         in VADEventPoolStats.dropped) or memory is exhausted
+VADEvent *vad_event_pool_acquire(VADEventPool *pool, int32_t type, size_t payload_bytes, void **payload);
+
+/// Return an event to the pool it came from. A repeated release is ignored
+/// while the pool is alive (see above).
+void vad_event_pool_release(const VADEvent *event);
+
+/// Read the pool counters
+void vad_event_pool_get_stats(VADEventPool *pool, VADEventPoolStats *stats_out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VAD_EVENTS_H */
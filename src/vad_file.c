@@ -0,0 +1,281 @@
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+// posix_madvise
+#define _GNU_SOURCE
+#endif
+
+#include "vad_file.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "vad_convert.h"
+
+// ============================================================================
+// Mapping
+// ============================================================================
+
+static int32_t map_file(VADFile *file, const char *path, char *error, size_t error_size)
+{
+#if _WIN32
+  HANDLE handle = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+  if (handle == INVALID_HANDLE_VALUE)
+  {
+    snprintf(error, error_size, "Audio file does not exist: %s", path);
+    return -1;
+  }
+  LARGE_INTEGER size;
+  if (!GetFileSizeEx(handle, &size) || (uint64_t)size.QuadPart > (uint64_t)SIZE_MAX)
+  {
+    CloseHandle(handle);
+    snprintf(error, error_size, "Audio file is unreadable: %s", path);
+    return -1;
+  }
+  file->map_size = (size_t)size.QuadPart;
+  if (file->map_size > 0)
+  {
+    HANDLE mapping = CreateFileMappingA(handle, NULL, PAGE_READONLY, 0, 0, NULL);
+    if (mapping != NULL)
+    {
+      file->map = (const uint8_t *)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      // The view keeps the mapping alive
+      CloseHandle(mapping);
+    }
+  }
+  CloseHandle(handle);
+#else
+  int fd = open(path, O_RDONLY);
+  if (fd < 0)
+  {
+    snprintf(error, error_size, "Audio file does not exist: %s", path);
+    return -1;
+  }
+  struct stat info;
+  if (fstat(fd, &info) != 0 || (uint64_t)info.st_size > (uint64_t)SIZE_MAX)
+  {
+    close(fd);
+    snprintf(error, error_size, "Audio file is unreadable: %s", path);
+    return -1;
+  }
+  file->map_size = (size_t)info.st_size;
+  if (file->map_size > 0)
+  {
+    void *map = mmap(NULL, file->map_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map != MAP_FAILED)
+    {
+      // Read front to back once; let the kernel read ahead and drop pages behind
+      posix_madvise(map, file->map_size, POSIX_MADV_SEQUENTIAL);
+      file->map = (const uint8_t *)map;
+    }
+  }
+  close(fd);
+#endif
+
+  if (file->map_size > 0 && file->map == NULL)
+  {
+    snprintf(error, error_size, "Failed to map audio file: %s", path);
+    return -1;
+  }
+  return 0;
+}
+
+void vad_file_close(VADFile *file)
+{
+  if (file->map != NULL)
+  {
+#if _WIN32
+    UnmapViewOfFile(file->map);
+#else
+    munmap((void *)file->map, file->map_size);
+#endif
+  }
+  memset(file, 0, sizeof(*file));
+}
+
+// ============================================================================
+// WAV Header
+// ============================================================================
+
+#define WAV_FORMAT_PCM 0x0001
+#define WAV_FORMAT_IEEE_FLOAT 0x0003
+#define WAV_FORMAT_EXTENSIBLE 0xFFFE
+
+static uint16_t read_u16(const uint8_t *p)
+{
+  return (uint16_t)(p[0] | (p[1] << 8));
+}
+
+static uint32_t read_u32(const uint8_t *p)
+{
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+/// Find the fmt and data chunks of a RIFF/WAVE file
+static int32_t parse_wav(VADFile *file, char *error, size_t error_size)
+{
+  const uint8_t *end = file->map + file->map_size;
+  const uint8_t *chunk = file->map + 12;
+  int32_t have_format = 0;
+
+  while (end - chunk >= 8)
+  {
+    uint32_t size = read_u32(chunk + 4);
+    const uint8_t *body = chunk + 8;
+    size_t available = (size_t)(end - body);
+
+    if (memcmp(chunk, "fmt ", 4) == 0)
+    {
+      if (size < 16 || available < 16)
+        break;
+      uint16_t tag = read_u16(body);
+      uint16_t channels = read_u16(body + 2);
+      uint16_t bits = read_u16(body + 14);
+      if (tag == WAV_FORMAT_EXTENSIBLE && size >= 40 && available >= 40)
+        tag = read_u16(body + 24); // first two bytes of the sub-format GUID
+
+      if (tag == WAV_FORMAT_PCM && bits == 16)
+        file->format = VAD_FILE_FORMAT_S16;
+      else if (tag == WAV_FORMAT_PCM && bits == 32)
+        file->format = VAD_FILE_FORMAT_S32;
+      else if (tag == WAV_FORMAT_PCM && bits == 8)
+        file->format = VAD_FILE_FORMAT_U8;
+      else if (tag == WAV_FORMAT_IEEE_FLOAT && bits == 32)
+        file->format = VAD_FILE_FORMAT_F32;
+      else
+      {
+        snprintf(error, error_size, "Unsupported WAV format (tag %u, %u bits)", tag, bits);
+        return -2;
+      }
+      if (channels == 0)
+        break;
+      file->channels = channels;
+      file->bytes_per_frame = channels * (bits / 8);
+      file->sample_rate = (int32_t)read_u32(body + 4);
+      have_format = 1;
+    }
+    else if (memcmp(chunk, "data", 4) == 0)
+    {
+      if (!have_format)
+        break;
+      // Writers that never finalized the header leave 0 or 0xFFFFFFFF here
+      size_t data_size = size == 0 || size > available ? available : size;
+      file->data = body;
+      file->frames = (int64_t)(data_size / (size_t)file->bytes_per_frame);
+      return 0;
+    }
+
+    if (size > available)
+      break;
+    chunk = body + size + (size & 1);
+  }
+
+  snprintf(error, error_size, "Invalid WAV file (missing or malformed fmt/data chunk)");
+  return -2;
+}
+
+int32_t vad_file_open(VADFile *file, const char *path, char *error, size_t error_size)
+{
+  memset(file, 0, sizeof(*file));
+  int32_t result = map_file(file, path, error, error_size);
+  if (result != 0)
+    return result;
+
+  if (file->map_size >= 12 && memcmp(file->map, "RIFF", 4) == 0 && memcmp(file->map + 8, "WAVE", 4) == 0)
+  {
+    result = parse_wav(file, error, error_size);
+    if (result != 0)
+      vad_file_close(file);
+    return result;
+  }
+
+  // Raw PCM16 mono
+  file->data = file->map;
+  file->format = VAD_FILE_FORMAT_S16;
+  file->channels = 1;
+  file->bytes_per_frame = 2;
+  file->frames = (int64_t)(file->map_size / 2);
+  return 0;
+}
+
+// ============================================================================
+// Sample Conversion
+// ============================================================================
+
+static float read_sample(const VADFile *file, const uint8_t *p)
+{
+  switch (file->format)
+  {
+  case VAD_FILE_FORMAT_S16:
+    return (float)(int16_t)read_u16(p) / 32768.0f;
+  case VAD_FILE_FORMAT_S32:
+    return (float)(int32_t)read_u32(p) / 2147483648.0f;
+  case VAD_FILE_FORMAT_U8:
+    return (float)((int32_t)p[0] - 128) / 128.0f;
+  case VAD_FILE_FORMAT_F32:
+  default:
+  {
+    float value;
+    memcpy(&value, p, sizeof(value));
+    return value;
+  }
+  }
+}
+
+void vad_file_read(const VADFile *file, int64_t offset, int32_t count, float *dst)
+{
+  const uint8_t *src = file->data + offset * file->bytes_per_frame;
+  size_t sample_size = (size_t)file->bytes_per_frame / (size_t)file->channels;
+
+  // The vectorized converters need naturally aligned samples, which every
+  // well-formed WAV file has
+  if (((uintptr_t)src & (sample_size - 1)) == 0)
+  {
+    if (file->channels == 1)
+    {
+      switch (file->format)
+      {
+      case VAD_FILE_FORMAT_S16:
+        vad_convert_s16_to_f32((const int16_t *)src, dst, count);
+        return;
+      case VAD_FILE_FORMAT_S32:
+        vad_convert_s32_to_f32((const int32_t *)src, dst, count);
+        return;
+      case VAD_FILE_FORMAT_U8:
+        vad_convert_u8_to_f32(src, dst, count);
+        return;
+      case VAD_FILE_FORMAT_F32:
+        memcpy(dst, src, (size_t)count * sizeof(float));
+        return;
+      }
+    }
+    else if (file->channels == 2 && file->format == VAD_FILE_FORMAT_S16)
+    {
+      vad_convert_s16_stereo_to_f32_mono((const int16_t *)src, dst, count);
+      return;
+    }
+    else if (file->channels == 2 && file->format == VAD_FILE_FORMAT_F32)
+    {
+      vad_convert_f32_stereo_to_mono((const float *)src, dst, count);
+      return;
+    }
+  }
+
+  float scale = 1.0f / (float)file->channels;
+  for (int32_t i = 0; i < count; i++)
+  {
+    const uint8_t *frame = src + (size_t)i * file->bytes_per_frame;
+    float sum = 0.0f;
+    for (int32_t c = 0; c < file->channels; c++)
+      sum += read_sample(file, frame + (size_t)c * sample_size);
+    dst[i] = sum * scale;
+  }
+}
@@ -0,0 +1,59 @@
+#ifndef VAD_FILE_H
+#define VAD_FILE_H
+
+// Read-only memory-mapped audio files for offline segmentation. WAV files
+// (PCM16, PCM32, 8-bit or float32, any channel count) are parsed in place;
+// anything without a RIFF header is taken as raw mono PCM16 little-endian.
+// Samples are converted to mono float on demand, a block at a time, so the
+// file is never decoded into memory as a whole.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Sample encoding of a mapped file
+typedef enum VADFileFormat
+{
+    VAD_FILE_FORMAT_S16 = 0,
+    VAD_FILE_FORMAT_S32 = 1,
+    VAD_FILE_FORMAT_U8 = 2,
+    VAD_FILE_FORMAT_F32 = 3,
+} VADFileFormat;
+
+typedef struct VADFile
+{
+    /// Whole file as mapped
+    const uint8_t *map;
+    size_t map_size;
+    /// First sample and the number of sample frames (one sample per channel)
+    const uint8_t *data;
+    int64_t frames;
+    VADFileFormat format;
+    int32_t channels;
+    int32_t bytes_per_frame;
+    /// From the WAV header, 0 for raw PCM
+    int32_t sample_rate;
+} VADFile;
+
+/// Map a file and locate its samples
+/// @return 0 on success, -1 if the file cannot be opened or mapped, -2 if its
+///         WAV header is invalid or its format unsupported (message in error)
+int32_t vad_file_open(VADFile *file, const char *path, char *error, size_t error_size);
+
+/// Unmap a file opened with vad_file_open (safe on a zeroed VADFile)
+void vad_file_close(VADFile *file);
+
+/// Convert count sample frames starting at frame offset to mono float,
+/// averaging the channels of multi-channel files
+/// @param dst Output, count floats
+void vad_file_read(const VADFile *file, int64_t offset, int32_t count, float *dst);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VAD_FILE_H
@@ -0,0 +1,130 @@
+#include "vad_gate.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "vad_convert.h"
+#include "vad_platform.h"
+
+// Noise floor tracking: the floor drops quickly to a quieter frame and rises
+// slowly towards a louder one (about 1.5 dB per second at 32 ms frames), so
+// speech barely moves it while a change of background noise is followed
+// within seconds
+#define VAD_GATE_FLOOR_FALL 0.25f
+#define VAD_GATE_FLOOR_RISE_DB 0.05f
+
+// Level of an all-zero frame
+#define VAD_GATE_MIN_DB -120.0f
+
+struct VADGate
+{
+  int32_t hold_frames;
+  float threshold_dbfs;
+  float noise_margin_db;
+
+  float noise_floor_db;
+  int32_t floor_valid;
+  int32_t silent_run;
+  int32_t skipping;
+};
+
+VADGate *vad_gate_create(void)
+{
+  VADGate *gate = (VADGate *)vad_aligned_alloc(sizeof(VADGate));
+  if (gate == NULL)
+    return NULL;
+  memset(gate, 0, sizeof(VADGate));
+  return gate;
+}
+
+void vad_gate_destroy(VADGate *gate)
+{
+  vad_aligned_free(gate);
+}
+
+void vad_gate_configure(VADGate *gate, int32_t hold_frames, float threshold_dbfs, float noise_margin_db)
+{
+  if (gate == NULL)
+    return;
+  gate->hold_frames = hold_frames > 0 ? hold_frames : 0;
+  gate->threshold_dbfs = threshold_dbfs;
+  gate->noise_margin_db = noise_margin_db > 0.0f ? noise_margin_db : 0.0f;
+  vad_gate_reset(gate);
+}
+
+void vad_gate_reset(VADGate *gate)
+{
+  if (gate == NULL)
+    return;
+  gate->noise_floor_db = VAD_GATE_MIN_DB;
+  gate->floor_valid = 0;
+  gate->silent_run = 0;
+  gate->skipping = 0;
+}
+
+static float to_db(float power)
+{
+  // NaN stays NaN
+  return power <= 1e-12f ? VAD_GATE_MIN_DB : 10.0f * log10f(power);
+}
+
+/// Threshold for the next frame, following the noise floor when enabled
+static float update_threshold(VADGate *gate, float level_db)
+{
+  if (gate->noise_margin_db <= 0.0f || isnan(level_db))
+    return gate->threshold_dbfs;
+
+  if (!gate->floor_valid)
+  {
+    gate->noise_floor_db = level_db;
+    gate->floor_valid = 1;
+  }
+  else if (level_db < gate->noise_floor_db)
+  {
+    gate->noise_floor_db += (level_db - gate->noise_floor_db) * VAD_GATE_FLOOR_FALL;
+  }
+  else
+  {
+    float rise = level_db - gate->noise_floor_db;
+    gate->noise_floor_db += rise < VAD_GATE_FLOOR_RISE_DB ? rise : VAD_GATE_FLOOR_RISE_DB;
+  }
+
+  float adaptive = gate->noise_floor_db + gate->noise_margin_db;
+  if (adaptive > VAD_GATE_ADAPTIVE_CEILING_DBFS)
+    adaptive = VAD_GATE_ADAPTIVE_CEILING_DBFS;
+  return adaptive > gate->threshold_dbfs ? adaptive : gate->threshold_dbfs;
+}
+
+int32_t vad_gate_push(VADGate *gate, const float *frame, int32_t count)
+{
+  if (gate == NULL || gate->hold_frames == 0 || count <= 0)
+    return VAD_GATE_INFER;
+
+  float sum_squares;
+  float peak;
+  vad_convert_f32_level(frame, count, &sum_squares, &peak);
+  float level_db = to_db(sum_squares / (float)count);
+  float peak_db = to_db(peak * peak);
+
+  // A NaN level (NaN samples) compares false and keeps the frame on the model
+  float threshold = update_threshold(gate, level_db);
+  int32_t silent = level_db < threshold && peak_db < threshold + VAD_GATE_PEAK_MARGIN_DB;
+
+  if (!silent)
+  {
+    gate->silent_run = 0;
+    if (gate->skipping)
+    {
+      gate->skipping = 0;
+      return VAD_GATE_RESUME;
+    }
+    return VAD_GATE_INFER;
+  }
+
+  if (gate->silent_run <= gate->hold_frames)
+    gate->silent_run++;
+  if (gate->silent_run <= gate->hold_frames)
+    return VAD_GATE_INFER;
+  gate->skipping = 1;
+  return VAD_GATE_SKIP;
+}
@@ -0,0 +1,65 @@
+#ifndef VAD_GATE_H
+#define VAD_GATE_H
+
+// Energy pre-gate in front of the model (VADConfig.silence_gate_frames),
+// shared by every platform implementation. Each frame's RMS and peak level
+// (vad_convert_f32_level) is compared with a fixed threshold, optionally
+// raised to follow the noise floor; once more than hold_frames frames in a
+// row are silent, the model is skipped until a frame is not. Skipped frames
+// count as probability 0.
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Decisions of vad_gate_push() for one frame
+/// Run the model on the frame
+#define VAD_GATE_INFER 0
+/// Skip the model; the frame's probability is 0
+#define VAD_GATE_SKIP 1
+/// Run the model on the first frame after skipped ones. The LSTM state (h and
+/// c) is still that of the last frame inferred, hold_frames silent frames into
+/// the gap; vad_plus restarts it from zero, as the model does after a reset
+#define VAD_GATE_RESUME 2
+
+/// A frame whose peak is this far above the threshold is never silent, so a
+/// click or a plosive onset in an otherwise quiet frame reaches the model
+#define VAD_GATE_PEAK_MARGIN_DB 20.0f
+
+/// Highest threshold the noise floor can raise the gate to
+#define VAD_GATE_ADAPTIVE_CEILING_DBFS -35.0f
+
+typedef struct VADGate VADGate;
+
+/// Allocate a disabled gate (every frame is inferred)
+/// @return Gate, or NULL on allocation failure
+VADGate *vad_gate_create(void);
+
+/// Free a gate
+void vad_gate_destroy(VADGate *gate);
+
+/// Set the gate up and reset it
+/// @param hold_frames Silent frames still inferred before the gate closes
+///        (0 disables the gate)
+/// @param threshold_dbfs Frame RMS level under which a frame is silent
+/// @param noise_margin_db Also count frames within this many dB of the
+///        tracked noise floor as silent, up to VAD_GATE_ADAPTIVE_CEILING_DBFS
+///        (0 = fixed threshold only)
+void vad_gate_configure(VADGate *gate, int32_t hold_frames, float threshold_dbfs, float noise_margin_db);
+
+/// Forget the noise floor and the silent run, as at the start of a stream
+void vad_gate_reset(VADGate *gate);
+
+/// Classify the next frame
+/// @return VAD_GATE_INFER, VAD_GATE_SKIP or VAD_GATE_RESUME (always
+///         VAD_GATE_INFER while the gate is disabled)
+int32_t vad_gate_push(VADGate *gate, const float *frame, int32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VAD_GATE_H
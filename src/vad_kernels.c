@@ -0,0 +1,213 @@
+#include "vad_kernels.h"
+
+#include <math.h>
+#include <stddef.h>
+
+// Weight block size of vad_kernel_gemm() (16 KB, half a typical L1 data cache)
+#define GEMM_BLOCK_FLOATS 4096
+
+float vad_kernel_dot(const float *a, const float *b, int32_t n)
+{
+  // Eight independent accumulators break the add dependency chain and map
+  // onto one 256-bit or two 128-bit vector registers.
+  float acc[8] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+  int32_t i = 0;
+  for (; i + 8 <= n; i += 8)
+  {
+    for (int32_t k = 0; k < 8; k++)
+      acc[k] += a[i + k] * b[i + k];
+  }
+  float sum = ((acc[0] + acc[4]) + (acc[1] + acc[5])) + ((acc[2] + acc[6]) + (acc[3] + acc[7]));
+  for (; i < n; i++)
+    sum += a[i] * b[i];
+  return sum;
+}
+
+void vad_kernel_gemv(const float *w, const float *x, const float *bias, float *y, int32_t rows, int32_t cols)
+{
+  for (int32_t r = 0; r < rows; r++)
+  {
+    float sum = vad_kernel_dot(w + (int64_t)r * cols, x, cols);
+    y[r] = bias != NULL ? sum + bias[r] : sum;
+  }
+}
+
+void vad_kernel_gemm(const float *w, const float *const *x, const float *bias, float *const *y, int32_t rows,
+                     int32_t cols, int32_t n)
+{
+  // Walk the weights in blocks that stay in L1 while every vector passes over
+  // them, so the matrix is read from memory once per call instead of once per
+  // vector. Each output is a plain vad_kernel_dot(), same as vad_kernel_gemv().
+  int32_t block = GEMM_BLOCK_FLOATS / cols;
+  if (block < 1)
+    block = 1;
+
+  for (int32_t r0 = 0; r0 < rows; r0 += block)
+  {
+    int32_t r1 = r0 + block < rows ? r0 + block : rows;
+    for (int32_t j = 0; j < n; j++)
+    {
+      const float *xj = x[j];
+      float *yj = y[j];
+      for (int32_t r = r0; r < r1; r++)
+      {
+        float sum = vad_kernel_dot(w + (int64_t)r * cols, xj, cols);
+        yj[r] = bias != NULL ? sum + bias[r] : sum;
+      }
+    }
+  }
+}
+
+void vad_kernel_conv1d_k3_relu(const float *input, int32_t in_channels, int32_t in_length,
+                               const float *weight, const float *bias, int32_t out_channels,
+                               int32_t stride, float *output, float *column)
+{
+  int32_t out_length = (in_length - 1) / stride + 1;
+  int32_t row = in_channels * 3;
+
+  for (int32_t t = 0; t < out_length; t++)
+  {
+    // Gather the receptive field of output step t in weight order [cin][k]
+    int32_t start = t * stride - 1;
+    for (int32_t ci = 0; ci < in_channels; ci++)
+    {
+      const float *src = input + (int64_t)ci * in_length;
+      for (int32_t k = 0; k < 3; k++)
+      {
+        int32_t pos = start + k;
+        column[ci * 3 + k] = (pos >= 0 && pos < in_length) ? src[pos] : 0.0f;
+      }
+    }
+
+    for (int32_t co = 0; co < out_channels; co++)
+    {
+      float value = vad_kernel_dot(weight + (int64_t)co * row, column, row) + bias[co];
+      output[(int64_t)co * out_length + t] = value > 0.0f ? value : 0.0f;
+    }
+  }
+}
+
+float vad_kernel_quantize(const float *x, int16_t *q, int32_t n)
+{
+  float peak = 0.0f;
+  for (int32_t i = 0; i < n; i++)
+  {
+    float magnitude = fabsf(x[i]);
+    peak = magnitude > peak ? magnitude : peak;
+  }
+  if (peak == 0.0f)
+  {
+    for (int32_t i = 0; i < n; i++)
+      q[i] = 0;
+    return 0.0f;
+  }
+
+  // Round half away from zero by hand: lrintf() is a library call that
+  // keeps this loop from vectorizing
+  float inverse = 127.0f / peak;
+  for (int32_t i = 0; i < n; i++)
+  {
+    float scaled = x[i] * inverse;
+    q[i] = (int16_t)(scaled + (scaled >= 0.0f ? 0.5f : -0.5f));
+  }
+  return peak / 127.0f;
+}
+
+int32_t vad_kernel_dot_q8(const int16_t *a, const int16_t *b, int32_t n)
+{
+  // Both operands are int16 lanes, so the compiler multiplies and adds pairs
+  // straight into int32 lanes (pmaddwd on x86, smlal on ARM)
+  int32_t sum = 0;
+  for (int32_t i = 0; i < n; i++)
+    sum += (int32_t)a[i] * (int32_t)b[i];
+  return sum;
+}
+
+void vad_kernel_gemv_q8(const int16_t *w, const float *w_scale, const int16_t *x, float x_scale, const float *bias,
+                        float *y, int32_t rows, int32_t cols)
+{
+  for (int32_t r = 0; r < rows; r++)
+  {
+    float sum = (float)vad_kernel_dot_q8(w + (int64_t)r * cols, x, cols) * (w_scale[r] * x_scale);
+    y[r] = bias != NULL ? sum + bias[r] : sum;
+  }
+}
+
+void vad_kernel_gemm_q8(const int16_t *w, const float *w_scale, const int16_t *const *x, const float *x_scale,
+                        const float *bias, float *const *y, int32_t rows, int32_t cols, int32_t n)
+{
+  // Same blocking as vad_kernel_gemm(), sized in int16 lanes instead of floats
+  int32_t block = GEMM_BLOCK_FLOATS * (int32_t)(sizeof(float) / sizeof(int16_t)) / cols;
+  if (block < 1)
+    block = 1;
+
+  for (int32_t r0 = 0; r0 < rows; r0 += block)
+  {
+    int32_t r1 = r0 + block < rows ? r0 + block : rows;
+    for (int32_t j = 0; j < n; j++)
+    {
+      const int16_t *xj = x[j];
+      float *yj = y[j];
+      for (int32_t r = r0; r < r1; r++)
+      {
+        float sum = (float)vad_kernel_dot_q8(w + (int64_t)r * cols, xj, cols) * (w_scale[r] * x_scale[j]);
+        yj[r] = bias != NULL ? sum + bias[r] : sum;
+      }
+    }
+  }
+}
+
+void vad_kernel_conv1d_k3_relu_q8(const float *input, int32_t in_channels, int32_t in_length,
+                                  const int16_t *weight, const float *weight_scale, const float *bias,
+                                  int32_t out_channels, int32_t stride, float *output, float *column,
+                                  int16_t *column_q8)
+{
+  int32_t out_length = (in_length - 1) / stride + 1;
+  int32_t row = in_channels * 3;
+
+  for (int32_t t = 0; t < out_length; t++)
+  {
+    int32_t start = t * stride - 1;
+    for (int32_t ci = 0; ci < in_channels; ci++)
+    {
+      const float *src = input + (int64_t)ci * in_length;
+      for (int32_t k = 0; k < 3; k++)
+      {
+        int32_t pos = start + k;
+        column[ci * 3 + k] = (pos >= 0 && pos < in_length) ? src[pos] : 0.0f;
+      }
+    }
+    float column_scale = vad_kernel_quantize(column, column_q8, row);
+
+    for (int32_t co = 0; co < out_channels; co++)
+    {
+      float value = (float)vad_kernel_dot_q8(weight + (int64_t)co * row, column_q8, row) *
+                        (weight_scale[co] * column_scale) +
+                    bias[co];
+      output[(int64_t)co * out_length + t] = value > 0.0f ? value : 0.0f;
+    }
+  }
+}
+
+float vad_kernel_sigmoid(float x)
+{
+  return 1.0f / (1.0f + expf(-x));
+}
+
+void vad_kernel_lstm_cell(const float *gates, float *h, float *c, int32_t hidden_size)
+{
+  const float *gate_i = gates;
+  const float *gate_f = gates + hidden_size;
+  const float *gate_g = gates + 2 * hidden_size;
+  const float *gate_o = gates + 3 * hidden_size;
+
+  for (int32_t j = 0; j < hidden_size; j++)
+  {
+    float i = vad_kernel_sigmoid(gate_i[j]);
+    float f = vad_kernel_sigmoid(gate_f[j]);
+    float g = tanhf(gate_g[j]);
+    float o = vad_kernel_sigmoid(gate_o[j]);
+    c[j] = f * c[j] + i * g;
+    h[j] = o * tanhf(c[j]);
+  }
+}
@@ -0,0 +1,73 @@
+#ifndef VAD_KERNELS_H
+#define VAD_KERNELS_H
+
+// CPU kernels for the Silero v6 forward pass. All matrices are row-major and
+// every inner loop runs over contiguous memory so the compiler can vectorize it.
+
+#include <stdint.h>
+
+/// Dot product of two float vectors
+float vad_kernel_dot(const float *a, const float *b, int32_t n);
+
+/// Matrix-vector product: y[r] = bias[r] + sum_c w[r * cols + c] * x[c]
+/// @param bias Optional bias (NULL for none)
+void vad_kernel_gemv(const float *w, const float *x, const float *bias, float *y, int32_t rows, int32_t cols);
+
+/// Matrix product against several independent vectors: y[j][r] = bias[r] + w[r] . x[j].
+/// The weights are read in cache-sized blocks shared by all vectors; every
+/// output is summed in the same order as vad_kernel_gemv().
+/// @param x n input vectors of cols floats
+/// @param bias Optional bias (NULL for none)
+/// @param y n output vectors of rows floats
+void vad_kernel_gemm(const float *w, const float *const *x, const float *bias, float *const *y, int32_t rows,
+                     int32_t cols, int32_t n);
+
+/// 1D convolution with kernel size 3, padding 1 and ReLU, matching PyTorch Conv1d.
+/// @param input Input [in_channels][in_length]
+/// @param weight Weights [out_channels][in_channels][3]
+/// @param bias Bias [out_channels]
+/// @param output Output [out_channels][out_length], out_length = (in_length - 1) / stride + 1
+/// @param column Scratch of in_channels * 3 floats
+void vad_kernel_conv1d_k3_relu(const float *input, int32_t in_channels, int32_t in_length,
+                               const float *weight, const float *bias, int32_t out_channels,
+                               int32_t stride, float *output, float *column);
+
+/// Quantize a vector to int8 values with one symmetric scale: x[i] ~= q[i] * scale.
+/// Values are stored in int16 lanes so that the dot products below widen
+/// straight into int32 (pmaddwd / smlal) instead of unpacking bytes first.
+/// @return Scale (0 for an all-zero vector)
+float vad_kernel_quantize(const float *x, int16_t *q, int32_t n);
+
+/// Dot product of two quantized vectors, accumulated in int32
+int32_t vad_kernel_dot_q8(const int16_t *a, const int16_t *b, int32_t n);
+
+/// Matrix-vector product with int8 weights and input:
+/// y[r] = bias[r] + w_scale[r] * x_scale * sum_c w[r * cols + c] * x[c]
+/// @param w_scale Scale of each weight row
+/// @param bias Optional bias (NULL for none)
+void vad_kernel_gemv_q8(const int16_t *w, const float *w_scale, const int16_t *x, float x_scale, const float *bias,
+                        float *y, int32_t rows, int32_t cols);
+
+/// vad_kernel_gemm() with int8 weights and inputs, each input with its own scale
+/// @param x_scale n input scales
+void vad_kernel_gemm_q8(const int16_t *w, const float *w_scale, const int16_t *const *x, const float *x_scale,
+                        const float *bias, float *const *y, int32_t rows, int32_t cols, int32_t n);
+
+/// vad_kernel_conv1d_k3_relu() with int8 weights; each receptive field is
+/// quantized on the fly
+/// @param weight_scale Scale of each output channel
+/// @param column Scratch of in_channels * 3 floats
+/// @param column_q8 Scratch of in_channels * 3 int16 lanes
+void vad_kernel_conv1d_k3_relu_q8(const float *input, int32_t in_channels, int32_t in_length,
+                                  const int16_t *weight, const float *weight_scale, const float *bias,
+                                  int32_t out_channels, int32_t stride, float *output, float *column,
+                                  int16_t *column_q8);
+
+/// Logistic sigmoid
+float vad_kernel_sigmoid(float x);
+
+/// PyTorch LSTMCell update from precomputed gates (i, f, g, o blocks of hidden_size).
+/// Updates h and c in place.
+void vad_kernel_lstm_cell(const float *gates, float *h, float *c, int32_t hidden_size);
+
+#endif /* VAD_KERNELS_H */
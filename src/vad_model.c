@@ -0,0 +1,923 @@
+#include "vad_model.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vad_kernels.h"
+#include "vad_onnx.h"
+#include "vad_platform.h"
+
+// ============================================================================
+// Architecture Constants
+// ============================================================================
+
+// Encoder strides of the v6 reparameterized conv blocks
+static const int32_t kEncoderStrides[VAD_MODEL_ENCODER_LAYERS] = {1, 2, 2, 1};
+
+// Largest 16kHz shapes: 576 input + 64 reflect pad, 4 STFT frames of 129 bins
+#define MAX_PADDED 640
+#define MAX_SPECTRUM 258
+#define MAX_STFT_FRAMES 4
+#define MAX_FEATURES (129 * MAX_STFT_FRAMES)
+#define MAX_COLUMN (129 * 3)
+#define MAX_GATES (4 * VAD_MODEL_HIDDEN_SIZE)
+
+// ============================================================================
+// Weight Discovery
+// ============================================================================
+
+enum
+{
+  W_STFT_BASIS,
+  W_ENCODER0_WEIGHT,
+  W_ENCODER1_WEIGHT,
+  W_ENCODER2_WEIGHT,
+  W_ENCODER3_WEIGHT,
+  W_ENCODER0_BIAS,
+  W_ENCODER1_BIAS,
+  W_ENCODER2_BIAS,
+  W_ENCODER3_BIAS,
+  W_LSTM_WEIGHT_IH,
+  W_LSTM_WEIGHT_HH,
+  W_LSTM_BIAS_IH,
+  W_LSTM_BIAS_HH,
+  W_DECODER_WEIGHT,
+  W_DECODER_BIAS,
+  W_COUNT
+};
+
+// Tensor names as exported by silero-vad; each sample rate branch of the
+// graph prefixes them differently (e.g. "If_0_then_branch__Inline_0__")
+static const char *const kWeightNames[W_COUNT] = {
+    "stft.forward_basis_buffer",
+    "encoder.0.reparam_conv.weight",
+    "encoder.1.reparam_conv.weight",
+    "encoder.2.reparam_conv.weight",
+    "encoder.3.reparam_conv.weight",
+    "encoder.0.reparam_conv.bias",
+    "encoder.1.reparam_conv.bias",
+    "encoder.2.reparam_conv.bias",
+    "encoder.3.reparam_conv.bias",
+    "decoder.rnn.weight_ih",
+    "decoder.rnn.weight_hh",
+    "decoder.rnn.bias_ih",
+    "decoder.rnn.bias_hh",
+    "decoder.decoder.2.weight",
+    "decoder.decoder.2.bias",
+};
+
+// Weights that run through the int8 kernels when the model stores them quantized
+#define INT8_WEIGHTS                                                                                               \
+  ((1u << W_ENCODER0_WEIGHT) | (1u << W_ENCODER1_WEIGHT) | (1u << W_ENCODER2_WEIGHT) | (1u << W_ENCODER3_WEIGHT) | \
+   (1u << W_LSTM_WEIGHT_IH) | (1u << W_LSTM_WEIGHT_HH))
+
+#define MAX_BRANCHES 4
+
+// Quantized weights are stored as three tensors named after the float one
+enum
+{
+  PART_VALUE,
+  PART_QUANTIZED,
+  PART_SCALE,
+  PART_ZERO_POINT,
+  PART_COUNT
+};
+
+static const char *const kPartSuffixes[PART_COUNT] = {"", "_quantized", "_scale", "_zero_point"};
+
+typedef struct WeightBranch
+{
+  const char *prefix;
+  size_t prefix_length;
+  VADOnnxTensor tensors[W_COUNT];
+  uint32_t found;
+  /// Parts of quantized weights, folded into tensors by dequantize_branch()
+  VADOnnxTensor parts[PART_COUNT][W_COUNT];
+  uint32_t found_parts[PART_COUNT];
+  /// Weights that were stored quantized, and their dequantized values
+  uint32_t quantized;
+  float *dequantized[W_COUNT];
+} WeightBranch;
+
+typedef struct WeightCollector
+{
+  WeightBranch branches[MAX_BRANCHES];
+  int32_t branch_count;
+} WeightCollector;
+
+static int32_t accepted_type(const VADOnnxTensor *tensor, int32_t part)
+{
+  if (part == PART_QUANTIZED || part == PART_ZERO_POINT)
+    return tensor->data_type == VAD_ONNX_INT8 || tensor->data_type == VAD_ONNX_UINT8;
+  return tensor->data_type == VAD_ONNX_FLOAT;
+}
+
+static void collect_tensor(const VADOnnxTensor *tensor, void *user_data)
+{
+  WeightCollector *collector = (WeightCollector *)user_data;
+  if (tensor->data == NULL)
+    return;
+
+  // Strip the quantization suffix, if any, before matching the weight name
+  int32_t part = PART_VALUE;
+  VADOnnxTensor base = *tensor;
+  for (int32_t p = PART_COUNT - 1; p > PART_VALUE; p--)
+  {
+    if (vad_onnx_name_ends_with(tensor, kPartSuffixes[p]))
+    {
+      part = p;
+      base.name_length -= strlen(kPartSuffixes[p]);
+      break;
+    }
+  }
+  if (!accepted_type(tensor, part))
+    return;
+
+  for (int32_t w = 0; w < W_COUNT; w++)
+  {
+    if (!vad_onnx_name_ends_with(&base, kWeightNames[w]))
+      continue;
+
+    const char *prefix = base.name;
+    size_t prefix_length = base.name_length - strlen(kWeightNames[w]);
+
+    WeightBranch *branch = NULL;
+    for (int32_t b = 0; b < collector->branch_count; b++)
+    {
+      WeightBranch *candidate = &collector->branches[b];
+      if (candidate->prefix_length == prefix_length && memcmp(candidate->prefix, prefix, prefix_length) == 0)
+      {
+        branch = candidate;
+        break;
+      }
+    }
+    if (branch == NULL)
+    {
+      if (collector->branch_count >= MAX_BRANCHES)
+        return;
+      branch = &collector->branches[collector->branch_count++];
+      branch->prefix = prefix;
+      branch->prefix_length = prefix_length;
+    }
+
+    if (part == PART_VALUE)
+    {
+      branch->tensors[w] = *tensor;
+      branch->found |= 1u << w;
+    }
+    else
+    {
+      branch->parts[part][w] = *tensor;
+      branch->found_parts[part] |= 1u << w;
+    }
+    return;
+  }
+}
+
+static float quantized_at(const VADOnnxTensor *tensor, int64_t index)
+{
+  uint8_t byte = tensor->data[index];
+  return tensor->data_type == VAD_ONNX_INT8 ? (float)(int8_t)byte : (float)byte;
+}
+
+/// Dequantize one weight: (q - zero_point) * scale, with the scale and zero
+/// point either per tensor or per slice along axis 0
+/// @param values Receives the dequantized values (malloc'd)
+/// @return 0 on success, -1 if the parts are inconsistent, -2 when out of memory
+static int32_t dequantize_weight(const VADOnnxTensor *quantized, const VADOnnxTensor *scale,
+                                 const VADOnnxTensor *zero_point, float **values)
+{
+  int64_t count = vad_onnx_tensor_elements(quantized);
+  int64_t channels = vad_onnx_tensor_elements(scale);
+  if (quantized->rank < 1 || count <= 0 || quantized->data_length < (size_t)count)
+    return -1;
+  if (channels != 1 && (scale->rank != 1 || channels != quantized->dims[0]))
+    return -1;
+  if (scale->data_length < (size_t)channels * sizeof(float))
+    return -1;
+  if (zero_point != NULL && (zero_point->data_type != quantized->data_type ||
+                             vad_onnx_tensor_elements(zero_point) != channels ||
+                             zero_point->data_length < (size_t)channels))
+    return -1;
+
+  float *result = (float *)malloc((size_t)count * sizeof(float));
+  if (result == NULL)
+    return -2;
+
+  int64_t per_channel = count / channels;
+  for (int64_t c = 0; c < channels; c++)
+  {
+    float step;
+    memcpy(&step, scale->data + c * sizeof(float), sizeof(float));
+    float zero = zero_point != NULL ? quantized_at(zero_point, c) : 0.0f;
+    for (int64_t i = c * per_channel; i < (c + 1) * per_channel; i++)
+      result[i] = (quantized_at(quantized, i) - zero) * step;
+  }
+  *values = result;
+  return 0;
+}
+
+/// Replace every quantized weight of a branch by a float tensor over its
+/// dequantized values, so shape checks and packing see a plain fp32 model
+/// @return 0 on success, -1 on inconsistent parts, -2 when out of memory
+static int32_t dequantize_branch(WeightBranch *branch)
+{
+  for (int32_t w = 0; w < W_COUNT; w++)
+  {
+    uint32_t bit = 1u << w;
+    if ((branch->found & bit) != 0 || (branch->found_parts[PART_QUANTIZED] & bit) == 0)
+      continue;
+    if ((branch->found_parts[PART_SCALE] & bit) == 0)
+      return -1;
+
+    const VADOnnxTensor *quantized = &branch->parts[PART_QUANTIZED][w];
+    const VADOnnxTensor *zero_point =
+        (branch->found_parts[PART_ZERO_POINT] & bit) != 0 ? &branch->parts[PART_ZERO_POINT][w] : NULL;
+    float *values;
+    int32_t status = dequantize_weight(quantized, &branch->parts[PART_SCALE][w], zero_point, &values);
+    if (status != 0)
+      return status;
+
+    VADOnnxTensor *tensor = &branch->tensors[w];
+    *tensor = *quantized;
+    tensor->data_type = VAD_ONNX_FLOAT;
+    tensor->data = (const uint8_t *)values;
+    tensor->data_length = (size_t)vad_onnx_tensor_elements(quantized) * sizeof(float);
+    branch->dequantized[w] = values;
+    branch->found |= bit;
+    branch->quantized |= bit;
+  }
+  return 0;
+}
+
+static void free_collector(WeightCollector *collector)
+{
+  for (int32_t b = 0; b < collector->branch_count; b++)
+  {
+    for (int32_t w = 0; w < W_COUNT; w++)
+      free(collector->branches[b].dequantized[w]);
+  }
+  free(collector);
+}
+
+static int32_t tensor_is(const VADOnnxTensor *tensor, int32_t rank, int64_t d0, int64_t d1, int64_t d2)
+{
+  const int64_t dims[3] = {d0, d1, d2};
+  if (tensor->rank != rank)
+    return 0;
+  for (int32_t i = 0; i < rank; i++)
+  {
+    if (tensor->dims[i] != dims[i])
+      return 0;
+  }
+  return tensor->data_length >= (size_t)vad_onnx_tensor_elements(tensor) * sizeof(float);
+}
+
+/// Validate a branch and fill shape information into rate (pointers are set later)
+static int32_t describe_branch(const WeightBranch *branch, VADModelRate *rate)
+{
+  const int32_t hidden = VAD_MODEL_HIDDEN_SIZE;
+  const VADOnnxTensor *t = branch->tensors;
+
+  if (branch->found != (1u << W_COUNT) - 1)
+    return -1;
+
+  const VADOnnxTensor *basis = &t[W_STFT_BASIS];
+  if (basis->rank != 3 || basis->dims[1] != 1)
+    return -1;
+
+  memset(rate, 0, sizeof(*rate));
+  rate->n_fft = (int32_t)basis->dims[2];
+  rate->bins = rate->n_fft / 2 + 1;
+  rate->hop_length = rate->n_fft / 2;
+  if (!tensor_is(basis, 3, 2 * rate->bins, 1, rate->n_fft))
+    return -1;
+
+  if (rate->n_fft == 256)
+  {
+    rate->sample_rate = 16000;
+    rate->frame_samples = 512;
+    rate->context_size = 64;
+  }
+  else if (rate->n_fft == 128)
+  {
+    rate->sample_rate = 8000;
+    rate->frame_samples = 256;
+    rate->context_size = 32;
+  }
+  else
+  {
+    return -1;
+  }
+
+  // Inference runs each layer in fixed-size scratch (MAX_COLUMN for one
+  // im2col column, MAX_FEATURES for the layer output), so wider layers are
+  // rejected here rather than overflowing it
+  int32_t channels = rate->bins;
+  int32_t steps = (rate->context_size + rate->frame_samples + rate->n_fft / 4 - rate->n_fft) / rate->hop_length + 1;
+  for (int32_t i = 0; i < VAD_MODEL_ENCODER_LAYERS; i++)
+  {
+    const VADOnnxTensor *weight = &t[W_ENCODER0_WEIGHT + i];
+    if (weight->rank != 3 || weight->dims[0] <= 0 || weight->dims[0] > MAX_FEATURES)
+      return -1;
+    int32_t out_channels = (int32_t)weight->dims[0];
+    if (!tensor_is(weight, 3, out_channels, channels, 3) ||
+        !tensor_is(&t[W_ENCODER0_BIAS + i], 1, out_channels, 0, 0))
+      return -1;
+    steps = (steps - 1) / kEncoderStrides[i] + 1;
+    if (channels * 3 > MAX_COLUMN || out_channels * steps > MAX_FEATURES)
+      return -1;
+
+    rate->encoder[i].in_channels = channels;
+    rate->encoder[i].out_channels = out_channels;
+    rate->encoder[i].stride = kEncoderStrides[i];
+    channels = out_channels;
+  }
+  if (channels != hidden)
+    return -1;
+
+  if (!tensor_is(&t[W_LSTM_WEIGHT_IH], 2, 4 * hidden, hidden, 0) ||
+      !tensor_is(&t[W_LSTM_WEIGHT_HH], 2, 4 * hidden, hidden, 0) ||
+      !tensor_is(&t[W_LSTM_BIAS_IH], 1, 4 * hidden, 0, 0) ||
+      !tensor_is(&t[W_LSTM_BIAS_HH], 1, 4 * hidden, 0, 0) ||
+      !tensor_is(&t[W_DECODER_WEIGHT], 3, 1, hidden, 1) ||
+      !tensor_is(&t[W_DECODER_BIAS], 1, 1, 0, 0))
+    return -1;
+
+  return 0;
+}
+
+/// Floats needed to store a branch, each tensor rounded up to a cache line
+static size_t aligned_floats(size_t count)
+{
+  const size_t line = VAD_ALIGNMENT / sizeof(float);
+  return (count + line - 1) / line * line;
+}
+
+/// Floats needed to store count quantized weights (int16 lanes), rounded up to a cache line
+static size_t aligned_q8(size_t count)
+{
+  return aligned_floats((count * sizeof(int16_t) + sizeof(float) - 1) / sizeof(float));
+}
+
+/// Floats needed to store a weight matrix: float rows, or int8 rows and one scale per row
+static size_t matrix_storage(const VADModelRate *rate, size_t rows, size_t cols)
+{
+  if (rate->quantized)
+    return aligned_q8(rows * cols) + aligned_floats(rows);
+  return aligned_floats(rows * cols);
+}
+
+static size_t branch_storage(const VADModelRate *rate)
+{
+  const size_t hidden = VAD_MODEL_HIDDEN_SIZE;
+  size_t total = aligned_floats((size_t)2 * rate->bins * rate->n_fft);
+  for (int32_t i = 0; i < VAD_MODEL_ENCODER_LAYERS; i++)
+  {
+    total += matrix_storage(rate, (size_t)rate->encoder[i].out_channels, (size_t)rate->encoder[i].in_channels * 3);
+    total += aligned_floats((size_t)rate->encoder[i].out_channels);
+  }
+  total += matrix_storage(rate, 4 * hidden, 2 * hidden);
+  total += aligned_floats(4 * hidden);
+  total += aligned_floats(hidden);
+  return total;
+}
+
+/// Copy little-endian float data (the buffer may be unaligned)
+static float *copy_floats(float *dst, const VADOnnxTensor *tensor, size_t count)
+{
+  memcpy(dst, tensor->data, count * sizeof(float));
+  return dst + aligned_floats(count);
+}
+
+/// Gather row r of a weight matrix. With a second matrix, the rows of both
+/// are placed side by side, each taking half of cols.
+static void read_row(const VADOnnxTensor *first, const VADOnnxTensor *second, int32_t r, int32_t cols, float *row)
+{
+  if (second == NULL)
+  {
+    memcpy(row, first->data + (size_t)r * cols * sizeof(float), (size_t)cols * sizeof(float));
+    return;
+  }
+  int32_t half = cols / 2;
+  memcpy(row, first->data + (size_t)r * half * sizeof(float), (size_t)half * sizeof(float));
+  memcpy(row + half, second->data + (size_t)r * half * sizeof(float), (size_t)half * sizeof(float));
+}
+
+/// Store a weight matrix as float rows, or for quantized branches as int8
+/// rows with one symmetric scale each
+static float *pack_matrix(float *dst, const VADOnnxTensor *first, const VADOnnxTensor *second, int32_t rows,
+                          int32_t cols, const VADModelRate *rate, const float **weight, const int16_t **weight_q8,
+                          const float **scale)
+{
+  if (!rate->quantized)
+  {
+    for (int32_t r = 0; r < rows; r++)
+      read_row(first, second, r, cols, dst + (size_t)r * cols);
+    *weight = dst;
+    return dst + aligned_floats((size_t)rows * cols);
+  }
+
+  // Rows are at most 129 * 3 (encoder.0 at 16kHz) or 2 * hidden (LSTM) wide
+  float row[MAX_COLUMN];
+  int16_t *q8 = (int16_t *)dst;
+  float *scales = dst + aligned_q8((size_t)rows * cols);
+  for (int32_t r = 0; r < rows; r++)
+  {
+    read_row(first, second, r, cols, row);
+    scales[r] = vad_kernel_quantize(row, q8 + (size_t)r * cols, cols);
+  }
+  *weight_q8 = q8;
+  *scale = scales;
+  return scales + aligned_floats((size_t)rows);
+}
+
+/// Copy branch weights into storage and point rate at them
+static float *pack_branch(float *dst, const WeightBranch *branch, VADModelRate *rate)
+{
+  const int32_t hidden = VAD_MODEL_HIDDEN_SIZE;
+  const VADOnnxTensor *t = branch->tensors;
+
+  rate->stft_basis = dst;
+  dst = copy_floats(dst, &t[W_STFT_BASIS], (size_t)2 * rate->bins * rate->n_fft);
+
+  for (int32_t i = 0; i < VAD_MODEL_ENCODER_LAYERS; i++)
+  {
+    VADModelConv *conv = &rate->encoder[i];
+    dst = pack_matrix(dst, &t[W_ENCODER0_WEIGHT + i], NULL, conv->out_channels, conv->in_channels * 3, rate,
+                      &conv->weight, &conv->weight_q8, &conv->weight_scale);
+    conv->bias = dst;
+    dst = copy_floats(dst, &t[W_ENCODER0_BIAS + i], (size_t)conv->out_channels);
+  }
+
+  // Interleave input and recurrent weights per gate row so a single gemv
+  // over [x; h] produces all four gates
+  dst = pack_matrix(dst, &t[W_LSTM_WEIGHT_IH], &t[W_LSTM_WEIGHT_HH], 4 * hidden, 2 * hidden, rate,
+                    &rate->lstm_weight, &rate->lstm_weight_q8, &rate->lstm_scale);
+
+  float *lstm_bias = dst;
+  for (int32_t r = 0; r < 4 * hidden; r++)
+  {
+    float bias_ih;
+    float bias_hh;
+    memcpy(&bias_ih, t[W_LSTM_BIAS_IH].data + r * sizeof(float), sizeof(float));
+    memcpy(&bias_hh, t[W_LSTM_BIAS_HH].data + r * sizeof(float), sizeof(float));
+    lstm_bias[r] = bias_ih + bias_hh;
+  }
+  rate->lstm_bias = lstm_bias;
+  dst += aligned_floats((size_t)4 * hidden);
+
+  rate->decoder_weight = dst;
+  dst = copy_floats(dst, &t[W_DECODER_WEIGHT], (size_t)hidden);
+  memcpy(&rate->decoder_bias, t[W_DECODER_BIAS].data, sizeof(float));
+
+  return dst;
+}
+
+// ============================================================================
+// Loading
+// ============================================================================
+
+/// FNV-1a over the packed weights (alignment gaps are zeroed)
+static uint64_t fingerprint(const float *storage, size_t count)
+{
+  const uint32_t *words = (const uint32_t *)storage;
+  uint64_t hash = 14695981039346656037ull;
+  for (size_t i = 0; i < count; i++)
+  {
+    hash ^= words[i];
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+int32_t vad_model_load_buffer(VADModel *model, const void *data, size_t length, char *error, size_t error_size)
+{
+  memset(model, 0, sizeof(*model));
+
+  WeightCollector *collector = (WeightCollector *)calloc(1, sizeof(WeightCollector));
+  if (collector == NULL)
+  {
+    snprintf(error, error_size, "Out of memory while loading model");
+    return -2;
+  }
+
+  if (vad_onnx_visit_tensors((const uint8_t *)data, length, collect_tensor, collector) != 0)
+  {
+    free_collector(collector);
+    snprintf(error, error_size, "Model is not a valid ONNX file");
+    return -2;
+  }
+
+  // Classify the branches found in the graph by their STFT size
+  const WeightBranch *sources[2] = {NULL, NULL};
+  VADModelRate rates[2];
+  for (int32_t b = 0; b < collector->branch_count; b++)
+  {
+    int32_t status = dequantize_branch(&collector->branches[b]);
+    if (status == -2)
+    {
+      free_collector(collector);
+      snprintf(error, error_size, "Out of memory while loading model");
+      return -2;
+    }
+
+    VADModelRate rate;
+    if (status != 0 || describe_branch(&collector->branches[b], &rate) != 0)
+      continue;
+    rate.quantized = (collector->branches[b].quantized & INT8_WEIGHTS) != 0;
+    int32_t slot = rate.sample_rate == 16000 ? 0 : 1;
+    if (sources[slot] == NULL)
+    {
+      sources[slot] = &collector->branches[b];
+      rates[slot] = rate;
+    }
+  }
+
+  if (sources[0] == NULL && sources[1] == NULL)
+  {
+    free_collector(collector);
+    snprintf(error, error_size, "Model does not contain Silero VAD v6 weights");
+    return -2;
+  }
+
+  size_t total = 0;
+  for (int32_t slot = 0; slot < 2; slot++)
+  {
+    if (sources[slot] != NULL)
+      total += branch_storage(&rates[slot]);
+  }
+
+  model->storage = (float *)vad_aligned_alloc(total * sizeof(float));
+  if (model->storage == NULL)
+  {
+    free_collector(collector);
+    snprintf(error, error_size, "Out of memory while loading model");
+    return -2;
+  }
+  model->storage_size = total * sizeof(float);
+  memset(model->storage, 0, model->storage_size);
+
+  float *dst = model->storage;
+  for (int32_t slot = 0; slot < 2; slot++)
+  {
+    if (sources[slot] == NULL)
+      continue;
+    dst = pack_branch(dst, sources[slot], &rates[slot]);
+    if (slot == 0)
+      model->rate_16k = rates[slot];
+    else
+      model->rate_8k = rates[slot];
+  }
+  model->fingerprint = fingerprint(model->storage, total);
+
+  free_collector(collector);
+  return 0;
+}
+
+int32_t vad_model_read_file(const char *path, void **data, size_t *length, char *error, size_t error_size)
+{
+  *data = NULL;
+  *length = 0;
+
+  FILE *file = fopen(path, "rb");
+  if (file == NULL)
+  {
+    snprintf(error, error_size, "Model file does not exist: %s", path);
+    return -2;
+  }
+
+  long size = -1;
+  if (fseek(file, 0, SEEK_END) == 0)
+    size = ftell(file);
+  if (size <= 0 || fseek(file, 0, SEEK_SET) != 0)
+  {
+    fclose(file);
+    snprintf(error, error_size, "Model file is empty or unreadable: %s", path);
+    return -2;
+  }
+
+  void *bytes = malloc((size_t)size);
+  if (bytes == NULL)
+  {
+    fclose(file);
+    snprintf(error, error_size, "Out of memory while reading model");
+    return -2;
+  }
+
+  size_t read = fread(bytes, 1, (size_t)size, file);
+  fclose(file);
+  if (read != (size_t)size)
+  {
+    free(bytes);
+    snprintf(error, error_size, "Failed to read model file: %s", path);
+    return -2;
+  }
+
+  *data = bytes;
+  *length = (size_t)size;
+  return 0;
+}
+
+int32_t vad_model_load_file(VADModel *model, const char *path, char *error, size_t error_size)
+{
+  memset(model, 0, sizeof(*model));
+
+  void *data;
+  size_t length;
+  int32_t result = vad_model_read_file(path, &data, &length, error, error_size);
+  if (result != 0)
+    return result;
+
+  result = vad_model_load_buffer(model, data, length, error, error_size);
+  free(data);
+  return result;
+}
+
+void vad_model_free(VADModel *model)
+{
+  if (model == NULL)
+    return;
+  vad_aligned_free(model->storage);
+  memset(model, 0, sizeof(*model));
+}
+
+const VADModelRate *vad_model_get_rate(const VADModel *model, int32_t sample_rate)
+{
+  if (sample_rate == 16000 && model->rate_16k.sample_rate != 0)
+    return &model->rate_16k;
+  if (sample_rate == 8000 && model->rate_8k.sample_rate != 0)
+    return &model->rate_8k;
+  return NULL;
+}
+
+// ============================================================================
+// Inference
+// ============================================================================
+
+float vad_model_infer(const VADModelRate *rate, const float *input, float *state)
+{
+  const int32_t hidden = VAD_MODEL_HIDDEN_SIZE;
+  float padded[MAX_PADDED];
+  float spectrum[MAX_SPECTRUM];
+  float features[MAX_FEATURES];
+  float column[MAX_COLUMN];
+  int16_t column_q8[MAX_COLUMN];
+  float buffer_a[MAX_FEATURES];
+  float buffer_b[MAX_FEATURES];
+  float lstm_input[2 * VAD_MODEL_HIDDEN_SIZE];
+  int16_t lstm_input_q8[2 * VAD_MODEL_HIDDEN_SIZE];
+  float gates[MAX_GATES];
+
+  // STFT front end: reflect-pad the right edge by n_fft / 4
+  int32_t length = rate->context_size + rate->frame_samples;
+  int32_t pad = rate->n_fft / 4;
+  memcpy(padded, input, (size_t)length * sizeof(float));
+  for (int32_t k = 0; k < pad; k++)
+    padded[length + k] = input[length - 2 - k];
+
+  int32_t frames = (length + pad - rate->n_fft) / rate->hop_length + 1;
+  for (int32_t t = 0; t < frames; t++)
+  {
+    vad_kernel_gemv(rate->stft_basis, padded + t * rate->hop_length, NULL, spectrum, 2 * rate->bins, rate->n_fft);
+    for (int32_t b = 0; b < rate->bins; b++)
+    {
+      float re = spectrum[b];
+      float im = spectrum[rate->bins + b];
+      features[b * frames + t] = sqrtf(re * re + im * im);
+    }
+  }
+
+  // Encoder: four conv + ReLU blocks reduce [bins][4] to [128][1]
+  const float *x = features;
+  int32_t steps = frames;
+  for (int32_t i = 0; i < VAD_MODEL_ENCODER_LAYERS; i++)
+  {
+    const VADModelConv *conv = &rate->encoder[i];
+    float *out = (i % 2 == 0) ? buffer_a : buffer_b;
+    if (rate->quantized)
+      vad_kernel_conv1d_k3_relu_q8(x, conv->in_channels, steps, conv->weight_q8, conv->weight_scale, conv->bias,
+                                   conv->out_channels, conv->stride, out, column, column_q8);
+    else
+      vad_kernel_conv1d_k3_relu(x, conv->in_channels, steps, conv->weight, conv->bias, conv->out_channels,
+                                conv->stride, out, column);
+    steps = (steps - 1) / conv->stride + 1;
+    x = out;
+  }
+
+  // Decoder LSTM cell over [x; h]
+  float *h = state;
+  float *c = state + hidden;
+  memcpy(lstm_input, x, (size_t)hidden * sizeof(float));
+  memcpy(lstm_input + hidden, h, (size_t)hidden * sizeof(float));
+  if (rate->quantized)
+  {
+    float input_scale = vad_kernel_quantize(lstm_input, lstm_input_q8, 2 * hidden);
+    vad_kernel_gemv_q8(rate->lstm_weight_q8, rate->lstm_scale, lstm_input_q8, input_scale, rate->lstm_bias, gates,
+                       4 * hidden, 2 * hidden);
+  }
+  else
+  {
+    vad_kernel_gemv(rate->lstm_weight, lstm_input, rate->lstm_bias, gates, 4 * hidden, 2 * hidden);
+  }
+  vad_kernel_lstm_cell(gates, h, c, hidden);
+
+  // Output head: ReLU -> 1x1 conv -> sigmoid
+  float logit = rate->decoder_bias;
+  for (int32_t j = 0; j < hidden; j++)
+    logit += rate->decoder_weight[j] * (h[j] > 0.0f ? h[j] : 0.0f);
+  return vad_kernel_sigmoid(logit);
+}
+
+// Streams per batched pass. Bounds the scratch size while still reusing each
+// weight row across many streams.
+#define BATCH_CHUNK 16
+
+// Per-stream scratch of the batched pass, activations stored time-major ([t][c])
+#define BATCH_SPECTRUM (MAX_SPECTRUM * MAX_STFT_FRAMES)
+#define BATCH_COLUMNS (MAX_COLUMN * MAX_STFT_FRAMES)
+// Quantized copies of the columns and LSTM inputs (int16 lanes), in floats
+#define BATCH_COLUMNS_Q8 ((BATCH_COLUMNS + 2 * VAD_MODEL_HIDDEN_SIZE + 1) / 2)
+#define BATCH_STREAM_FLOATS                                                                                   \
+  (MAX_PADDED + BATCH_SPECTRUM + MAX_FEATURES + BATCH_COLUMNS + 2 * MAX_FEATURES + 2 * VAD_MODEL_HIDDEN_SIZE + \
+   MAX_GATES + BATCH_COLUMNS_Q8)
+
+typedef struct BatchScratch
+{
+  float *padded;
+  float *spectrum;
+  float *features;
+  float *columns;
+  float *buffer_a;
+  float *buffer_b;
+  float *lstm_input;
+  float *gates;
+  int16_t *columns_q8;
+  int16_t *lstm_input_q8;
+} BatchScratch;
+
+static BatchScratch batch_scratch(float *base)
+{
+  BatchScratch s;
+  s.padded = base;
+  s.spectrum = s.padded + MAX_PADDED;
+  s.features = s.spectrum + BATCH_SPECTRUM;
+  s.columns = s.features + MAX_FEATURES;
+  s.buffer_a = s.columns + BATCH_COLUMNS;
+  s.buffer_b = s.buffer_a + MAX_FEATURES;
+  s.lstm_input = s.buffer_b + MAX_FEATURES;
+  s.gates = s.lstm_input + 2 * VAD_MODEL_HIDDEN_SIZE;
+  s.columns_q8 = (int16_t *)(s.gates + MAX_GATES);
+  s.lstm_input_q8 = s.columns_q8 + BATCH_COLUMNS;
+  return s;
+}
+
+static void infer_chunk(const VADModelRate *rate, const float *const *inputs, float *const *states, int32_t count,
+                        float *probabilities, float *workspace)
+{
+  const int32_t hidden = VAD_MODEL_HIDDEN_SIZE;
+  BatchScratch scratch[BATCH_CHUNK];
+  const float *x_ptrs[BATCH_CHUNK * MAX_STFT_FRAMES];
+  float *y_ptrs[BATCH_CHUNK * MAX_STFT_FRAMES];
+  const int16_t *q8_ptrs[BATCH_CHUNK * MAX_STFT_FRAMES];
+  float q8_scales[BATCH_CHUNK * MAX_STFT_FRAMES];
+
+  for (int32_t n = 0; n < count; n++)
+    scratch[n] = batch_scratch(workspace + (size_t)n * BATCH_STREAM_FLOATS);
+
+  // STFT front end, one column per (stream, frame)
+  int32_t length = rate->context_size + rate->frame_samples;
+  int32_t pad = rate->n_fft / 4;
+  int32_t frames = (length + pad - rate->n_fft) / rate->hop_length + 1;
+  int32_t spectrum_size = 2 * rate->bins;
+  for (int32_t n = 0; n < count; n++)
+  {
+    memcpy(scratch[n].padded, inputs[n], (size_t)length * sizeof(float));
+    for (int32_t k = 0; k < pad; k++)
+      scratch[n].padded[length + k] = inputs[n][length - 2 - k];
+    for (int32_t t = 0; t < frames; t++)
+    {
+      x_ptrs[n * frames + t] = scratch[n].padded + t * rate->hop_length;
+      y_ptrs[n * frames + t] = scratch[n].spectrum + t * spectrum_size;
+    }
+  }
+  vad_kernel_gemm(rate->stft_basis, x_ptrs, NULL, y_ptrs, spectrum_size, rate->n_fft, count * frames);
+
+  for (int32_t n = 0; n < count; n++)
+  {
+    for (int32_t t = 0; t < frames; t++)
+    {
+      const float *spectrum = scratch[n].spectrum + t * spectrum_size;
+      for (int32_t b = 0; b < rate->bins; b++)
+      {
+        float re = spectrum[b];
+        float im = spectrum[rate->bins + b];
+        scratch[n].features[t * rate->bins + b] = sqrtf(re * re + im * im);
+      }
+    }
+  }
+
+  // Encoder: gather each receptive field into a column, one GEMM per layer
+  int32_t steps = frames;
+  for (int32_t i = 0; i < VAD_MODEL_ENCODER_LAYERS; i++)
+  {
+    const VADModelConv *conv = &rate->encoder[i];
+    int32_t cin = conv->in_channels;
+    int32_t out_steps = (steps - 1) / conv->stride + 1;
+
+    for (int32_t n = 0; n < count; n++)
+    {
+      const float *in = i == 0 ? scratch[n].features : ((i % 2 == 1) ? scratch[n].buffer_a : scratch[n].buffer_b);
+      float *out = (i % 2 == 0) ? scratch[n].buffer_a : scratch[n].buffer_b;
+      for (int32_t t = 0; t < out_steps; t++)
+      {
+        float *column = scratch[n].columns + t * cin * 3;
+        int32_t start = t * conv->stride - 1;
+        for (int32_t ci = 0; ci < cin; ci++)
+        {
+          for (int32_t k = 0; k < 3; k++)
+          {
+            int32_t pos = start + k;
+            column[ci * 3 + k] = (pos >= 0 && pos < steps) ? in[pos * cin + ci] : 0.0f;
+          }
+        }
+        x_ptrs[n * out_steps + t] = column;
+        y_ptrs[n * out_steps + t] = out + t * conv->out_channels;
+        if (rate->quantized)
+        {
+          int16_t *column_q8 = scratch[n].columns_q8 + t * cin * 3;
+          q8_ptrs[n * out_steps + t] = column_q8;
+          q8_scales[n * out_steps + t] = vad_kernel_quantize(column, column_q8, cin * 3);
+        }
+      }
+    }
+
+    if (rate->quantized)
+      vad_kernel_gemm_q8(conv->weight_q8, conv->weight_scale, q8_ptrs, q8_scales, conv->bias, y_ptrs,
+                         conv->out_channels, cin * 3, count * out_steps);
+    else
+      vad_kernel_gemm(conv->weight, x_ptrs, conv->bias, y_ptrs, conv->out_channels, cin * 3, count * out_steps);
+    for (int32_t j = 0; j < count * out_steps; j++)
+    {
+      for (int32_t co = 0; co < conv->out_channels; co++)
+        y_ptrs[j][co] = y_ptrs[j][co] > 0.0f ? y_ptrs[j][co] : 0.0f;
+    }
+    steps = out_steps;
+  }
+
+  // Decoder LSTM cell over [x; h] for every stream at once
+  for (int32_t n = 0; n < count; n++)
+  {
+    const float *encoded = (VAD_MODEL_ENCODER_LAYERS % 2 == 0) ? scratch[n].buffer_b : scratch[n].buffer_a;
+    memcpy(scratch[n].lstm_input, encoded, (size_t)hidden * sizeof(float));
+    memcpy(scratch[n].lstm_input + hidden, states[n], (size_t)hidden * sizeof(float));
+    x_ptrs[n] = scratch[n].lstm_input;
+    y_ptrs[n] = scratch[n].gates;
+    if (rate->quantized)
+    {
+      q8_ptrs[n] = scratch[n].lstm_input_q8;
+      q8_scales[n] = vad_kernel_quantize(scratch[n].lstm_input, scratch[n].lstm_input_q8, 2 * hidden);
+    }
+  }
+  if (rate->quantized)
+    vad_kernel_gemm_q8(rate->lstm_weight_q8, rate->lstm_scale, q8_ptrs, q8_scales, rate->lstm_bias, y_ptrs,
+                       4 * hidden, 2 * hidden, count);
+  else
+    vad_kernel_gemm(rate->lstm_weight, x_ptrs, rate->lstm_bias, y_ptrs, 4 * hidden, 2 * hidden, count);
+
+  for (int32_t n = 0; n < count; n++)
+  {
+    float *h = states[n];
+    float *c = states[n] + hidden;
+    vad_kernel_lstm_cell(scratch[n].gates, h, c, hidden);
+
+    // Output head: ReLU -> 1x1 conv -> sigmoid
+    float logit = rate->decoder_bias;
+    for (int32_t j = 0; j < hidden; j++)
+      logit += rate->decoder_weight[j] * (h[j] > 0.0f ? h[j] : 0.0f);
+    probabilities[n] = vad_kernel_sigmoid(logit);
+  }
+}
+
+int32_t vad_model_infer_batch(const VADModelRate *rate, const float *const *inputs, float *const *states,
+                              int32_t count, float *probabilities)
+{
+  if (count <= 0)
+    return 0;
+
+  int32_t chunk = count < BATCH_CHUNK ? count : BATCH_CHUNK;
+  float *workspace = (float *)vad_aligned_alloc((size_t)chunk * BATCH_STREAM_FLOATS * sizeof(float));
+  if (workspace == NULL)
+    return -2;
+
+  for (int32_t offset = 0; offset < count; offset += chunk)
+  {
+    int32_t n = count - offset < chunk ? count - offset : chunk;
+    infer_chunk(rate, inputs + offset, states + offset, n, probabilities + offset, workspace);
+  }
+
+  vad_aligned_free(workspace);
+  return 0;
+}
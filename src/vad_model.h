@@ -0,0 +1,128 @@
+#ifndef VAD_MODEL_H
+#define VAD_MODEL_H
+
+// Native Silero VAD v6 model: weight loading from the ONNX file and the
+// forward pass (STFT front end, conv encoder, LSTM cell, output head).
+// Mirrors the ONNX contract used by VADHandleInternal.runInference:
+//   input [1, context + frame], sr, state [2, 1, 128] -> output [1, 1], stateN [2, 1, 128]
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// LSTM hidden size
+#define VAD_MODEL_HIDDEN_SIZE 128
+/// Number of state rows (h and c)
+#define VAD_MODEL_NUM_LAYERS 2
+/// Floats in the recurrent state tensor (2 * 1 * 128)
+#define VAD_MODEL_STATE_SIZE (VAD_MODEL_NUM_LAYERS * VAD_MODEL_HIDDEN_SIZE)
+/// Number of reparameterized conv blocks in the encoder
+#define VAD_MODEL_ENCODER_LAYERS 4
+
+/// One encoder conv block (kernel 3, padding 1, followed by ReLU)
+typedef struct VADModelConv
+{
+    /// Weights [out_channels][in_channels][3], NULL when quantized
+    const float *weight;
+    /// Int8 weights (in int16 lanes) [out_channels][in_channels][3] and one scale per output
+    /// channel, NULL unless the branch is quantized
+    const int16_t *weight_q8;
+    const float *weight_scale;
+    /// Bias [out_channels]
+    const float *bias;
+    int32_t in_channels;
+    int32_t out_channels;
+    int32_t stride;
+} VADModelConv;
+
+/// Weights for one sample rate branch of the model
+typedef struct VADModelRate
+{
+    /// 16000 or 8000, 0 if this branch was not found in the model
+    int32_t sample_rate;
+    /// Samples per frame (512 for 16kHz, 256 for 8kHz)
+    int32_t frame_samples;
+    /// Samples of previous audio prepended to each frame (64 for 16kHz, 32 for 8kHz)
+    int32_t context_size;
+    /// STFT filter length, hop and number of frequency bins
+    int32_t n_fft;
+    int32_t hop_length;
+    int32_t bins;
+    /// STFT basis [2 * bins][n_fft] (real rows then imaginary rows)
+    const float *stft_basis;
+    VADModelConv encoder[VAD_MODEL_ENCODER_LAYERS];
+    /// LSTM weights [4 * hidden][2 * hidden], input and recurrent weights side by side,
+    /// NULL when quantized
+    const float *lstm_weight;
+    /// Int8 LSTM weights (in int16 lanes) in the same layout and one scale per row, NULL unless quantized
+    const int16_t *lstm_weight_q8;
+    const float *lstm_scale;
+    /// LSTM bias [4 * hidden] (bias_ih + bias_hh)
+    const float *lstm_bias;
+    /// Output head weights [hidden] and bias
+    const float *decoder_weight;
+    float decoder_bias;
+    /// Non-zero when the model file stores this branch int8-quantized: the conv
+    /// and LSTM weights then run through the int8 kernels, with activations
+    /// quantized per vector at inference time
+    int32_t quantized;
+} VADModelRate;
+
+/// Loaded model with both sample rate branches
+typedef struct VADModel
+{
+    VADModelRate rate_16k;
+    VADModelRate rate_8k;
+    /// Single aligned allocation holding every weight
+    float *storage;
+    size_t storage_size;
+    /// Hash of the packed weights; equal for models loaded from the same file
+    uint64_t fingerprint;
+} VADModel;
+
+/// Load the model from an ONNX file
+/// Besides the fp32 export, int8-quantized variants are accepted: any weight
+/// stored as <name>_quantized (int8 or uint8, raw_data) with <name>_scale and
+/// optionally <name>_zero_point, per tensor or per output channel, as written
+/// by vad_plus_quantize and by ONNX Runtime's static (QDQ) and dynamic quantizers.
+/// @param model Model to fill (zeroed on failure)
+/// @param path Path to silero_vad_v6.onnx
+/// @param error Buffer receiving an error message on failure
+/// @param error_size Size of error buffer
+/// @return 0 on success, negative error code on failure
+int32_t vad_model_load_file(VADModel *model, const char *path, char *error, size_t error_size);
+
+/// Read a model file into memory
+/// @param data Receives the file contents (release with free())
+/// @param length Receives the file size in bytes
+/// @return 0 on success, negative error code on failure
+int32_t vad_model_read_file(const char *path, void **data, size_t *length, char *error, size_t error_size);
+
+/// Load the model from a serialized ONNX buffer (the buffer can be freed afterwards)
+/// @return 0 on success, negative error code on failure
+int32_t vad_model_load_buffer(VADModel *model, const void *data, size_t length, char *error, size_t error_size);
+
+/// Release model weights
+void vad_model_free(VADModel *model);
+
+/// Get the weights for a sample rate
+/// @return Rate weights, or NULL if the model has no branch for sample_rate
+const VADModelRate *vad_model_get_rate(const VADModel *model, int32_t sample_rate);
+
+/// Run one inference step.
+/// @param rate Weights for the configured sample rate
+/// @param input context_size + frame_samples samples
+/// @param state Recurrent state [2][128] (h then c), updated in place
+/// @return Speech probability (0.0 - 1.0)
+float vad_model_infer(const VADModelRate *rate, const float *input, float *state);
+
+/// Run one inference step for several independent streams sharing the same
+/// weights. Each weight row is applied to all streams at once; the results
+/// are summed in the same order as vad_model_infer().
+/// @param inputs count pointers to context_size + frame_samples samples
+/// @param states count pointers to recurrent states, updated in place
+/// @param probabilities Receives count speech probabilities
+/// @return 0 on success, -2 if scratch memory could not be allocated
+int32_t vad_model_infer_batch(const VADModelRate *rate, const float *const *inputs, float *const *states,
+                              int32_t count, float *probabilities);
+
+#endif /* VAD_MODEL_H */
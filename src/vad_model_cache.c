@@ -0,0 +1,205 @@
+#include "vad_model_cache.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <sys/types.h>
+
+#include "vad_platform.h"
+
+typedef struct CacheEntry
+{
+  struct CacheEntry *next;
+  VADModel model;
+  int32_t refs;
+  // Path the model was first loaded from (NULL for a caller's buffer), with
+  // the file size and modification time seen then
+  char *path;
+  uint64_t file_size;
+  int64_t file_time;
+  // Hash and length of the serialized model
+  uint64_t content_hash;
+  size_t content_length;
+} CacheEntry;
+
+static vad_static_mutex_t g_cache_lock = VAD_STATIC_MUTEX_INIT;
+static CacheEntry *g_cache = NULL;
+
+/// Size and modification time of a file
+/// @return 0 on success, -1 if the file cannot be queried
+static int32_t file_identity(const char *path, uint64_t *size, int64_t *time)
+{
+#if _WIN32
+  struct _stat64 info;
+  if (_stat64(path, &info) != 0)
+    return -1;
+#else
+  struct stat info;
+  if (stat(path, &info) != 0)
+    return -1;
+#endif
+  *size = (uint64_t)info.st_size;
+  *time = (int64_t)info.st_mtime;
+  return 0;
+}
+
+/// FNV-1a over 64-bit words (the tail is zero-padded); the buffer may be unaligned
+static uint64_t content_hash(const uint8_t *data, size_t length)
+{
+  uint64_t hash = 14695981039346656037ull;
+  size_t i = 0;
+  for (; i + sizeof(uint64_t) <= length; i += sizeof(uint64_t))
+  {
+    uint64_t word;
+    memcpy(&word, data + i, sizeof(word));
+    hash ^= word;
+    hash *= 1099511628211ull;
+  }
+  if (i < length)
+  {
+    uint64_t word = 0;
+    memcpy(&word, data + i, length - i);
+    hash ^= word;
+    hash *= 1099511628211ull;
+  }
+  return hash;
+}
+
+static CacheEntry *find_by_path(const char *path, uint64_t size, int64_t time)
+{
+  for (CacheEntry *entry = g_cache; entry != NULL; entry = entry->next)
+  {
+    if (entry->path != NULL && entry->file_size == size && entry->file_time == time && strcmp(entry->path, path) == 0)
+      return entry;
+  }
+  return NULL;
+}
+
+static CacheEntry *find_by_content(uint64_t hash, size_t length)
+{
+  for (CacheEntry *entry = g_cache; entry != NULL; entry = entry->next)
+  {
+    if (entry->content_hash == hash && entry->content_length == length)
+      return entry;
+  }
+  return NULL;
+}
+
+static void free_entry(CacheEntry *entry)
+{
+  vad_model_free(&entry->model);
+  free(entry->path);
+  free(entry);
+}
+
+/// Share the cached model with this content, or load and cache it. Called with the lock held.
+/// @param path Path the data was read from, NULL for a caller's buffer
+static int32_t acquire_content(const void *data, size_t length, const char *path, uint64_t file_size,
+                               int64_t file_time, const VADModel **model, char *error, size_t error_size)
+{
+  uint64_t hash = content_hash((const uint8_t *)data, length);
+  CacheEntry *entry = find_by_content(hash, length);
+  if (entry != NULL)
+  {
+    entry->refs++;
+    *model = &entry->model;
+    return 0;
+  }
+
+  entry = (CacheEntry *)calloc(1, sizeof(CacheEntry));
+  size_t path_length = path != NULL ? strlen(path) : 0;
+  if (entry != NULL && path != NULL)
+    entry->path = (char *)malloc(path_length + 1);
+  if (entry == NULL || (path != NULL && entry->path == NULL))
+  {
+    free(entry);
+    snprintf(error, error_size, "Out of memory while loading model");
+    return -2;
+  }
+
+  int32_t result = vad_model_load_buffer(&entry->model, data, length, error, error_size);
+  if (result != 0)
+  {
+    free(entry->path);
+    free(entry);
+    return result;
+  }
+
+  if (path != NULL)
+    memcpy(entry->path, path, path_length + 1);
+  entry->file_size = file_size;
+  entry->file_time = file_time;
+  entry->content_hash = hash;
+  entry->content_length = length;
+  entry->refs = 1;
+  entry->next = g_cache;
+  g_cache = entry;
+
+  *model = &entry->model;
+  return 0;
+}
+
+int32_t vad_model_cache_acquire(const char *path, const VADModel **model, char *error, size_t error_size)
+{
+  *model = NULL;
+
+  // Loading happens under the lock, so concurrent inits of one model load it once
+  vad_static_mutex_lock(&g_cache_lock);
+
+  uint64_t file_size = 0;
+  int64_t file_time = 0;
+  int32_t have_identity = file_identity(path, &file_size, &file_time) == 0;
+  CacheEntry *entry = have_identity ? find_by_path(path, file_size, file_time) : NULL;
+  if (entry != NULL)
+  {
+    entry->refs++;
+    *model = &entry->model;
+    vad_static_mutex_unlock(&g_cache_lock);
+    return 0;
+  }
+
+  void *data;
+  size_t length;
+  int32_t result = vad_model_read_file(path, &data, &length, error, error_size);
+  if (result == 0)
+  {
+    // A model with the same content (another path, or an unchanged file touched since) is shared too
+    result = acquire_content(data, length, path, have_identity ? file_size : 0, have_identity ? file_time : 0, model,
+                             error, error_size);
+    free(data);
+  }
+  vad_static_mutex_unlock(&g_cache_lock);
+  return result;
+}
+
+int32_t vad_model_cache_acquire_buffer(const void *data, size_t length, const VADModel **model, char *error,
+                                       size_t error_size)
+{
+  *model = NULL;
+  vad_static_mutex_lock(&g_cache_lock);
+  int32_t result = acquire_content(data, length, NULL, 0, 0, model, error, error_size);
+  vad_static_mutex_unlock(&g_cache_lock);
+  return result;
+}
+
+void vad_model_cache_release(const VADModel *model)
+{
+  if (model == NULL)
+    return;
+
+  vad_static_mutex_lock(&g_cache_lock);
+  for (CacheEntry **link = &g_cache; *link != NULL; link = &(*link)->next)
+  {
+    CacheEntry *entry = *link;
+    if (&entry->model != model)
+      continue;
+    if (--entry->refs == 0)
+    {
+      *link = entry->next;
+      free_entry(entry);
+    }
+    break;
+  }
+  vad_static_mutex_unlock(&g_cache_lock);
+}
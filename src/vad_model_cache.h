@@ -0,0 +1,32 @@
+#ifndef VAD_MODEL_CACHE_H
+#define VAD_MODEL_CACHE_H
+
+// Process-wide cache of loaded models. Weights are immutable once loaded, so
+// every handle initialized from the same model shares one copy and keeps only
+// its own recurrent state and context. Entries are keyed by model path and
+// content hash (content only for models loaded from memory), and freed with
+// their last reference.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "vad_model.h"
+
+/// Get the model stored in a file, loading it unless a cached model has the
+/// same path (and file size and modification time) or the same content
+/// @param model Receives the shared model; release it with vad_model_cache_release()
+/// @param error Buffer receiving an error message on failure
+/// @return 0 on success, negative error code on failure
+int32_t vad_model_cache_acquire(const char *path, const VADModel **model, char *error, size_t error_size);
+
+/// Get the model serialized in a buffer, loading it unless a cached model has
+/// the same content. The buffer is only read during the call.
+/// @param model Receives the shared model; release it with vad_model_cache_release()
+/// @return 0 on success, negative error code on failure
+int32_t vad_model_cache_acquire_buffer(const void *data, size_t length, const VADModel **model, char *error,
+                                       size_t error_size);
+
+/// Drop a reference taken by either acquire call (NULL is ignored)
+void vad_model_cache_release(const VADModel *model);
+
+#endif /* VAD_MODEL_CACHE_H */
@@ -0,0 +1,269 @@
+#include "vad_offline.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "vad_platform.h"
+#include "vad_segmenter.h"
+
+// Chunks one worker steps together through vad_model_infer_batch(), so each
+// weight row is reused across them
+#define LOCKSTEP_CHUNKS 16
+
+typedef struct OfflineJob
+{
+  const VADModelRate *rate;
+  const VADFile *source;
+  int32_t frame_samples;
+  int32_t context_size;
+  int64_t total_frames;
+  int64_t chunk_frames;
+  int64_t lead_in_frames;
+  int64_t chunk_count;
+  int32_t worker_count;
+  /// One probability per frame, written by whichever worker owns its chunk
+  float *probabilities;
+} OfflineJob;
+
+typedef struct OfflineWorker
+{
+  const OfflineJob *job;
+  int32_t index;
+  int32_t result;
+} OfflineWorker;
+
+/// One chunk in a lockstep group
+typedef struct ChunkStream
+{
+  /// Recurrent state, followed by the [context | frame] input window
+  float *state;
+  float *input;
+  /// First frame run (lead-in included), first frame kept, end of the chunk
+  int64_t first_frame;
+  int64_t output_frame;
+  int64_t end_frame;
+} ChunkStream;
+
+/// Convert one frame of the source, padding with silence past its end
+static void load_frame(const OfflineJob *job, float *dst, int64_t frame)
+{
+  int64_t offset = frame * job->frame_samples;
+  int64_t available = job->source->frames - offset;
+  int32_t count = available < job->frame_samples ? (int32_t)available : job->frame_samples;
+  vad_file_read(job->source, offset, count, dst);
+  if (count < job->frame_samples)
+    memset(dst + count, 0, (size_t)(job->frame_samples - count) * sizeof(float));
+}
+
+static void start_chunk(const OfflineJob *job, ChunkStream *stream, int64_t chunk)
+{
+  stream->output_frame = chunk * job->chunk_frames;
+  stream->end_frame = stream->output_frame + job->chunk_frames;
+  if (stream->end_frame > job->total_frames)
+    stream->end_frame = job->total_frames;
+  stream->first_frame = stream->output_frame > job->lead_in_frames ? stream->output_frame - job->lead_in_frames : 0;
+
+  memset(stream->state, 0, VAD_MODEL_STATE_SIZE * sizeof(float));
+  // The context is the tail of the frame before, silence at the start of the source
+  if (stream->first_frame > 0)
+    vad_file_read(job->source, stream->first_frame * job->frame_samples - job->context_size, job->context_size,
+                  stream->input);
+  else
+    memset(stream->input, 0, (size_t)job->context_size * sizeof(float));
+}
+
+/// Compute the probabilities of chunks index, index + worker_count, ...
+static vad_thread_result_t VAD_THREAD_CALL run_worker(void *arg)
+{
+  OfflineWorker *worker = (OfflineWorker *)arg;
+  const OfflineJob *job = worker->job;
+
+  // Whole cache lines per stream keep every state and window aligned
+  size_t stream_floats = (size_t)(VAD_MODEL_STATE_SIZE + job->context_size + job->frame_samples);
+  stream_floats = (stream_floats + VAD_ALIGNMENT / sizeof(float) - 1) & ~(VAD_ALIGNMENT / sizeof(float) - 1);
+  float *buffers = (float *)vad_aligned_alloc(LOCKSTEP_CHUNKS * stream_floats * sizeof(float));
+  if (buffers == NULL)
+  {
+    worker->result = -2;
+    return (vad_thread_result_t)0;
+  }
+
+  ChunkStream streams[LOCKSTEP_CHUNKS];
+  const float *inputs[LOCKSTEP_CHUNKS];
+  float *states[LOCKSTEP_CHUNKS];
+  float probabilities[LOCKSTEP_CHUNKS];
+  int32_t members[LOCKSTEP_CHUNKS];
+
+  int64_t chunk = worker->index;
+  while (chunk < job->chunk_count)
+  {
+    int32_t group = 0;
+    for (; group < LOCKSTEP_CHUNKS && chunk < job->chunk_count; group++, chunk += job->worker_count)
+    {
+      streams[group].state = buffers + (size_t)group * stream_floats;
+      streams[group].input = streams[group].state + VAD_MODEL_STATE_SIZE;
+      start_chunk(job, &streams[group], chunk);
+    }
+
+    for (int64_t step = 0;; step++)
+    {
+      int32_t active = 0;
+      for (int32_t s = 0; s < group; s++)
+      {
+        int64_t frame = streams[s].first_frame + step;
+        if (frame >= streams[s].end_frame)
+          continue;
+        load_frame(job, streams[s].input + job->context_size, frame);
+        inputs[active] = streams[s].input;
+        states[active] = streams[s].state;
+        members[active] = s;
+        active++;
+      }
+      if (active == 0)
+        break;
+
+      if (active == 1 || vad_model_infer_batch(job->rate, inputs, states, active, probabilities) != 0)
+      {
+        // Single chunk, or no scratch for the batched pass
+        for (int32_t k = 0; k < active; k++)
+          probabilities[k] = vad_model_infer(job->rate, inputs[k], states[k]);
+      }
+
+      for (int32_t k = 0; k < active; k++)
+      {
+        ChunkStream *stream = &streams[members[k]];
+        int64_t frame = stream->first_frame + step;
+        if (frame >= stream->output_frame)
+          job->probabilities[frame] = probabilities[k];
+
+        float *window = stream->input;
+        memcpy(window, window + job->frame_samples, (size_t)job->context_size * sizeof(float));
+      }
+    }
+  }
+
+  vad_aligned_free(buffers);
+  return (vad_thread_result_t)0;
+}
+
+typedef struct SegmentList
+{
+  VADSegment *items;
+  int32_t count;
+  int32_t capacity;
+} SegmentList;
+
+static int32_t segment_list_push(SegmentList *list, int64_t start_sample, int64_t end_sample)
+{
+  if (list->count == list->capacity)
+  {
+    int32_t capacity = list->capacity > 0 ? list->capacity * 2 : 64;
+    VADSegment *grown = (VADSegment *)realloc(list->items, (size_t)capacity * sizeof(VADSegment));
+    if (grown == NULL)
+      return -2;
+    list->items = grown;
+    list->capacity = capacity;
+  }
+  list->items[list->count].start_sample = start_sample;
+  list->items[list->count].end_sample = end_sample;
+  list->count++;
+  return 0;
+}
+
+/// Run the hysteresis over every frame in order
+static int32_t collect_segments(const OfflineJob *job, const VADConfig *config, SegmentList *segments)
+{
+  int64_t total = job->source->frames;
+  VADSegmenter segmenter;
+  vad_segmenter_init(&segmenter, config);
+
+  for (int64_t frame = 0; frame < job->total_frames; frame++)
+  {
+    if (vad_segmenter_push(&segmenter, job->probabilities[frame]) & (VAD_SEGMENTER_END | VAD_SEGMENTER_SPLIT))
+    {
+      int64_t end = segmenter.ended_end * job->frame_samples;
+      if (segment_list_push(segments, segmenter.ended_start * job->frame_samples, end < total ? end : total) != 0)
+        return -2;
+    }
+  }
+  if (vad_segmenter_close(&segmenter))
+    return segment_list_push(segments, segmenter.ended_start * job->frame_samples, total);
+  return 0;
+}
+
+int32_t vad_offline_segment(const VADModelRate *rate, const VADConfig *config, const VADFile *source,
+                            const VADSegmentOptions *options, VADSegment **out_segments, int32_t *out_count)
+{
+  *out_segments = NULL;
+  *out_count = 0;
+
+  OfflineJob job;
+  memset(&job, 0, sizeof(job));
+  job.rate = rate;
+  job.source = source;
+  job.frame_samples = rate->frame_samples;
+  job.context_size = rate->context_size;
+  job.total_frames = (source->frames + rate->frame_samples - 1) / rate->frame_samples;
+  if (job.total_frames == 0)
+    return 0;
+
+  job.chunk_frames = options != NULL && options->chunk_frames > 0 ? options->chunk_frames : job.total_frames;
+  job.lead_in_frames = options != NULL && options->lead_in_frames > 0 ? options->lead_in_frames : 0;
+  job.chunk_count = (job.total_frames + job.chunk_frames - 1) / job.chunk_frames;
+
+  int64_t thread_count = options == NULL ? 1 : options->threads > 0 ? options->threads : vad_cpu_count();
+  job.worker_count = (int32_t)(thread_count < job.chunk_count ? thread_count : job.chunk_count);
+
+  job.probabilities = (float *)malloc((size_t)job.total_frames * sizeof(float));
+  OfflineWorker *workers = (OfflineWorker *)calloc((size_t)job.worker_count, sizeof(OfflineWorker));
+  vad_thread_t *thread_ids = (vad_thread_t *)calloc((size_t)job.worker_count, sizeof(vad_thread_t));
+  int32_t *started = (int32_t *)calloc((size_t)job.worker_count, sizeof(int32_t));
+  int32_t result = 0;
+  if (job.probabilities == NULL || workers == NULL || thread_ids == NULL || started == NULL)
+    result = -2;
+
+  if (result == 0)
+  {
+    // Worker 0 runs on the calling thread; a worker whose thread cannot be
+    // started runs there too, after it
+    for (int32_t i = 0; i < job.worker_count; i++)
+    {
+      workers[i].job = &job;
+      workers[i].index = i;
+      if (i > 0)
+        started[i] = vad_thread_create(&thread_ids[i], run_worker, &workers[i]) == 0;
+    }
+    run_worker(&workers[0]);
+    for (int32_t i = 1; i < job.worker_count; i++)
+    {
+      if (started[i])
+        vad_thread_join(thread_ids[i]);
+      else
+        run_worker(&workers[i]);
+    }
+    for (int32_t i = 0; i < job.worker_count; i++)
+    {
+      if (workers[i].result != 0)
+        result = workers[i].result;
+    }
+  }
+
+  SegmentList segments = {NULL, 0, 0};
+  if (result == 0)
+    result = collect_segments(&job, config, &segments);
+  if (result == 0)
+  {
+    *out_segments = segments.items;
+    *out_count = segments.count;
+  }
+  else
+  {
+    free(segments.items);
+  }
+
+  free(job.probabilities);
+  free(workers);
+  free(thread_ids);
+  free(started);
+  return result;
+}
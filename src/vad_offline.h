@@ -0,0 +1,37 @@
+#ifndef VAD_OFFLINE_H
+#define VAD_OFFLINE_H
+
+// Offline segmentation of a complete recording (vad_segment_file and
+// vad_segment_buffer). Speech probabilities are computed chunk by chunk, in
+// parallel when asked to, and the hysteresis then runs once over all of them
+// in order, so segments never need stitching at chunk boundaries. A chunk
+// other than the first starts from a zero state, run over lead_in_frames
+// frames before it whose probabilities are discarded; its probabilities are
+// close to, but not the same as, those of one sequential pass.
+
+#include <stdint.h>
+
+#include "vad_file.h"
+#include "vad_model.h"
+#include "vad_plus.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Find the speech segments of a sample source
+/// @param rate Model weights for config->sample_rate
+/// @param source Mapped file, or a VADFile wrapping a float buffer
+/// @param options Chunking and threads; NULL for one sequential pass
+/// @param out_segments Receives the segments (free()), NULL if there are none
+/// @param out_count Receives the number of segments
+/// @return 0 on success, -2 if memory or threads could not be allocated
+int32_t vad_offline_segment(const VADModelRate *rate, const VADConfig *config, const VADFile *source,
+                            const VADSegmentOptions *options, VADSegment **out_segments, int32_t *out_count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VAD_OFFLINE_H
@@ -0,0 +1,325 @@
+#include "vad_onnx.h"
+
+#include <string.h>
+
+// ============================================================================
+// Protobuf Wire Format
+// ============================================================================
+
+// Field numbers from onnx.proto3
+#define MODEL_GRAPH 7
+
+#define GRAPH_NODE 1
+#define GRAPH_INITIALIZER 5
+
+#define NODE_OUTPUT 2
+#define NODE_OP_TYPE 4
+#define NODE_ATTRIBUTE 5
+
+#define ATTRIBUTE_NAME 1
+#define ATTRIBUTE_TENSOR 5
+#define ATTRIBUTE_GRAPH 6
+#define ATTRIBUTE_GRAPHS 11
+
+#define TENSOR_DIMS 1
+#define TENSOR_DATA_TYPE 2
+#define TENSOR_FLOAT_DATA 4
+#define TENSOR_NAME 8
+#define TENSOR_RAW_DATA 9
+
+#define WIRE_VARINT 0
+#define WIRE_FIXED64 1
+#define WIRE_LENGTH 2
+#define WIRE_FIXED32 5
+
+// Subgraphs nest a few levels deep in the Silero export; anything deeper is malformed
+#define MAX_GRAPH_DEPTH 16
+
+typedef struct PbReader
+{
+  const uint8_t *cur;
+  const uint8_t *end;
+} PbReader;
+
+typedef struct PbField
+{
+  uint32_t number;
+  uint32_t wire_type;
+  uint64_t varint;
+  const uint8_t *data;
+  size_t length;
+} PbField;
+
+static int32_t pb_read_varint(PbReader *reader, uint64_t *value)
+{
+  uint64_t result = 0;
+  for (int shift = 0; shift < 64; shift += 7)
+  {
+    if (reader->cur >= reader->end)
+      return -1;
+    uint8_t byte = *reader->cur++;
+    result |= (uint64_t)(byte & 0x7f) << shift;
+    if ((byte & 0x80) == 0)
+    {
+      *value = result;
+      return 0;
+    }
+  }
+  return -1;
+}
+
+/// Read the next field. Returns 1 when a field was read, 0 at end, -1 on error.
+static int32_t pb_next(PbReader *reader, PbField *field)
+{
+  if (reader->cur >= reader->end)
+    return 0;
+
+  uint64_t key;
+  if (pb_read_varint(reader, &key) != 0)
+    return -1;
+
+  field->number = (uint32_t)(key >> 3);
+  field->wire_type = (uint32_t)(key & 7);
+  field->varint = 0;
+  field->data = NULL;
+  field->length = 0;
+
+  switch (field->wire_type)
+  {
+  case WIRE_VARINT:
+    return pb_read_varint(reader, &field->varint) == 0 ? 1 : -1;
+  case WIRE_FIXED64:
+    if ((size_t)(reader->end - reader->cur) < 8)
+      return -1;
+    field->data = reader->cur;
+    field->length = 8;
+    reader->cur += 8;
+    return 1;
+  case WIRE_FIXED32:
+    if ((size_t)(reader->end - reader->cur) < 4)
+      return -1;
+    field->data = reader->cur;
+    field->length = 4;
+    reader->cur += 4;
+    return 1;
+  case WIRE_LENGTH:
+  {
+    uint64_t length;
+    if (pb_read_varint(reader, &length) != 0 || length > (uint64_t)(reader->end - reader->cur))
+      return -1;
+    field->data = reader->cur;
+    field->length = (size_t)length;
+    reader->cur += length;
+    return 1;
+  }
+  default:
+    return -1;
+  }
+}
+
+// ============================================================================
+// Message Decoding
+// ============================================================================
+
+static int32_t parse_tensor(const uint8_t *data, size_t length, VADOnnxTensor *tensor)
+{
+  memset(tensor, 0, sizeof(*tensor));
+
+  PbReader reader = {data, data + length};
+  PbField field;
+  int32_t status;
+  while ((status = pb_next(&reader, &field)) > 0)
+  {
+    switch (field.number)
+    {
+    case TENSOR_DIMS:
+      if (field.wire_type == WIRE_VARINT)
+      {
+        if (tensor->rank >= VAD_ONNX_MAX_RANK)
+          return -1;
+        tensor->dims[tensor->rank++] = (int64_t)field.varint;
+      }
+      else if (field.wire_type == WIRE_LENGTH)
+      {
+        // Packed repeated int64
+        PbReader packed = {field.data, field.data + field.length};
+        while (packed.cur < packed.end)
+        {
+          uint64_t dim;
+          if (tensor->rank >= VAD_ONNX_MAX_RANK || pb_read_varint(&packed, &dim) != 0)
+            return -1;
+          tensor->dims[tensor->rank++] = (int64_t)dim;
+        }
+      }
+      break;
+    case TENSOR_DATA_TYPE:
+      tensor->data_type = (int32_t)field.varint;
+      break;
+    case TENSOR_NAME:
+      if (field.wire_type == WIRE_LENGTH)
+      {
+        tensor->name = (const char *)field.data;
+        tensor->name_length = field.length;
+      }
+      break;
+    case TENSOR_RAW_DATA:
+      tensor->data = field.data;
+      tensor->data_length = field.length;
+      break;
+    case TENSOR_FLOAT_DATA:
+      // Packed float_data has the same little-endian layout as raw_data
+      if (field.wire_type == WIRE_LENGTH && tensor->data == NULL)
+      {
+        tensor->data = field.data;
+        tensor->data_length = field.length;
+      }
+      break;
+    default:
+      break;
+    }
+  }
+  return status;
+}
+
+typedef struct VisitContext
+{
+  VADOnnxTensorVisitor visitor;
+  void *user_data;
+} VisitContext;
+
+static int32_t visit_graph(const uint8_t *data, size_t length, const VisitContext *ctx, int32_t depth);
+
+static int32_t visit_node(const uint8_t *data, size_t length, const VisitContext *ctx, int32_t depth)
+{
+  const char *output = NULL;
+  size_t output_length = 0;
+  int32_t is_constant = 0;
+
+  // First pass: op type and first output name (field order is not guaranteed)
+  PbReader reader = {data, data + length};
+  PbField field;
+  int32_t status;
+  while ((status = pb_next(&reader, &field)) > 0)
+  {
+    if (field.number == NODE_OP_TYPE && field.wire_type == WIRE_LENGTH)
+      is_constant = field.length == 8 && memcmp(field.data, "Constant", 8) == 0;
+    else if (field.number == NODE_OUTPUT && field.wire_type == WIRE_LENGTH && output == NULL)
+    {
+      output = (const char *)field.data;
+      output_length = field.length;
+    }
+  }
+  if (status < 0)
+    return -1;
+
+  // Second pass: attributes (constant values and subgraphs)
+  reader.cur = data;
+  while ((status = pb_next(&reader, &field)) > 0)
+  {
+    if (field.number != NODE_ATTRIBUTE || field.wire_type != WIRE_LENGTH)
+      continue;
+
+    PbReader attr = {field.data, field.data + field.length};
+    PbField attr_field;
+    while ((status = pb_next(&attr, &attr_field)) > 0)
+    {
+      if (attr_field.wire_type != WIRE_LENGTH)
+        continue;
+
+      if (attr_field.number == ATTRIBUTE_TENSOR && is_constant)
+      {
+        VADOnnxTensor tensor;
+        if (parse_tensor(attr_field.data, attr_field.length, &tensor) < 0)
+          return -1;
+        if (output != NULL)
+        {
+          tensor.name = output;
+          tensor.name_length = output_length;
+        }
+        ctx->visitor(&tensor, ctx->user_data);
+      }
+      else if (attr_field.number == ATTRIBUTE_GRAPH || attr_field.number == ATTRIBUTE_GRAPHS)
+      {
+        if (visit_graph(attr_field.data, attr_field.length, ctx, depth + 1) < 0)
+          return -1;
+      }
+    }
+    if (status < 0)
+      return -1;
+  }
+  return status;
+}
+
+static int32_t visit_graph(const uint8_t *data, size_t length, const VisitContext *ctx, int32_t depth)
+{
+  if (depth > MAX_GRAPH_DEPTH)
+    return -1;
+
+  PbReader reader = {data, data + length};
+  PbField field;
+  int32_t status;
+  while ((status = pb_next(&reader, &field)) > 0)
+  {
+    if (field.wire_type != WIRE_LENGTH)
+      continue;
+
+    if (field.number == GRAPH_INITIALIZER)
+    {
+      VADOnnxTensor tensor;
+      if (parse_tensor(field.data, field.length, &tensor) < 0)
+        return -1;
+      ctx->visitor(&tensor, ctx->user_data);
+    }
+    else if (field.number == GRAPH_NODE)
+    {
+      if (visit_node(field.data, field.length, ctx, depth) < 0)
+        return -1;
+    }
+  }
+  return status;
+}
+
+// ============================================================================
+// Public Functions
+// ============================================================================
+
+int32_t vad_onnx_visit_tensors(const uint8_t *data, size_t length, VADOnnxTensorVisitor visitor, void *user_data)
+{
+  if (data == NULL || length == 0 || visitor == NULL)
+    return -1;
+
+  VisitContext ctx = {visitor, user_data};
+  int32_t found_graph = 0;
+
+  PbReader reader = {data, data + length};
+  PbField field;
+  int32_t status;
+  while ((status = pb_next(&reader, &field)) > 0)
+  {
+    if (field.number == MODEL_GRAPH && field.wire_type == WIRE_LENGTH)
+    {
+      if (visit_graph(field.data, field.length, &ctx, 0) < 0)
+        return -1;
+      found_graph = 1;
+    }
+  }
+  if (status < 0 || !found_graph)
+    return -1;
+  return 0;
+}
+
+int64_t vad_onnx_tensor_elements(const VADOnnxTensor *tensor)
+{
+  int64_t count = 1;
+  for (int32_t i = 0; i < tensor->rank; i++)
+    count *= tensor->dims[i];
+  return count;
+}
+
+int32_t vad_onnx_name_ends_with(const VADOnnxTensor *tensor, const char *suffix)
+{
+  size_t suffix_length = strlen(suffix);
+  if (tensor->name == NULL || tensor->name_length < suffix_length)
+    return 0;
+  return memcmp(tensor->name + tensor->name_length - suffix_length, suffix, suffix_length) == 0;
+}
@@ -0,0 +1,54 @@
+#ifndef VAD_ONNX_H
+#define VAD_ONNX_H
+
+// Minimal ONNX (protobuf) reader used to pull constant tensors out of the
+// Silero model file. Only the handful of fields needed to locate weights are
+// decoded; everything else is skipped.
+
+#include <stddef.h>
+#include <stdint.h>
+
+/// ONNX TensorProto.DataType values used by the engine
+#define VAD_ONNX_FLOAT 1
+#define VAD_ONNX_UINT8 2
+#define VAD_ONNX_INT8 3
+
+/// Maximum tensor rank handled by the reader
+#define VAD_ONNX_MAX_RANK 8
+
+/// A tensor found in the model (initializer or Constant node value).
+/// All pointers reference the caller's model buffer.
+typedef struct VADOnnxTensor
+{
+    /// Tensor name (not NUL-terminated). For Constant nodes this is the node output name.
+    const char *name;
+    size_t name_length;
+    /// ONNX element type (VAD_ONNX_FLOAT, ...)
+    int32_t data_type;
+    /// Tensor shape
+    int64_t dims[VAD_ONNX_MAX_RANK];
+    int32_t rank;
+    /// Little-endian element data (raw_data or packed typed data), NULL if absent
+    const uint8_t *data;
+    size_t data_length;
+} VADOnnxTensor;
+
+/// Visitor invoked once per tensor
+typedef void (*VADOnnxTensorVisitor)(const VADOnnxTensor *tensor, void *user_data);
+
+/// Walk every initializer and Constant node (including If/Loop subgraphs) of a
+/// serialized ModelProto and report its tensors to the visitor.
+/// @param data Serialized ONNX model
+/// @param length Size of data in bytes
+/// @param visitor Callback receiving each tensor
+/// @param user_data Passed through to visitor
+/// @return 0 on success, -1 if the buffer is not a well-formed model
+int32_t vad_onnx_visit_tensors(const uint8_t *data, size_t length, VADOnnxTensorVisitor visitor, void *user_data);
+
+/// Number of elements described by the tensor shape
+int64_t vad_onnx_tensor_elements(const VADOnnxTensor *tensor);
+
+/// Check whether the tensor name ends with the given suffix
+int32_t vad_onnx_name_ends_with(const VADOnnxTensor *tensor, const char *suffix);
+
+#endif /* VAD_ONNX_H */
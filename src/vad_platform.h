@@ -0,0 +1,271 @@
+#ifndef VAD_PLATFORM_H
+#define VAD_PLATFORM_H
+
+// Internal portability helpers for the native engine (not part of the FFI API).
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#if _WIN32
+#include <windows.h>
+#include <malloc.h>
+#else
+#include <pthread.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+/// Alignment used for weights and per-handle buffers (one cache line)
+#define VAD_ALIGNMENT 64
+
+// ============================================================================
+// Mutex
+// ============================================================================
+
+#if _WIN32
+typedef CRITICAL_SECTION vad_mutex_t;
+#define vad_mutex_init(m) InitializeCriticalSection(m)
+#define vad_mutex_destroy(m) DeleteCriticalSection(m)
+#define vad_mutex_lock(m) EnterCriticalSection(m)
+#define vad_mutex_unlock(m) LeaveCriticalSection(m)
+#else
+typedef pthread_mutex_t vad_mutex_t;
+#define vad_mutex_init(m) pthread_mutex_init((m), NULL)
+#define vad_mutex_destroy(m) pthread_mutex_destroy(m)
+#define vad_mutex_lock(m) pthread_mutex_lock(m)
+#define vad_mutex_unlock(m) pthread_mutex_unlock(m)
+#endif
+
+/// Process-wide lock usable without an init call (VAD_STATIC_MUTEX_INIT)
+#if _WIN32
+typedef SRWLOCK vad_static_mutex_t;
+#define VAD_STATIC_MUTEX_INIT SRWLOCK_INIT
+#define vad_static_mutex_lock(m) AcquireSRWLockExclusive(m)
+#define vad_static_mutex_unlock(m) ReleaseSRWLockExclusive(m)
+#else
+typedef pthread_mutex_t vad_static_mutex_t;
+#define VAD_STATIC_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+#define vad_static_mutex_lock(m) pthread_mutex_lock(m)
+#define vad_static_mutex_unlock(m) pthread_mutex_unlock(m)
+#endif
+
+// ============================================================================
+// Threads
+// ============================================================================
+
+#if _WIN32
+typedef HANDLE vad_thread_t;
+typedef DWORD vad_thread_result_t;
+#define VAD_THREAD_CALL WINAPI
+#else
+typedef pthread_t vad_thread_t;
+typedef void *vad_thread_result_t;
+#define VAD_THREAD_CALL
+#endif
+
+/// Thread entry point: static vad_thread_result_t VAD_THREAD_CALL entry(void *arg)
+typedef vad_thread_result_t(VAD_THREAD_CALL *vad_thread_entry_t)(void *arg);
+
+/// Start a thread running entry(arg)
+/// @return 0 on success, -1 on failure
+static inline int32_t vad_thread_create(vad_thread_t *thread, vad_thread_entry_t entry, void *arg)
+{
+#if _WIN32
+  *thread = CreateThread(NULL, 0, entry, arg, 0, NULL);
+  return *thread != NULL ? 0 : -1;
+#else
+  return pthread_create(thread, NULL, entry, arg) == 0 ? 0 : -1;
+#endif
+}
+
+/// Wait for a thread started with vad_thread_create to return
+static inline void vad_thread_join(vad_thread_t thread)
+{
+#if _WIN32
+  WaitForSingleObject(thread, INFINITE);
+  CloseHandle(thread);
+#else
+  pthread_join(thread, NULL);
+#endif
+}
+
+/// Number of online CPU cores (at least 1)
+static inline int32_t vad_cpu_count(void)
+{
+#if _WIN32
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return info.dwNumberOfProcessors > 0 ? (int32_t)info.dwNumberOfProcessors : 1;
+#else
+  long count = sysconf(_SC_NPROCESSORS_ONLN);
+  return count > 0 ? (int32_t)count : 1;
+#endif
+}
+
+// ============================================================================
+// Atomics
+// ============================================================================
+
+/// Acquire load / release store of a 64-bit counter shared between two threads
+#if defined(_MSC_VER) && !defined(__clang__)
+static inline int64_t vad_atomic_load_acquire(volatile int64_t *p)
+{
+  // Interlocked operations are full barriers on every MSVC target
+  return _InterlockedOr64((volatile __int64 *)p, 0);
+}
+
+static inline void vad_atomic_store_release(volatile int64_t *p, int64_t value)
+{
+  _InterlockedExchange64((volatile __int64 *)p, value);
+}
+
+static inline uint32_t vad_atomic_load_acquire_u32(volatile uint32_t *p)
+{
+  return (uint32_t)_InterlockedOr((volatile long *)p, 0);
+}
+
+static inline void vad_atomic_store_release_u32(volatile uint32_t *p, uint32_t value)
+{
+  _InterlockedExchange((volatile long *)p, (long)value);
+}
+
+/// Keep earlier stores from being reordered after later ones
+static inline void vad_atomic_fence_release(void)
+{
+  MemoryBarrier();
+}
+
+/// Keep later loads from being reordered before earlier ones
+static inline void vad_atomic_fence_acquire(void)
+{
+  MemoryBarrier();
+}
+
+/// Add to a counter that several threads may update, without ordering
+static inline void vad_atomic_add_u32(volatile uint32_t *p, uint32_t value)
+{
+  _InterlockedExchangeAdd((volatile long *)p, (long)value);
+}
+
+static inline void vad_atomic_add(volatile int64_t *p, int64_t value)
+{
+  _InterlockedExchangeAdd64((volatile __int64 *)p, value);
+}
+
+/// Raise *p to value if it is larger
+static inline void vad_atomic_max(volatile int64_t *p, int64_t value)
+{
+  int64_t current = *p;
+  while (value > current)
+  {
+    int64_t seen = _InterlockedCompareExchange64((volatile __int64 *)p, value, current);
+    if (seen == current)
+      break;
+    current = seen;
+  }
+}
+#else
+static inline int64_t vad_atomic_load_acquire(volatile int64_t *p)
+{
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static inline void vad_atomic_store_release(volatile int64_t *p, int64_t value)
+{
+  __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+static inline uint32_t vad_atomic_load_acquire_u32(volatile uint32_t *p)
+{
+  return __atomic_load_n(p, __ATOMIC_ACQUIRE);
+}
+
+static inline void vad_atomic_store_release_u32(volatile uint32_t *p, uint32_t value)
+{
+  __atomic_store_n(p, value, __ATOMIC_RELEASE);
+}
+
+/// Keep earlier stores from being reordered after later ones
+static inline void vad_atomic_fence_release(void)
+{
+  __atomic_thread_fence(__ATOMIC_RELEASE);
+}
+
+/// Keep later loads from being reordered before earlier ones
+static inline void vad_atomic_fence_acquire(void)
+{
+  __atomic_thread_fence(__ATOMIC_ACQUIRE);
+}
+
+/// Add to a counter that several threads may update, without ordering
+static inline void vad_atomic_add_u32(volatile uint32_t *p, uint32_t value)
+{
+  __atomic_fetch_add(p, value, __ATOMIC_RELAXED);
+}
+
+static inline void vad_atomic_add(volatile int64_t *p, int64_t value)
+{
+  __atomic_fetch_add(p, value, __ATOMIC_RELAXED);
+}
+
+/// Raise *p to value if it is larger
+static inline void vad_atomic_max(volatile int64_t *p, int64_t value)
+{
+  int64_t current = __atomic_load_n(p, __ATOMIC_RELAXED);
+  while (value > current &&
+         !__atomic_compare_exchange_n(p, &current, value, 1, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+  {
+  }
+}
+#endif
+
+// ============================================================================
+// Time
+// ============================================================================
+
+/// Monotonic clock in nanoseconds
+static inline uint64_t vad_now_ns(void)
+{
+#if _WIN32
+  LARGE_INTEGER frequency;
+  LARGE_INTEGER counter;
+  QueryPerformanceFrequency(&frequency);
+  QueryPerformanceCounter(&counter);
+  return (uint64_t)((double)counter.QuadPart * 1e9 / (double)frequency.QuadPart);
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+#endif
+}
+
+// ============================================================================
+// Aligned Allocation
+// ============================================================================
+
+/// Allocate size bytes aligned to VAD_ALIGNMENT, or NULL on failure
+static inline void *vad_aligned_alloc(size_t size)
+{
+  if (size == 0)
+    size = VAD_ALIGNMENT;
+#if _WIN32
+  return _aligned_malloc(size, VAD_ALIGNMENT);
+#else
+  void *ptr = NULL;
+  if (posix_memalign(&ptr, VAD_ALIGNMENT, size) != 0)
+    return NULL;
+  return ptr;
+#endif
+}
+
+static inline void vad_aligned_free(void *ptr)
+{
+#if _WIN32
+  _aligned_free(ptr);
+#else
+  free(ptr);
+#endif
+}
+
+#endif /* VAD_PLATFORM_H */
@@ -1,32 +1,708 @@
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+// Needed for dladdr() when locating the bundled model
+#define _GNU_SOURCE
+#endif
+
 #include "vad_plus.h"
 
+#include "vad_convert.h"
+#include "vad_events.h"
+
 // ============================================================================
 // Platform-specific Implementation
 // ============================================================================
 
 #if defined(__APPLE__)
 // iOS/macOS: Implementation is in Swift (VadPlusFFI.swift)
-// These stubs are only compiled if Swift implementation is not available
+// The native engine is only compiled if Swift implementation is not available
 
 #include <TargetConditionals.h>
 
 #if !TARGET_OS_IOS && !TARGET_OS_MAC
-// Stub implementations for non-Apple platforms or testing
-#define IMPLEMENT_STUBS 1
+#define VAD_PLUS_NATIVE_ENGINE 1
 #endif
 
 #else
-// Non-Apple platforms: Use stub implementations
-#define IMPLEMENT_STUBS 1
+// Non-Apple platforms (Linux, Windows): native C engine running the Silero
+// model with hand-written CPU kernels (vad_model.c)
+#define VAD_PLUS_NATIVE_ENGINE 1
+#endif
+
+#ifdef VAD_PLUS_NATIVE_ENGINE
+
+#include <stdarg.h>
+#include <string.h>
+
+#if !_WIN32
+#include <dlfcn.h>
+#endif
+
+#include "vad_file.h"
+#include "vad_gate.h"
+#include "vad_model.h"
+#include "vad_model_cache.h"
+#include "vad_offline.h"
+#include "vad_platform.h"
+#include "vad_resample.h"
+#include "vad_segmenter.h"
+#include "vad_stats.h"
+#include "vad_status.h"
+#include "vad_trace.h"
+
+// ============================================================================
+// Handle State
+// ============================================================================
+
+// Inline event payload: one frame at the largest supported frame size, so
+// frame events never touch the large slabs
+#define VAD_EVENT_INLINE_BYTES (512 * sizeof(float))
+
+#define VAD_ERROR_SIZE 512
+
+static const char *const kBundledModelNames[] = {"silero_vad_v6.onnx", "silero_vad.onnx"};
+static const char *const kBundledInt8ModelNames[] = {"silero_vad_v6_int8.onnx"};
+
+struct VADHandle
+{
+  VADConfig config;
+  // Shared with every handle using the same model file (vad_model_cache.c)
+  const VADModel *model;
+  const VADModelRate *rate;
+  int32_t initialized;
+
+  // VAD state for v6 model (2 * 1 * 128 = 256 floats)
+  float state[VAD_MODEL_STATE_SIZE];
+
+  // Model input window: [context | frame]. Incoming samples are written
+  // straight into the frame slot; the context is carried over in place.
+  float *input;
+  int32_t context_size;
+  int32_t pending_samples;
+
+  // Input at another rate than the model's (input_sample_rate) goes through
+  // the resampler, VAD_RESAMPLER_BLOCK samples at a time; NULL otherwise.
+  // resampled holds two blocks: resampler output, then converted
+  // vad_process_audio_ex() input waiting to be resampled.
+  VADResampler *resampler;
+  float *resampled;
+
+  // Speech detection state
+  VADSegmenter segmenter;
+
+  // Energy pre-gate skipping the model on silence (VADConfig.silence_gate_frames)
+  VADGate *gate;
+
+  // Pre-speech pad: ring of the last pre_speech_pad_frames frames
+  float *pre_speech;
+  int32_t pre_speech_count;
+  int32_t pre_speech_next;
+
+  // Speech segment as PCM16, converted frame by frame. Preallocated for
+  // pre_speech_pad_frames + max_speech_frames frames when max_speech_frames
+  // is set, so a segment never reallocates; grown on demand otherwise.
+  // Neither the segment nor its pad is kept when no event carries audio
+  // (speech_end_by_reference without speech chunks).
+  int32_t store_speech;
+  int16_t *speech;
+  size_t speech_length;
+  size_t speech_capacity;
+  // Samples of the segment already sent as VAD_EVENT_SPEECH_CHUNK
+  size_t speech_streamed;
+
+  // Callback
+  vad_mutex_t callback_lock;
+  VADEventCallback callback;
+  void *user_data;
+  int32_t callback_valid;
+
+  // Events stay owned by the pool until the consumer calls vad_event_release()
+  VADEventPool *events;
+
+  // Polled by readers without calls (vad_get_status_block)
+  VADStatusBlock *status;
+
+  // Latency histograms and counters (vad_get_stats); a frame taking longer
+  // than frame_budget_ns, the audio it holds, counts as late
+  VADStatsRecorder *stats;
+  uint64_t frame_budget_ns;
+
+  // Timeline of the pipeline stages (vad_trace_start / vad_trace_dump)
+  VADTracer *trace;
+
+  // Event subscription (vad_set_event_mask / vad_set_frame_event_interval)
+  volatile uint32_t event_mask;
+  volatile int32_t frame_event_interval;
+  int32_t frame_event_countdown;
+
+  // Warm-up (vad_prewarm, VADConfig.prewarm_frames). The first real frame
+  // after vad_init() is timed, and first waits for a background warm-up.
+  VADWarmupInfo warmup;
+  int32_t first_frame_pending;
+  vad_thread_t prewarm_thread;
+  int32_t prewarm_running;
+
+  char last_error[VAD_ERROR_SIZE];
+};
+
+static void set_error(VADHandle *handle, const char *format, ...)
+{
+  va_list args;
+  va_start(args, format);
+  vsnprintf(handle->last_error, sizeof(handle->last_error), format, args);
+  va_end(args);
+}
+
+static void log_debug(const VADHandle *handle, const char *format, ...)
+{
+  if (!handle->config.is_debug)
+    return;
+  va_list args;
+  va_start(args, format);
+  fprintf(stderr, "[vad_plus] ");
+  vfprintf(stderr, format, args);
+  fprintf(stderr, "\n");
+  va_end(args);
+}
+
+// ============================================================================
+// Event Sending
+// ============================================================================
+
+static void dispatch_event(VADHandle *handle, VADEvent *event)
+{
+  if (event == NULL)
+    return;
+
+  // The callback runs under the lock so vad_invalidate_callback() waits for it
+  int32_t type = event->type;
+  uint64_t requested = vad_tracer_now(handle->trace);
+  vad_mutex_lock(&handle->callback_lock);
+  uint64_t start = vad_now_ns();
+  if (requested != 0)
+    vad_tracer_record(handle->trace, VAD_TRACE_CALLBACK_LOCK, type, requested, start);
+  if (handle->callback_valid && handle->callback != NULL)
+  {
+    handle->callback(event, handle->user_data);
+    uint64_t end = vad_now_ns();
+    vad_stats_record_callback(handle->stats, end - start);
+    if (requested != 0)
+      vad_tracer_record(handle->trace, VAD_TRACE_CALLBACK, type, start, end);
+    event = NULL;
+  }
+  vad_mutex_unlock(&handle->callback_lock);
+
+  // Callback was invalidated, hand the event straight back
+  vad_event_pool_release(event);
+}
+
+/// Whether an event of this type would reach the callback; checked before any copy
+static int32_t wants_event(const VADHandle *handle, VADEventType type)
+{
+  return handle->callback_valid && (handle->event_mask & VAD_EVENT_MASK(type)) != 0;
+}
+
+static void send_event(VADHandle *handle, VADEventType type)
+{
+  if (!wants_event(handle, type))
+    return;
+  dispatch_event(handle, vad_event_pool_acquire(handle->events, type, 0, NULL));
+}
+
+static void send_frame_event(VADHandle *handle, float probability, const float *frame, int32_t frame_length)
+{
+  if (!wants_event(handle, VAD_EVENT_FRAME_PROCESSED))
+    return;
+
+  // Decimation: deliver the first frame, then every frame_event_interval-th
+  if (handle->frame_event_countdown > 0)
+  {
+    handle->frame_event_countdown--;
+    return;
+  }
+  handle->frame_event_countdown = handle->frame_event_interval - 1;
+
+  size_t bytes = (size_t)frame_length * sizeof(float);
+  float *frame_copy;
+  VADEvent *event = vad_event_pool_acquire(handle->events, VAD_EVENT_FRAME_PROCESSED, bytes, (void **)&frame_copy);
+  if (event == NULL)
+    return;
+
+  memcpy(frame_copy, frame, bytes);
+  event->frame_probability = probability;
+  event->frame_is_speech = probability >= handle->config.positive_speech_threshold ? 1 : 0;
+  event->frame_data = frame_copy;
+  event->frame_length = frame_length;
+  dispatch_event(handle, event);
+}
+
+/// SPEECH_START, or MISFIRE with the bounds of the segment that just closed
+static void send_segment_event(VADHandle *handle, VADEventType type, int64_t start_frame, int64_t end_frame)
+{
+  if (!wants_event(handle, type))
+    return;
+  VADEvent *event = vad_event_pool_acquire(handle->events, type, 0, NULL);
+  if (event == NULL)
+    return;
+
+  event->segment_start_sample = start_frame * handle->config.frame_samples;
+  event->segment_end_sample = end_frame * handle->config.frame_samples;
+  dispatch_event(handle, event);
+}
+
+static void send_speech_end_event(VADHandle *handle)
+{
+  if (!wants_event(handle, VAD_EVENT_SPEECH_END))
+    return;
+
+  const VADSegmenter *segmenter = &handle->segmenter;
+  int64_t frame_samples = handle->config.frame_samples;
+  int32_t length = handle->config.speech_end_by_reference ? 0 : (int32_t)handle->speech_length;
+  int16_t *audio;
+  VADEvent *event =
+      vad_event_pool_acquire(handle->events, VAD_EVENT_SPEECH_END, (size_t)length * sizeof(int16_t), (void **)&audio);
+  if (event == NULL)
+    return;
+
+  if (length > 0)
+  {
+    memcpy(audio, handle->speech, (size_t)length * sizeof(int16_t));
+    event->speech_end_audio_data = audio;
+  }
+  event->speech_end_audio_length = length;
+  event->segment_start_sample = segmenter->ended_start * frame_samples;
+  event->segment_end_sample = segmenter->ended_end * frame_samples;
+  event->speech_end_duration_ms = (int32_t)((double)(event->segment_end_sample - event->segment_start_sample) /
+                                            handle->config.sample_rate * 1000.0);
+  dispatch_event(handle, event);
+}
+
+static void send_speech_chunk_event(VADHandle *handle, size_t offset, size_t length, int32_t is_last)
+{
+  if (!wants_event(handle, VAD_EVENT_SPEECH_CHUNK))
+    return;
+
+  int16_t *audio;
+  VADEvent *event =
+      vad_event_pool_acquire(handle->events, VAD_EVENT_SPEECH_CHUNK, length * sizeof(int16_t), (void **)&audio);
+  if (event == NULL)
+    return;
+
+  memcpy(audio, handle->speech + offset, length * sizeof(int16_t));
+  event->speech_chunk_audio_data = audio;
+  event->speech_chunk_audio_length = (int32_t)length;
+  event->speech_chunk_offset = (int32_t)offset;
+  event->speech_chunk_is_last = is_last;
+  dispatch_event(handle, event);
+}
+
+static void send_error_event(VADHandle *handle, const char *message, int32_t code)
+{
+  if (!wants_event(handle, VAD_EVENT_ERROR))
+    return;
+
+  size_t length = strlen(message) + 1;
+  char *message_copy;
+  VADEvent *event = vad_event_pool_acquire(handle->events, VAD_EVENT_ERROR, length, (void **)&message_copy);
+  if (event == NULL)
+    return;
+
+  memcpy(message_copy, message, length);
+  event->error_message = message_copy;
+  event->error_code = code;
+  dispatch_event(handle, event);
+}
+
+// ============================================================================
+// State Management
+// ============================================================================
+
+/// Drop the stored segment once the segmenter has closed it
+static void reset_speech(VADHandle *handle)
+{
+  vad_status_set_speaking(handle->status, 0);
+  handle->speech_length = 0;
+  handle->speech_streamed = 0;
+}
+
+/// Publish the speech storage in use and allocated
+static void publish_speech_stats(VADHandle *handle)
+{
+  size_t pad_bytes = handle->pre_speech != NULL ? (size_t)handle->config.pre_speech_pad_frames *
+                                                      (size_t)handle->config.frame_samples * sizeof(float)
+                                                : 0;
+  vad_stats_set_speech(handle->stats, (int64_t)(handle->speech_length * sizeof(int16_t)),
+                       (int64_t)(handle->speech_capacity * sizeof(int16_t) + pad_bytes));
+}
+
+static void reset_states(VADHandle *handle)
+{
+  memset(handle->state, 0, sizeof(handle->state));
+  if (handle->input != NULL)
+    memset(handle->input, 0, (size_t)handle->context_size * sizeof(float));
+  handle->pending_samples = 0;
+  handle->pre_speech_count = 0;
+  handle->pre_speech_next = 0;
+  handle->frame_event_countdown = 0;
+  vad_segmenter_reset(&handle->segmenter);
+  vad_gate_reset(handle->gate);
+  vad_resampler_reset(handle->resampler);
+  reset_speech(handle);
+  vad_status_reset(handle->status);
+  vad_stats_reset(handle->stats);
+  publish_speech_stats(handle);
+}
+
+static void free_buffers(VADHandle *handle)
+{
+  vad_aligned_free(handle->input);
+  free(handle->pre_speech);
+  free(handle->speech);
+  vad_resampler_destroy(handle->resampler);
+  vad_aligned_free(handle->resampled);
+  handle->input = NULL;
+  handle->pre_speech = NULL;
+  handle->speech = NULL;
+  handle->resampler = NULL;
+  handle->resampled = NULL;
+  handle->speech_length = 0;
+  handle->speech_capacity = 0;
+  publish_speech_stats(handle);
+}
+
+/// Drop the handle's reference to its shared model
+static void release_model(VADHandle *handle)
+{
+  vad_model_cache_release(handle->model);
+  handle->model = NULL;
+  handle->rate = NULL;
+}
+
+static int32_t append_speech(VADHandle *handle, const float *samples, int32_t count)
+{
+  size_t needed = handle->speech_length + (size_t)count;
+  if (needed > handle->speech_capacity)
+  {
+    size_t capacity = handle->speech_capacity > 0 ? handle->speech_capacity : (size_t)count * 64;
+    while (capacity < needed)
+      capacity *= 2;
+    int16_t *grown = (int16_t *)realloc(handle->speech, capacity * sizeof(int16_t));
+    if (grown == NULL)
+    {
+      send_error_event(handle, "Out of memory buffering speech", -10);
+      return -1;
+    }
+    handle->speech = grown;
+    handle->speech_capacity = capacity;
+  }
+  vad_convert_f32_to_s16(samples, handle->speech + handle->speech_length, count);
+  handle->speech_length = needed;
+  return 0;
+}
+
+/// Locate a model shipped next to the shared library, trying names in order
+static int32_t find_bundled_model(const char *const *names, size_t count, char *path, size_t path_size)
+{
+  char directory[1024] = {0};
+
+#if _WIN32
+  HMODULE module = NULL;
+  if (!GetModuleHandleExA(GET_MODULE_HANDLE_EX_FLAG_FROM_ADDRESS | GET_MODULE_HANDLE_EX_FLAG_UNCHANGED_REFCOUNT,
+                          (LPCSTR)(void *)&find_bundled_model, &module))
+    return -1;
+  if (GetModuleFileNameA(module, directory, (DWORD)sizeof(directory)) == 0)
+    return -1;
+  char *slash = strrchr(directory, '\\');
+#else
+  Dl_info info;
+  if (dladdr((void *)&find_bundled_model, &info) == 0 || info.dli_fname == NULL)
+    return -1;
+  strncpy(directory, info.dli_fname, sizeof(directory) - 1);
+  char *slash = strrchr(directory, '/');
 #endif
 
-#ifdef IMPLEMENT_STUBS
+  if (slash != NULL)
+    slash[1] = '\0';
+  else
+    directory[0] = '\0';
+
+  for (size_t i = 0; i < count; i++)
+  {
+    snprintf(path, path_size, "%s%s", directory, names[i]);
+    FILE *file = fopen(path, "rb");
+    if (file != NULL)
+    {
+      fclose(file);
+      return 0;
+    }
+  }
+  return -1;
+}
 
 // ============================================================================
-// Stub Implementations (for platforms without native support)
+// Audio Processing
 // ============================================================================
 
-static const char *stub_error = "VAD not supported on this platform";
+/// Send every complete chunk of confirmed speech not yet streamed; at the end
+/// of the segment also the remainder, flagged as the last chunk
+static void stream_speech_chunks(VADHandle *handle, int32_t end_of_segment)
+{
+  size_t chunk = (size_t)handle->config.speech_chunk_samples;
+  if (chunk == 0)
+    return;
+
+  while (handle->speech_length - handle->speech_streamed >= chunk)
+  {
+    send_speech_chunk_event(handle, handle->speech_streamed, chunk, 0);
+    handle->speech_streamed += chunk;
+  }
+  if (end_of_segment)
+  {
+    send_speech_chunk_event(handle, handle->speech_streamed, handle->speech_length - handle->speech_streamed, 1);
+    handle->speech_streamed = handle->speech_length;
+  }
+}
+
+static void emit_speech_end(VADHandle *handle)
+{
+  stream_speech_chunks(handle, 1);
+  // The segment keeps the trailing silence frames, like the mobile implementations
+  send_speech_end_event(handle);
+}
+
+/// Close a segment that reached max_speech_frames while speech goes on. The
+/// next frame continues in a new segment with SPEECH_START; it gets its
+/// REAL_SPEECH_START only once it has min_speech_frames speech frames of its
+/// own, and ends as a misfire if it never does.
+static void split_speech(VADHandle *handle)
+{
+  emit_speech_end(handle);
+
+  handle->speech_length = 0;
+  handle->speech_streamed = 0;
+  send_segment_event(handle, VAD_EVENT_SPEECH_START, handle->segmenter.segment_start, 0);
+}
+
+static void process_vad_logic(VADHandle *handle, const float *frame, float probability)
+{
+  const VADConfig *config = &handle->config;
+  VADSegmenter *segmenter = &handle->segmenter;
+  int32_t frame_samples = config->frame_samples;
+  int32_t was_speaking = segmenter->is_speaking;
+
+  uint32_t transitions = vad_segmenter_push(segmenter, probability);
+
+  if (transitions & VAD_SEGMENTER_START)
+  {
+    // Prepend the pre-speech pad, oldest frame first
+    handle->speech_length = 0;
+    if (handle->store_speech)
+    {
+      int32_t oldest = (handle->pre_speech_next - handle->pre_speech_count + config->pre_speech_pad_frames) %
+                       (config->pre_speech_pad_frames > 0 ? config->pre_speech_pad_frames : 1);
+      for (int32_t i = 0; i < handle->pre_speech_count; i++)
+      {
+        int32_t slot = (oldest + i) % config->pre_speech_pad_frames;
+        append_speech(handle, handle->pre_speech + (size_t)slot * frame_samples, frame_samples);
+      }
+      append_speech(handle, frame, frame_samples);
+    }
+
+    send_segment_event(handle, VAD_EVENT_SPEECH_START, segmenter->segment_start, 0);
+  }
+  else if (was_speaking && handle->store_speech)
+  {
+    append_speech(handle, frame, frame_samples);
+  }
+
+  if (transitions & VAD_SEGMENTER_REAL_START)
+    send_event(handle, VAD_EVENT_REAL_SPEECH_START);
+
+  if (transitions & (VAD_SEGMENTER_END | VAD_SEGMENTER_MISFIRE))
+  {
+    if (transitions & VAD_SEGMENTER_END)
+      emit_speech_end(handle);
+    else
+      send_segment_event(handle, VAD_EVENT_MISFIRE, segmenter->ended_start, segmenter->ended_end);
+    reset_speech(handle);
+  }
+  else if (transitions & VAD_SEGMENTER_SPLIT)
+  {
+    // emit_speech_end() streams whatever is left of the segment
+    split_speech(handle);
+  }
+  else if (segmenter->is_speaking && segmenter->has_emitted_real_start)
+  {
+    // Confirmed speech is streamed as it arrives, starting with the pre-speech pad
+    stream_speech_chunks(handle, 0);
+  }
+
+  // Remember this frame for the pre-speech pad of a later segment. The current
+  // frame is not part of its own pad, so it is not duplicated at the start of
+  // the segment.
+  if (config->pre_speech_pad_frames > 0 && handle->store_speech)
+  {
+    memcpy(handle->pre_speech + (size_t)handle->pre_speech_next * frame_samples, frame,
+           (size_t)frame_samples * sizeof(float));
+    handle->pre_speech_next = (handle->pre_speech_next + 1) % config->pre_speech_pad_frames;
+    if (handle->pre_speech_count < config->pre_speech_pad_frames)
+      handle->pre_speech_count++;
+  }
+}
+
+/// Run the VAD logic on the frame in the input window once its probability is known
+static void finish_frame(VADHandle *handle, float probability)
+{
+  const float *frame = handle->input + handle->context_size;
+  int32_t frame_index = (int32_t)handle->segmenter.frame_index;
+
+  // Send frame processed event
+  send_frame_event(handle, probability, frame, handle->config.frame_samples);
+
+  uint64_t traced = vad_tracer_now(handle->trace);
+  process_vad_logic(handle, frame, probability);
+  vad_status_publish_frame(handle->status, probability, handle->segmenter.is_speaking);
+  publish_speech_stats(handle);
+  if (traced != 0)
+    vad_tracer_record(handle->trace, VAD_TRACE_VAD_LOGIC, frame_index, traced, 0);
+
+  // Update context buffer with the tail of this frame
+  memcpy(handle->input, frame + handle->config.frame_samples - handle->context_size,
+         (size_t)handle->context_size * sizeof(float));
+}
+
+/// Microseconds since a vad_now_ns() reading
+static float elapsed_us(uint64_t start)
+{
+  return (float)((double)(vad_now_ns() - start) / 1e3);
+}
+
+/// Run dummy frames on scratch state; the handle's state and context are not touched
+/// @return 0 on success, -2 if the input buffer could not be allocated
+static int32_t run_prewarm(VADHandle *handle, int32_t frames)
+{
+  const VADModelRate *rate = handle->rate;
+  int32_t length = rate->context_size + rate->frame_samples;
+  float *input = (float *)vad_aligned_alloc((size_t)length * sizeof(float));
+  if (input == NULL)
+    return -2;
+  float state[VAD_MODEL_STATE_SIZE];
+  memset(state, 0, sizeof(state));
+
+  uint64_t traced = vad_tracer_now(handle->trace);
+  double warm_total = 0.0;
+  int32_t warm_count = 0;
+  uint32_t seed = 1;
+  for (int32_t f = 0; f < frames; f++)
+  {
+    // Low-level noise (about -40 dBFS); any input runs the same kernels
+    for (int32_t i = 0; i < length; i++)
+    {
+      seed = seed * 1664525u + 1013904223u;
+      input[i] = ((float)(seed >> 8) / 16777216.0f - 0.5f) * 0.02f;
+    }
+    uint64_t start = vad_now_ns();
+    vad_model_infer(rate, input, state);
+    float us = elapsed_us(start);
+    if (handle->warmup.cold_frame_us == 0.0f)
+      handle->warmup.cold_frame_us = us;
+    if (f >= frames / 2)
+    {
+      warm_total += us;
+      warm_count++;
+    }
+  }
+  vad_aligned_free(input);
+  if (traced != 0)
+    vad_tracer_record(handle->trace, VAD_TRACE_PREWARM, frames, traced, 0);
+
+  handle->warmup.prewarm_frames = frames;
+  handle->warmup.warm_frame_us = warm_count > 0 ? (float)(warm_total / warm_count) : 0.0f;
+  return 0;
+}
+
+static vad_thread_result_t VAD_THREAD_CALL prewarm_entry(void *arg)
+{
+  VADHandle *handle = (VADHandle *)arg;
+  run_prewarm(handle, handle->config.prewarm_frames);
+  return (vad_thread_result_t)0;
+}
+
+/// Wait for the background warm-up started by vad_init(), if it is running
+static void wait_prewarm(VADHandle *handle)
+{
+  if (!handle->prewarm_running)
+    return;
+  vad_thread_join(handle->prewarm_thread);
+  handle->prewarm_running = 0;
+}
+
+/// Record the latency of the first real frame after vad_init()
+static void record_first_frame(VADHandle *handle, float us)
+{
+  handle->warmup.first_frame_us = us;
+  if (handle->warmup.cold_frame_us == 0.0f)
+    handle->warmup.cold_frame_us = us;
+  handle->first_frame_pending = 0;
+}
+
+/// Run the silence gate on the frame in the input window
+/// @return 1 if the frame skips the model, 0 if it is to be inferred
+static int32_t gate_frame(VADHandle *handle)
+{
+  int32_t decision = vad_gate_push(handle->gate, handle->input + handle->context_size, handle->config.frame_samples);
+  if (decision == VAD_GATE_SKIP)
+  {
+    vad_stats_add_gated(handle->stats);
+    return 1;
+  }
+  // After a gap the LSTM state of the last inferred frame is stale. On
+  // synthetic audio, restarting it from zero as at the start of a stream
+  // tracked the ungated probabilities more closely than carrying it over
+  if (decision == VAD_GATE_RESUME)
+    memset(handle->state, 0, sizeof(handle->state));
+  return 0;
+}
+
+static void process_frame(VADHandle *handle)
+{
+  if (handle->first_frame_pending)
+    wait_prewarm(handle);
+
+  // Tracing reuses the frame timing, so it adds no clock reads here
+  uint64_t traced = vad_tracer_now(handle->trace);
+  uint64_t start = traced != 0 ? traced : vad_now_ns();
+  int32_t frame_index = (int32_t)handle->segmenter.frame_index;
+  if (gate_frame(handle))
+  {
+    finish_frame(handle, 0.0f);
+    if (traced != 0)
+      vad_tracer_record(handle->trace, VAD_TRACE_FRAME, frame_index, start, 0);
+    return;
+  }
+
+  float probability = vad_model_infer(handle->rate, handle->input, handle->state);
+  uint64_t inferred = vad_now_ns();
+  if (handle->first_frame_pending)
+    record_first_frame(handle, (float)((double)(inferred - start) / 1e3));
+  finish_frame(handle, probability);
+  uint64_t end = vad_now_ns();
+  vad_stats_record_frame(handle->stats, inferred - start, end - start, handle->frame_budget_ns);
+  if (traced != 0)
+  {
+    vad_tracer_record(handle->trace, VAD_TRACE_INFERENCE, frame_index, start, inferred);
+    vad_tracer_record(handle->trace, VAD_TRACE_FRAME, frame_index, start, end);
+  }
+}
+
+/// Handles can share a batched model run when their weights and sample rate match
+static int32_t same_weights(const VADHandle *a, const VADHandle *b)
+{
+  return a->rate->sample_rate == b->rate->sample_rate && a->model->fingerprint == b->model->fingerprint;
+}
+
+// ============================================================================
+// FFI Exports
+// ============================================================================
 
 FFI_PLUGIN_EXPORT void vad_config_default(VADConfig *config_out)
 {
@@ -41,99 +717,766 @@ FFI_PLUGIN_EXPORT void vad_config_default(VADConfig *config_out)
   config_out->frame_samples = 512;
   config_out->end_speech_pad_frames = 3;
   config_out->is_debug = 0;
+  config_out->speech_chunk_samples = 0;
+  config_out->max_speech_frames = 938;
+  config_out->speech_end_by_reference = 0;
+  config_out->input_sample_rate = 0;
+  config_out->prefer_int8_model = 0;
+  config_out->prewarm_frames = 0;
+  config_out->silence_gate_frames = 0;
+  config_out->silence_gate_dbfs = -55.0f;
+  config_out->silence_gate_noise_margin_db = 0.0f;
 }
 
 FFI_PLUGIN_EXPORT VADHandle *vad_create(void)
 {
-  // Return a dummy non-null pointer for error handling
-  return (VADHandle *)1;
+  VADHandle *handle = (VADHandle *)calloc(1, sizeof(VADHandle));
+  if (handle == NULL)
+    return NULL;
+  handle->events = vad_event_pool_create(VAD_EVENT_POOL_SLOTS, VAD_EVENT_INLINE_BYTES);
+  handle->status = vad_status_create();
+  handle->stats = vad_stats_create();
+  handle->trace = vad_tracer_create();
+  handle->gate = vad_gate_create();
+  if (handle->events == NULL || handle->status == NULL || handle->stats == NULL || handle->trace == NULL ||
+      handle->gate == NULL)
+  {
+    vad_event_pool_close(handle->events);
+    vad_status_destroy(handle->status);
+    vad_stats_destroy(handle->stats);
+    vad_tracer_destroy(handle->trace);
+    vad_gate_destroy(handle->gate);
+    free(handle);
+    return NULL;
+  }
+  vad_config_default(&handle->config);
+  vad_mutex_init(&handle->callback_lock);
+  handle->event_mask = VAD_EVENT_MASK_ALL;
+  handle->frame_event_interval = 1;
+  return handle;
 }
 
 FFI_PLUGIN_EXPORT void vad_destroy(VADHandle *handle)
 {
-  (void)handle;
+  if (handle == NULL)
+    return;
+  wait_prewarm(handle);
+  vad_invalidate_callback(handle);
+  vad_event_pool_close(handle->events);
+  vad_status_destroy(handle->status);
+  free_buffers(handle);
+  vad_stats_destroy(handle->stats);
+  vad_tracer_destroy(handle->trace);
+  vad_gate_destroy(handle->gate);
+  release_model(handle);
+  vad_mutex_destroy(&handle->callback_lock);
+  free(handle);
+}
+
+/// Validate the configuration and drop the handle's previous model and buffers
+static int32_t init_begin(VADHandle *handle, const VADConfig *config)
+{
+  wait_prewarm(handle);
+  handle->initialized = 0;
+  handle->rate = NULL;
+  free_buffers(handle);
+  release_model(handle);
+
+  if (config->sample_rate != 16000 && config->sample_rate != 8000)
+  {
+    set_error(handle, "Unsupported sample rate %d (expected 16000 or 8000)", config->sample_rate);
+    return -1;
+  }
+  if (config->pre_speech_pad_frames < 0 || config->redemption_frames < 0 || config->min_speech_frames < 0 ||
+      config->speech_chunk_samples < 0 || config->max_speech_frames < 0 || config->prewarm_frames < 0 ||
+      config->silence_gate_frames < 0)
+  {
+    set_error(handle, "Frame counts and chunk sizes in VADConfig must not be negative");
+    return -1;
+  }
+  if (config->max_speech_frames != 0 && config->max_speech_frames < config->min_speech_frames)
+  {
+    set_error(handle, "max_speech_frames must be 0 or at least min_speech_frames");
+    return -1;
+  }
+  if (config->silence_gate_noise_margin_db < 0.0f)
+  {
+    set_error(handle, "silence_gate_noise_margin_db must not be negative");
+    return -1;
+  }
+  handle->config = *config;
+  vad_segmenter_init(&handle->segmenter, config);
+  vad_gate_configure(handle->gate, config->silence_gate_frames, config->silence_gate_dbfs,
+                     config->silence_gate_noise_margin_db);
+  return 0;
+}
+
+/// Bind the acquired model to the handle and allocate its buffers
+static int32_t init_finish(VADHandle *handle, const VADConfig *config)
+{
+  handle->rate = vad_model_get_rate(handle->model, config->sample_rate);
+  if (handle->rate == NULL)
+  {
+    set_error(handle, "Model has no weights for sample rate %d", config->sample_rate);
+    release_model(handle);
+    return -2;
+  }
+  if (config->frame_samples != handle->rate->frame_samples)
+  {
+    set_error(handle, "frame_samples must be %d for %d Hz", handle->rate->frame_samples, config->sample_rate);
+    release_model(handle);
+    return -1;
+  }
+
+  if (handle->rate->quantized)
+    log_debug(handle, "Model weights are int8-quantized");
+
+  handle->context_size = handle->rate->context_size;
+  handle->frame_budget_ns = (uint64_t)config->frame_samples * 1000000000ull / (uint64_t)config->sample_rate;
+  handle->store_speech = !config->speech_end_by_reference || config->speech_chunk_samples > 0;
+  int32_t pad_frames = handle->store_speech ? config->pre_speech_pad_frames : 0;
+  int32_t bounded = handle->store_speech && config->max_speech_frames > 0;
+  handle->input = (float *)vad_aligned_alloc((size_t)(handle->context_size + config->frame_samples) * sizeof(float));
+  if (pad_frames > 0)
+    handle->pre_speech = (float *)malloc((size_t)pad_frames * config->frame_samples * sizeof(float));
+  if (bounded)
+  {
+    handle->speech_capacity =
+        (size_t)(config->pre_speech_pad_frames + config->max_speech_frames) * (size_t)config->frame_samples;
+    handle->speech = (int16_t *)malloc(handle->speech_capacity * sizeof(int16_t));
+  }
+  if (config->input_sample_rate != 0 && config->input_sample_rate != config->sample_rate)
+  {
+    handle->resampler = vad_resampler_create(config->input_sample_rate, config->sample_rate);
+    if (handle->resampler == NULL)
+    {
+      set_error(handle, "Unsupported input sample rate %d", config->input_sample_rate);
+      free_buffers(handle);
+      release_model(handle);
+      return -1;
+    }
+    handle->resampled = (float *)vad_aligned_alloc(2 * VAD_RESAMPLER_BLOCK * sizeof(float));
+  }
+  if (handle->input == NULL || (pad_frames > 0 && handle->pre_speech == NULL) || (bounded && handle->speech == NULL) ||
+      (handle->resampler != NULL && handle->resampled == NULL))
+  {
+    set_error(handle, "Out of memory");
+    free_buffers(handle);
+    release_model(handle);
+    return -2;
+  }
+
+  reset_states(handle);
+  memset(&handle->warmup, 0, sizeof(handle->warmup));
+  handle->first_frame_pending = 1;
+  handle->initialized = 1;
+  log_debug(handle, "Initialized (%d Hz, %d samples per frame)", config->sample_rate, config->frame_samples);
+  if (handle->resampler != NULL)
+    log_debug(handle, "Resampling %d Hz input (%d taps)", config->input_sample_rate,
+              vad_resampler_taps(handle->resampler));
+
+  // Background warm-up; without a thread it runs here instead
+  if (config->prewarm_frames > 0)
+  {
+    handle->prewarm_running = vad_thread_create(&handle->prewarm_thread, prewarm_entry, handle) == 0;
+    if (!handle->prewarm_running)
+      run_prewarm(handle, config->prewarm_frames);
+  }
+
+  send_event(handle, VAD_EVENT_INITIALIZED);
+  return 0;
 }
 
 FFI_PLUGIN_EXPORT int32_t vad_init(VADHandle *handle, const VADConfig *config, const char *model_path)
 {
-  (void)handle;
-  (void)config;
-  (void)model_path;
-  return -100; // Platform not supported
+  if (handle == NULL || config == NULL)
+    return -1;
+  int32_t result = init_begin(handle, config);
+  if (result != 0)
+    return result;
+
+  // Find model path
+  char bundled_path[1024];
+  const char *final_model_path = model_path;
+  int32_t use_bundled = final_model_path == NULL || final_model_path[0] == '\0';
+  result = -2;
+  if (use_bundled && config->prefer_int8_model &&
+      find_bundled_model(kBundledInt8ModelNames, sizeof(kBundledInt8ModelNames) / sizeof(kBundledInt8ModelNames[0]),
+                         bundled_path, sizeof(bundled_path)) == 0)
+  {
+    log_debug(handle, "Loading model: %s", bundled_path);
+    result = vad_model_cache_acquire(bundled_path, &handle->model, handle->last_error, sizeof(handle->last_error));
+    if (result == 0 && vad_model_get_rate(handle->model, config->sample_rate) == NULL)
+    {
+      snprintf(handle->last_error, sizeof(handle->last_error), "no weights for %d Hz", config->sample_rate);
+      release_model(handle);
+      result = -2;
+    }
+    if (result != 0)
+      log_debug(handle, "Int8 model not usable (%s), falling back to fp32", handle->last_error);
+  }
+
+  if (result != 0)
+  {
+    if (use_bundled)
+    {
+      if (find_bundled_model(kBundledModelNames, sizeof(kBundledModelNames) / sizeof(kBundledModelNames[0]),
+                             bundled_path, sizeof(bundled_path)) != 0)
+      {
+        set_error(handle, "ONNX model not found next to the library or provided path");
+        return -2;
+      }
+      final_model_path = bundled_path;
+    }
+    log_debug(handle, "Loading model: %s", final_model_path);
+
+    result = vad_model_cache_acquire(final_model_path, &handle->model, handle->last_error, sizeof(handle->last_error));
+    if (result != 0)
+      return result;
+  }
+
+  return init_finish(handle, config);
+}
+
+FFI_PLUGIN_EXPORT int32_t vad_init_from_memory(VADHandle *handle, const VADConfig *config, const void *data,
+                                               size_t length)
+{
+  if (handle == NULL || config == NULL || data == NULL || length == 0)
+    return -1;
+  int32_t result = init_begin(handle, config);
+  if (result != 0)
+    return result;
+
+  log_debug(handle, "Loading model from memory (%zu bytes)", length);
+  result = vad_model_cache_acquire_buffer(data, length, &handle->model, handle->last_error,
+                                          sizeof(handle->last_error));
+  if (result != 0)
+    return result;
+  return init_finish(handle, config);
 }
 
 FFI_PLUGIN_EXPORT void vad_set_callback(VADHandle *handle, VADEventCallback callback, void *user_data)
 {
-  (void)handle;
-  (void)callback;
-  (void)user_data;
+  if (handle == NULL)
+    return;
+  vad_mutex_lock(&handle->callback_lock);
+  handle->callback = callback;
+  handle->user_data = user_data;
+  handle->callback_valid = callback != NULL;
+  vad_mutex_unlock(&handle->callback_lock);
 }
 
 FFI_PLUGIN_EXPORT void vad_invalidate_callback(VADHandle *handle)
 {
-  (void)handle;
+  if (handle == NULL)
+    return;
+  vad_mutex_lock(&handle->callback_lock);
+  handle->callback_valid = 0;
+  handle->callback = NULL;
+  handle->user_data = NULL;
+  vad_mutex_unlock(&handle->callback_lock);
+}
+
+FFI_PLUGIN_EXPORT void vad_set_event_mask(VADHandle *handle, uint32_t mask)
+{
+  if (handle == NULL)
+    return;
+  handle->event_mask = mask;
+}
+
+FFI_PLUGIN_EXPORT void vad_set_frame_event_interval(VADHandle *handle, int32_t interval)
+{
+  if (handle == NULL)
+    return;
+  handle->frame_event_interval = interval > 1 ? interval : 1;
 }
 
 FFI_PLUGIN_EXPORT int32_t vad_start(VADHandle *handle)
 {
-  (void)handle;
-  return -100; // Platform not supported
+  if (handle == NULL)
+    return -1;
+  if (!handle->initialized)
+  {
+    set_error(handle, "VAD not initialized");
+    return -2;
+  }
+  // No capture backend on this platform; audio is fed with vad_process_audio()
+  set_error(handle, "Microphone capture is not supported on this platform, use vad_process_audio");
+  return -100;
 }
 
 FFI_PLUGIN_EXPORT void vad_stop(VADHandle *handle)
 {
-  (void)handle;
+  if (handle == NULL)
+    return;
+  reset_states(handle);
+  send_event(handle, VAD_EVENT_STOPPED);
+}
+
+/// Layout of caller audio (vad_process_audio_ex)
+typedef struct InputLayout
+{
+  VADSampleFormat format;
+  int32_t channels;
+  int32_t stride;
+} InputLayout;
+
+static const InputLayout kMonoFloat = {VAD_SAMPLE_FORMAT_F32, 1, 1};
+
+/// Convert count frames of data, starting at frame first, to mono float
+static void convert_input(const void *data, const InputLayout *layout, int32_t first, float *dst, int32_t count)
+{
+  int64_t offset = (int64_t)first * layout->stride;
+  if (layout->format == VAD_SAMPLE_FORMAT_S16)
+    vad_convert_s16_frames_to_f32((const int16_t *)data + offset, layout->channels, layout->stride, dst, count);
+  else
+    vad_convert_f32_frames_to_f32((const float *)data + offset, layout->channels, layout->stride, dst, count);
+}
+
+/// Split frames at the model rate into model frames, converting them straight
+/// into the frame slot, and process each full one
+static void feed_frames(VADHandle *handle, const void *data, const InputLayout *layout, int32_t frames)
+{
+  int32_t frame_samples = handle->config.frame_samples;
+  float *frame = handle->input + handle->context_size;
+
+  for (int32_t offset = 0; offset < frames;)
+  {
+    int32_t count = frame_samples - handle->pending_samples;
+    if (count > frames - offset)
+      count = frames - offset;
+
+    convert_input(data, layout, offset, frame + handle->pending_samples, count);
+    handle->pending_samples += count;
+    offset += count;
+
+    if (handle->pending_samples == frame_samples)
+    {
+      process_frame(handle);
+      handle->pending_samples = 0;
+    }
+  }
+  vad_stats_set_queued(handle->stats, handle->pending_samples);
+}
+
+/// Resample mono float input to the model rate and frame it
+static void resample_frames(VADHandle *handle, const float *samples, int32_t sample_count)
+{
+  for (;;)
+  {
+    int32_t used;
+    int32_t produced = vad_resampler_process(handle->resampler, samples, sample_count, &used, handle->resampled,
+                                             VAD_RESAMPLER_BLOCK);
+    samples += used;
+    sample_count -= used;
+    feed_frames(handle, handle->resampled, &kMonoFloat, produced);
+    if (produced < VAD_RESAMPLER_BLOCK)
+      break;
+  }
+}
+
+static void process_input(VADHandle *handle, const void *data, const InputLayout *layout, int32_t frames)
+{
+  uint64_t traced = vad_tracer_now(handle->trace);
+  if (handle->resampler == NULL)
+  {
+    feed_frames(handle, data, layout, frames);
+  }
+  else if (layout->format == VAD_SAMPLE_FORMAT_F32 && layout->stride == 1)
+  {
+    resample_frames(handle, (const float *)data, frames);
+  }
+  else
+  {
+    // The resampler takes mono float: convert a block at a time
+    float *converted = handle->resampled + VAD_RESAMPLER_BLOCK;
+    for (int32_t offset = 0; offset < frames; offset += VAD_RESAMPLER_BLOCK)
+    {
+      int32_t count = frames - offset < VAD_RESAMPLER_BLOCK ? frames - offset : VAD_RESAMPLER_BLOCK;
+      convert_input(data, layout, offset, converted, count);
+      resample_frames(handle, converted, count);
+    }
+  }
+  if (traced != 0)
+    vad_tracer_record(handle->trace, VAD_TRACE_PROCESS_AUDIO, frames, traced, 0);
 }
 
 FFI_PLUGIN_EXPORT int32_t vad_process_audio(VADHandle *handle, const float *samples, int32_t sample_count)
 {
-  (void)handle;
-  (void)samples;
-  (void)sample_count;
-  return -100; // Platform not supported
+  if (handle == NULL || samples == NULL || sample_count <= 0)
+    return -1;
+  if (!handle->initialized)
+  {
+    set_error(handle, "VAD not initialized");
+    return -2;
+  }
+
+  process_input(handle, samples, &kMonoFloat, sample_count);
+  return 0;
+}
+
+FFI_PLUGIN_EXPORT int32_t vad_process_audio_ex(VADHandle *handle, const void *data, int32_t frames,
+                                               VADSampleFormat format, int32_t channels, int32_t stride)
+{
+  if (handle == NULL || data == NULL || frames <= 0)
+    return -1;
+  if (!handle->initialized)
+  {
+    set_error(handle, "VAD not initialized");
+    return -2;
+  }
+  if (format != VAD_SAMPLE_FORMAT_F32 && format != VAD_SAMPLE_FORMAT_S16)
+  {
+    set_error(handle, "Unsupported sample format %d", (int)format);
+    return -1;
+  }
+  if (stride == 0)
+    stride = channels;
+  if (channels < 1 || stride < channels)
+  {
+    set_error(handle, "Invalid layout: %d channels with stride %d", channels, stride);
+    return -1;
+  }
+
+  InputLayout layout = {format, channels, stride};
+  process_input(handle, data, &layout, frames);
+  return 0;
+}
+
+FFI_PLUGIN_EXPORT int32_t vad_process_batch(VADHandle *const *handles, const float *const *frames, int32_t count)
+{
+  if (handles == NULL || frames == NULL || count <= 0)
+    return -1;
+
+  for (int32_t i = 0; i < count; i++)
+  {
+    if (handles[i] == NULL || frames[i] == NULL)
+      return -1;
+    if (!handles[i]->initialized)
+    {
+      set_error(handles[i], "VAD not initialized");
+      return -2;
+    }
+    wait_prewarm(handles[i]);
+    if (handles[i]->resampler != NULL)
+    {
+      set_error(handles[i], "vad_process_batch takes frames at sample_rate, input_sample_rate is not supported");
+      return -1;
+    }
+    for (int32_t j = 0; j < i; j++)
+    {
+      if (handles[j] == handles[i])
+      {
+        set_error(handles[i], "Handle appears more than once in batch");
+        return -1;
+      }
+    }
+  }
+
+  // Model arguments of the current group, and results per handle
+  size_t pointer_bytes = (size_t)count * (sizeof(const float *) + sizeof(float *));
+  size_t value_bytes = (size_t)count * (3 * sizeof(float) + 3 * sizeof(int32_t));
+  char *scratch = (char *)malloc(pointer_bytes + value_bytes);
+  if (scratch == NULL)
+  {
+    set_error(handles[0], "Out of memory");
+    return -2;
+  }
+  const float **inputs = (const float **)scratch;
+  float **states = (float **)(inputs + count);
+  float *group_probabilities = (float *)(states + count);
+  float *probabilities = group_probabilities + count;
+  float *inference_us = probabilities + count;
+  int32_t *members = (int32_t *)(inference_us + count);
+  int32_t *done = members + count;
+  int32_t *gated = done + count;
+
+  // Complete each handle's pending frame from the front of its input; frames
+  // the silence gate holds back stay out of the model run
+  for (int32_t i = 0; i < count; i++)
+  {
+    VADHandle *handle = handles[i];
+    float *frame = handle->input + handle->context_size;
+    int32_t needed = handle->config.frame_samples - handle->pending_samples;
+    memcpy(frame + handle->pending_samples, frames[i], (size_t)needed * sizeof(float));
+    gated[i] = gate_frame(handle);
+    done[i] = gated[i];
+    probabilities[i] = 0.0f;
+  }
+
+  // One model run per group of handles with identical weights
+  for (int32_t i = 0; i < count; i++)
+  {
+    if (done[i])
+      continue;
+
+    int32_t group = 0;
+    for (int32_t j = i; j < count; j++)
+    {
+      if (done[j] || !same_weights(handles[i], handles[j]))
+        continue;
+      done[j] = 1;
+      members[group] = j;
+      inputs[group] = handles[j]->input;
+      states[group] = handles[j]->state;
+      group++;
+    }
+
+    uint64_t start = vad_now_ns();
+    if (vad_model_infer_batch(handles[i]->rate, inputs, states, group, group_probabilities) != 0)
+    {
+      // Scratch allocation failed; fall back to one stream at a time
+      for (int32_t k = 0; k < group; k++)
+        group_probabilities[k] = vad_model_infer(handles[i]->rate, inputs[k], states[k]);
+    }
+    uint64_t end = vad_now_ns();
+    float frame_us = (float)((double)(end - start) / 1e3) / (float)group;
+    for (int32_t k = 0; k < group; k++)
+    {
+      VADHandle *member = handles[members[k]];
+      probabilities[members[k]] = group_probabilities[k];
+      inference_us[members[k]] = frame_us;
+      // A first frame run in a batch is charged its share of the pass
+      if (member->first_frame_pending)
+        record_first_frame(member, frame_us);
+      // Each traced handle shows the whole shared pass
+      if (vad_tracer_now(member->trace) != 0)
+        vad_tracer_record(member->trace, VAD_TRACE_INFERENCE, (int32_t)member->segmenter.frame_index, start, end);
+    }
+  }
+
+  // VAD logic and events in caller order, then keep the leftover samples pending
+  for (int32_t i = 0; i < count; i++)
+  {
+    VADHandle *handle = handles[i];
+    uint64_t start = vad_now_ns();
+    finish_frame(handle, probabilities[i]);
+    // inference_us is only written for handles that ran the model
+    if (!gated[i])
+    {
+      uint64_t inference_ns = (uint64_t)(inference_us[i] * 1e3f);
+      vad_stats_record_frame(handle->stats, inference_ns, inference_ns + (vad_now_ns() - start),
+                             handle->frame_budget_ns);
+    }
+
+    int32_t pending = handle->pending_samples;
+    int32_t used = handle->config.frame_samples - pending;
+    memcpy(handle->input + handle->context_size, frames[i] + used, (size_t)pending * sizeof(float));
+  }
+
+  free(scratch);
+  return 0;
 }
 
 FFI_PLUGIN_EXPORT void vad_reset(VADHandle *handle)
 {
-  (void)handle;
+  if (handle == NULL)
+    return;
+  reset_states(handle);
 }
 
 FFI_PLUGIN_EXPORT void vad_force_end_speech(VADHandle *handle)
 {
-  (void)handle;
+  if (handle == NULL)
+    return;
+
+  if (vad_segmenter_close(&handle->segmenter))
+    emit_speech_end(handle);
+  reset_speech(handle);
 }
 
 FFI_PLUGIN_EXPORT int32_t vad_is_speaking(VADHandle *handle)
 {
-  (void)handle;
+  if (handle == NULL)
+    return 0;
+  return handle->segmenter.is_speaking ? 1 : 0;
+}
+
+FFI_PLUGIN_EXPORT const VADStatusBlock *vad_get_status_block(VADHandle *handle)
+{
+  if (handle == NULL)
+    return NULL;
+  return handle->status;
+}
+
+FFI_PLUGIN_EXPORT int32_t vad_prewarm(VADHandle *handle, int32_t n_frames)
+{
+  if (handle == NULL)
+    return -1;
+  if (!handle->initialized)
+  {
+    set_error(handle, "VAD not initialized");
+    return -2;
+  }
+  if (n_frames <= 0)
+  {
+    set_error(handle, "n_frames must be positive");
+    return -1;
+  }
+
+  wait_prewarm(handle);
+  if (run_prewarm(handle, n_frames) != 0)
+  {
+    set_error(handle, "Out of memory");
+    return -2;
+  }
+  log_debug(handle, "Prewarmed %d frames: cold %.1f us, warm %.1f us per frame", n_frames,
+            handle->warmup.cold_frame_us, handle->warmup.warm_frame_us);
   return 0;
 }
 
-FFI_PLUGIN_EXPORT const char *vad_get_last_error(VADHandle *handle)
+FFI_PLUGIN_EXPORT int32_t vad_get_warmup_info(VADHandle *handle, VADWarmupInfo *info_out)
 {
-  (void)handle;
-  return stub_error;
+  if (handle == NULL || info_out == NULL)
+    return -1;
+  wait_prewarm(handle);
+  *info_out = handle->warmup;
+  return 0;
 }
 
-FFI_PLUGIN_EXPORT void vad_float_to_pcm16(const float *float_samples, int16_t *pcm16_samples, int32_t sample_count)
+FFI_PLUGIN_EXPORT int32_t vad_get_stats(VADHandle *handle, VADStats *stats_out)
 {
-  for (int32_t i = 0; i < sample_count; i++)
+  if (handle == NULL || stats_out == NULL)
+    return -1;
+  vad_stats_read(handle->stats, handle->events, stats_out);
+  return 0;
+}
+
+FFI_PLUGIN_EXPORT int32_t vad_trace_start(VADHandle *handle, int32_t events_per_thread)
+{
+  if (handle == NULL)
+    return -1;
+  if (events_per_thread < 0)
   {
-    float clamped = float_samples[i];
-    if (clamped > 1.0f)
-      clamped = 1.0f;
-    if (clamped < -1.0f)
-      clamped = -1.0f;
-    pcm16_samples[i] = (int16_t)(clamped * 32767.0f);
+    set_error(handle, "events_per_thread must not be negative");
+    return -1;
   }
+  vad_tracer_start(handle->trace, events_per_thread);
+  return 0;
 }
 
-FFI_PLUGIN_EXPORT void vad_pcm16_to_float(const int16_t *pcm16_samples, float *float_samples, int32_t sample_count)
+FFI_PLUGIN_EXPORT void vad_trace_stop(VADHandle *handle)
+{
+  if (handle == NULL)
+    return;
+  vad_tracer_stop(handle->trace);
+}
+
+FFI_PLUGIN_EXPORT int32_t vad_trace_dump(VADHandle *handle, const char *path)
+{
+  if (handle == NULL || path == NULL)
+    return -1;
+  return vad_tracer_write_json(handle->trace, path, handle->last_error, sizeof(handle->last_error));
+}
+
+/// Segment a mapped file or wrapped buffer with the handle's model and config
+static int32_t segment_source(VADHandle *handle, const VADFile *source, const VADSegmentOptions *options,
+                              VADSegment **out_segments, int32_t *out_count)
 {
-  for (int32_t i = 0; i < sample_count; i++)
+  uint64_t start = vad_now_ns();
+  int32_t result = vad_offline_segment(handle->rate, &handle->config, source, options, out_segments, out_count);
+  if (result != 0)
   {
-    float_samples[i] = (float)pcm16_samples[i] / 32768.0f;
+    set_error(handle, "Out of memory");
+    return result;
   }
+  log_debug(handle, "Segmented %lld samples into %d segments in %.1f ms", (long long)source->frames, *out_count,
+            (double)(vad_now_ns() - start) / 1e6);
+  return 0;
 }
 
-#endif // IMPLEMENT_STUBS
+FFI_PLUGIN_EXPORT void vad_segment_options_default(VADSegmentOptions *options_out)
+{
+  if (options_out == NULL)
+    return;
+  options_out->threads = 0;
+  options_out->chunk_frames = 1875;
+  options_out->lead_in_frames = 0;
+}
+
+FFI_PLUGIN_EXPORT int32_t vad_segment_file(VADHandle *handle, const char *path, const VADSegmentOptions *options,
+                                           VADSegment **out_segments, int32_t *out_count)
+{
+  if (out_segments != NULL)
+    *out_segments = NULL;
+  if (out_count != NULL)
+    *out_count = 0;
+  if (handle == NULL || path == NULL || out_segments == NULL || out_count == NULL)
+    return -1;
+  if (!handle->initialized)
+  {
+    set_error(handle, "VAD not initialized");
+    return -2;
+  }
+
+  VADFile file;
+  int32_t result = vad_file_open(&file, path, handle->last_error, sizeof(handle->last_error));
+  if (result != 0)
+    return result;
+  if (file.sample_rate != 0 && file.sample_rate != handle->config.sample_rate)
+  {
+    set_error(handle, "Audio file is %d Hz, VAD is configured for %d Hz", file.sample_rate,
+              handle->config.sample_rate);
+    vad_file_close(&file);
+    return -2;
+  }
+
+  result = segment_source(handle, &file, options, out_segments, out_count);
+  vad_file_close(&file);
+  return result;
+}
+
+FFI_PLUGIN_EXPORT int32_t vad_segment_buffer(VADHandle *handle, const float *samples, int64_t sample_count,
+                                             const VADSegmentOptions *options, VADSegment **out_segments,
+                                             int32_t *out_count)
+{
+  if (out_segments != NULL)
+    *out_segments = NULL;
+  if (out_count != NULL)
+    *out_count = 0;
+  if (handle == NULL || samples == NULL || sample_count < 0 || out_segments == NULL || out_count == NULL)
+    return -1;
+  if (!handle->initialized)
+  {
+    set_error(handle, "VAD not initialized");
+    return -2;
+  }
+
+  // Read the buffer like a mapped mono float file
+  VADFile source;
+  memset(&source, 0, sizeof(source));
+  source.data = (const uint8_t *)samples;
+  source.frames = sample_count;
+  source.format = VAD_FILE_FORMAT_F32;
+  source.channels = 1;
+  source.bytes_per_frame = (int32_t)sizeof(float);
+  return segment_source(handle, &source, options, out_segments, out_count);
+}
+
+FFI_PLUGIN_EXPORT void vad_segments_free(VADSegment *segments)
+{
+  free(segments);
+}
+
+FFI_PLUGIN_EXPORT const char *vad_get_last_error(VADHandle *handle)
+{
+  if (handle == NULL)
+    return "Invalid handle";
+  return handle->last_error;
+}
+
+#endif // VAD_PLUS_NATIVE_ENGINE
+
+// ============================================================================
+// Sample Conversion (all platforms)
+// ============================================================================
+
+FFI_PLUGIN_EXPORT void vad_float_to_pcm16(const float *float_samples, int16_t *pcm16_samples, int32_t sample_count)
+{
+  vad_convert_f32_to_s16(float_samples, pcm16_samples, sample_count);
+}
+
+FFI_PLUGIN_EXPORT void vad_pcm16_to_float(const int16_t *pcm16_samples, float *float_samples, int32_t sample_count)
+{
+  vad_convert_s16_to_f32(pcm16_samples, float_samples, sample_count);
+}
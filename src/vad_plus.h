@@ -15,6 +15,11 @@
 #define FFI_PLUGIN_EXPORT __attribute__((visibility("default")))
 #endif
 
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
 // ============================================================================
 // VAD Configuration
 // ============================================================================
@@ -40,8 +45,59 @@ typedef struct VADConfig
     int32_t end_speech_pad_frames;
     /// Enable debug logging (0 = false, 1 = true, using int32_t for FFI compatibility)
     int32_t is_debug;
+    /// Stream confirmed speech as VAD_EVENT_SPEECH_CHUNK events of this many
+    /// samples (default: 0 = off, audio only arrives with VAD_EVENT_SPEECH_END)
+    int32_t speech_chunk_samples;
+    /// Longest segment in frames, pre-speech pad excluded (default: 938, about
+    /// 30 s). Longer confirmed speech is split into several segments; each
+    /// continuation needs min_speech_frames speech frames of its own, or ends as
+    /// a misfire. Segment storage is allocated once for this size. 0 =
+    /// unbounded, storage grows as needed; otherwise at least min_speech_frames.
+    int32_t max_speech_frames;
+    /// Send VAD_EVENT_SPEECH_END without audio, only the segment's sample
+    /// range, for callers that keep the input stream themselves (0 = false,
+    /// 1 = true, default: 0). Segment audio is then not stored at all, unless
+    /// speech_chunk_samples asks for chunks.
+    int32_t speech_end_by_reference;
+    /// Sample rate of the audio passed to vad_process_audio (default: 0 = same
+    /// as sample_rate). Any other rate from 4000 to 384000 Hz is resampled to
+    /// sample_rate before framing; sample positions in events still count
+    /// samples at sample_rate.
+    int32_t input_sample_rate;
+    /// Load the int8-quantized bundled model (silero_vad_v6_int8.onnx, written
+    /// by vad_plus_quantize) when no model path is given (0 = false, 1 = true,
+    /// default: 0). Falls back to the fp32 bundled model when it is missing or
+    /// does not load. A model path given to vad_init() is used as is, quantized
+    /// or not.
+    int32_t prefer_int8_model;
+    /// Dummy frames to run on a background thread right after vad_init(), as
+    /// vad_prewarm() would (default: 0 = none). The first real frame waits for
+    /// the warm-up to finish.
+    int32_t prewarm_frames;
+    /// Silence gate: once more than this many frames in a row are silent
+    /// (see silence_gate_dbfs), later silent frames skip model inference and
+    /// count as probability 0, until a frame is not silent (default: 0 = off,
+    /// every frame is inferred). The model's LSTM state restarts from zero
+    /// when inference resumes. Measured on synthetic audio only so far.
+    int32_t silence_gate_frames;
+    /// Frame RMS level in dBFS under which a frame is silent (default: -55).
+    /// A frame peaking 20 dB or more above it is never silent.
+    float silence_gate_dbfs;
+    /// Let the gate follow the background noise: frames within this many dB
+    /// of the tracked noise floor are silent too, as long as that stays under
+    /// -35 dBFS (default: 0 = fixed silence_gate_dbfs only)
+    float silence_gate_noise_margin_db;
 } VADConfig;
 
+/// Sample formats accepted by vad_process_audio_ex()
+typedef enum VADSampleFormat
+{
+    /// 32-bit float, normalized to -1.0 to 1.0
+    VAD_SAMPLE_FORMAT_F32 = 0,
+    /// Signed 16-bit PCM
+    VAD_SAMPLE_FORMAT_S16 = 1
+} VADSampleFormat;
+
 // ============================================================================
 // VAD Event Types
 // ============================================================================
@@ -56,60 +112,196 @@ typedef enum VADEventType
     VAD_EVENT_REAL_SPEECH_START = 4,
     VAD_EVENT_MISFIRE = 5,
     VAD_EVENT_ERROR = 6,
-    VAD_EVENT_STOPPED = 7
+    VAD_EVENT_STOPPED = 7,
+    VAD_EVENT_SPEECH_CHUNK = 8
 } VADEventType;
 
+/// Bit selecting one event type in an event mask
+#define VAD_EVENT_MASK(type) (1u << (type))
+
+/// Event mask enabling every event type (the default)
+#define VAD_EVENT_MASK_ALL 0xFFFFFFFFu
+
 // ============================================================================
-// VAD Event Data Structures
+// VAD Event Structure
 // ============================================================================
 
-/// Frame processed event data
-typedef struct VADFrameData
+/// VAD Event structure (flat for easier FFI).
+/// Only the fields belonging to the event type are set; the others are zero.
+typedef struct VADEvent
 {
+    /// Event type (VADEventType)
+    int32_t type;
+
+    // Frame data (VAD_EVENT_FRAME_PROCESSED)
     /// Speech probability (0.0 - 1.0)
-    float probability;
+    float frame_probability;
     /// Whether current frame is speech (0 = false, 1 = true)
-    int32_t is_speech;
+    int32_t frame_is_speech;
     /// Pointer to frame audio data (float32)
     const float *frame_data;
     /// Number of samples in frame
     int32_t frame_length;
-} VADFrameData;
 
-/// Speech end event data
-typedef struct VADSpeechEndData
-{
-    /// Pointer to PCM16 audio data
-    const int16_t *audio_data;
-    /// Number of samples
-    int32_t audio_length;
+    // Speech end data (VAD_EVENT_SPEECH_END)
+    /// Pointer to PCM16 audio data (NULL when speech_end_by_reference is set)
+    const int16_t *speech_end_audio_data;
+    /// Number of samples (0 when speech_end_by_reference is set)
+    int32_t speech_end_audio_length;
     /// Duration in milliseconds
-    int32_t duration_ms;
-} VADSpeechEndData;
+    int32_t speech_end_duration_ms;
 
-/// Error event data
-typedef struct VADErrorData
-{
+    // Error data (VAD_EVENT_ERROR)
     /// Error message
-    const char *message;
+    const char *error_message;
     /// Error code
-    int32_t code;
-} VADErrorData;
+    int32_t error_code;
+
+    // Speech chunk data (VAD_EVENT_SPEECH_CHUNK)
+    /// Pointer to PCM16 audio data
+    const int16_t *speech_chunk_audio_data;
+    /// Number of samples (speech_chunk_samples, except for the last chunk)
+    int32_t speech_chunk_audio_length;
+    /// Position of the first sample within the segment, pre-speech pad included
+    int32_t speech_chunk_offset;
+    /// 1 for the final chunk of the segment (which may be empty), sent just before VAD_EVENT_SPEECH_END
+    int32_t speech_chunk_is_last;
+
+    // Segment position (VAD_EVENT_SPEECH_START, VAD_EVENT_SPEECH_END, VAD_EVENT_MISFIRE)
+    /// First sample of the segment, pre-speech pad included, counted from the
+    /// first sample processed after vad_init(), vad_stop() or vad_reset()
+    int64_t segment_start_sample;
+    /// One past the last sample, trailing silence included (SPEECH_END and MISFIRE only)
+    int64_t segment_end_sample;
+} VADEvent;
+
+// ============================================================================
+// Status Block
+// ============================================================================
 
-/// Union for event data
-typedef union VADEventData
+/// Number of recent frame probabilities kept in VADStatusBlock.history
+#define VAD_STATUS_HISTORY 64
+
+/// Live handle status in native memory, for polling without a call per read
+/// (see vad_get_status_block). Every field is 32 bits wide; the first cache
+/// line holds the counters and the probability history starts on the next.
+///
+/// is_speaking is always safe to read on its own. The other fields are written
+/// under a seqlock: read sequence, then the fields, then sequence again, and
+/// retry if the two differ or are odd. The probability of frame n (counting
+/// from 0 since the last reset) is history[n % VAD_STATUS_HISTORY], so the
+/// newest entry is at (frame_count - 1) % VAD_STATUS_HISTORY.
+typedef struct VADStatusBlock
 {
-    VADFrameData frame;
-    VADSpeechEndData speech_end;
-    VADErrorData error;
-} VADEventData;
+    /// Seqlock counter, odd while the writer is updating
+    volatile uint32_t sequence;
+    /// 1 while speech is detected, 0 otherwise
+    volatile int32_t is_speaking;
+    /// Frames processed since the last reset (wraps at 2^32)
+    volatile uint32_t frame_count;
+    /// Speech probability of the latest frame
+    volatile float last_probability;
+    /// Number of entries in history (VAD_STATUS_HISTORY)
+    uint32_t history_length;
+    uint32_t reserved[11];
+    /// Ring of the latest frame probabilities
+    volatile float history[VAD_STATUS_HISTORY];
+} VADStatusBlock;
 
-/// VAD Event structure
-typedef struct VADEvent
+// ============================================================================
+// Warm-up
+// ============================================================================
+
+/// Cold versus warm inference latency of a handle (vad_get_warmup_info)
+typedef struct VADWarmupInfo
 {
-    VADEventType type;
-    VADEventData data;
-} VADEvent;
+    /// Frames run by the last warm-up (vad_prewarm or VADConfig.prewarm_frames), 0 if none
+    int32_t prewarm_frames;
+    /// Latency of the first inference after vad_init(), warm-up or real, in microseconds
+    float cold_frame_us;
+    /// Mean latency over the second half of the warm-up frames (0 without warm-up)
+    float warm_frame_us;
+    /// Latency of the first real frame after vad_init() (0 until it has run)
+    float first_frame_us;
+} VADWarmupInfo;
+
+// ============================================================================
+// Runtime Statistics
+// ============================================================================
+
+/// Counters and latency percentiles of a handle (vad_get_stats). Latencies
+/// come from log-bucketed histograms (8 buckets per power of two), so the
+/// percentiles are bucket midpoints within about 6% of the true value; max is
+/// exact. Everything counts from vad_init(), vad_stop() or vad_reset().
+typedef struct VADStats
+{
+    /// Frames run through the model
+    uint64_t frames_processed;
+    /// Frames whose processing (inference, VAD logic and callbacks) took
+    /// longer than the audio they hold, i.e. fell behind real time
+    uint64_t late_frames;
+    /// Captured samples dropped because the input queue was full (microphone
+    /// capture only; audio passed to vad_process_audio is never dropped)
+    uint64_t dropped_samples;
+    /// Events passed to the callback
+    uint64_t callbacks;
+    /// Model inference latency per frame, in microseconds
+    float inference_p50_us;
+    float inference_p95_us;
+    float inference_p99_us;
+    float inference_max_us;
+    /// Time spent in the callback per event, in microseconds
+    float callback_p50_us;
+    float callback_p95_us;
+    float callback_p99_us;
+    float callback_max_us;
+    /// Samples received but not yet processed (partial frame, plus captured
+    /// audio waiting for the inference thread)
+    int32_t queued_samples;
+    /// Events delivered but not yet returned with vad_event_release()
+    int32_t pending_events;
+    /// Bytes of PCM16 audio stored for the current speech segment
+    int64_t speech_buffer_bytes;
+    /// Bytes allocated for speech storage (segment buffer and pre-speech pad)
+    int64_t speech_capacity_bytes;
+    /// Frames the silence gate kept from the model (VADConfig.silence_gate_frames);
+    /// they are not in frames_processed
+    uint64_t gated_frames;
+    /// Events not delivered because too many were awaiting vad_event_release()
+    uint64_t dropped_events;
+} VADStats;
+
+// ============================================================================
+// Offline Segmentation
+// ============================================================================
+
+/// Speech segment found by vad_segment_file(), in samples from the start of the file
+typedef struct VADSegment
+{
+    /// First sample, pre-speech pad included
+    int64_t start_sample;
+    /// One past the last sample, trailing silence frames included
+    int64_t end_sample;
+} VADSegment;
+
+/// How vad_segment_file() / vad_segment_buffer() split the work. The audio is
+/// cut into chunks that run on a thread pool; each chunk after the first starts
+/// from a fresh model state, optionally run over lead-in frames before it. The
+/// speech hysteresis still runs over all frames in order, but the recurrent
+/// state carries a long memory, so the chunked result is approximate: on
+/// vad_plus_bench_segment's synthetic hour, 0.1-0.25% of speech samples move
+/// against the sequential pass (mostly one-frame boundary shifts), whatever
+/// the lead-in. Use chunk_frames = 0 when results must match streaming.
+typedef struct VADSegmentOptions
+{
+    /// Worker threads (default: 0 = one per CPU core)
+    int32_t threads;
+    /// Frames per chunk (default: 1875, 60 s); 0 = one chunk, exact but sequential
+    int32_t chunk_frames;
+    /// Frames run before a chunk, their probabilities discarded (default: 0).
+    /// Lead-ins of 8 to 512 frames measured no consistent gain over none.
+    int32_t lead_in_frames;
+} VADSegmentOptions;
 
 // ============================================================================
 // Callback Types
@@ -117,6 +309,8 @@ typedef struct VADEvent
 
 /// Callback function type for VAD events
 /// Note: Event is passed by pointer for C/Swift FFI compatibility
+/// The event and its data stay valid after the callback returns, until it is
+/// handed back with vad_event_release(); every delivered event must be released.
 typedef void (*VADEventCallback)(const VADEvent *event, void *user_data);
 
 // ============================================================================
@@ -149,6 +343,21 @@ FFI_PLUGIN_EXPORT void vad_destroy(VADHandle *handle);
 /// @return 0 on success, negative error code on failure
 FFI_PLUGIN_EXPORT int32_t vad_init(VADHandle *handle, const VADConfig *config, const char *model_path);
 
+/// Initialize VAD with configuration and a model held in memory, e.g. embedded
+/// in the application binary, instead of a file
+/// The buffer is borrowed: it is read during the call only, never copied or
+/// kept, so it may be read-only and can be freed as soon as the call returns.
+/// On iOS/macOS, where ONNX Runtime only opens model files, a model not seen
+/// before is written once to the temporary directory instead.
+/// prefer_int8_model is ignored; the buffer's model is used as is.
+/// @param handle VAD handle
+/// @param config Pointer to VAD configuration
+/// @param data Serialized ONNX model (silero_vad_v6.onnx or its int8 variant)
+/// @param length Size of data in bytes
+/// @return 0 on success, negative error code on failure
+FFI_PLUGIN_EXPORT int32_t vad_init_from_memory(VADHandle *handle, const VADConfig *config, const void *data,
+                                               size_t length);
+
 /// Set the event callback for VAD events
 /// @param handle VAD handle
 /// @param callback Event callback function
@@ -161,6 +370,19 @@ FFI_PLUGIN_EXPORT void vad_set_callback(VADHandle *handle, VADEventCallback call
 /// @param handle VAD handle
 FFI_PLUGIN_EXPORT void vad_invalidate_callback(VADHandle *handle);
 
+/// Choose which event types reach the callback
+/// Disabled types are skipped before any data is copied, so e.g. turning off
+/// VAD_EVENT_FRAME_PROCESSED removes the per-frame event cost entirely.
+/// @param handle VAD handle
+/// @param mask OR of VAD_EVENT_MASK(type) bits (default VAD_EVENT_MASK_ALL)
+FFI_PLUGIN_EXPORT void vad_set_event_mask(VADHandle *handle, uint32_t mask);
+
+/// Deliver only every Nth VAD_EVENT_FRAME_PROCESSED event
+/// The count restarts on vad_reset(); other event types are not affected.
+/// @param handle VAD handle
+/// @param interval Frames per delivered frame event (1 = every frame, the default)
+FFI_PLUGIN_EXPORT void vad_set_frame_event_interval(VADHandle *handle, int32_t interval);
+
 /// Start audio capture and VAD processing
 /// @param handle VAD handle
 /// @return 0 on success, negative error code on failure
@@ -173,11 +395,39 @@ FFI_PLUGIN_EXPORT void vad_stop(VADHandle *handle);
 /// Process audio samples directly (without microphone capture)
 /// Use this when you have your own audio source
 /// @param handle VAD handle
-/// @param samples Pointer to float32 audio samples (normalized -1.0 to 1.0)
+/// @param samples Pointer to float32 audio samples (normalized -1.0 to 1.0), at
+///                input_sample_rate when set
 /// @param sample_count Number of samples
 /// @return 0 on success, negative error code on failure
 FFI_PLUGIN_EXPORT int32_t vad_process_audio(VADHandle *handle, const float *samples, int32_t sample_count);
 
+/// Process PCM16 or float audio, mono or interleaved, converting it straight
+/// into the framing buffer without an intermediate float array. Each frame
+/// gives one mono sample: the average of channels adjacent samples, the next
+/// frame starting stride samples later. For interleaved stereo PCM16:
+///   downmix:        vad_process_audio_ex(handle, pcm, frames, VAD_SAMPLE_FORMAT_S16, 2, 2)
+///   right channel:  vad_process_audio_ex(handle, pcm + 1, frames, VAD_SAMPLE_FORMAT_S16, 1, 2)
+/// @param handle VAD handle
+/// @param data First sample of the first channel used, at input_sample_rate when set
+/// @param frames Number of frames
+/// @param format Sample format of data
+/// @param channels Number of adjacent channels averaged per frame (1 = take one channel as is)
+/// @param stride Samples from one frame to the next, at least channels (0 = channels)
+/// @return 0 on success, negative error code on failure
+FFI_PLUGIN_EXPORT int32_t vad_process_audio_ex(VADHandle *handle, const void *data, int32_t frames,
+                                               VADSampleFormat format, int32_t channels, int32_t stride);
+
+/// Process one frame for each of several VAD instances with a single batched
+/// model run. Equivalent to calling vad_process_audio() with frame_samples
+/// samples on each handle in turn, but instances loaded from the same model
+/// file with the same sample rate share one inference pass. Frames are at
+/// sample_rate; handles configured with input_sample_rate are rejected.
+/// @param handles Initialized VAD handles, each at most once
+/// @param frames One pointer per handle to frame_samples float32 samples
+/// @param count Number of handles
+/// @return 0 on success, negative error code on failure (nothing is processed)
+FFI_PLUGIN_EXPORT int32_t vad_process_batch(VADHandle *const *handles, const float *const *frames, int32_t count);
+
 /// Reset VAD state (clear buffers and speech detection state)
 /// @param handle VAD handle
 FFI_PLUGIN_EXPORT void vad_reset(VADHandle *handle);
@@ -191,6 +441,103 @@ FFI_PLUGIN_EXPORT void vad_force_end_speech(VADHandle *handle);
 /// @return 1 if speech is being detected, 0 otherwise
 FFI_PLUGIN_EXPORT int32_t vad_is_speaking(VADHandle *handle);
 
+/// Get the handle's live status block
+/// The block is owned by the handle and stays at the same address until
+/// vad_destroy(); readers poll it directly instead of calling vad_is_speaking().
+/// @param handle VAD handle
+/// @return Status block, or NULL if handle is NULL
+FFI_PLUGIN_EXPORT const VADStatusBlock *vad_get_status_block(VADHandle *handle);
+
+/// Run dummy frames through the model so that the first real frame does not
+/// pay one-time costs (allocator growth, lazy kernel and graph setup, cold
+/// caches). The frames run on scratch state: the handle's recurrent state,
+/// context and speech state are left as they were, and no events are sent.
+/// @param handle Initialized VAD handle
+/// @param n_frames Number of dummy frames (e.g. 8)
+/// @return 0 on success, negative error code on failure
+FFI_PLUGIN_EXPORT int32_t vad_prewarm(VADHandle *handle, int32_t n_frames);
+
+/// Get cold and warm per-frame latency measured since vad_init()
+/// Waits for a background warm-up (VADConfig.prewarm_frames) to finish.
+/// @param handle VAD handle
+/// @param info_out Receives the latencies
+/// @return 0 on success, negative error code on failure
+FFI_PLUGIN_EXPORT int32_t vad_get_warmup_info(VADHandle *handle, VADWarmupInfo *info_out);
+
+/// Get the handle's runtime counters and latency percentiles
+/// Recording is always on and costs a few clock reads and relaxed atomic adds
+/// per frame; this call may be made from any thread while audio is processed.
+/// @param handle VAD handle
+/// @param stats_out Receives the statistics
+/// @return 0 on success, negative error code on failure
+FFI_PLUGIN_EXPORT int32_t vad_get_stats(VADHandle *handle, VADStats *stats_out);
+
+/// Start recording a timeline of the handle's pipeline: capture, framing,
+/// inference, VAD logic, and each event's wait for the callback lock and time
+/// in the callback. Every thread records into its own lock-free ring, which
+/// keeps its latest events_per_thread spans. Spans of an earlier trace are
+/// discarded. While no trace is running each stage costs one flag check.
+/// @param handle VAD handle
+/// @param events_per_thread Spans kept per thread (0 for 65536, 1.5 MB)
+/// @return 0 on success, negative error code on failure
+FFI_PLUGIN_EXPORT int32_t vad_trace_start(VADHandle *handle, int32_t events_per_thread);
+
+/// Stop recording; the spans recorded so far are kept for vad_trace_dump()
+/// @param handle VAD handle
+FFI_PLUGIN_EXPORT void vad_trace_stop(VADHandle *handle);
+
+/// Write the spans of the last trace as Chrome trace-event JSON, which opens
+/// in Perfetto (ui.perfetto.dev) and chrome://tracing. Timestamps are in
+/// microseconds from vad_trace_start(); call vad_trace_stop() first for a
+/// consistent snapshot.
+/// @param handle VAD handle
+/// @param path File to write
+/// @return 0 on success, negative error code on failure
+FFI_PLUGIN_EXPORT int32_t vad_trace_dump(VADHandle *handle, const char *path);
+
+/// Return an event delivered to the callback to the handle's event pool
+/// Events may be released from any thread, including after vad_destroy().
+/// Release each event once: a repeated release is ignored only while the
+/// handle or another of its events is still alive.
+/// @param handle VAD handle the event came from (may be NULL)
+/// @param event Event received by the callback
+FFI_PLUGIN_EXPORT void vad_event_release(VADHandle *handle, const VADEvent *event);
+
+/// Fill segmentation options with their defaults (parallel on every core)
+/// @param options_out Pointer to VADSegmentOptions struct to fill
+FFI_PLUGIN_EXPORT void vad_segment_options_default(VADSegmentOptions *options_out);
+
+/// Find the speech segments of an audio file without feeding it through
+/// vad_process_audio(). The file is memory-mapped and streamed through the
+/// handle's model and config; no events are sent and no speech audio is
+/// copied. The segments are the ones VAD_EVENT_SPEECH_END would cover:
+/// misfires are dropped and speech still open at the end of the file is closed
+/// as by vad_force_end_speech(). A final partial frame is padded with silence.
+/// The handle's own stream state is left untouched.
+/// Supported files: WAV (PCM16, PCM32, 8-bit or float32, channels averaged) at
+/// the configured sample rate, or headerless mono PCM16 little-endian.
+/// Native engine only (Linux, Windows).
+/// @param handle Initialized VAD handle
+/// @param path Audio file
+/// @param options Chunking and threads, or NULL for one sequential pass that
+///        matches vad_process_audio() exactly
+/// @param out_segments Receives the segments (free with vad_segments_free), NULL if there are none
+/// @param out_count Receives the number of segments
+/// @return 0 on success, negative error code on failure
+FFI_PLUGIN_EXPORT int32_t vad_segment_file(VADHandle *handle, const char *path, const VADSegmentOptions *options,
+                                           VADSegment **out_segments, int32_t *out_count);
+
+/// Same as vad_segment_file() for mono float32 samples already in memory
+/// @param samples Samples at the configured sample rate
+/// @param sample_count Number of samples
+FFI_PLUGIN_EXPORT int32_t vad_segment_buffer(VADHandle *handle, const float *samples, int64_t sample_count,
+                                             const VADSegmentOptions *options, VADSegment **out_segments,
+                                             int32_t *out_count);
+
+/// Free segments returned by vad_segment_file() or vad_segment_buffer()
+/// @param segments Segment array (may be NULL)
+FFI_PLUGIN_EXPORT void vad_segments_free(VADSegment *segments);
+
 /// Get the last error message
 /// @param handle VAD handle
 /// @return Error message string (do not free)
@@ -212,4 +559,8 @@ FFI_PLUGIN_EXPORT void vad_float_to_pcm16(const float *float_samples, int16_t *p
 /// @param sample_count Number of samples
 FFI_PLUGIN_EXPORT void vad_pcm16_to_float(const int16_t *pcm16_samples, float *float_samples, int32_t sample_count);
 
+#ifdef __cplusplus
+}
+#endif
+
 #endif /* VAD_PLUS_H */
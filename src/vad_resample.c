@@ -0,0 +1,212 @@
+#include "vad_resample.h"
+
+#include <math.h>
+#include <string.h>
+
+#include "vad_platform.h"
+
+// Filter design: zero crossings of the sinc on each side of the centre, the
+// passband edge as a fraction of the lower Nyquist rate, and the Kaiser beta
+#define ZERO_CROSSINGS 12
+#define ROLLOFF 0.9
+#define KAISER_BETA 8.0
+
+#define MIN_RATE 4000
+#define MAX_RATE 384000
+#define MAX_PHASES 1024
+
+#define PI 3.14159265358979323846
+
+struct VADResampler
+{
+  /// Output step in input samples: step_whole + step_phase / phases
+  int32_t phases;
+  int32_t step_whole;
+  int32_t step_phase;
+  /// Taps per phase, a multiple of 8
+  int32_t taps;
+  /// phases * taps coefficients, phase by phase
+  float *bank;
+
+  /// Input history: the first tap of the next output is buffer[offset], its
+  /// filter phase is phase
+  float *buffer;
+  int32_t capacity;
+  int32_t length;
+  int32_t offset;
+  int32_t phase;
+};
+
+static int32_t gcd(int32_t a, int32_t b)
+{
+  while (b != 0)
+  {
+    int32_t t = a % b;
+    a = b;
+    b = t;
+  }
+  return a;
+}
+
+/// Zeroth-order modified Bessel function of the first kind (power series)
+static double bessel_i0(double x)
+{
+  double sum = 1.0;
+  double term = 1.0;
+  double quarter = x * x / 4.0;
+  for (int32_t k = 1; k < 64 && term > sum * 1e-17; k++)
+  {
+    term *= quarter / ((double)k * k);
+    sum += term;
+  }
+  return sum;
+}
+
+/// Windowed sinc at t input samples from the centre
+/// @param cutoff Cutoff in cycles per input sample, times two
+/// @param half_width Support of the window in input samples
+static double filter_at(double t, double cutoff, double half_width)
+{
+  if (fabs(t) >= half_width)
+    return 0.0;
+  double x = cutoff * t;
+  double sinc = x == 0.0 ? 1.0 : sin(PI * x) / (PI * x);
+  double ratio = t / half_width;
+  return cutoff * sinc * bessel_i0(KAISER_BETA * sqrt(1.0 - ratio * ratio)) / bessel_i0(KAISER_BETA);
+}
+
+/// Eight independent accumulators, as in vad_kernel_dot(); taps is a multiple of 8
+static float dot(const float *a, const float *b, int32_t n)
+{
+  float acc[8] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f};
+  for (int32_t i = 0; i < n; i += 8)
+  {
+    for (int32_t k = 0; k < 8; k++)
+      acc[k] += a[i + k] * b[i + k];
+  }
+  return ((acc[0] + acc[4]) + (acc[1] + acc[5])) + ((acc[2] + acc[6]) + (acc[3] + acc[7]));
+}
+
+VADResampler *vad_resampler_create(int32_t input_rate, int32_t output_rate)
+{
+  if (input_rate < MIN_RATE || input_rate > MAX_RATE || output_rate < MIN_RATE || output_rate > MAX_RATE)
+    return NULL;
+
+  int32_t divisor = gcd(input_rate, output_rate);
+  int32_t phases = output_rate / divisor;
+  int32_t step = input_rate / divisor;
+  if (phases > MAX_PHASES)
+    return NULL;
+
+  // Low-pass below the lower of the two Nyquist rates
+  double cutoff = (output_rate < input_rate ? (double)output_rate / input_rate : 1.0) * ROLLOFF;
+  double half_width = ZERO_CROSSINGS / cutoff;
+  int32_t taps = 2 * (int32_t)ceil(half_width);
+  taps = (taps + 7) & ~7;
+
+  VADResampler *resampler = (VADResampler *)vad_aligned_alloc(sizeof(VADResampler));
+  if (resampler == NULL)
+    return NULL;
+  memset(resampler, 0, sizeof(VADResampler));
+  resampler->phases = phases;
+  resampler->step_whole = step / phases;
+  resampler->step_phase = step % phases;
+  resampler->taps = taps;
+  resampler->capacity = taps + VAD_RESAMPLER_BLOCK;
+  resampler->bank = (float *)vad_aligned_alloc((size_t)phases * taps * sizeof(float));
+  resampler->buffer = (float *)vad_aligned_alloc((size_t)resampler->capacity * sizeof(float));
+  if (resampler->bank == NULL || resampler->buffer == NULL)
+  {
+    vad_resampler_destroy(resampler);
+    return NULL;
+  }
+
+  // Phase p is the filter for output times p / phases past an input sample;
+  // tap k then weighs the input sample taps / 2 - 1 - k before that sample.
+  // Every phase is normalized to unit gain at DC.
+  for (int32_t p = 0; p < phases; p++)
+  {
+    float *row = resampler->bank + (size_t)p * taps;
+    double sum = 0.0;
+    for (int32_t k = 0; k < taps; k++)
+    {
+      double value = filter_at((double)p / phases + taps / 2 - 1 - k, cutoff, half_width);
+      row[k] = (float)value;
+      sum += value;
+    }
+    for (int32_t k = 0; k < taps; k++)
+      row[k] = (float)(row[k] / sum);
+  }
+
+  vad_resampler_reset(resampler);
+  return resampler;
+}
+
+void vad_resampler_destroy(VADResampler *resampler)
+{
+  if (resampler == NULL)
+    return;
+  vad_aligned_free(resampler->bank);
+  vad_aligned_free(resampler->buffer);
+  vad_aligned_free(resampler);
+}
+
+void vad_resampler_reset(VADResampler *resampler)
+{
+  if (resampler == NULL)
+    return;
+  // Silence before the stream, so output 0 is centred on input sample 0
+  resampler->length = resampler->taps / 2 - 1;
+  memset(resampler->buffer, 0, (size_t)resampler->length * sizeof(float));
+  resampler->offset = 0;
+  resampler->phase = 0;
+}
+
+int32_t vad_resampler_taps(const VADResampler *resampler)
+{
+  return resampler != NULL ? resampler->taps : 0;
+}
+
+int32_t vad_resampler_process(VADResampler *resampler, const float *input, int32_t input_count, int32_t *input_used,
+                              float *output, int32_t output_capacity)
+{
+  int32_t taps = resampler->taps;
+  int32_t used = 0;
+  int32_t produced = 0;
+
+  for (;;)
+  {
+    // Every output whose taps are all buffered
+    while (produced < output_capacity && resampler->offset + taps <= resampler->length)
+    {
+      const float *row = resampler->bank + (size_t)resampler->phase * taps;
+      output[produced++] = dot(row, resampler->buffer + resampler->offset, taps);
+
+      resampler->offset += resampler->step_whole;
+      resampler->phase += resampler->step_phase;
+      if (resampler->phase >= resampler->phases)
+      {
+        resampler->phase -= resampler->phases;
+        resampler->offset++;
+      }
+    }
+    if (produced == output_capacity || used == input_count)
+      break;
+
+    // Drop the samples no later output reads, then refill
+    int32_t drop = resampler->offset < resampler->length ? resampler->offset : resampler->length;
+    resampler->length -= drop;
+    resampler->offset -= drop;
+    memmove(resampler->buffer, resampler->buffer + drop, (size_t)resampler->length * sizeof(float));
+
+    int32_t count = resampler->capacity - resampler->length;
+    if (count > input_count - used)
+      count = input_count - used;
+    memcpy(resampler->buffer + resampler->length, input + used, (size_t)count * sizeof(float));
+    resampler->length += count;
+    used += count;
+  }
+
+  *input_used = used;
+  return produced;
+}
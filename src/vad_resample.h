@@ -0,0 +1,59 @@
+#ifndef VAD_RESAMPLE_H
+#define VAD_RESAMPLE_H
+
+// Streaming polyphase resampler in front of the framing step, so callers can
+// feed audio at its native rate (48 kHz, 44.1 kHz, ...). Each output sample is
+// the dot product of one phase of a Kaiser-windowed sinc filter bank with the
+// input samples around it; the bank is stored phase by phase so every dot
+// product runs over two contiguous arrays. All memory is allocated at create
+// time, processing never allocates.
+//
+// Output sample n sits at input time n * input_rate / output_rate: the filter
+// delay is taken up front, at the cost of a lookahead of half the filter
+// (well under a millisecond for the supported rates).
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Input samples buffered per refill; process() may be called with any count
+#define VAD_RESAMPLER_BLOCK 1024
+
+typedef struct VADResampler VADResampler;
+
+/// Create a resampler
+/// @param input_rate Input sample rate in Hz (4000 to 384000)
+/// @param output_rate Output sample rate in Hz (4000 to 384000)
+/// @return Resampler, or NULL if the rates are out of range, their ratio needs
+///         more than 1024 filter phases, or allocation fails
+VADResampler *vad_resampler_create(int32_t input_rate, int32_t output_rate);
+
+/// Destroy a resampler
+void vad_resampler_destroy(VADResampler *resampler);
+
+/// Back to the start of a stream (silence before the first sample)
+void vad_resampler_reset(VADResampler *resampler);
+
+/// Number of filter taps per output sample
+int32_t vad_resampler_taps(const VADResampler *resampler);
+
+/// Resample part of a stream
+/// Stops when the input is used up or the output is full; call again with the
+/// rest of the input (possibly none) while it returns output_capacity.
+/// @param input Input samples
+/// @param input_count Number of input samples
+/// @param input_used Receives the number of input samples taken
+/// @param output Output samples
+/// @param output_capacity Room in output
+/// @return Number of output samples written
+int32_t vad_resampler_process(VADResampler *resampler, const float *input, int32_t input_count, int32_t *input_used,
+                              float *output, int32_t output_capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VAD_RESAMPLE_H
@@ -0,0 +1,210 @@
+#include "vad_ring.h"
+
+#include <string.h>
+
+#include "vad_convert.h"
+#include "vad_platform.h"
+
+struct VADRing
+{
+  // Producer and consumer positions live on separate cache lines
+  volatile int64_t write_pos;
+  char write_pad[VAD_ALIGNMENT - sizeof(int64_t)];
+  volatile int64_t read_pos;
+  char read_pad[VAD_ALIGNMENT - sizeof(int64_t)];
+
+  int32_t capacity;
+  int32_t mask;
+  int32_t max_window;
+  /// capacity + max_window floats; the tail mirrors the first max_window
+  float *storage;
+};
+
+VADRing *vad_ring_create(int32_t capacity, int32_t max_window)
+{
+  if (capacity <= 0 || max_window <= 0 || capacity > (1 << 28))
+    return NULL;
+
+  int32_t size = 1;
+  while (size < capacity || size < max_window)
+    size <<= 1;
+
+  VADRing *ring = (VADRing *)vad_aligned_alloc(sizeof(VADRing));
+  if (ring == NULL)
+    return NULL;
+  memset(ring, 0, sizeof(VADRing));
+
+  ring->storage = (float *)vad_aligned_alloc((size_t)(size + max_window) * sizeof(float));
+  if (ring->storage == NULL)
+  {
+    vad_aligned_free(ring);
+    return NULL;
+  }
+  ring->capacity = size;
+  ring->mask = size - 1;
+  ring->max_window = max_window;
+  return ring;
+}
+
+void vad_ring_destroy(VADRing *ring)
+{
+  if (ring == NULL)
+    return;
+  vad_aligned_free(ring->storage);
+  vad_aligned_free(ring);
+}
+
+void vad_ring_reset(VADRing *ring)
+{
+  if (ring == NULL)
+    return;
+  vad_atomic_store_release(&ring->read_pos, 0);
+  vad_atomic_store_release(&ring->write_pos, 0);
+}
+
+int32_t vad_ring_capacity(const VADRing *ring)
+{
+  return ring != NULL ? ring->capacity : 0;
+}
+
+const float *vad_ring_data(const VADRing *ring)
+{
+  return ring != NULL ? ring->storage : NULL;
+}
+
+int32_t vad_ring_data_length(const VADRing *ring)
+{
+  return ring != NULL ? ring->capacity + ring->max_window : 0;
+}
+
+/// Reserve space for up to count samples; returns the writable count
+static int32_t writable(VADRing *ring, int32_t count, int32_t *index)
+{
+  int64_t write_pos = ring->write_pos;
+  int64_t read_pos = vad_atomic_load_acquire(&ring->read_pos);
+  int32_t space = ring->capacity - (int32_t)(write_pos - read_pos);
+  *index = (int32_t)(write_pos & ring->mask);
+  return count < space ? count : space;
+}
+
+/// Refresh the mirror for slots [index, index + count) that fall in the first max_window
+static void mirror(VADRing *ring, int32_t index, int32_t count)
+{
+  if (index >= ring->max_window)
+    return;
+  int32_t end = index + count < ring->max_window ? index + count : ring->max_window;
+  memcpy(ring->storage + ring->capacity + index, ring->storage + index, (size_t)(end - index) * sizeof(float));
+}
+
+static void publish(VADRing *ring, int32_t count)
+{
+  vad_atomic_store_release(&ring->write_pos, ring->write_pos + count);
+}
+
+int32_t vad_ring_write(VADRing *ring, const float *samples, int32_t count)
+{
+  if (ring == NULL || samples == NULL || count <= 0)
+    return 0;
+
+  int32_t index;
+  int32_t total = writable(ring, count, &index);
+  int32_t first = total < ring->capacity - index ? total : ring->capacity - index;
+
+  memcpy(ring->storage + index, samples, (size_t)first * sizeof(float));
+  memcpy(ring->storage, samples + first, (size_t)(total - first) * sizeof(float));
+  mirror(ring, index, first);
+  mirror(ring, 0, total - first);
+
+  publish(ring, total);
+  return total;
+}
+
+int32_t vad_ring_write_pcm16(VADRing *ring, const int16_t *samples, int32_t count)
+{
+  if (ring == NULL || samples == NULL || count <= 0)
+    return 0;
+
+  int32_t index;
+  int32_t total = writable(ring, count, &index);
+  int32_t first = total < ring->capacity - index ? total : ring->capacity - index;
+
+  vad_convert_s16_to_f32(samples, ring->storage + index, first);
+  vad_convert_s16_to_f32(samples + first, ring->storage, total - first);
+  mirror(ring, index, first);
+  mirror(ring, 0, total - first);
+
+  publish(ring, total);
+  return total;
+}
+
+int32_t vad_ring_write_s16_frames(VADRing *ring, const int16_t *samples, int32_t channels, int32_t stride,
+                                  int32_t count)
+{
+  if (ring == NULL || samples == NULL || count <= 0 || channels <= 0 || stride < channels)
+    return 0;
+
+  int32_t index;
+  int32_t total = writable(ring, count, &index);
+  int32_t first = total < ring->capacity - index ? total : ring->capacity - index;
+
+  vad_convert_s16_frames_to_f32(samples, channels, stride, ring->storage + index, first);
+  vad_convert_s16_frames_to_f32(samples + (int64_t)first * stride, channels, stride, ring->storage, total - first);
+  mirror(ring, index, first);
+  mirror(ring, 0, total - first);
+
+  publish(ring, total);
+  return total;
+}
+
+int32_t vad_ring_write_f32_frames(VADRing *ring, const float *samples, int32_t channels, int32_t stride,
+                                  int32_t count)
+{
+  if (ring == NULL || samples == NULL || count <= 0 || channels <= 0 || stride < channels)
+    return 0;
+
+  int32_t index;
+  int32_t total = writable(ring, count, &index);
+  int32_t first = total < ring->capacity - index ? total : ring->capacity - index;
+
+  vad_convert_f32_frames_to_f32(samples, channels, stride, ring->storage + index, first);
+  vad_convert_f32_frames_to_f32(samples + (int64_t)first * stride, channels, stride, ring->storage, total - first);
+  mirror(ring, index, first);
+  mirror(ring, 0, total - first);
+
+  publish(ring, total);
+  return total;
+}
+
+int32_t vad_ring_available(VADRing *ring)
+{
+  if (ring == NULL)
+    return 0;
+  return (int32_t)(vad_atomic_load_acquire(&ring->write_pos) - ring->read_pos);
+}
+
+const float *vad_ring_peek(VADRing *ring, int32_t count)
+{
+  if (ring == NULL || count <= 0 || count > ring->max_window || vad_ring_available(ring) < count)
+    return NULL;
+  return ring->storage + (ring->read_pos & ring->mask);
+}
+
+void vad_ring_consume(VADRing *ring, int32_t count)
+{
+  if (ring == NULL || count <= 0)
+    return;
+  int32_t available = vad_ring_available(ring);
+  if (count > available)
+    count = available;
+  vad_atomic_store_release(&ring->read_pos, ring->read_pos + count);
+}
+
+int32_t vad_ring_read(VADRing *ring, float *dst, int32_t count)
+{
+  const float *src = vad_ring_peek(ring, count);
+  if (src == NULL)
+    return 0;
+  memcpy(dst, src, (size_t)count * sizeof(float));
+  vad_ring_consume(ring, count);
+  return 1;
+}
@@ -0,0 +1,82 @@
+#ifndef VAD_RING_H
+#define VAD_RING_H
+
+// Lock-free single-producer/single-consumer float ring used to frame incoming
+// audio. The first max_window samples of the storage are mirrored past its
+// end, so any window of up to max_window unread samples can be read in place
+// as one contiguous block, even across the wrap point.
+//
+// One thread may write (vad_ring_write*) while another reads (vad_ring_peek,
+// vad_ring_consume, vad_ring_read) without locks. Writing never allocates.
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct VADRing VADRing;
+
+/// Create a ring
+/// @param capacity Minimum number of buffered samples (rounded up to a power of two)
+/// @param max_window Largest window that will be peeked (e.g. frame_samples)
+/// @return Ring, or NULL on invalid arguments or allocation failure
+VADRing *vad_ring_create(int32_t capacity, int32_t max_window);
+
+/// Destroy a ring
+void vad_ring_destroy(VADRing *ring);
+
+/// Drop all buffered samples (neither side may be active)
+void vad_ring_reset(VADRing *ring);
+
+/// Number of samples the ring can hold
+int32_t vad_ring_capacity(const VADRing *ring);
+
+/// Backing storage, for exposing the ring to another runtime (e.g. a direct ByteBuffer)
+/// Windows returned by vad_ring_peek always lie inside it; callers must only read.
+const float *vad_ring_data(const VADRing *ring);
+
+/// Number of floats in the backing storage (capacity plus the mirrored window)
+int32_t vad_ring_data_length(const VADRing *ring);
+
+/// Producer: append float samples
+/// @return Number of samples written (less than count if the ring is full)
+int32_t vad_ring_write(VADRing *ring, const float *samples, int32_t count);
+
+/// Producer: append PCM16 samples, converting them to float on the way in
+/// @return Number of samples written (less than count if the ring is full)
+int32_t vad_ring_write_pcm16(VADRing *ring, const int16_t *samples, int32_t count);
+
+/// Producer: append interleaved PCM16 frames as mono float, picking or
+/// averaging channels on the way in (see vad_convert_s16_frames_to_f32())
+/// @param channels Number of adjacent channels averaged per frame
+/// @param stride Samples from one frame to the next
+/// @return Number of frames written (less than count if the ring is full)
+int32_t vad_ring_write_s16_frames(VADRing *ring, const int16_t *samples, int32_t channels, int32_t stride,
+                                  int32_t count);
+
+/// Producer: append interleaved float frames as mono float, as vad_ring_write_s16_frames()
+/// @return Number of frames written (less than count if the ring is full)
+int32_t vad_ring_write_f32_frames(VADRing *ring, const float *samples, int32_t channels, int32_t stride,
+                                  int32_t count);
+
+/// Consumer: number of samples ready to read
+int32_t vad_ring_available(VADRing *ring);
+
+/// Consumer: pointer to the next count unread samples, valid until they are consumed
+/// @return NULL if fewer than count samples are buffered or count exceeds max_window
+const float *vad_ring_peek(VADRing *ring, int32_t count);
+
+/// Consumer: release count samples back to the producer
+void vad_ring_consume(VADRing *ring, int32_t count);
+
+/// Consumer: copy out and consume exactly count samples
+/// @return 1 if count samples were read, 0 if not enough are buffered
+int32_t vad_ring_read(VADRing *ring, float *dst, int32_t count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* VAD_RING_H */
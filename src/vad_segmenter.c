@@ -0,0 +1,113 @@
+#include "vad_segmenter.h"
+
+void vad_segmenter_init(VADSegmenter *segmenter, const VADConfig *config)
+{
+  segmenter->positive_threshold = config->positive_speech_threshold;
+  segmenter->negative_threshold = config->negative_speech_threshold;
+  segmenter->pre_speech_pad_frames = config->pre_speech_pad_frames;
+  segmenter->redemption_frames = config->redemption_frames;
+  segmenter->min_speech_frames = config->min_speech_frames;
+  segmenter->max_speech_frames = config->max_speech_frames;
+  vad_segmenter_reset(segmenter);
+}
+
+static void clear_speech(VADSegmenter *segmenter)
+{
+  segmenter->is_speaking = 0;
+  segmenter->speech_frame_count = 0;
+  segmenter->silence_frame_count = 0;
+  segmenter->has_emitted_real_start = 0;
+  segmenter->segment_frames = 0;
+}
+
+void vad_segmenter_reset(VADSegmenter *segmenter)
+{
+  clear_speech(segmenter);
+  segmenter->frame_index = 0;
+  segmenter->segment_start = 0;
+  segmenter->ended_start = 0;
+  segmenter->ended_end = 0;
+}
+
+uint32_t vad_segmenter_push(VADSegmenter *segmenter, float probability)
+{
+  uint32_t transitions = 0;
+  int64_t frame = segmenter->frame_index++;
+
+  if (!segmenter->is_speaking)
+  {
+    if (probability >= segmenter->positive_threshold)
+    {
+      segmenter->is_speaking = 1;
+      segmenter->speech_frame_count = 1;
+      segmenter->silence_frame_count = 0;
+      segmenter->has_emitted_real_start = 0;
+      segmenter->segment_frames = 1;
+
+      // The pad holds the frames before this one, as many as were seen
+      int64_t pad = frame < segmenter->pre_speech_pad_frames ? frame : segmenter->pre_speech_pad_frames;
+      segmenter->segment_start = frame - pad;
+      transitions |= VAD_SEGMENTER_START;
+    }
+  }
+  else
+  {
+    segmenter->segment_frames++;
+
+    if (probability >= segmenter->positive_threshold)
+    {
+      segmenter->speech_frame_count++;
+      segmenter->silence_frame_count = 0;
+
+      if (!segmenter->has_emitted_real_start && segmenter->speech_frame_count >= segmenter->min_speech_frames)
+      {
+        segmenter->has_emitted_real_start = 1;
+        transitions |= VAD_SEGMENTER_REAL_START;
+      }
+    }
+    else if (probability < segmenter->negative_threshold)
+    {
+      segmenter->silence_frame_count++;
+
+      // The segment keeps its trailing silence frames
+      if (segmenter->silence_frame_count >= segmenter->redemption_frames)
+      {
+        transitions |= segmenter->speech_frame_count >= segmenter->min_speech_frames ? VAD_SEGMENTER_END
+                                                                                     : VAD_SEGMENTER_MISFIRE;
+        segmenter->ended_start = segmenter->segment_start;
+        segmenter->ended_end = frame + 1;
+        clear_speech(segmenter);
+      }
+    }
+  }
+
+  // Only confirmed segments are split: an unconfirmed one runs on until it is
+  // confirmed or ends as a misfire. The continuation confirms on its own speech
+  // frames, and trailing silence keeps counting towards its redemption.
+  if (segmenter->is_speaking && segmenter->has_emitted_real_start && segmenter->max_speech_frames > 0 &&
+      segmenter->segment_frames >= segmenter->max_speech_frames)
+  {
+    transitions |= VAD_SEGMENTER_SPLIT;
+    segmenter->ended_start = segmenter->segment_start;
+    segmenter->ended_end = frame + 1;
+    segmenter->segment_start = frame + 1;
+    segmenter->segment_frames = 0;
+    segmenter->speech_frame_count = 0;
+    segmenter->has_emitted_real_start = 0;
+  }
+  return transitions;
+}
+
+int32_t vad_segmenter_close(VADSegmenter *segmenter)
+{
+  if (!segmenter->is_speaking)
+    return 0;
+
+  // A split on the last frame leaves an open segment with no frames yet
+  int32_t is_speech = segmenter->frame_index > segmenter->segment_start &&
+                      segmenter->speech_frame_count >= segmenter->min_speech_frames;
+  segmenter->ended_start = segmenter->segment_start;
+  segmenter->ended_end = segmenter->frame_index;
+  clear_speech(segmenter);
+  return is_speech;
+}
@@ -0,0 +1,78 @@
+#ifndef VAD_SEGMENTER_H
+#define VAD_SEGMENTER_H
+
+// Speech/silence hysteresis over per-frame probabilities. The live engine
+// drives it frame by frame and turns its transitions into events; offline
+// segmentation only keeps the segment boundaries it reports. Positions are in
+// frames since the last reset.
+
+#include <stdint.h>
+
+#include "vad_plus.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Transitions reported by vad_segmenter_push() for one frame
+/// Speech started with this frame; the segment begins with the pre-speech pad
+#define VAD_SEGMENTER_START 0x1u
+/// The segment reached min_speech_frames speech frames
+#define VAD_SEGMENTER_REAL_START 0x2u
+/// A confirmed segment ended with this frame
+#define VAD_SEGMENTER_END 0x4u
+/// A segment ended with this frame before reaching min_speech_frames
+#define VAD_SEGMENTER_MISFIRE 0x8u
+/// A confirmed segment reached max_speech_frames and ended with this frame; the
+/// next frame continues in a new, unconfirmed segment that needs
+/// min_speech_frames speech frames of its own and otherwise ends as a misfire
+#define VAD_SEGMENTER_SPLIT 0x10u
+
+typedef struct VADSegmenter
+{
+    float positive_threshold;
+    float negative_threshold;
+    int32_t pre_speech_pad_frames;
+    int32_t redemption_frames;
+    int32_t min_speech_frames;
+    int32_t max_speech_frames;
+
+    /// Frames pushed since the last reset
+    int64_t frame_index;
+    /// Also read by other threads (vad_is_speaking)
+    volatile int32_t is_speaking;
+    int32_t speech_frame_count;
+    int32_t silence_frame_count;
+    int32_t has_emitted_real_start;
+    /// Frames of the segment after its pre-speech pad
+    int32_t segment_frames;
+    /// First frame of the open segment, pre-speech pad included
+    int64_t segment_start;
+    /// Bounds of the segment that ended with the last push, [start, end) in frames
+    int64_t ended_start;
+    int64_t ended_end;
+} VADSegmenter;
+
+/// Take the thresholds and frame counts from config and reset
+void vad_segmenter_init(VADSegmenter *segmenter, const VADConfig *config);
+
+/// Back to frame 0 with no open segment
+void vad_segmenter_reset(VADSegmenter *segmenter);
+
+/// Advance by one frame
+/// @param probability Speech probability of the frame
+/// @return OR of VAD_SEGMENTER_* transitions; after END, MISFIRE or SPLIT the
+///         ended segment is in ended_start / ended_end
+uint32_t vad_segmenter_push(VADSegmenter *segmenter, float probability);
+
+/// Close the open segment before its natural end (forced end, end of input)
+/// @return 1 if the segment counts as speech (bounds in ended_start /
+///         ended_end), 0 if there was none or it had too few speech frames
+int32_t vad_segmenter_close(VADSegmenter *segmenter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VAD_SEGMENTER_H
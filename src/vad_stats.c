@@ -0,0 +1,222 @@
+#include "vad_stats.h"
+
+#include <string.h>
+
+#include "vad_platform.h"
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+// Histogram buckets: values below 2 * kSubBuckets nanoseconds get one bucket
+// each, every power of two above is split into kSubBuckets equal buckets (a
+// bucket spans at most 1/8 of its lower bound). Values from 2^VAD_STATS_MAX_EXPONENT ns
+// (about 18 minutes) up land in the last bucket.
+#define VAD_STATS_SUB_BITS 3
+#define VAD_STATS_MAX_EXPONENT 40
+
+enum
+{
+  kSubBuckets = 1 << VAD_STATS_SUB_BITS,
+  kLinearBuckets = 2 * kSubBuckets,
+  kBuckets = kLinearBuckets + (VAD_STATS_MAX_EXPONENT - VAD_STATS_SUB_BITS - 1) * kSubBuckets,
+};
+
+typedef struct Histogram
+{
+  volatile uint32_t buckets[kBuckets];
+  volatile int64_t max_ns;
+} Histogram;
+
+struct VADStatsRecorder
+{
+  Histogram inference;
+  Histogram callback;
+  volatile int64_t late_frames;
+  volatile int64_t gated_frames;
+  volatile int64_t dropped_samples;
+  volatile uint32_t queued_samples;
+  volatile int64_t speech_bytes;
+  volatile int64_t speech_capacity_bytes;
+};
+
+static int32_t log2_u64(uint64_t value)
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+  unsigned long index;
+  _BitScanReverse64(&index, value);
+  return (int32_t)index;
+#else
+  return 63 - __builtin_clzll(value);
+#endif
+}
+
+static int32_t bucket_index(uint64_t ns)
+{
+  if (ns < (uint64_t)kLinearBuckets)
+    return (int32_t)ns;
+  int32_t exponent = log2_u64(ns);
+  if (exponent >= VAD_STATS_MAX_EXPONENT)
+    return kBuckets - 1;
+  int32_t sub = (int32_t)(ns >> (exponent - VAD_STATS_SUB_BITS)) & (kSubBuckets - 1);
+  return kLinearBuckets + (exponent - VAD_STATS_SUB_BITS - 1) * kSubBuckets + sub;
+}
+
+/// Midpoint of a bucket, in nanoseconds
+static double bucket_value(int32_t index)
+{
+  if (index < kLinearBuckets)
+    return (double)index;
+  int32_t group = (index - kLinearBuckets) / kSubBuckets;
+  int32_t sub = (index - kLinearBuckets) % kSubBuckets;
+  double width = (double)(1ull << (group + 1));
+  return (double)(kSubBuckets + sub) * width + width * 0.5;
+}
+
+static void histogram_record(Histogram *histogram, uint64_t ns)
+{
+  vad_atomic_add_u32(&histogram->buckets[bucket_index(ns)], 1);
+  vad_atomic_max(&histogram->max_ns, (int64_t)ns);
+}
+
+static void histogram_clear(Histogram *histogram)
+{
+  for (int32_t i = 0; i < kBuckets; i++)
+    vad_atomic_store_release_u32(&histogram->buckets[i], 0);
+  vad_atomic_store_release(&histogram->max_ns, 0);
+}
+
+/// Snapshot a histogram and compute its percentiles in microseconds
+/// @return Number of samples
+static uint64_t histogram_read(const Histogram *histogram, float *p50, float *p95, float *p99, float *max)
+{
+  static const double kQuantiles[3] = {0.50, 0.95, 0.99};
+  float *outputs[3] = {p50, p95, p99};
+
+  uint32_t counts[kBuckets];
+  uint64_t total = 0;
+  for (int32_t i = 0; i < kBuckets; i++)
+  {
+    counts[i] = vad_atomic_load_acquire_u32((volatile uint32_t *)&histogram->buckets[i]);
+    total += counts[i];
+  }
+  double max_ns = (double)vad_atomic_load_acquire((volatile int64_t *)&histogram->max_ns);
+  *max = (float)(max_ns / 1e3);
+
+  int32_t bucket = 0;
+  uint64_t seen = 0;
+  for (int32_t q = 0; q < 3; q++)
+  {
+    if (total == 0)
+    {
+      *outputs[q] = 0.0f;
+      continue;
+    }
+    // Smallest value with at least this fraction of the samples at or below it
+    uint64_t rank = (uint64_t)(kQuantiles[q] * (double)total + 0.999999);
+    rank = rank < 1 ? 1 : rank;
+    while (bucket < kBuckets - 1 && seen + counts[bucket] < rank)
+      seen += counts[bucket++];
+    double value = bucket_value(bucket);
+    *outputs[q] = (float)((value < max_ns ? value : max_ns) / 1e3);
+  }
+  return total;
+}
+
+VADStatsRecorder *vad_stats_create(void)
+{
+  VADStatsRecorder *stats = (VADStatsRecorder *)vad_aligned_alloc(sizeof(VADStatsRecorder));
+  if (stats == NULL)
+    return NULL;
+  memset(stats, 0, sizeof(VADStatsRecorder));
+  return stats;
+}
+
+void vad_stats_destroy(VADStatsRecorder *stats)
+{
+  vad_aligned_free(stats);
+}
+
+void vad_stats_reset(VADStatsRecorder *stats)
+{
+  if (stats == NULL)
+    return;
+  histogram_clear(&stats->inference);
+  histogram_clear(&stats->callback);
+  vad_atomic_store_release(&stats->late_frames, 0);
+  vad_atomic_store_release(&stats->gated_frames, 0);
+  vad_atomic_store_release(&stats->dropped_samples, 0);
+  vad_atomic_store_release_u32(&stats->queued_samples, 0);
+  vad_atomic_store_release(&stats->speech_bytes, 0);
+}
+
+void vad_stats_record_frame(VADStatsRecorder *stats, uint64_t inference_ns, uint64_t frame_ns, uint64_t budget_ns)
+{
+  if (stats == NULL)
+    return;
+  histogram_record(&stats->inference, inference_ns);
+  if (frame_ns > budget_ns)
+    vad_atomic_add(&stats->late_frames, 1);
+}
+
+void vad_stats_add_gated(VADStatsRecorder *stats)
+{
+  if (stats == NULL)
+    return;
+  vad_atomic_add(&stats->gated_frames, 1);
+}
+
+void vad_stats_record_callback(VADStatsRecorder *stats, uint64_t ns)
+{
+  if (stats == NULL)
+    return;
+  histogram_record(&stats->callback, ns);
+}
+
+void vad_stats_add_dropped(VADStatsRecorder *stats, int64_t samples)
+{
+  if (stats == NULL || samples <= 0)
+    return;
+  vad_atomic_add(&stats->dropped_samples, samples);
+}
+
+void vad_stats_set_queued(VADStatsRecorder *stats, int32_t samples)
+{
+  if (stats == NULL)
+    return;
+  vad_atomic_store_release_u32(&stats->queued_samples, (uint32_t)samples);
+}
+
+void vad_stats_set_speech(VADStatsRecorder *stats, int64_t bytes, int64_t capacity_bytes)
+{
+  if (stats == NULL)
+    return;
+  vad_atomic_store_release(&stats->speech_bytes, bytes);
+  vad_atomic_store_release(&stats->speech_capacity_bytes, capacity_bytes);
+}
+
+void vad_stats_read(const VADStatsRecorder *stats, VADEventPool *events, VADStats *stats_out)
+{
+  memset(stats_out, 0, sizeof(VADStats));
+  if (events != NULL)
+  {
+    VADEventPoolStats pool;
+    vad_event_pool_get_stats(events, &pool);
+    stats_out->pending_events = pool.outstanding;
+    stats_out->dropped_events = (uint64_t)pool.dropped;
+  }
+  if (stats == NULL)
+    return;
+
+  stats_out->frames_processed = histogram_read(&stats->inference, &stats_out->inference_p50_us,
+                                               &stats_out->inference_p95_us, &stats_out->inference_p99_us,
+                                               &stats_out->inference_max_us);
+  stats_out->callbacks = histogram_read(&stats->callback, &stats_out->callback_p50_us, &stats_out->callback_p95_us,
+                                        &stats_out->callback_p99_us, &stats_out->callback_max_us);
+  stats_out->late_frames = (uint64_t)vad_atomic_load_acquire((volatile int64_t *)&stats->late_frames);
+  stats_out->dropped_samples = (uint64_t)vad_atomic_load_acquire((volatile int64_t *)&stats->dropped_samples);
+  stats_out->gated_frames = (uint64_t)vad_atomic_load_acquire((volatile int64_t *)&stats->gated_frames);
+  stats_out->queued_samples = (int32_t)vad_atomic_load_acquire_u32((volatile uint32_t *)&stats->queued_samples);
+  stats_out->speech_buffer_bytes = vad_atomic_load_acquire((volatile int64_t *)&stats->speech_bytes);
+  stats_out->speech_capacity_bytes = vad_atomic_load_acquire((volatile int64_t *)&stats->speech_capacity_bytes);
+}
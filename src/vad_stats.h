@@ -0,0 +1,62 @@
+#ifndef VAD_STATS_H
+#define VAD_STATS_H
+
+// Recorder behind vad_get_stats (see VADStats in vad_plus.h), shared by every
+// platform implementation. Recording is lock-free: each sample is one relaxed
+// atomic add into a log-bucketed histogram, so it stays on in the hot path.
+// Percentiles are only computed when the stats are read, from any thread.
+
+#include <stdint.h>
+
+#include "vad_events.h"
+#include "vad_plus.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+typedef struct VADStatsRecorder VADStatsRecorder;
+
+/// Allocate a zeroed, cache-line-aligned recorder
+/// @return Recorder, or NULL on allocation failure
+VADStatsRecorder *vad_stats_create(void);
+
+/// Free a recorder
+void vad_stats_destroy(VADStatsRecorder *stats);
+
+/// Clear every counter and histogram. Samples recorded concurrently by
+/// another thread may survive the reset.
+void vad_stats_reset(VADStatsRecorder *stats);
+
+/// Record one processed frame
+/// @param inference_ns Model inference time
+/// @param frame_ns Whole frame time: inference, VAD logic and callbacks
+/// @param budget_ns Duration of the audio in the frame; longer frames count as late
+void vad_stats_record_frame(VADStatsRecorder *stats, uint64_t inference_ns, uint64_t frame_ns, uint64_t budget_ns);
+
+/// Count a frame the silence gate kept from the model (vad_gate.h); it is
+/// not recorded as a frame
+void vad_stats_add_gated(VADStatsRecorder *stats);
+
+/// Record the time one event spent in the callback
+void vad_stats_record_callback(VADStatsRecorder *stats, uint64_t ns);
+
+/// Count captured samples lost to a full input queue
+void vad_stats_add_dropped(VADStatsRecorder *stats, int64_t samples);
+
+/// Publish the samples waiting for a frame to complete
+void vad_stats_set_queued(VADStatsRecorder *stats, int32_t samples);
+
+/// Publish the speech storage in use and allocated
+void vad_stats_set_speech(VADStatsRecorder *stats, int64_t bytes, int64_t capacity_bytes);
+
+/// Read the counters and compute the latency percentiles
+/// @param events The handle's event pool, for pending_events (may be NULL)
+void vad_stats_read(const VADStatsRecorder *stats, VADEventPool *events, VADStats *stats_out);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VAD_STATS_H
@@ -0,0 +1,73 @@
+#include "vad_status.h"
+
+#include <stddef.h>
+#include <string.h>
+
+#include "vad_platform.h"
+
+// Readers outside C (Dart) map the block with fixed offsets
+_Static_assert(offsetof(VADStatusBlock, history) == VAD_ALIGNMENT, "history must start on the second cache line");
+
+VADStatusBlock *vad_status_create(void)
+{
+  VADStatusBlock *status = (VADStatusBlock *)vad_aligned_alloc(sizeof(VADStatusBlock));
+  if (status == NULL)
+    return NULL;
+  memset(status, 0, sizeof(VADStatusBlock));
+  status->history_length = VAD_STATUS_HISTORY;
+  return status;
+}
+
+void vad_status_destroy(VADStatusBlock *status)
+{
+  vad_aligned_free(status);
+}
+
+/// Enter the write section: readers seeing an odd sequence retry
+static uint32_t write_begin(VADStatusBlock *status)
+{
+  uint32_t sequence = status->sequence + 1;
+  vad_atomic_store_release_u32(&status->sequence, sequence);
+  vad_atomic_fence_release();
+  return sequence;
+}
+
+static void write_end(VADStatusBlock *status, uint32_t sequence)
+{
+  vad_atomic_store_release_u32(&status->sequence, sequence + 1);
+}
+
+void vad_status_reset(VADStatusBlock *status)
+{
+  if (status == NULL)
+    return;
+
+  uint32_t sequence = write_begin(status);
+  status->is_speaking = 0;
+  status->frame_count = 0;
+  status->last_probability = 0.0f;
+  for (int32_t i = 0; i < VAD_STATUS_HISTORY; i++)
+    status->history[i] = 0.0f;
+  write_end(status, sequence);
+}
+
+void vad_status_publish_frame(VADStatusBlock *status, float probability, int32_t is_speaking)
+{
+  if (status == NULL)
+    return;
+
+  uint32_t sequence = write_begin(status);
+  uint32_t frame = status->frame_count;
+  status->history[frame % VAD_STATUS_HISTORY] = probability;
+  status->last_probability = probability;
+  status->frame_count = frame + 1;
+  status->is_speaking = is_speaking ? 1 : 0;
+  write_end(status, sequence);
+}
+
+void vad_status_set_speaking(VADStatusBlock *status, int32_t is_speaking)
+{
+  if (status == NULL)
+    return;
+  status->is_speaking = is_speaking ? 1 : 0;
+}
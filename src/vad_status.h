@@ -0,0 +1,39 @@
+#ifndef VAD_STATUS_H
+#define VAD_STATUS_H
+
+// Writer side of VADStatusBlock (see vad_plus.h), shared by every platform
+// implementation. Each handle has one block, written by the thread running
+// inference; readers poll it without calls or locks.
+
+#include <stdint.h>
+
+#include "vad_plus.h"
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Allocate a zeroed, cache-line-aligned block
+/// @return Block, or NULL on allocation failure
+VADStatusBlock *vad_status_create(void);
+
+/// Free a block
+void vad_status_destroy(VADStatusBlock *status);
+
+/// Clear the speaking flag, frame counter and history
+void vad_status_reset(VADStatusBlock *status);
+
+/// Record one processed frame
+/// @param probability Speech probability of the frame
+/// @param is_speaking Speaking state after the frame
+void vad_status_publish_frame(VADStatusBlock *status, float probability, int32_t is_speaking);
+
+/// Update the speaking flag outside of frame processing (e.g. forced speech end)
+void vad_status_set_speaking(VADStatusBlock *status, int32_t is_speaking);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VAD_STATUS_H
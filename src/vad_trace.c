@@ -0,0 +1,309 @@
+#if !defined(_WIN32) && !defined(_GNU_SOURCE)
+// Needed for syscall(SYS_gettid)
+#define _GNU_SOURCE
+#endif
+
+#include "vad_trace.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#include "vad_platform.h"
+
+#if !_WIN32
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#define VAD_THREAD_LOCAL __declspec(thread)
+#else
+#define VAD_THREAD_LOCAL _Thread_local
+#endif
+
+// Tracers each thread recently recorded into, direct-mapped by session key
+#define VAD_TRACE_CACHE_SIZE 4
+
+typedef struct TraceRecord
+{
+  uint64_t start_ns;
+  uint64_t end_ns;
+  int32_t span;
+  int32_t arg;
+} TraceRecord;
+
+typedef struct TraceRing
+{
+  // Operating system id of the owning thread, 0 once released by
+  // vad_tracer_start() (guarded by lock)
+  uint64_t thread;
+  TraceRecord *records;
+  int32_t capacity;
+  // Spans recorded; the owner publishes each with a release store
+  volatile int64_t written;
+} TraceRing;
+
+struct VADTracer
+{
+  volatile uint32_t enabled;
+  // Unique per session, so rings cached by threads in earlier sessions (or
+  // for a tracer since freed) are never taken for this one
+  volatile int64_t key;
+  volatile int64_t session_start_ns;
+  volatile int64_t dropped;
+
+  // Claiming a ring and dumping take the lock; recording does not
+  vad_mutex_t lock;
+  int32_t capacity;
+  int32_t ring_count;
+  TraceRing rings[VAD_TRACE_MAX_THREADS];
+};
+
+typedef struct TraceCacheEntry
+{
+  int64_t key;
+  TraceRing *ring;
+} TraceCacheEntry;
+
+static VAD_THREAD_LOCAL TraceCacheEntry t_cache[VAD_TRACE_CACHE_SIZE];
+
+static vad_static_mutex_t g_key_lock = VAD_STATIC_MUTEX_INIT;
+static int64_t g_next_key = 1;
+
+static const char *const kSpanNames[VAD_TRACE_SPAN_COUNT] = {
+    "capture", "process_audio", "frame", "inference", "vad_logic", "callback_lock", "callback", "prewarm",
+};
+
+static const char *const kEventNames[] = {
+    "initialized", "speech_start", "speech_end", "frame_processed", "real_speech_start",
+    "misfire",     "error",        "stopped",    "speech_chunk",
+};
+
+static int64_t next_key(void)
+{
+  vad_static_mutex_lock(&g_key_lock);
+  int64_t key = g_next_key++;
+  vad_static_mutex_unlock(&g_key_lock);
+  return key;
+}
+
+/// Operating system id of the calling thread, as profilers show it
+static uint64_t current_thread(void)
+{
+#if _WIN32
+  return (uint64_t)GetCurrentThreadId();
+#elif defined(__APPLE__)
+  uint64_t id = 0;
+  pthread_threadid_np(NULL, &id);
+  return id;
+#elif defined(__linux__)
+  return (uint64_t)syscall(SYS_gettid);
+#else
+  // The address of a thread-local is distinct for every live thread
+  return (uint64_t)(uintptr_t)&t_cache;
+#endif
+}
+
+static int32_t current_pid(void)
+{
+#if _WIN32
+  return (int32_t)GetCurrentProcessId();
+#else
+  return (int32_t)getpid();
+#endif
+}
+
+/// Find or claim the calling thread's ring
+/// @return Ring, or NULL when every ring is taken or allocation failed
+static TraceRing *claim_ring(VADTracer *tracer)
+{
+  uint64_t thread = current_thread();
+  TraceRing *ring = NULL;
+
+  vad_mutex_lock(&tracer->lock);
+  for (int32_t i = 0; i < tracer->ring_count && ring == NULL; i++)
+  {
+    if (tracer->rings[i].thread == thread)
+      ring = &tracer->rings[i];
+  }
+  // Rings released by vad_tracer_start() are reused before new ones are allocated
+  for (int32_t i = 0; i < tracer->ring_count && ring == NULL; i++)
+  {
+    if (tracer->rings[i].thread == 0)
+      ring = &tracer->rings[i];
+  }
+  if (ring == NULL && tracer->ring_count < VAD_TRACE_MAX_THREADS)
+  {
+    TraceRecord *records = (TraceRecord *)vad_aligned_alloc((size_t)tracer->capacity * sizeof(TraceRecord));
+    if (records != NULL)
+    {
+      ring = &tracer->rings[tracer->ring_count++];
+      ring->records = records;
+      ring->capacity = tracer->capacity;
+    }
+  }
+  if (ring != NULL && ring->thread != thread)
+  {
+    ring->thread = thread;
+    vad_atomic_store_release(&ring->written, 0);
+  }
+  vad_mutex_unlock(&tracer->lock);
+  return ring;
+}
+
+VADTracer *vad_tracer_create(void)
+{
+  VADTracer *tracer = (VADTracer *)vad_aligned_alloc(sizeof(VADTracer));
+  if (tracer == NULL)
+    return NULL;
+  memset(tracer, 0, sizeof(VADTracer));
+  vad_mutex_init(&tracer->lock);
+  tracer->capacity = VAD_TRACE_DEFAULT_EVENTS;
+  tracer->key = next_key();
+  return tracer;
+}
+
+void vad_tracer_destroy(VADTracer *tracer)
+{
+  if (tracer == NULL)
+    return;
+  for (int32_t i = 0; i < tracer->ring_count; i++)
+    vad_aligned_free(tracer->rings[i].records);
+  vad_mutex_destroy(&tracer->lock);
+  vad_aligned_free(tracer);
+}
+
+void vad_tracer_start(VADTracer *tracer, int32_t events_per_thread)
+{
+  if (tracer == NULL)
+    return;
+  vad_mutex_lock(&tracer->lock);
+  tracer->capacity = events_per_thread > 0 ? events_per_thread : VAD_TRACE_DEFAULT_EVENTS;
+  // Threads of an earlier session may have exited: release their rings, and
+  // the new key sends every thread back through claim_ring()
+  for (int32_t i = 0; i < tracer->ring_count; i++)
+    tracer->rings[i].thread = 0;
+  vad_atomic_store_release(&tracer->key, next_key());
+  vad_atomic_store_release(&tracer->dropped, 0);
+  vad_atomic_store_release(&tracer->session_start_ns, (int64_t)vad_now_ns());
+  vad_mutex_unlock(&tracer->lock);
+  vad_atomic_store_release_u32(&tracer->enabled, 1);
+}
+
+void vad_tracer_stop(VADTracer *tracer)
+{
+  if (tracer == NULL)
+    return;
+  vad_atomic_store_release_u32(&tracer->enabled, 0);
+}
+
+uint64_t vad_tracer_now(const VADTracer *tracer)
+{
+  if (tracer == NULL || !vad_atomic_load_acquire_u32((volatile uint32_t *)&tracer->enabled))
+    return 0;
+  return vad_now_ns();
+}
+
+void vad_tracer_record(VADTracer *tracer, int32_t span, int32_t arg, uint64_t start_ns, uint64_t end_ns)
+{
+  if (tracer == NULL || start_ns == 0)
+    return;
+
+  int64_t key = vad_atomic_load_acquire(&tracer->key);
+  TraceCacheEntry *entry = &t_cache[key & (VAD_TRACE_CACHE_SIZE - 1)];
+  if (entry->key != key)
+  {
+    TraceRing *ring = claim_ring(tracer);
+    if (ring == NULL)
+    {
+      vad_atomic_add(&tracer->dropped, 1);
+      return;
+    }
+    entry->key = key;
+    entry->ring = ring;
+  }
+
+  if (end_ns == 0)
+    end_ns = vad_now_ns();
+  TraceRing *ring = entry->ring;
+  int64_t written = vad_atomic_load_acquire(&ring->written);
+  TraceRecord *record = &ring->records[written % ring->capacity];
+  record->start_ns = start_ns;
+  record->end_ns = end_ns >= start_ns ? end_ns : start_ns;
+  record->span = span;
+  record->arg = arg;
+  vad_atomic_store_release(&ring->written, written + 1);
+}
+
+static void write_args(FILE *file, int32_t span, int32_t arg)
+{
+  switch (span)
+  {
+  case VAD_TRACE_CAPTURE:
+  case VAD_TRACE_PROCESS_AUDIO:
+    fprintf(file, "{\"samples\":%d}", arg);
+    break;
+  case VAD_TRACE_CALLBACK_LOCK:
+  case VAD_TRACE_CALLBACK:
+    if (arg >= 0 && arg < (int32_t)(sizeof(kEventNames) / sizeof(kEventNames[0])))
+      fprintf(file, "{\"event\":\"%s\"}", kEventNames[arg]);
+    else
+      fprintf(file, "{\"event\":%d}", arg);
+    break;
+  case VAD_TRACE_PREWARM:
+    fprintf(file, "{\"frames\":%d}", arg);
+    break;
+  default:
+    fprintf(file, "{\"frame\":%d}", arg);
+    break;
+  }
+}
+
+int32_t vad_tracer_write_json(VADTracer *tracer, const char *path, char *error, size_t error_size)
+{
+  FILE *file = fopen(path, "wb");
+  if (file == NULL)
+  {
+    snprintf(error, error_size, "Failed to open trace file: %s", path);
+    return -1;
+  }
+
+  int32_t pid = current_pid();
+  uint64_t session = (uint64_t)vad_atomic_load_acquire(&tracer->session_start_ns);
+  int64_t overwritten = 0;
+
+  fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  fprintf(file, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":\"vad_plus\"}}", pid);
+
+  vad_mutex_lock(&tracer->lock);
+  for (int32_t r = 0; r < tracer->ring_count; r++)
+  {
+    const TraceRing *ring = &tracer->rings[r];
+    int64_t written = vad_atomic_load_acquire((volatile int64_t *)&ring->written);
+    int64_t first = written > ring->capacity ? written - ring->capacity : 0;
+    overwritten += first;
+    for (int64_t i = first; i < written; i++)
+    {
+      const TraceRecord *record = &ring->records[i % ring->capacity];
+      if (record->start_ns < session || record->span < 0 || record->span >= VAD_TRACE_SPAN_COUNT)
+        continue;
+      fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"vad\",\"ph\":\"X\",\"pid\":%d,\"tid\":%llu,",
+              kSpanNames[record->span], pid, (unsigned long long)ring->thread);
+      fprintf(file, "\"ts\":%.3f,\"dur\":%.3f,\"args\":", (double)(record->start_ns - session) / 1e3,
+              (double)(record->end_ns - record->start_ns) / 1e3);
+      write_args(file, record->span, record->arg);
+      fputc('}', file);
+    }
+  }
+  vad_mutex_unlock(&tracer->lock);
+
+  fprintf(file, "\n],\"otherData\":{\"dropped_spans\":%lld,\"overwritten_spans\":%lld}}\n",
+          (long long)vad_atomic_load_acquire(&tracer->dropped), (long long)overwritten);
+
+  if (fclose(file) != 0)
+  {
+    snprintf(error, error_size, "Failed to write trace file: %s", path);
+    return -1;
+  }
+  return 0;
+}
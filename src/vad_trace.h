@@ -0,0 +1,82 @@
+#ifndef VAD_TRACE_H
+#define VAD_TRACE_H
+
+// Timeline trace behind vad_trace_start / vad_trace_dump, shared by every
+// platform implementation. Each thread that records a span gets its own ring
+// of complete spans (begin and end in one record), claimed on its first span
+// and written without locks or atomics other than one release store. While
+// tracing is off, vad_tracer_now() returns 0 and callers skip the span.
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+/// Pipeline stages; the name and the meaning of arg are given per stage
+typedef enum VADTraceSpan
+{
+    /// "capture": microphone buffer handed to the pipeline, arg = samples
+    VAD_TRACE_CAPTURE = 0,
+    /// "process_audio": caller-fed audio through framing and every frame it
+    /// completes, arg = samples
+    VAD_TRACE_PROCESS_AUDIO = 1,
+    /// "frame": one frame, inference to the last callback, arg = frame index
+    VAD_TRACE_FRAME = 2,
+    /// "inference": model run, arg = frame index
+    VAD_TRACE_INFERENCE = 3,
+    /// "vad_logic": speech state machine and storage, arg = frame index
+    VAD_TRACE_VAD_LOGIC = 4,
+    /// "callback_lock": waiting for the callback lock, arg = event type
+    VAD_TRACE_CALLBACK_LOCK = 5,
+    /// "callback": event in the consumer's callback, arg = event type
+    VAD_TRACE_CALLBACK = 6,
+    /// "prewarm": warm-up run, arg = frames
+    VAD_TRACE_PREWARM = 7,
+    VAD_TRACE_SPAN_COUNT = 8,
+} VADTraceSpan;
+
+/// Spans kept per thread when vad_tracer_start() is given 0 (24 bytes each)
+#define VAD_TRACE_DEFAULT_EVENTS 65536
+
+/// Threads that can record into one tracer; spans of further threads are dropped
+#define VAD_TRACE_MAX_THREADS 16
+
+typedef struct VADTracer VADTracer;
+
+/// Allocate a stopped tracer; a thread ring is allocated on its first span
+/// @return Tracer, or NULL on allocation failure
+VADTracer *vad_tracer_create(void);
+
+/// Free a tracer and its thread rings. No thread may be recording.
+void vad_tracer_destroy(VADTracer *tracer);
+
+/// Start a trace session: spans recorded before it are left out of the dump
+/// @param events_per_thread Ring size for threads that record their first
+/// span from now on (0 for VAD_TRACE_DEFAULT_EVENTS); older rings keep theirs
+void vad_tracer_start(VADTracer *tracer, int32_t events_per_thread);
+
+/// Stop recording; recorded spans are kept for vad_tracer_write_json()
+void vad_tracer_stop(VADTracer *tracer);
+
+/// Timestamp to open a span with, on the vad_now_ns() clock
+/// @return 0 while tracing is off (or tracer is NULL)
+uint64_t vad_tracer_now(const VADTracer *tracer);
+
+/// Record a span into the calling thread's ring, overwriting its oldest span
+/// when full. Nothing is recorded when start_ns is 0; an end_ns of 0 means now.
+void vad_tracer_record(VADTracer *tracer, int32_t span, int32_t arg, uint64_t start_ns, uint64_t end_ns);
+
+/// Write the spans of the current session as Chrome trace-event JSON
+/// (Perfetto, chrome://tracing). Safe while threads record; spans written
+/// during the dump may be missing or, at a ring's wrap point, torn.
+/// @return 0 on success, -1 on failure with a message in error
+int32_t vad_tracer_write_json(VADTracer *tracer, const char *path, char *error, size_t error_size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // VAD_TRACE_H